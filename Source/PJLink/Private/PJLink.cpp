@@ -2,6 +2,11 @@
 #include "PJLink.h"
 #include "Modules/ModuleManager.h"
 #include "PJLinkLog.h"
+#include "PJLinkIOReactor.h"
+#include "PJLinkIOThreadPool.h"
+#include "PJLinkReconnectScheduler.h"
+#include "PJLinkNotificationListener.h"
+#include "PJLinkEventDrainScheduler.h"
 
 #define LOCTEXT_NAMESPACE "FPJLinkModule"
 
@@ -13,6 +18,19 @@ void FPJLinkModule::StartupModule()
 
 void FPJLinkModule::ShutdownModule()
 {
+    // 재연결 예약과 알림 소켓 정리 (타이머와 소켓이 리액터에 있으므로 리액터보다 먼저)
+    FPJLinkReconnectScheduler::Shutdown();
+    FPJLinkNotificationListener::Shutdown();
+
+    // 게임 스레드 이벤트 처리 티커 해제
+    FPJLinkEventDrainScheduler::Shutdown();
+
+    // 스캔 작업용 I/O 스레드 풀 종료
+    FPJLinkIOThreadPool::Shutdown();
+
+    // 공유 I/O 리액터 스레드 종료
+    FPJLinkIOReactor::Shutdown();
+
     // 모듈 종료시 로그 출력
     PJLINK_LOG_INFO(TEXT("PJLink Module Shutdown"));
 }
@@ -3,6 +3,8 @@
 #include "PJLinkSubsystem.h" // 여기서 완전한 정의 포함
 #include "Kismet/GameplayStatics.h"
 #include "PJLinkDiscoveryManager.h"
+#include "PJLinkReconnectScheduler.h"
+#include "PJLinkEventDrainScheduler.h"
 
 UPJLinkSubsystem* UPJLinkBlueprintLibrary::GetPJLinkSubsystem(const UObject* WorldContextObject)
 {
@@ -130,6 +132,31 @@ FPJLinkProjectorInfo UPJLinkBlueprintLibrary::GetProjectorInfo(const UObject* Wo
     return FPJLinkProjectorInfo();
 }
 
+void UPJLinkBlueprintLibrary::SetMaxConcurrentReconnects(int32 MaxConcurrentConnects)
+{
+    FPJLinkReconnectScheduler::Get().SetMaxConcurrentConnects(MaxConcurrentConnects);
+}
+
+void UPJLinkBlueprintLibrary::SetMaxReconnectBackoff(float MaxBackoffSeconds)
+{
+    FPJLinkReconnectScheduler::Get().SetMaxBackoffSeconds(MaxBackoffSeconds);
+}
+
+FPJLinkReconnectStats UPJLinkBlueprintLibrary::GetReconnectStats()
+{
+    return FPJLinkReconnectScheduler::Get().GetStats();
+}
+
+void UPJLinkBlueprintLibrary::SetEventDrainBudget(float BudgetMicroseconds)
+{
+    FPJLinkEventDrainScheduler::Get().SetFrameBudgetMicroseconds(BudgetMicroseconds);
+}
+
+float UPJLinkBlueprintLibrary::GetEventDrainBudget()
+{
+    return FPJLinkEventDrainScheduler::Get().GetFrameBudgetMicroseconds();
+}
+
 UPJLinkDiscoveryManager* UPJLinkBlueprintLibrary::CreatePJLinkDiscoveryManager(const UObject* WorldContextObject, AActor* OwnerActor)
 {
     UObject* Outer = OwnerActor ? OwnerActor : const_cast<UObject*>(WorldContextObject);
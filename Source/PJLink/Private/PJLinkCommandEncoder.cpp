@@ -0,0 +1,76 @@
+﻿// PJLinkCommandEncoder.cpp
+#include "PJLinkCommandEncoder.h"
+#include "PJLinkLog.h"
+
+namespace PJLinkCommandEncoder
+{
+    const ANSICHAR* GetCommandName(EPJLinkCommand Command)
+    {
+        static const ANSICHAR* const CommandNames[] =
+        {
+            "POWR", // EPJLinkCommand::POWR
+            "INPT", // EPJLinkCommand::INPT
+            "AVMT", // EPJLinkCommand::AVMT
+            "ERST", // EPJLinkCommand::ERST
+            "LAMP", // EPJLinkCommand::LAMP
+            "INST", // EPJLinkCommand::INST
+            "NAME", // EPJLinkCommand::NAME
+            "INF1", // EPJLinkCommand::INF1
+            "INF2", // EPJLinkCommand::INF2
+            "INFO", // EPJLinkCommand::INFO
+            "CLSS"  // EPJLinkCommand::CLSS
+        };
+
+        const uint8 CommandIndex = static_cast<uint8>(Command);
+        return CommandIndex < UE_ARRAY_COUNT(CommandNames) ? CommandNames[CommandIndex] : nullptr;
+    }
+
+    int32 AppendCommand(TArray<uint8>& Buffer, EPJLinkCommand Command, EPJLinkClass ProtocolClass,
+        const ANSICHAR* Parameter, int32 ParameterLength)
+    {
+        const ANSICHAR* CommandName = GetCommandName(Command);
+        if (!CommandName)
+        {
+            PJLINK_LOG_ERROR(TEXT("Invalid command index: %d"), static_cast<int32>(Command));
+            return 0;
+        }
+
+        if (ParameterLength > MaxEncodedCommandLength - 8)
+        {
+            PJLINK_LOG_ERROR(TEXT("Command parameter too long: %d bytes"), ParameterLength);
+            return 0;
+        }
+
+        const int32 EncodedLength = 6 + (ParameterLength > 0 ? ParameterLength + 1 : 0) + 1;
+        const int32 Offset = Buffer.AddUninitialized(EncodedLength);
+        uint8* Out = Buffer.GetData() + Offset;
+
+        *Out++ = '%';
+        *Out++ = ProtocolClass == EPJLinkClass::Class2 ? '2' : '1';
+        FMemory::Memcpy(Out, CommandName, 4);
+        Out += 4;
+
+        if (ParameterLength > 0)
+        {
+            *Out++ = ' ';
+            FMemory::Memcpy(Out, Parameter, ParameterLength);
+            Out += ParameterLength;
+        }
+
+        *Out = '\r';
+        return EncodedLength;
+    }
+
+    int32 AppendCommand(TArray<uint8>& Buffer, EPJLinkCommand Command, EPJLinkClass ProtocolClass,
+        const FString& Parameter)
+    {
+        if (Parameter.IsEmpty())
+        {
+            return AppendCommand(Buffer, Command, ProtocolClass, nullptr, 0);
+        }
+
+        // 짧은 파라미터는 변환기 내부 버퍼에 들어가므로 힙 할당 없음
+        FTCHARToUTF8 Utf8Parameter(*Parameter);
+        return AppendCommand(Buffer, Command, ProtocolClass, Utf8Parameter.Get(), Utf8Parameter.Length());
+    }
+}
@@ -0,0 +1,307 @@
+﻿// PJLinkConnection.cpp
+#include "PJLinkConnection.h"
+#include "PJLinkLog.h"
+#include "Misc/ScopeLock.h"
+
+using namespace PJLinkSocketPlatform;
+
+TSharedPtr<FPJLinkConnection, ESPMode::ThreadSafe> FPJLinkConnection::Create(
+    FNativeSocket ConnectedSocket, IPJLinkConnectionListener* InListener)
+{
+    if (ConnectedSocket == InvalidSocket)
+    {
+        return nullptr;
+    }
+
+    TSharedPtr<FPJLinkConnection, ESPMode::ThreadSafe> Connection =
+        MakeShareable(new FPJLinkConnection(ConnectedSocket, InListener, false));
+
+    FPJLinkIOReactor::Get().Register(ConnectedSocket, Connection.ToSharedRef(), EPollFlags::Readable);
+    return Connection;
+}
+
+TSharedPtr<FPJLinkConnection, ESPMode::ThreadSafe> FPJLinkConnection::CreateConnecting(
+    FNativeSocket ConnectingSocket, IPJLinkConnectionListener* InListener)
+{
+    if (ConnectingSocket == InvalidSocket)
+    {
+        return nullptr;
+    }
+
+    TSharedPtr<FPJLinkConnection, ESPMode::ThreadSafe> Connection =
+        MakeShareable(new FPJLinkConnection(ConnectingSocket, InListener, true));
+
+    // 연결 완료 = 쓰기 가능 (실패는 poll 오류로 전달됨)
+    // 완료 전에 들어온 Send()가 쓰기 관심을 다시 요청하지 않도록 플래그를 미리 올려 둠
+    Connection->bFlushRequested.store(true);
+    FPJLinkIOReactor::Get().Register(ConnectingSocket, Connection.ToSharedRef(), EPollFlags::Writable);
+    return Connection;
+}
+
+FPJLinkConnection::FPJLinkConnection(FNativeSocket InSocket, IPJLinkConnectionListener* InListener, bool bInConnecting)
+    : Socket(InSocket)
+    , bOpen(true)
+    , Listener(InListener)
+    , PartialSendOffset(0)
+    , bFlushRequested(false)
+    , bConnecting(bInConnecting)
+{
+}
+
+FPJLinkConnection::~FPJLinkConnection()
+{
+}
+
+bool FPJLinkConnection::Send(const uint8* Data, int32 Length)
+{
+    TArray<uint8> Buffer;
+    Buffer.Append(Data, Length);
+    return Send(MoveTemp(Buffer));
+}
+
+bool FPJLinkConnection::Send(TArray<uint8>&& Data)
+{
+    if (!IsOpen())
+    {
+        return false;
+    }
+
+    if (Data.Num() == 0)
+    {
+        return true;
+    }
+
+    // 락 없이 큐에 넣고 I/O 스레드에 알림 - 소켓 상태와 무관하게 즉시 반환
+    OutboundQueue.Enqueue(MoveTemp(Data));
+    RequestFlush();
+    return true;
+}
+
+void FPJLinkConnection::RequestFlush()
+{
+    // 이미 요청된 상태면 I/O 스레드가 큐를 비우면서 새 항목도 함께 보냄
+    if (!bFlushRequested.exchange(true))
+    {
+        FPJLinkIOReactor::Get().SetInterest(Socket, EPollFlags::Readable | EPollFlags::Writable);
+    }
+}
+
+bool FPJLinkConnection::FlushOutbound()
+{
+    for (;;)
+    {
+        // 이전에 일부만 보낸 데이터부터 이어서 전송
+        if (PartialSendOffset < PartialSend.Num())
+        {
+            int32 BytesSent = 0;
+            const EIOResult Result = PJLinkSocketPlatform::Send(Socket,
+                PartialSend.GetData() + PartialSendOffset, PartialSend.Num() - PartialSendOffset, BytesSent);
+            if (Result == EIOResult::Error)
+            {
+                return false;
+            }
+
+            PartialSendOffset += BytesSent;
+            if (PartialSendOffset < PartialSend.Num())
+            {
+                // 소켓 버퍼가 가득 참 - 다음 쓰기 가능 이벤트에서 계속
+                return true;
+            }
+        }
+
+        PartialSend.Reset();
+        PartialSendOffset = 0;
+
+        if (!OutboundQueue.Dequeue(PartialSend))
+        {
+            return true;
+        }
+
+        // 뒤이어 쌓인 작은 쓰기를 이어 붙여 한 번의 send 로 보냄
+        // TCP_NODELAY 로 Nagle 을 끈 대신, 동시에 대기 중인 쓰기는 여기서 직접 합침
+        while (PartialSend.Num() < MaxCoalescedSendBytes)
+        {
+            TArray<uint8>* Next = OutboundQueue.Peek();
+            if (!Next || PartialSend.Num() + Next->Num() > MaxCoalescedSendBytes)
+            {
+                break;
+            }
+
+            PartialSend.Append(*Next);
+            OutboundQueue.Pop();
+        }
+    }
+}
+
+FPJLinkTimerId FPJLinkConnection::ScheduleTimer(double DelaySeconds, uint64 Cookie)
+{
+    // 소켓과 같은 샤드에 예약해 수신 콜백과 타이머 콜백이 한 스레드에서 순서대로 호출되게 함
+    TWeakPtr<FPJLinkConnection, ESPMode::ThreadSafe> WeakThis = AsShared();
+    return FPJLinkIOReactor::Get().ScheduleSocketTimer(Socket, DelaySeconds, [WeakThis, Cookie]()
+    {
+        if (TSharedPtr<FPJLinkConnection, ESPMode::ThreadSafe> StrongThis = WeakThis.Pin())
+        {
+            StrongThis->HandleTimer(Cookie);
+        }
+    });
+}
+
+void FPJLinkConnection::CancelTimer(FPJLinkTimerId TimerId)
+{
+    FPJLinkIOReactor::Get().CancelTimer(TimerId);
+}
+
+void FPJLinkConnection::HandleTimer(uint64 Cookie)
+{
+    if (!IsOpen())
+    {
+        return;
+    }
+
+    FScopeLock Lock(&ListenerLock);
+    if (Listener)
+    {
+        Listener->OnConnectionTimer(Cookie);
+    }
+}
+
+void FPJLinkConnection::Close()
+{
+    DetachListener();
+
+    if (bOpen.exchange(false))
+    {
+        FPJLinkIOReactor::Get().Unregister(Socket, true);
+    }
+}
+
+void FPJLinkConnection::DetachListener()
+{
+    FScopeLock Lock(&ListenerLock);
+    Listener = nullptr;
+}
+
+void FPJLinkConnection::OnReadable()
+{
+    if (!IsOpen())
+    {
+        return;
+    }
+
+    // 읽을 수 있는 만큼 모두 읽음 (레벨 트리거 poll 이므로 남겨도 되지만 왕복 횟수 감소)
+    for (;;)
+    {
+        int32 BytesRead = 0;
+        const EIOResult Result = Recv(Socket, RecvBuffer, sizeof(RecvBuffer), BytesRead);
+
+        if (Result == EIOResult::Ok)
+        {
+            FScopeLock Lock(&ListenerLock);
+            if (Listener)
+            {
+                Listener->OnConnectionData(RecvBuffer, BytesRead);
+            }
+            continue;
+        }
+
+        if (Result == EIOResult::WouldBlock)
+        {
+            return;
+        }
+
+        HandleClosed(Result == EIOResult::Closed ? 0 : GetLastErrorCode());
+        return;
+    }
+}
+
+bool FPJLinkConnection::CompleteConnect()
+{
+    const int32 PendingError = GetPendingError(Socket);
+    if (PendingError != 0)
+    {
+        HandleClosed(PendingError);
+        return false;
+    }
+
+    bConnecting = false;
+
+    FScopeLock Lock(&ListenerLock);
+    if (Listener)
+    {
+        Listener->OnConnectionEstablished();
+    }
+    return IsOpen();
+}
+
+void FPJLinkConnection::OnWritable()
+{
+    if (!IsOpen())
+    {
+        return;
+    }
+
+    // 첫 쓰기 가능 이벤트는 연결 완료 - 이후 대기 중인 송신을 이어서 처리
+    if (bConnecting && !CompleteConnect())
+    {
+        return;
+    }
+
+    for (;;)
+    {
+        if (!FlushOutbound())
+        {
+            HandleClosed(GetLastErrorCode());
+            return;
+        }
+
+        if (PartialSendOffset < PartialSend.Num())
+        {
+            // 아직 보낼 데이터가 남아 있으므로 쓰기 관심 유지
+            return;
+        }
+
+        // 요청 플래그를 먼저 내린 뒤 큐를 다시 확인해야
+        // 그 사이에 들어온 Send()가 누락되지 않음
+        bFlushRequested.store(false);
+        if (OutboundQueue.IsEmpty())
+        {
+            FPJLinkIOReactor::Get().SetInterest(Socket, EPollFlags::Readable);
+            return;
+        }
+
+        if (bFlushRequested.exchange(true))
+        {
+            // 다른 스레드가 이미 쓰기 관심을 다시 요청함
+            return;
+        }
+    }
+}
+
+void FPJLinkConnection::OnPollError()
+{
+    if (!IsOpen())
+    {
+        return;
+    }
+
+    HandleClosed(GetPendingError(Socket));
+}
+
+void FPJLinkConnection::HandleClosed(int32 ErrorCode)
+{
+    if (!bOpen.exchange(false))
+    {
+        return;
+    }
+
+    {
+        FScopeLock Lock(&ListenerLock);
+        if (Listener)
+        {
+            Listener->OnConnectionClosed(ErrorCode);
+            Listener = nullptr;
+        }
+    }
+
+    FPJLinkIOReactor::Get().Unregister(Socket, true);
+}
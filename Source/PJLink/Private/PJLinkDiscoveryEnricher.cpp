@@ -0,0 +1,481 @@
+﻿// PJLinkDiscoveryEnricher.cpp
+#include "PJLinkDiscoveryEnricher.h"
+#include "PJLinkConnection.h"
+#include "PJLinkLog.h"
+#include "Misc/ScopeLock.h"
+
+using namespace PJLinkSocketPlatform;
+
+namespace
+{
+    // 한 번에 보내는 식별 정보 조회 (응답도 같은 순서로 한 줄씩 옴)
+    const ANSICHAR IdentityQueries[] = "%1NAME ?\r%1INF1 ?\r%1INF2 ?\r%1INFO ?\r";
+
+    // 인증이 필요 없는 장치의 인사말
+    const ANSICHAR OpenGreeting[] = "PJLINK 0";
+
+    // 장치 하나에서 받을 최대 바이트 (NAME 64, INF1/INF2/INFO 각 32 바이트와 헤더를 넉넉히 담음)
+    constexpr int32 MaxResponseBytes = 1024;
+}
+
+/**
+ * 장치 하나의 식별 정보 조회 (리액터 연결 수신자)
+ * 콜백은 리액터 I/O 스레드에서 호출되며, 연결 등록은 JobLock 안에서 하므로 등록이 끝나기 전에 콜백이 진행되지 않습니다.
+ * JobLock 을 잡은 채로 연결을 닫지 않습니다 (연결의 수신자 락과 순서가 엇갈려 교착 상태가 됨).
+ */
+class FPJLinkEnrichmentJob
+    : public IPJLinkConnectionListener
+    , public TSharedFromThis<FPJLinkEnrichmentJob, ESPMode::ThreadSafe>
+{
+public:
+    FPJLinkEnrichmentJob(const TSharedRef<FPJLinkDiscoveryEnricher, ESPMode::ThreadSafe>& InOwner, uint32 InIPv4)
+        : Owner(InOwner)
+        , IPv4(InIPv4)
+        , Phase(EPhase::Connecting)
+        , StartTime(0.0)
+        , ResponseStart(0)
+        , bFinished(false)
+    {
+    }
+
+    // 조회 시작 (Socket 이 유효하면 넘겨받은 연결, 바로 실패하면 false)
+    bool Start(FNativeSocket Socket, const FPJLinkEnrichmentSettings& Settings);
+
+    // 이벤트 없이 중단하고 연결을 닫음
+    void Abort();
+
+    // IPJLinkConnectionListener 인터페이스 (I/O 스레드)
+    virtual void OnConnectionEstablished() override;
+    virtual void OnConnectionData(const uint8* Data, int32 Length) override;
+    virtual void OnConnectionClosed(int32 ErrorCode) override;
+    virtual void OnConnectionTimer(uint64 Cookie) override;
+
+private:
+    enum class EPhase : uint8
+    {
+        Connecting,
+        AwaitingGreeting,
+        AwaitingResponse
+    };
+
+    // 조회 전송 후 응답 대기로 전환 (JobLock 안에서 호출, InResponseStart = 응답이 시작될 수신 위치)
+    bool SendQueries(int32 InResponseStart);
+
+    // 조회 종료 후 소유자에게 보고 (JobLock 밖에서 호출, 한 번만 보고)
+    void Finish(bool bComplete);
+
+    TWeakPtr<FPJLinkDiscoveryEnricher, ESPMode::ThreadSafe> Owner;
+    uint32 IPv4;
+
+    FCriticalSection JobLock;
+    TSharedPtr<FPJLinkConnection, ESPMode::ThreadSafe> Connection;
+    EPhase Phase;
+    double StartTime;
+
+    // 받은 바이트 / 조회 응답이 시작되는 위치 (새로 연결한 경우 인사말 다음)
+    TArray<ANSICHAR> Received;
+    int32 ResponseStart;
+
+    bool bFinished;
+};
+
+bool FPJLinkEnrichmentJob::Start(FNativeSocket Socket, const FPJLinkEnrichmentSettings& Settings)
+{
+    StartTime = FPlatformTime::Seconds();
+
+    if (Socket != InvalidSocket)
+    {
+        // 스윕이 인사말을 확인한 연결 - 같은 소켓으로 바로 조회
+        SetNoDelay(Socket, true);
+
+        bool bSent = false;
+        {
+            FScopeLock Lock(&JobLock);
+            if (bFinished)
+            {
+                // 시작 전에 취소됨
+                Close(Socket);
+                return false;
+            }
+
+            Connection = FPJLinkConnection::Create(Socket, this);
+            if (Connection.IsValid())
+            {
+                Connection->ScheduleTimer(Settings.ResponseTimeoutSeconds, 0);
+                bSent = SendQueries(0);
+            }
+        }
+
+        if (!bSent)
+        {
+            Abort();
+        }
+        return bSent;
+    }
+
+    Socket = CreateTcpSocket();
+    if (Socket == InvalidSocket)
+    {
+        PJLINK_LOG_WARNING(TEXT("Failed to create enrichment socket - Error: %d"), GetLastErrorCode());
+        return false;
+    }
+    SetNoDelay(Socket, true);
+
+    if (Connect(Socket, IPv4, Settings.Port) == EConnectResult::Failed)
+    {
+        Close(Socket);
+        return false;
+    }
+
+    // 연결 완료와 인사말은 I/O 스레드가 처리 (제한 시간은 연결과 응답을 합쳐 한 번만 예약)
+    FScopeLock Lock(&JobLock);
+    if (bFinished)
+    {
+        Close(Socket);
+        return false;
+    }
+
+    Connection = FPJLinkConnection::CreateConnecting(Socket, this);
+    Connection->ScheduleTimer(Settings.ConnectTimeoutSeconds + Settings.ResponseTimeoutSeconds, 0);
+    return true;
+}
+
+void FPJLinkEnrichmentJob::Abort()
+{
+    TSharedPtr<FPJLinkConnection, ESPMode::ThreadSafe> ClosingConnection;
+    {
+        FScopeLock Lock(&JobLock);
+        bFinished = true;
+        ClosingConnection = MoveTemp(Connection);
+    }
+
+    if (ClosingConnection.IsValid())
+    {
+        ClosingConnection->Close();
+    }
+}
+
+void FPJLinkEnrichmentJob::OnConnectionEstablished()
+{
+    FScopeLock Lock(&JobLock);
+    if (Phase == EPhase::Connecting)
+    {
+        Phase = EPhase::AwaitingGreeting;
+    }
+}
+
+void FPJLinkEnrichmentJob::OnConnectionData(const uint8* Data, int32 Length)
+{
+    bool bDone = false;
+    bool bComplete = false;
+    {
+        FScopeLock Lock(&JobLock);
+        if (bFinished)
+        {
+            return;
+        }
+
+        const int32 Space = MaxResponseBytes - Received.Num();
+        Received.Append(reinterpret_cast<const ANSICHAR*>(Data), FMath::Min(Length, Space));
+
+        if (Phase == EPhase::AwaitingGreeting)
+        {
+            int32 GreetingEnd = INDEX_NONE;
+            if (Received.Find('\r', GreetingEnd))
+            {
+                // 인증이 필요한 장치는 암호 없이 조회하면 ERRA 로 끊기므로 인사말만 보고
+                const int32 GreetingLength = UE_ARRAY_COUNT(OpenGreeting) - 1;
+                const bool bOpen = GreetingEnd >= GreetingLength
+                    && FCStringAnsi::Strncmp(Received.GetData(), OpenGreeting, GreetingLength) == 0;
+                bDone = !bOpen || !SendQueries(GreetingEnd + 1);
+            }
+        }
+
+        if (Phase == EPhase::AwaitingResponse)
+        {
+            int32 LineCount = 0;
+            for (int32 ByteIndex = ResponseStart; ByteIndex < Received.Num(); ++ByteIndex)
+            {
+                LineCount += Received[ByteIndex] == '\r' ? 1 : 0;
+            }
+            bComplete = LineCount >= FPJLinkDiscoveryEnricher::NumIdentityQueries;
+            bDone |= bComplete;
+        }
+
+        // 버퍼가 찼으면 받은 만큼만 보고
+        bDone |= Length > Space;
+    }
+
+    if (bDone)
+    {
+        Finish(bComplete);
+    }
+}
+
+void FPJLinkEnrichmentJob::OnConnectionClosed(int32 ErrorCode)
+{
+    Finish(false);
+}
+
+void FPJLinkEnrichmentJob::OnConnectionTimer(uint64 Cookie)
+{
+    Finish(false);
+}
+
+bool FPJLinkEnrichmentJob::SendQueries(int32 InResponseStart)
+{
+    // 조회 네 개를 한 번에 보내고 응답을 한꺼번에 기다림 (명령마다 왕복하지 않음)
+    if (!Connection.IsValid()
+        || !Connection->Send(reinterpret_cast<const uint8*>(IdentityQueries), UE_ARRAY_COUNT(IdentityQueries) - 1))
+    {
+        return false;
+    }
+
+    Phase = EPhase::AwaitingResponse;
+    ResponseStart = InResponseStart;
+    return true;
+}
+
+void FPJLinkEnrichmentJob::Finish(bool bComplete)
+{
+    // 소유자가 조회 목록에서 지워도 이 함수가 끝날 때까지 유지
+    TSharedPtr<FPJLinkEnrichmentJob, ESPMode::ThreadSafe> KeepAlive = AsShared();
+
+    TSharedPtr<FPJLinkConnection, ESPMode::ThreadSafe> ClosingConnection;
+    FString Response;
+    {
+        FScopeLock Lock(&JobLock);
+        if (bFinished)
+        {
+            return;
+        }
+        bFinished = true;
+        ClosingConnection = MoveTemp(Connection);
+
+        if (Received.Num() > 0)
+        {
+            const FUTF8ToTCHAR Converted(Received.GetData(), Received.Num());
+            Response = FString(Converted.Length(), Converted.Get());
+        }
+    }
+
+    if (ClosingConnection.IsValid())
+    {
+        ClosingConnection->Close();
+    }
+
+    if (TSharedPtr<FPJLinkDiscoveryEnricher, ESPMode::ThreadSafe> PinnedOwner = Owner.Pin())
+    {
+        PinnedOwner->OnJobFinished(IPv4, Response, bComplete, FPlatformTime::Seconds() - StartTime);
+    }
+}
+
+FPJLinkDiscoveryEnricher::FPJLinkDiscoveryEnricher(const FPJLinkEnrichmentSettings& InSettings, FPJLinkEnrichmentCallbacks&& InCallbacks)
+    : Settings(InSettings)
+    , Callbacks(MoveTemp(InCallbacks))
+    , bCancelled(false)
+    , PeakActive(0)
+    , EnrichedCount(0)
+    , FailedCount(0)
+    , TotalLatencySeconds(0.0)
+    , BusyStartTime(-1.0)
+    , AccumulatedBusySeconds(0.0)
+{
+    Settings.MaxConcurrent = FMath::Max(1, Settings.MaxConcurrent);
+    Settings.ConnectTimeoutSeconds = FMath::Max(0.01, Settings.ConnectTimeoutSeconds);
+    Settings.ResponseTimeoutSeconds = FMath::Max(0.01, Settings.ResponseTimeoutSeconds);
+}
+
+FPJLinkDiscoveryEnricher::~FPJLinkDiscoveryEnricher()
+{
+    Cancel();
+}
+
+void FPJLinkDiscoveryEnricher::AddConnectedDevice(uint32 IPv4, FNativeSocket Socket)
+{
+    FPendingDevice Device;
+    Device.IPv4 = IPv4;
+    Device.Socket = Socket;
+    Enqueue(Device);
+}
+
+void FPJLinkDiscoveryEnricher::AddDevice(uint32 IPv4)
+{
+    FPendingDevice Device;
+    Device.IPv4 = IPv4;
+    Enqueue(Device);
+}
+
+void FPJLinkDiscoveryEnricher::Enqueue(const FPendingDevice& Device)
+{
+    bool bAccepted = false;
+    {
+        FScopeLock ScopeLock(&Lock);
+        bool bAlreadyKnown = false;
+        KnownDevices.Add(Device.IPv4, &bAlreadyKnown);
+        if (!bCancelled && !bAlreadyKnown)
+        {
+            Pending.Add(Device);
+            UpdateBusyTime(FPlatformTime::Seconds());
+            bAccepted = true;
+        }
+    }
+
+    if (!bAccepted)
+    {
+        if (Device.Socket != InvalidSocket)
+        {
+            Close(Device.Socket);
+        }
+        return;
+    }
+
+    StartQueuedJobs();
+}
+
+void FPJLinkDiscoveryEnricher::StartQueuedJobs()
+{
+    for (;;)
+    {
+        FPendingDevice Device;
+        TSharedPtr<FPJLinkEnrichmentJob, ESPMode::ThreadSafe> Job;
+        {
+            FScopeLock ScopeLock(&Lock);
+            if (bCancelled || Pending.Num() == 0 || ActiveJobs.Num() >= Settings.MaxConcurrent)
+            {
+                return;
+            }
+
+            Device = Pending[0];
+            Pending.RemoveAt(0, 1, EAllowShrinking::No);
+            Job = MakeShared<FPJLinkEnrichmentJob, ESPMode::ThreadSafe>(AsShared(), Device.IPv4);
+            ActiveJobs.Add(Device.IPv4, Job);
+            PeakActive = FMath::Max(PeakActive, ActiveJobs.Num());
+        }
+
+        // 연결 등록은 락 밖에서 (I/O 스레드의 종료 보고가 이 락을 잡음)
+        if (!Job->Start(Device.Socket, Settings))
+        {
+            RecordJobFinished(Device.IPv4, FString(), false, 0.0);
+        }
+    }
+}
+
+void FPJLinkDiscoveryEnricher::OnJobFinished(uint32 IPv4, const FString& Response, bool bComplete, double LatencySeconds)
+{
+    RecordJobFinished(IPv4, Response, bComplete, LatencySeconds);
+
+    // 빈 자리를 대기 중인 장치로 채움
+    StartQueuedJobs();
+}
+
+void FPJLinkDiscoveryEnricher::RecordJobFinished(uint32 IPv4, const FString& Response, bool bComplete, double LatencySeconds)
+{
+    FScopeLock ScopeLock(&Lock);
+
+    // 취소된 뒤 끝난 조회는 보고하지 않음
+    if (bCancelled || ActiveJobs.Remove(IPv4) == 0)
+    {
+        return;
+    }
+
+    if (bComplete)
+    {
+        ++EnrichedCount;
+    }
+    else
+    {
+        ++FailedCount;
+    }
+    TotalLatencySeconds += LatencySeconds;
+    UpdateBusyTime(FPlatformTime::Seconds());
+
+    // 여러 I/O 스레드에서 끝난 조회의 이벤트가 OnIdle 뒤로 밀리지 않도록 락 안에서 발생
+    if (Callbacks.OnDeviceEnriched)
+    {
+        Callbacks.OnDeviceEnriched(IPv4, Response, bComplete);
+    }
+
+    if (Pending.Num() == 0 && ActiveJobs.Num() == 0 && Callbacks.OnIdle)
+    {
+        Callbacks.OnIdle();
+    }
+}
+
+void FPJLinkDiscoveryEnricher::UpdateBusyTime(double Now)
+{
+    const bool bBusy = Pending.Num() > 0 || ActiveJobs.Num() > 0;
+    if (bBusy && BusyStartTime < 0.0)
+    {
+        BusyStartTime = Now;
+    }
+    else if (!bBusy && BusyStartTime >= 0.0)
+    {
+        AccumulatedBusySeconds += Now - BusyStartTime;
+        BusyStartTime = -1.0;
+    }
+}
+
+void FPJLinkDiscoveryEnricher::Cancel()
+{
+    TArray<TSharedPtr<FPJLinkEnrichmentJob, ESPMode::ThreadSafe>> Jobs;
+    TArray<FPendingDevice> Dropped;
+    {
+        FScopeLock ScopeLock(&Lock);
+        if (bCancelled)
+        {
+            return;
+        }
+        bCancelled = true;
+
+        ActiveJobs.GenerateValueArray(Jobs);
+        ActiveJobs.Reset();
+        Dropped = MoveTemp(Pending);
+        Pending.Reset();
+        UpdateBusyTime(FPlatformTime::Seconds());
+    }
+
+    // 넘겨받았지만 아직 조회하지 않은 소켓은 여기서 닫음
+    for (const FPendingDevice& Device : Dropped)
+    {
+        if (Device.Socket != InvalidSocket)
+        {
+            Close(Device.Socket);
+        }
+    }
+
+    for (const TSharedPtr<FPJLinkEnrichmentJob, ESPMode::ThreadSafe>& Job : Jobs)
+    {
+        Job->Abort();
+    }
+}
+
+bool FPJLinkDiscoveryEnricher::IsIdle() const
+{
+    FScopeLock ScopeLock(&Lock);
+    return Pending.Num() == 0 && ActiveJobs.Num() == 0;
+}
+
+FPJLinkEnrichmentStats FPJLinkDiscoveryEnricher::GetStats() const
+{
+    FScopeLock ScopeLock(&Lock);
+
+    FPJLinkEnrichmentStats Stats;
+    Stats.QueuedDevices = Pending.Num();
+    Stats.ActiveDevices = ActiveJobs.Num();
+    Stats.PeakActiveDevices = PeakActive;
+    Stats.EnrichedDevices = EnrichedCount;
+    Stats.FailedDevices = FailedCount;
+    Stats.BusySeconds = AccumulatedBusySeconds + (BusyStartTime >= 0.0 ? FPlatformTime::Seconds() - BusyStartTime : 0.0);
+
+    const int32 FinishedCount = EnrichedCount + FailedCount;
+    if (Stats.BusySeconds > 0.0)
+    {
+        Stats.DevicesPerSecond = FinishedCount / Stats.BusySeconds;
+    }
+    if (FinishedCount > 0)
+    {
+        Stats.AverageLatencyMs = TotalLatencySeconds / FinishedCount * 1000.0;
+    }
+    return Stats;
+}
@@ -3,132 +3,298 @@
 #include "PJLinkLog.h"
 #include "PJLinkPresetManager.h"
 #include "PJLinkManagerComponent.h"
-#include "SocketSubsystem.h"
-#include "Sockets.h"
-#include "IPAddress.h"
-#include "HAL/RunnableThread.h"
-#include "Async/AsyncWork.h"
+#include "PJLinkIOReactor.h"
+#include "PJLinkNotificationListener.h"
+#include "PJLinkScanEngine.h"
+#include "PJLinkDiscoveryEnricher.h"
+#include "PJLinkKnownHostsIndex.h"
+#include "Async/Async.h"
+#include "Misc/Paths.h"
 #include "TimerManager.h"
 #include "Engine/World.h"
 #include "Engine/Engine.h"
 #include "Kismet/GameplayStatics.h"
 
-// 스캔 작업을 위한 비동기 작업 클래스
-class FScanWorker : public FNonAbandonableTask
+using namespace PJLinkSocketPlatform;
+
+/**
+ * Class 2 브로드캐스트 검색 세션 (%2SRCH 전송, %2ACKN 수집)
+ *
+ * 임의 포트에 바인딩한 UDP 소켓으로 검색 명령을 여러 번 브로드캐스트하고, 응답은 두 경로로 받습니다.
+ * 규격대로 컨트롤러의 4352 포트로 보내는 장치는 알림 수신기를 통해, 송신 포트로 되돌려 보내는 장치는 이 소켓으로 들어옵니다.
+ * 재전송 때문에 같은 장치가 여러 번 응답하므로 송신 IP 로 중복을 걸러 게임 스레드에는 장치당 한 번만 전달합니다.
+ * 소켓과 재전송/종료 타이머는 I/O 리액터가 처리하므로 검색 동안 대기하는 스레드가 없습니다.
+ */
+class FPJLinkBroadcastSearch
+    : public IPJLinkIOHandler
+    , public IPJLinkSearchReplySink
+    , public TSharedFromThis<FPJLinkBroadcastSearch, ESPMode::ThreadSafe>
 {
 public:
-    FScanWorker(UPJLinkDiscoveryManager* InManager, const FString& InDiscoveryID,
-        uint32 InStartIP, uint32 InEndIP, float InTimeoutSeconds)
-        : Manager(InManager)
+    // 재전송 간격 (검색 시간이 짧으면 그 안에 모두 보내도록 줄임)
+    static constexpr double DefaultRetransmitIntervalSeconds = 0.25;
+
+    FPJLinkBroadcastSearch(UPJLinkDiscoveryManager* InOwner, const FString& InDiscoveryID, uint32 InTargetIPv4, uint16 InTargetPort)
+        : Owner(InOwner)
         , DiscoveryID(InDiscoveryID)
-        , StartIP(InStartIP)
-        , EndIP(InEndIP)
-        , TimeoutSeconds(InTimeoutSeconds)
+        , TargetIPv4(InTargetIPv4)
+        , TargetPort(InTargetPort)
+        , Socket(InvalidSocket)
+        , StartTime(0.0)
+        , bStopped(false)
+        , TransmitCount(0)
+        , DuplicateCount(0)
+    {
+    }
+
+    virtual ~FPJLinkBroadcastSearch()
     {
-        bIsCancelled.store(false, std::memory_order_release);
+        Stop();
     }
 
-    void DoWork()
+    // 소켓을 열고 첫 검색 명령을 보낸 뒤 재전송과 종료 타이머 예약
+    bool Start(int32 NumTransmits, double IntervalSeconds, double TimeoutSeconds)
     {
-        if (Manager)
+        Socket = CreateUdpSocket();
+        if (Socket == InvalidSocket || !SetBroadcast(Socket, true) || !Bind(Socket, 0, 0))
+        {
+            PJLINK_LOG_ERROR(TEXT("Failed to open broadcast search socket - Error: %d"), GetLastErrorCode());
+            Close(Socket);
+            Socket = InvalidSocket;
+            bStopped.store(true);
+            return false;
+        }
+
+        FPJLinkIOReactor& Reactor = FPJLinkIOReactor::Get();
+        Reactor.Register(Socket, AsShared(), EPollFlags::Readable);
+        FPJLinkNotificationListener::Get().AddSearchSink(this);
+
+        StartTime = FPlatformTime::Seconds();
+        if (!SendSearch())
+        {
+            Stop();
+            return false;
+        }
+
+        TWeakPtr<FPJLinkBroadcastSearch, ESPMode::ThreadSafe> WeakThis = AsShared();
+        FScopeLock ScopeLock(&Lock);
+        for (int32 Index = 1; Index < NumTransmits; ++Index)
         {
-            Manager->PerformRangeScan(DiscoveryID, StartIP, EndIP, TimeoutSeconds, &bIsCancelled);
+            TimerIds.Add(Reactor.ScheduleTimer(IntervalSeconds * Index, [WeakThis]()
+            {
+                if (TSharedPtr<FPJLinkBroadcastSearch, ESPMode::ThreadSafe> StrongThis = WeakThis.Pin())
+                {
+                    StrongThis->SendSearch();
+                }
+            }));
         }
+
+        TimerIds.Add(Reactor.ScheduleTimer(TimeoutSeconds, [WeakThis]()
+        {
+            if (TSharedPtr<FPJLinkBroadcastSearch, ESPMode::ThreadSafe> StrongThis = WeakThis.Pin())
+            {
+                StrongThis->Finish();
+            }
+        }));
+        return true;
     }
 
-    void Cancel()
+    // 소켓과 타이머 정리 (이미 중지되었으면 false) - 반환 후에는 응답을 전달하지 않음
+    bool Stop()
     {
-        bIsCancelled.store(true, std::memory_order_release);
+        if (bStopped.exchange(true))
+        {
+            return false;
+        }
+
+        TArray<FPJLinkTimerId> TimersToCancel;
+        {
+            FScopeLock ScopeLock(&Lock);
+            TimersToCancel = MoveTemp(TimerIds);
+        }
+
+        // 알림 수신기는 자기 락을 잡은 채 OnSearchReply 를 호출하므로 이 객체의 락 밖에서 제거
+        FPJLinkNotificationListener::Get().RemoveSearchSink(this);
+
+        FPJLinkIOReactor& Reactor = FPJLinkIOReactor::Get();
+        for (FPJLinkTimerId TimerId : TimersToCancel)
+        {
+            Reactor.CancelTimer(TimerId);
+        }
+        Reactor.Unregister(Socket, true);
+
+        int32 NumResponded = 0;
+        {
+            FScopeLock ScopeLock(&Lock);
+            NumResponded = RespondedAddresses.Num();
+        }
+        PJLINK_LOG_VERBOSE(TEXT("Broadcast search %s stopped: %d SRCH sent, %d devices, %d duplicate replies"),
+            *DiscoveryID, TransmitCount.load(), NumResponded, DuplicateCount.load());
+        return true;
     }
 
-    bool IsCancelled() const
+    // IPJLinkIOHandler 인터페이스 - 송신 포트로 돌아온 응답
+    virtual void OnReadable() override
     {
-        return bIsCancelled.load(std::memory_order_acquire);
+        for (;;)
+        {
+            int32 BytesRead = 0;
+            uint32 SourceIPv4 = 0;
+            uint16 SourcePort = 0;
+            if (RecvFrom(Socket, Buffer, sizeof(Buffer), BytesRead, SourceIPv4, SourcePort) != EIOResult::Ok)
+            {
+                return;
+            }
+
+            // 응답 하나에 CR 로 끝나는 줄이 하나 이상 들어 있을 수 있음
+            int32 LineStart = 0;
+            for (int32 Index = 0; Index <= BytesRead; ++Index)
+            {
+                if (Index < BytesRead && Buffer[Index] != '\r' && Buffer[Index] != '\n')
+                {
+                    continue;
+                }
+
+                const int32 LineLength = Index - LineStart;
+                if (LineLength > 7 && FMemory::Memcmp(Buffer + LineStart, "%2ACKN=", 7) == 0)
+                {
+                    HandleReply(SourceIPv4, Buffer + LineStart, LineLength);
+                }
+                LineStart = Index + 1;
+            }
+        }
     }
 
-    FORCEINLINE TStatId GetStatId() const
+    virtual void OnWritable() override {}
+    virtual void OnPollError() override {}
+
+    // IPJLinkSearchReplySink 인터페이스 - 4352 포트로 들어온 응답
+    virtual void OnSearchReply(uint32 SourceIPv4, const uint8* Frame, int32 Length) override
     {
-        RETURN_QUICK_DECLARE_CYCLE_STAT(FScanWorker, STATGROUP_ThreadPoolAsyncTasks);
+        HandleReply(SourceIPv4, Frame, Length);
     }
 
 private:
-    UPJLinkDiscoveryManager* Manager;
-    FString DiscoveryID;
-    uint32 StartIP;
-    uint32 EndIP;
-    float TimeoutSeconds;
-    TAtomic<bool> bIsCancelled;
-};
+    // 검색 명령 전송 (리액터 타이머 또는 시작 스레드)
+    bool SendSearch()
+    {
+        if (bStopped.load())
+        {
+            return false;
+        }
 
-UPJLinkDiscoveryManager::UPJLinkDiscoveryManager()
-    : BroadcastSocket(nullptr)
-    , BroadcastPort(4352)
-    , DefaultTimeoutSeconds(5.0f)
-    , MaxConcurrentThreads(4)
-    , PerAddressWaitTimeMs(200)
-{
-}
+        static const ANSICHAR SearchCommand[] = "%2SRCH\r";
+        int32 BytesSent = 0;
+        const EIOResult Result = SendTo(Socket, reinterpret_cast<const uint8*>(SearchCommand), sizeof(SearchCommand) - 1,
+            TargetIPv4, TargetPort, BytesSent);
+        if (Result != EIOResult::Ok)
+        {
+            PJLINK_LOG_WARNING(TEXT("Failed to send SRCH broadcast - Error: %d"), GetLastErrorCode());
+            return false;
+        }
 
-// ~UPJLinkDiscoveryManager 소멸자 전체 구현
-UPJLinkDiscoveryManager::~UPJLinkDiscoveryManager()
-{
-    // 모든 검색 작업 취소 (CancelAllDiscoveries 호출)
-    CancelAllDiscoveries();
+        TransmitCount++;
+        return true;
+    }
 
-    // 추가 안전장치: 활성 작업 취소 확인
+    // ACKN 한 줄 처리 (I/O 스레드) - 처음 응답한 IP 만 게임 스레드로 전달
+    void HandleReply(uint32 SourceIPv4, const uint8* Frame, int32 Length)
     {
-        FScopeLock Lock(&DiscoveryLock);
-        if (!ActiveScanTasks.IsEmpty())
+        if (bStopped.load())
+        {
+            return;
+        }
+
         {
-            PJLINK_LOG_WARNING(TEXT("Active scan tasks still exist during destruction, forcing cleanup"));
-            // 락을 풀고 취소 처리를 별도로 수행
-            Lock.Unlock();
-            CancelAllDiscoveries();
+            FScopeLock ScopeLock(&Lock);
+            bool bAlreadyResponded = false;
+            RespondedAddresses.Add(SourceIPv4, &bAlreadyResponded);
+            if (bAlreadyResponded)
+            {
+                DuplicateCount++;
+                return;
+            }
         }
+
+        // "%2ACKN=" 뒤는 MAC 주소 (xx:xx:xx:xx:xx:xx)
+        const FString MacAddress = FString(Length - 7, reinterpret_cast<const ANSICHAR*>(Frame + 7)).TrimStartAndEnd().ToUpper();
+        const int32 ResponseTimeMs = FMath::RoundToInt((FPlatformTime::Seconds() - StartTime) * 1000.0);
+
+        TWeakObjectPtr<UPJLinkDiscoveryManager> WeakOwner = Owner;
+        FString SearchID = DiscoveryID;
+        AsyncTask(ENamedThreads::GameThread, [WeakOwner, SearchID, SourceIPv4, MacAddress, ResponseTimeMs]()
+        {
+            if (UPJLinkDiscoveryManager* StrongOwner = WeakOwner.Get())
+            {
+                StrongOwner->ProcessSearchReply(SearchID, SourceIPv4, MacAddress, ResponseTimeMs);
+            }
+        });
     }
 
-    // 소켓 정리
-    if (BroadcastSocket)
+    // 검색 시간 만료 (리액터 타이머)
+    void Finish()
     {
-        ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
-        if (SocketSubsystem)
+        if (!Stop())
         {
-            BroadcastSocket->Close();
-            SocketSubsystem->DestroySocket(BroadcastSocket);
+            return;
         }
-        BroadcastSocket = nullptr;
+
+        TWeakObjectPtr<UPJLinkDiscoveryManager> WeakOwner = Owner;
+        FString SearchID = DiscoveryID;
+        AsyncTask(ENamedThreads::GameThread, [WeakOwner, SearchID]()
+        {
+            if (UPJLinkDiscoveryManager* StrongOwner = WeakOwner.Get())
+            {
+                StrongOwner->CompleteDiscoveryWhenEnriched(SearchID);
+            }
+        });
     }
 
-    // 혹시 남아있을 수 있는 활성 작업 정리
-    {
-        FScopeLock Lock(&DiscoveryLock);
+    TWeakObjectPtr<UPJLinkDiscoveryManager> Owner;
+    FString DiscoveryID;
+    uint32 TargetIPv4;
+    uint16 TargetPort;
 
-        // 작업 포인터 수집 (임계 영역 내에서)
-        TArray<FAutoDeleteAsyncTask<FScanWorker>*> RemainingTasks;
-        ActiveScanTasks.GenerateValueArray(RemainingTasks);
+    FNativeSocket Socket;
+    double StartTime;
+    TAtomic<bool> bStopped;
 
-        // 작업 취소 및 삭제 준비 (맵 비우기)
-        ActiveScanTasks.Empty();
+    // 응답한 IP (재전송 중복 제거용)와 예약된 타이머 보호
+    FCriticalSection Lock;
+    TSet<uint32> RespondedAddresses;
+    TArray<FPJLinkTimerId> TimerIds;
 
-        // 임계 영역 밖에서 작업 취소 및 정리
-        Lock.Unlock();
+    TAtomic<int32> TransmitCount;
+    TAtomic<int32> DuplicateCount;
 
-        for (auto* Task : RemainingTasks)
-        {
-            if (Task)
-            {
-                // 작업 취소 플래그 설정
-                FScanWorker* ScanWorker = static_cast<FScanWorker*>(Task->GetTask());
-                if (ScanWorker)
-                {
-                    ScanWorker->Cancel();
-                }
+    // 수신 버퍼 (I/O 스레드 전용)
+    uint8 Buffer[512];
+};
 
-                // 일반적으로 작업은 자체 삭제되지만 소멸자에서는 명시적으로 삭제
-                // 이렇게 하면 자원 누수를 방지할 수 있습니다
-                delete Task;
-            }
-        }
+UPJLinkDiscoveryManager::UPJLinkDiscoveryManager()
+    : BroadcastPort(4352)
+    , DefaultTimeoutSeconds(5.0f)
+    , MaxConcurrentThreads(4)
+    , PerAddressWaitTimeMs(1000)
+    , MinPerAddressWaitTimeMs(250)
+    , MaxInFlight(1024)
+    , MaxConcurrentEnrichments(16)
+    , bUseKnownHosts(true)
+    , BackgroundSweepMaxInFlight(256)
+{
+}
+
+// ~UPJLinkDiscoveryManager 소멸자 전체 구현
+UPJLinkDiscoveryManager::~UPJLinkDiscoveryManager()
+{
+    // 모든 검색 작업 취소 (CancelAllDiscoveries 호출)
+    CancelAllDiscoveries();
+
+    // 진행 상황 게시 티커 정지
+    if (ProgressTickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(ProgressTickerHandle);
+        ProgressTickerHandle.Reset();
     }
 
     // 타이머 명시적 정리
@@ -186,48 +352,19 @@ FString UPJLinkDiscoveryManager::StartBroadcastDiscovery(float TimeoutSeconds)
     {
         FScopeLock Lock(&DiscoveryLock);
         DiscoveryStatuses.Add(DiscoveryID, NewStatus);
-        DiscoveryResults.Add(DiscoveryID, TArray<FPJLinkDiscoveryResult>());
+        DiscoveryResults.Add(DiscoveryID, FPJLinkDiscoveryResultSet());
     }
 
-    // 브로드캐스트 소켓 설정
-    if (!SetupBroadcastSocket())
-    {
-        PJLINK_LOG_ERROR(TEXT("Failed to setup broadcast socket for discovery"));
-
-        // 추가: 재시도 로직
-        static const int32 MaxRetries = 3;
-        for (int32 RetryCount = 0; RetryCount < MaxRetries; RetryCount++)
-        {
-            PJLINK_LOG_WARNING(TEXT("Retrying broadcast socket setup (%d/%d)..."), RetryCount + 1, MaxRetries);
-            // 잠시 대기 후 재시도
-            FPlatformProcess::Sleep(0.5f);
-            if (SetupBroadcastSocket())
-            {
-                PJLINK_LOG_INFO(TEXT("Broadcast socket setup successful on retry %d"), RetryCount + 1);
-                break;
-            }
-
-            // 마지막 시도에서도 실패하면 검색 종료
-            if (RetryCount == MaxRetries - 1)
-            {
-                CompleteDiscovery(DiscoveryID, false);
-                return DiscoveryID;
-            }
-        }
-    }
+    // 응답한 장치의 이름/모델은 검색과 함께 조회
+    StartEnricher(DiscoveryID);
 
-    // 타이머 설정 (타임아웃 처리)
-    if (UWorld* World = GEngine->GetWorldFromContextObject(GetOuter(), EGetWorldErrorMode::LogAndReturnNull))
+    // 브로드캐스트 수행 (제한 시간은 검색 세션이 리액터 타이머로 처리하므로 월드 타이머가 필요 없음)
+    if (!PerformBroadcastDiscovery(DiscoveryID, ActualTimeout))
     {
-        FTimerHandle& TimerHandle = DiscoveryTimerHandles.FindOrAdd(DiscoveryID);
-        FTimerDelegate TimerDelegate;
-        TimerDelegate.BindUObject(this, &UPJLinkDiscoveryManager::HandleDiscoveryTimeout, DiscoveryID);
-        World->GetTimerManager().SetTimer(TimerHandle, TimerDelegate, ActualTimeout, false);
+        CompleteDiscovery(DiscoveryID, false);
+        return DiscoveryID;
     }
 
-    // 브로드캐스트 수행
-    PerformBroadcastDiscovery(DiscoveryID, ActualTimeout);
-
     PJLINK_LOG_INFO(TEXT("Started broadcast discovery with ID: %s"), *DiscoveryID);
     return DiscoveryID;
 }
@@ -260,7 +397,7 @@ FString UPJLinkDiscoveryManager::StartRangeScan(const FString& StartIPAddress, c
     {
         FScopeLock Lock(&DiscoveryLock);
         DiscoveryStatuses.Add(DiscoveryID, NewStatus);
-        DiscoveryResults.Add(DiscoveryID, TArray<FPJLinkDiscoveryResult>());
+        DiscoveryResults.Add(DiscoveryID, FPJLinkDiscoveryResultSet());
     }
 
     // 타이머 설정 (타임아웃 처리)
@@ -272,29 +409,13 @@ FString UPJLinkDiscoveryManager::StartRangeScan(const FString& StartIPAddress, c
         World->GetTimerManager().SetTimer(TimerHandle, TimerDelegate, ActualTimeout, false);
     }
 
-    // 범위 스캔 작업 생성
-    FAutoDeleteAsyncTask<FScanWorker>* ScanTask = new FAutoDeleteAsyncTask<FScanWorker>(
-        this, DiscoveryID, StartIP, EndIP, ActualTimeout);
-
-    // 작업 저장 및 시작
+    // 범위 스캔 시작
+    if (!StartScanEngine(DiscoveryID, StartIP, EndIP, ActualTimeout))
     {
-        FScopeLock Lock(&DiscoveryLock);
-        // 기존 작업이 있으면 제거
-        if (ActiveScanTasks.Contains(DiscoveryID))
-        {
-            // 기존 작업이 있는 경우 (비정상적인 상황)
-            PJLINK_LOG_WARNING(TEXT("Existing scan task found for discovery ID: %s - this should not happen"), *DiscoveryID);
-            delete ActiveScanTasks[DiscoveryID];
-            ActiveScanTasks.Remove(DiscoveryID);
-        }
-
-        // 새 작업 추가
-        ActiveScanTasks.Add(DiscoveryID, ScanTask);
+        CompleteDiscovery(DiscoveryID, false);
+        return DiscoveryID;
     }
 
-    // 백그라운드 작업 시작
-    ScanTask->StartBackgroundTask();
-
     PJLINK_LOG_INFO(TEXT("Started IP range scan with ID: %s, Range: %s - %s, Addresses: %d"),
         *DiscoveryID, *StartIPAddress, *EndIPAddress, NewStatus.TotalAddresses);
 
@@ -333,7 +454,7 @@ FString UPJLinkDiscoveryManager::StartSubnetScan(const FString& SubnetAddress, c
     {
         FScopeLock Lock(&DiscoveryLock);
         DiscoveryStatuses.Add(DiscoveryID, NewStatus);
-        DiscoveryResults.Add(DiscoveryID, TArray<FPJLinkDiscoveryResult>());
+        DiscoveryResults.Add(DiscoveryID, FPJLinkDiscoveryResultSet());
     }
 
     // 타이머 설정 (타임아웃 처리)
@@ -346,7 +467,11 @@ FString UPJLinkDiscoveryManager::StartSubnetScan(const FString& SubnetAddress, c
     }
 
     // 서브넷 스캔 수행
-    (new FAutoDeleteAsyncTask<FScanWorker>(this, DiscoveryID, NetworkAddress + 1, NetworkAddress + AddressCount, ActualTimeout))->StartBackgroundTask();
+    if (!StartScanEngine(DiscoveryID, NetworkAddress + 1, NetworkAddress + AddressCount, ActualTimeout))
+    {
+        CompleteDiscovery(DiscoveryID, false);
+        return DiscoveryID;
+    }
 
     PJLINK_LOG_INFO(TEXT("Started subnet scan with ID: %s, Subnet: %s/%s, Addresses: %d"),
         *DiscoveryID, *SubnetAddress, *SubnetMask, AddressCount);
@@ -390,9 +515,6 @@ TArray<FPJLinkDiscoveryStatus> UPJLinkDiscoveryManager::GetAllDiscoveryStatuses(
 
 bool UPJLinkDiscoveryManager::CancelDiscovery(const FString& DiscoveryID)
 {
-    // 활성 작업 포인터를 저장할 변수 (임계 영역 밖에서 사용하기 위함)
-    FAutoDeleteAsyncTask<FScanWorker>* TaskToCancel = nullptr;
-
     {
         FScopeLock Lock(&DiscoveryLock);
 
@@ -421,32 +543,18 @@ bool UPJLinkDiscoveryManager::CancelDiscovery(const FString& DiscoveryID)
         // 진행률 100%로 설정 (UI 표시를 위해)
         Status.ProgressPercentage = 100.0f;
         Status.ScannedAddresses = Status.TotalAddresses;
-
-        // 활성 작업 찾기
-        if (ActiveScanTasks.Contains(DiscoveryID))
-        {
-            // 맵에서 작업 포인터를 가져오고 제거
-            TaskToCancel = ActiveScanTasks[DiscoveryID];
-            ActiveScanTasks.Remove(DiscoveryID);
-
-            PJLINK_LOG_VERBOSE(TEXT("Found active scan task to cancel for discovery: %s"), *DiscoveryID);
-        }
     }
 
-    // 임계 영역 밖에서 작업 취소 처리 (교착 상태 방지)
-    if (TaskToCancel)
-    {
-        // 작업의 FScanWorker 인스턴스에 접근
-        FScanWorker* ScanWorker = static_cast<FScanWorker*>(TaskToCancel->GetTask());
-        if (ScanWorker)
-        {
-            // Cancel 메서드 호출로 취소 플래그 설정
-            ScanWorker->Cancel();
-            PJLINK_LOG_INFO(TEXT("Cancelled active scan task for discovery: %s"), *DiscoveryID);
-        }
+    // 임계 영역 밖에서 스캔 중지 (교착 상태 방지)
+    StopScan(DiscoveryID);
 
-        // 주의: TaskToCancel은 자체 삭제되므로 여기서 delete하지 않음
-    }
+    // 브로드캐스트 검색 세션 중지
+    StopBroadcastSearch(DiscoveryID);
+
+    // 식별 정보 조회 중지
+    StopEnricher(DiscoveryID);
+    PendingCompletions.Remove(DiscoveryID);
+    ActiveRescans.Remove(DiscoveryID);
 
     // 타이머 정리
     if (DiscoveryTimerHandles.Contains(DiscoveryID))
@@ -470,7 +578,9 @@ bool UPJLinkDiscoveryManager::CancelDiscovery(const FString& DiscoveryID)
 void UPJLinkDiscoveryManager::CancelAllDiscoveries()
 {
     // 모든 활성 작업 포인터와 타이머 핸들을 수집할 변수 (임계 영역 밖에서 사용하기 위함)
-    TArray<FAutoDeleteAsyncTask<FScanWorker>*> TasksToCancel;
+    TArray<TSharedPtr<FPJLinkScanEngine, ESPMode::ThreadSafe>> ScansToStop;
+    TArray<TSharedPtr<FPJLinkBroadcastSearch, ESPMode::ThreadSafe>> SearchesToStop;
+    TArray<TSharedPtr<FPJLinkDiscoveryEnricher, ESPMode::ThreadSafe>> EnrichersToStop;
     TArray<FString> DiscoveryIDs;
     TArray<FTimerHandle> TimersToCancel;
 
@@ -498,17 +608,17 @@ void UPJLinkDiscoveryManager::CancelAllDiscoveries()
             DiscoveryIDs.Add(Pair.Key);
         }
 
-        // 모든 활성 작업 수집
-        for (const auto& Pair : ActiveScanTasks)
-        {
-            if (Pair.Value) // null 체크
-            {
-                TasksToCancel.Add(Pair.Value);
-            }
-        }
+        // 모든 활성 스캔 수집
+        ActiveScans.GenerateValueArray(ScansToStop);
+        ActiveScans.Empty();
 
-        // 활성 작업 맵 비우기
-        ActiveScanTasks.Empty();
+        // 브로드캐스트 검색 세션 수집
+        ActiveBroadcastSearches.GenerateValueArray(SearchesToStop);
+        ActiveBroadcastSearches.Empty();
+
+        // 식별 정보 조회 단계 수집
+        ActiveEnrichers.GenerateValueArray(EnrichersToStop);
+        ActiveEnrichers.Empty();
 
         // 타이머 핸들 수집
         for (const auto& Pair : DiscoveryTimerHandles)
@@ -517,22 +627,36 @@ void UPJLinkDiscoveryManager::CancelAllDiscoveries()
         }
     }
 
-    // 임계 영역 밖에서 작업 취소 처리
-    int32 CancelledTaskCount = 0;
-    for (auto* Task : TasksToCancel)
+    // 임계 영역 밖에서 스캔 취소 처리 (모두 중단 요청한 뒤 종료 대기)
+    const int32 CancelledTaskCount = ScansToStop.Num();
+    for (const TSharedPtr<FPJLinkScanEngine, ESPMode::ThreadSafe>& Engine : ScansToStop)
     {
-        if (!Task) continue; // 안전 검사
-
-        // 작업의 FScanWorker 인스턴스에 접근
-        FScanWorker* ScanWorker = static_cast<FScanWorker*>(Task->GetTask());
-        if (ScanWorker)
+        Engine->Cancel();
+    }
+    for (const TSharedPtr<FPJLinkScanEngine, ESPMode::ThreadSafe>& Engine : ScansToStop)
+    {
+        if (Engine->IsInScanThread())
         {
-            // Cancel 메서드 호출로 취소 플래그 설정
-            ScanWorker->Cancel();
-            CancelledTaskCount++;
+            // 진행 이벤트 처리 중에 취소됨 - 실행 중인 엔진은 게임 스레드에서 해제
+            AsyncTask(ENamedThreads::GameThread, [Engine]() {});
+            continue;
         }
+        Engine->WaitForCompletion();
+    }
+
+    for (const TSharedPtr<FPJLinkBroadcastSearch, ESPMode::ThreadSafe>& Search : SearchesToStop)
+    {
+        Search->Stop();
+    }
 
-        // 주의: Task는 자체 삭제되므로 여기서 delete하지 않음
+    for (const TSharedPtr<FPJLinkDiscoveryEnricher, ESPMode::ThreadSafe>& Enricher : EnrichersToStop)
+    {
+        Enricher->Cancel();
+    }
+    if (IsInGameThread())
+    {
+        PendingCompletions.Reset();
+        ActiveRescans.Reset();
     }
 
     // 모든 타이머 정리
@@ -571,12 +695,13 @@ TArray<FPJLinkDiscoveryResult> UPJLinkDiscoveryManager::GetDiscoveryResults(cons
 {
     FScopeLock Lock(&DiscoveryLock);
 
-    if (!DiscoveryResults.Contains(DiscoveryID))
+    const FPJLinkDiscoveryResultSet* ResultSet = DiscoveryResults.Find(DiscoveryID);
+    if (!ResultSet)
     {
         return TArray<FPJLinkDiscoveryResult>();
     }
 
-    return DiscoveryResults[DiscoveryID];
+    return ResultSet->Results;
 }
 
 FPJLinkProjectorInfo UPJLinkDiscoveryManager::ConvertToProjectorInfo(const FPJLinkDiscoveryResult& DiscoveryResult)
@@ -595,6 +720,10 @@ FPJLinkProjectorInfo UPJLinkDiscoveryManager::ConvertToProjectorInfo(const FPJLi
     {
         ProjectorInfo.ProductName = DiscoveryResult.ModelName;
     }
+    if (!DiscoveryResult.Manufacturer.IsEmpty())
+    {
+        ProjectorInfo.ManufacturerName = DiscoveryResult.Manufacturer;
+    }
 
     return ProjectorInfo;
 }
@@ -641,13 +770,14 @@ int32 UPJLinkDiscoveryManager::SaveDiscoveryResultsAsGroup(const FString& Discov
 
     {
         FScopeLock Lock(&DiscoveryLock);
-        if (!DiscoveryResults.Contains(DiscoveryID))
+        const FPJLinkDiscoveryResultSet* ResultSet = DiscoveryResults.Find(DiscoveryID);
+        if (!ResultSet)
         {
             PJLINK_LOG_ERROR(TEXT("Discovery ID not found: %s"), *DiscoveryID);
             return 0;
         }
 
-        Results = DiscoveryResults[DiscoveryID];
+        Results = ResultSet->Results;
     }
 
     if (Results.Num() == 0)
@@ -717,594 +847,803 @@ int32 UPJLinkDiscoveryManager::SaveDiscoveryResultsAsGroup(const FString& Discov
     return AddedCount;
 }
 
-bool UPJLinkDiscoveryManager::SetupBroadcastSocket()
+bool UPJLinkDiscoveryManager::PerformBroadcastDiscovery(const FString& DiscoveryID, float TimeoutSeconds)
 {
-    // 이미 소켓이 있으면 재사용
-    if (BroadcastSocket)
-    {
-        return true;
-    }
-
-    ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
-    if (!SocketSubsystem)
+    const uint32 TargetIPv4 = IPStringToUint32(BroadcastAddress);
+    if (TargetIPv4 == 0 || BroadcastPort <= 0 || BroadcastPort > 65535)
     {
-        PJLINK_LOG_ERROR(TEXT("Failed to get socket subsystem"));
+        PJLINK_LOG_ERROR(TEXT("Invalid broadcast target: %s:%d"), *BroadcastAddress, BroadcastPort);
         return false;
     }
 
-    // UDP 소켓 생성
-    BroadcastSocket = SocketSubsystem->CreateSocket(NAME_DGram, TEXT("PJLinkDiscovery"), true);
-    if (!BroadcastSocket)
+    TSharedPtr<FPJLinkBroadcastSearch, ESPMode::ThreadSafe> Search = MakeShared<FPJLinkBroadcastSearch, ESPMode::ThreadSafe>(
+        this, DiscoveryID, TargetIPv4, static_cast<uint16>(BroadcastPort));
+
+    // 재전송은 검색 시간 앞쪽에 몰아 마지막 전송 후에도 응답을 기다릴 여유를 둠
+    const double RetransmitInterval = FMath::Min(FPJLinkBroadcastSearch::DefaultRetransmitIntervalSeconds,
+        static_cast<double>(TimeoutSeconds) / (SearchTransmitCount + 1));
+    if (!Search->Start(SearchTransmitCount, RetransmitInterval, TimeoutSeconds))
     {
-        PJLINK_LOG_ERROR(TEXT("Failed to create UDP socket"));
         return false;
     }
 
-    // 브로드캐스트 허용
-    BroadcastSocket->SetBroadcast(true);
-
-    // 재사용 가능하도록 설정
-    BroadcastSocket->SetReuseAddr(true);
-
-    // 바인딩
-    FIPv4Address LocalAddr;
-    FIPv4Address::Parse(TEXT("0.0.0.0"), LocalAddr);
-    TSharedRef<FInternetAddr> LocalAddress = SocketSubsystem->CreateInternetAddr();
-    LocalAddress->SetIp(LocalAddr.Value);
-    LocalAddress->SetPort(0); // 시스템이 포트 할당
-
-    if (!BroadcastSocket->Bind(*LocalAddress))
     {
-        PJLINK_LOG_ERROR(TEXT("Failed to bind broadcast socket"));
-        SocketSubsystem->DestroySocket(BroadcastSocket);
-        BroadcastSocket = nullptr;
-        return false;
+        FScopeLock Lock(&DiscoveryLock);
+        ActiveBroadcastSearches.Add(DiscoveryID, Search);
     }
 
+    PJLINK_LOG_INFO(TEXT("SRCH broadcast sent to %s:%d (%d transmits), waiting for ACKN replies..."),
+        *BroadcastAddress, BroadcastPort, SearchTransmitCount);
+
+    PJLINK_CAPTURE_DIAGNOSTIC(DiscoveryDiagnosticData,
+        TEXT("Broadcast sent to port %d, waiting for responses..."), BroadcastPort);
     return true;
 }
 
-void UPJLinkDiscoveryManager::PerformBroadcastDiscovery(const FString& DiscoveryID, float TimeoutSeconds)
+void UPJLinkDiscoveryManager::StopBroadcastSearch(const FString& DiscoveryID)
 {
-    if (!BroadcastSocket)
+    TSharedPtr<FPJLinkBroadcastSearch, ESPMode::ThreadSafe> Search;
     {
-        PJLINK_LOG_ERROR(TEXT("Broadcast socket is null"));
-        CompleteDiscovery(DiscoveryID, false);
-        return;
+        FScopeLock Lock(&DiscoveryLock);
+        ActiveBroadcastSearches.RemoveAndCopyValue(DiscoveryID, Search);
     }
 
-    ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
-    if (!SocketSubsystem)
+    // 알림 수신기 락을 잡으므로 검색 락 밖에서 중지
+    if (Search.IsValid())
     {
-        PJLINK_LOG_ERROR(TEXT("Failed to get socket subsystem"));
-        CompleteDiscovery(DiscoveryID, false);
-        return;
+        Search->Stop();
     }
+}
 
-    // 브로드캐스트 주소 설정
-    TSharedRef<FInternetAddr> BroadcastAddr = SocketSubsystem->CreateInternetAddr();
-    BroadcastAddr->SetBroadcast();
-    BroadcastAddr->SetPort(BroadcastPort);
+bool UPJLinkDiscoveryManager::StartScanEngine(const FString& DiscoveryID, uint32 FirstIP, uint32 LastIP, float TimeoutSeconds)
+{
+    FPJLinkScanSettings Settings = MakeScanSettings(FirstIP, LastIP, TimeoutSeconds);
+    if (!bUseKnownHosts)
+    {
+        return LaunchScanEngine(DiscoveryID, Settings, false);
+    }
 
-    // PJLink 검색 명령 (예: "%1CLSS ?\r")
-    FString DiscoveryCommand = TEXT("%1CLSS ?\r");
-    FTCHARToUTF8 Utf8Command(*DiscoveryCommand);
+    TArray<FPJLinkKnownHost> KnownHosts;
+    GetKnownHostsIndex().FindHostsInRange(FirstIP, LastIP, BroadcastPort, KnownHosts);
 
-    // 브로드캐스트 전송
-    int32 BytesSent = 0;
-    bool bSendSuccess = BroadcastSocket->SendTo((uint8*)Utf8Command.Get(), Utf8Command.Length(), BytesSent, *BroadcastAddr);
+    FPJLinkRescanState& Rescan = ActiveRescans.Add(DiscoveryID);
+    Rescan.FirstIPv4 = FirstIP;
+    Rescan.LastIPv4 = LastIP;
+    Rescan.TimeoutSeconds = TimeoutSeconds;
 
-    if (!bSendSuccess || BytesSent != Utf8Command.Length())
+    int32 SlowestResponseMs = 0;
+    for (const FPJLinkKnownHost& Host : KnownHosts)
     {
-        PJLINK_LOG_ERROR(TEXT("Failed to send broadcast: %s"), *SocketSubsystem->GetSocketError().ToString());
-        CompleteDiscovery(DiscoveryID, false);
-        return;
+        Rescan.KnownDevices.Add(MakeEndpointKey(Host.Device), Host.Device);
+        Settings.TargetIPv4s.Add(Host.Device.IPv4);
+        SlowestResponseMs = FMath::Max(SlowestResponseMs, Host.Device.ResponseTimeMs);
     }
 
-    PJLINK_LOG_INFO(TEXT("Broadcast sent, waiting for responses..."));
-
-    // 브로드캐스트 응답 대기는 비동기로 처리됨
-    // 타임아웃 후 완료 처리
-    if (UWorld* World = GEngine->GetWorldFromContextObject(GetOuter(), EGetWorldErrorMode::LogAndReturnNull))
     {
-        FTimerDelegate CompletionDelegate;
-        CompletionDelegate.BindUObject(this, &UPJLinkDiscoveryManager::CompleteDiscovery, DiscoveryID, true);
+        FScopeLock Lock(&DiscoveryLock);
+        if (FPJLinkDiscoveryStatus* Status = DiscoveryStatuses.Find(DiscoveryID))
+        {
+            Status->KnownDevices = KnownHosts.Num();
+        }
+    }
 
-        FTimerHandle CompletionTimerHandle;
-        World->GetTimerManager().SetTimer(CompletionTimerHandle, CompletionDelegate, TimeoutSeconds, false);
+    if (KnownHosts.Num() == 0)
+    {
+        return LaunchScanEngine(DiscoveryID, Settings, false);
     }
 
-    PJLINK_CAPTURE_DIAGNOSTIC(DiscoveryDiagnosticData,
-        TEXT("Broadcast sent to port %d, waiting for responses..."), BroadcastPort);
+    // 알려진 호스트는 지난번 응답 시간의 두 배까지만 기다림 (놓친 호스트는 나머지 주소 스윕에서 다시 확인)
+    Settings.ConnectTimeoutSeconds = FMath::Min(Settings.ConnectTimeoutSeconds,
+        FMath::Max3(SlowestResponseMs * 2 / 1000.0, Settings.MinConnectTimeoutSeconds, 0.05));
+    Settings.bRetryTimedOut = false;
+
+    PJLINK_LOG_INFO(TEXT("Verifying %d known hosts for %s before sweeping the rest of the range"),
+        KnownHosts.Num(), *DiscoveryID);
+    return LaunchScanEngine(DiscoveryID, Settings, true);
 }
 
-void UPJLinkDiscoveryManager::PerformRangeScan(const FString& DiscoveryID, uint32 StartIP, uint32 EndIP,
-    float TimeoutSeconds, TAtomic<bool>* CancellationFlag)
+FPJLinkScanSettings UPJLinkDiscoveryManager::MakeScanSettings(uint32 FirstIP, uint32 LastIP, float TimeoutSeconds) const
 {
-    // 함수 시작 부분에 취소 확인 헬퍼 함수 추가
-    auto CheckCancellation = [&]() -> bool {
-        // 취소 확인 주기 제한 (자주 확인하지 않도록)
-        static double LastCheckTime = 0.0;
-        double CurrentTime = FPlatformTime::Seconds();
-
-        // 마지막 체크 후 최소 50ms 간격을 두어 잦은 락 획득으로 인한 성능 저하 방지
-        if (CurrentTime - LastCheckTime < 0.05) {
-            return false;  // 너무 자주 체크하지 않음
-        }
-
-        LastCheckTime = CurrentTime;
-
-        // 직접 취소 플래그 확인 (락 없이 가능)
-        if (CancellationFlag && CancellationFlag->load(std::memory_order_acquire)) {
-            PJLINK_LOG_VERBOSE(TEXT("Range scan cancelled via external flag for discovery: %s"), *DiscoveryID);
-            return true;
-        }
+    FPJLinkScanSettings Settings;
+    Settings.FirstIPv4 = FirstIP;
+    Settings.LastIPv4 = LastIP;
+    Settings.Port = static_cast<uint16>(FMath::Clamp(BroadcastPort, 1, 65535));
+    Settings.MaxInFlight = MaxInFlight;
+    Settings.NumWorkers = MaxConcurrentThreads;
+
+    // 호스트당 대기 시간은 전체 검색 제한 시간을 넘지 않음
+    Settings.ConnectTimeoutSeconds = FMath::Min(PerAddressWaitTimeMs / 1000.0, static_cast<double>(TimeoutSeconds));
+    Settings.MinConnectTimeoutSeconds = FMath::Min(MinPerAddressWaitTimeMs / 1000.0, Settings.ConnectTimeoutSeconds);
+    Settings.ResponseTimeoutSeconds = FMath::Min(2.0, static_cast<double>(TimeoutSeconds));
+
+    // 스윕은 CLSS 까지만 확인하고, 응답한 연결은 식별 정보 조회 단계로 넘겨 스윕이 조회를 기다리지 않게 함
+    Settings.bQueryIdentity = false;
+    return Settings;
+}
 
-        // 상태 기반 취소 확인 (락 필요)
+bool UPJLinkDiscoveryManager::LaunchScanEngine(const FString& DiscoveryID, const FPJLinkScanSettings& Settings, bool bVerifyingKnownHosts)
+{
+    // 알려진 호스트 확인과 나머지 주소 스윕은 식별 정보 조회 단계 하나를 함께 씀
+    TSharedPtr<FPJLinkDiscoveryEnricher, ESPMode::ThreadSafe> Enricher;
+    {
         FScopeLock Lock(&DiscoveryLock);
-        bool bCancelled = DiscoveryStatuses.Contains(DiscoveryID) &&
-            (DiscoveryStatuses[DiscoveryID].bIsComplete || DiscoveryStatuses[DiscoveryID].bWasCancelled);
-
-        if (bCancelled) {
-            PJLINK_LOG_VERBOSE(TEXT("Range scan cancelled via status flag for discovery: %s"), *DiscoveryID);
-        }
-
-        return bCancelled;
-        };
-
-    // 병렬 처리를 위한 IP 분할 개선
-    const uint32 MaxIPsPerBatch = 255;
-    const uint32 TotalIPCount = EndIP - StartIP + 1;
-
-    // 병렬 처리할 스레드 수 결정 (범위가 충분히 클 경우)
-    int32 ThreadCount = FMath::Min(MaxConcurrentThreads,
-        FMath::DivideAndRoundUp((int32)TotalIPCount, (int32)MaxIPsPerBatch));
-
-    if (ThreadCount > 1 && TotalIPCount > MaxIPsPerBatch)
+        Enricher = ActiveEnrichers.FindRef(DiscoveryID);
+    }
+    const bool bStartedEnricher = !Enricher.IsValid();
+    if (bStartedEnricher)
     {
-        // 병렬 처리할 경우 각 스레드가 담당할 IP 범위 계산
-        uint32 IPsPerThread = TotalIPCount / ThreadCount;
-
-        // 작업 리스트 생성
-        TArray<FAutoDeleteAsyncTask<FScanWorker>*> ParallelTasks;
-
-        for (int32 i = 0; i < ThreadCount; i++)
-        {
-            uint32 ThreadStartIP = StartIP + (i * IPsPerThread);
-            uint32 ThreadEndIP = (i == ThreadCount - 1) ? EndIP : ThreadStartIP + IPsPerThread - 1;
-
-            // 작업 생성 및 시작
-            FAutoDeleteAsyncTask<FScanWorker>* ThreadTask =
-                new FAutoDeleteAsyncTask<FScanWorker>(this, DiscoveryID, ThreadStartIP, ThreadEndIP, TimeoutSeconds);
+        Enricher = StartEnricher(DiscoveryID);
+    }
 
-            ParallelTasks.Add(ThreadTask);
-            ThreadTask->StartBackgroundTask();
+    TWeakObjectPtr<UPJLinkDiscoveryManager> WeakThis(this);
+    FPJLinkScanCallbacks Callbacks;
 
-            PJLINK_LOG_VERBOSE(TEXT("Started parallel scan task %d/%d for IP range %s - %s"),
-                i + 1, ThreadCount, *Uint32ToIPString(ThreadStartIP), *Uint32ToIPString(ThreadEndIP));
-        }
+    Callbacks.OnAdoptConnection = [Enricher](uint32 IPv4, FNativeSocket Socket)
+    {
+        Enricher->AddConnectedDevice(IPv4, Socket);
+        return true;
+    };
 
-        // 작업들을 ActiveScanTasks에 저장 (공유 취소 기능을 위해)
+    // 결과 저장과 발견 이벤트는 게임 스레드에서 처리
+    Callbacks.OnHostFound = [WeakThis, DiscoveryID](uint32 IPv4, const FString& Response, int32 ResponseTimeMs)
+    {
+        AsyncTask(ENamedThreads::GameThread, [WeakThis, DiscoveryID, IPv4, Response, ResponseTimeMs]()
         {
-            FScopeLock Lock(&DiscoveryLock);
-            for (int32 i = 0; i < ParallelTasks.Num(); i++)
+            if (UPJLinkDiscoveryManager* StrongThis = WeakThis.Get())
             {
-                FString SubTaskID = FString::Printf(TEXT("%s_thread%d"), *DiscoveryID, i);
-                ActiveScanTasks.Add(SubTaskID, ParallelTasks[i]);
+                StrongThis->ProcessDiscoveryResponse(DiscoveryID, IPv4, Response, ResponseTimeMs);
             }
-        }
-
-        return; // 병렬 태스크가 스캔을 처리할 것임
-    }
-
-    // 아래는 단일 스레드 처리 (작은 범위일 경우)
+        });
+    };
 
-    // 최대 IP 숫자 제한 (너무 큰 범위는 분할 처리)
-    if (EndIP - StartIP + 1 > MaxIPsPerBatch)
+    // 진행 상황은 콜백 대신 게시 티커가 엔진 통계를 주기적으로 읽어 반영
+    // 엔진은 StopScan 에서 종료를 기다린 뒤 해제되므로 종료 콜백 동안 매니저는 유효함
+    // 취소된 스캔은 CancelDiscovery/CompleteDiscovery 가 이미 완료 처리함
+    Callbacks.OnFinished = [this, WeakThis, DiscoveryID, bVerifyingKnownHosts](const FPJLinkScanStats& Stats, bool bCancelled)
     {
-        uint32 BatchCount = ((EndIP - StartIP) / MaxIPsPerBatch) + 1;
-        uint32 CurrentStartIP = StartIP;
-
-        for (uint32 i = 0; i < BatchCount; i++)
+        HandleScanFinished(DiscoveryID, Stats);
+        if (bCancelled)
         {
-            // 취소 확인
-            if (CheckCancellation()) {
-                return;
-            }
-
-            uint32 CurrentEndIP = FMath::Min(CurrentStartIP + MaxIPsPerBatch - 1, EndIP);
+            return;
+        }
 
-            // 부분 범위 스캔 작업 생성
-            TArray<FString> IPsToScan;
-            for (uint32 IP = CurrentStartIP; IP <= CurrentEndIP; IP++)
+        AsyncTask(ENamedThreads::GameThread, [WeakThis, DiscoveryID, bVerifyingKnownHosts]()
+        {
+            if (UPJLinkDiscoveryManager* StrongThis = WeakThis.Get())
             {
-                IPsToScan.Add(Uint32ToIPString(IP));
+                StrongThis->HandleScanPhaseFinished(DiscoveryID, bVerifyingKnownHosts);
             }
+        });
+    };
 
-            // 각 IP 주소 스캔
-            for (const FString& IPAddress : IPsToScan)
-            {
-                ScanIPAddress(DiscoveryID, IPAddress, TimeoutSeconds);
-
-                // 취소 확인
-                if (CheckCancellation()) {
-                    return;
-                }
-
-                // IP 스캔 간 대기 (네트워크 부하 방지)
-                FPlatformProcess::Sleep(PerAddressWaitTimeMs / 1000.0f);
-            }
+    TSharedPtr<FPJLinkScanEngine, ESPMode::ThreadSafe> Engine =
+        MakeShared<FPJLinkScanEngine, ESPMode::ThreadSafe>(Settings, MoveTemp(Callbacks));
 
-            CurrentStartIP = CurrentEndIP + 1;
-        }
+    // 스캔이 바로 끝나도 StopScan 이 찾을 수 있도록 시작 전에 등록
+    {
+        FScopeLock Lock(&DiscoveryLock);
+        ActiveScans.Add(DiscoveryID, Engine);
     }
-    else
+
+    if (!Engine->Start())
     {
-        // 작은 범위는 직접 처리
-        TArray<FString> IPsToScan;
-        for (uint32 IP = StartIP; IP <= EndIP; IP++)
+        PJLINK_LOG_ERROR(TEXT("Failed to start scan engine for discovery: %s"), *DiscoveryID);
         {
-            IPsToScan.Add(Uint32ToIPString(IP));
+            FScopeLock Lock(&DiscoveryLock);
+            ActiveScans.Remove(DiscoveryID);
         }
-
-        // 각 IP 주소 스캔
-        for (const FString& IPAddress : IPsToScan)
+        if (bStartedEnricher)
         {
-            ScanIPAddress(DiscoveryID, IPAddress, TimeoutSeconds);
-
-            // 취소 확인
-            if (CheckCancellation()) {
-                return;
-            }
-
-            // IP 스캔 간 대기 (네트워크 부하 방지)
-            FPlatformProcess::Sleep(PerAddressWaitTimeMs / 1000.0f);
+            StopEnricher(DiscoveryID);
         }
+        return false;
     }
 
-    // 스캔 완료 처리 전에 한 번 더 확인
-    if (CheckCancellation()) {
+    StartProgressPublisher();
+    return true;
+}
+
+void UPJLinkDiscoveryManager::HandleScanPhaseFinished(const FString& DiscoveryID, bool bVerifyingKnownHosts)
+{
+    if (bVerifyingKnownHosts)
+    {
+        StartBackgroundSweep(DiscoveryID);
         return;
     }
 
-    // 스캔 완료 처리 - 취소되지 않은 경우에만 완료 처리
-    FScopeLock Lock(&DiscoveryLock);
-    if (DiscoveryStatuses.Contains(DiscoveryID) &&
-        !DiscoveryStatuses[DiscoveryID].bIsComplete &&
-        !DiscoveryStatuses[DiscoveryID].bWasCancelled)
+    if (FPJLinkRescanState* Rescan = ActiveRescans.Find(DiscoveryID))
     {
-        // 락 외부에서 호출하기 위해 락 해제 후 호출
-        Lock.Unlock();
-        CompleteDiscovery(DiscoveryID, true);
+        Rescan->bSweepFinished = true;
     }
+    CompleteDiscoveryWhenEnriched(DiscoveryID);
 }
 
-void UPJLinkDiscoveryManager::PerformSubnetScan(const FString& DiscoveryID, uint32 NetworkAddress, uint32 SubnetMask, float TimeoutSeconds)
+void UPJLinkDiscoveryManager::StartBackgroundSweep(const FString& DiscoveryID)
 {
-    // 호스트 부분 비트 구하기
-    uint32 HostBits = ~SubnetMask;
-
-    // 첫 번째 호스트 주소 (네트워크 주소 + 1)
-    uint32 FirstHostIP = NetworkAddress + 1;
+    const FPJLinkRescanState* Rescan = ActiveRescans.Find(DiscoveryID);
+    if (!Rescan)
+    {
+        return;
+    }
 
-    // 마지막 호스트 주소 (브로드캐스트 주소 - 1)
-    uint32 LastHostIP = NetworkAddress + HostBits - 1;
+    // 확인을 마친 엔진을 정리해야 같은 검색 ID 로 스윕 엔진을 등록할 수 있음
+    StopScan(DiscoveryID);
 
-    // 서브넷 스캔 작업 생성
-    FAutoDeleteAsyncTask<FScanWorker>* ScanTask = new FAutoDeleteAsyncTask<FScanWorker>(
-        this, DiscoveryID, FirstHostIP, LastHostIP, TimeoutSeconds);
+    FPJLinkScanSettings Settings = MakeScanSettings(Rescan->FirstIPv4, Rescan->LastIPv4, Rescan->TimeoutSeconds);
 
-    // 작업 저장 및 시작
+    // 응답한 알려진 호스트만 빼고, 응답하지 않은 호스트는 전체 제한 시간으로 다시 확인
+    int32 VerifiedDevices = 0;
     {
         FScopeLock Lock(&DiscoveryLock);
-        // 기존 작업이 있으면 제거
-        if (ActiveScanTasks.Contains(DiscoveryID))
+        FPJLinkDiscoveryStatus* Status = DiscoveryStatuses.Find(DiscoveryID);
+        const FPJLinkDiscoveryResultSet* ResultSet = DiscoveryResults.Find(DiscoveryID);
+        if (!Status || Status->bIsComplete || !ResultSet)
         {
-            delete ActiveScanTasks[DiscoveryID];
-            ActiveScanTasks.Remove(DiscoveryID);
+            return;
         }
 
-        // 새 작업 추가
-        ActiveScanTasks.Add(DiscoveryID, ScanTask);
+        for (const auto& Pair : Rescan->KnownDevices)
+        {
+            if (ResultSet->EndpointIndices.Contains(Pair.Key))
+            {
+                Settings.ExcludedIPv4s.Add(Pair.Value.IPv4);
+            }
+        }
+        VerifiedDevices = Settings.ExcludedIPv4s.Num();
+
+        Status->bSweepingInBackground = true;
+        DirtyProgress.Add(DiscoveryID);
     }
 
-    // 백그라운드 작업 시작
-    ScanTask->StartBackgroundTask();
+    // 결과는 이미 보고했으므로 나머지 주소는 한 작업 스레드가 적은 동시 연결로 천천히 스윕
+    Settings.MaxInFlight = FMath::Min(Settings.MaxInFlight, BackgroundSweepMaxInFlight);
+    Settings.NumWorkers = 1;
+
+    PJLINK_LOG_INFO(TEXT("Known hosts for %s: %d of %d responded, sweeping the rest in the background (%d in flight)"),
+        *DiscoveryID, VerifiedDevices, Rescan->KnownDevices.Num(), Settings.MaxInFlight);
+
+    if (!LaunchScanEngine(DiscoveryID, Settings, false))
+    {
+        // 스윕 없이 끝나면 응답하지 않은 호스트를 사라진 것으로 판정하지 않음
+        CompleteDiscoveryWhenEnriched(DiscoveryID);
+    }
 }
 
-void UPJLinkDiscoveryManager::ScanIPAddress(const FString& DiscoveryID, const FString& IPAddress, float TimeoutSeconds)
+void UPJLinkDiscoveryManager::ReportDeviceChange(const FString& DiscoveryID, const FPJLinkDiscoveryResult& Result)
 {
-    // 현재 IP 주소 업데이트 및 스캔 시간 기록
-    CurrentScanningIPAddress = IPAddress;
-    LastIPScanTime = CurrentIPScanTime;
-    CurrentIPScanTime = FDateTime::Now();
-
-    // 이벤트 발생 (게임 스레드로 전달)
-    AsyncTask(ENamedThreads::GameThread, [this, IPAddress]() {
-        if (IsValid(this) && OnCurrentScanAddressChanged.IsBound())
-        {
-            OnCurrentScanAddressChanged.Broadcast(IPAddress);
-        }
-        });
+    FPJLinkRescanState* Rescan = ActiveRescans.Find(DiscoveryID);
+    if (!Rescan || !Result.bIdentityQueried)
+    {
+        return;
+    }
 
-    // 스캔 시간 기록 - 진단용
-    PJLINK_CAPTURE_DIAGNOSTIC(DiscoveryDiagnosticData,
-        TEXT("Scanning IP address: %s"), *IPAddress);
+    const uint64 EndpointKey = MakeEndpointKey(Result);
+    if (Rescan->ReportedDevices.Contains(EndpointKey))
+    {
+        return;
+    }
 
-    // 스캔 간 소요 시간 계산 (첫 스캔이 아닌 경우)
-    if (LastIPScanTime != FDateTime())
+    const FPJLinkDiscoveryResult* KnownDevice = Rescan->KnownDevices.Find(EndpointKey);
+    const bool bNew = KnownDevice == nullptr;
+    if (!bNew && !FPJLinkKnownHostsIndex::HasIdentityChanged(*KnownDevice, Result))
     {
-        FTimespan ScanInterval = CurrentIPScanTime - LastIPScanTime;
-        PJLINK_CAPTURE_DIAGNOSTIC(DiscoveryDiagnosticData,
-            TEXT("Time since last scan: %.2f ms"), ScanInterval.GetTotalMilliseconds());
+        return;
     }
+    Rescan->ReportedDevices.Add(EndpointKey);
 
-    // 스캔 진행 상황 업데이트
     {
         FScopeLock Lock(&DiscoveryLock);
-        if (DiscoveryStatuses.Contains(DiscoveryID))
+        if (FPJLinkDiscoveryStatus* Status = DiscoveryStatuses.Find(DiscoveryID))
         {
-            FPJLinkDiscoveryStatus& Status = DiscoveryStatuses[DiscoveryID];
-            Status.ScannedAddresses++;
-
-            // 스캔 속도 계산 (초당 스캔 IP 수)
-            if (Status.ScannedAddresses > 1 && Status.ElapsedTime.GetTotalSeconds() > 0)
-            {
-                float ScanSpeed = Status.ScannedAddresses / Status.ElapsedTime.GetTotalSeconds();
-                Status.ScanSpeedIPsPerSecond = ScanSpeed;
-
-                // 남은 시간 추정
-                if (Status.TotalAddresses > Status.ScannedAddresses && ScanSpeed > 0)
-                {
-                    float RemainingIPs = Status.TotalAddresses - Status.ScannedAddresses;
-                    float EstimatedTimeSeconds = RemainingIPs / ScanSpeed;
-                    Status.EstimatedTimeRemaining = FTimespan::FromSeconds(EstimatedTimeSeconds);
-                }
-            }
-
-            // 현재 스캔 중인 IP 주소 업데이트
-            Status.CurrentScanningIP = IPAddress;
-
-            UpdateDiscoveryProgress(DiscoveryID, Status.ScannedAddresses, Status.DiscoveredDevices);
+            (bNew ? Status->NewDevices : Status->ChangedDevices)++;
+            DirtyProgress.Add(DiscoveryID);
         }
     }
 
-    ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
-    if (!SocketSubsystem)
+    FPJLinkDiscoveryResult ChangedResult = Result;
+    if (ChangedResult.IPAddress.IsEmpty())
     {
-        PJLINK_LOG_ERROR(TEXT("Failed to get socket subsystem"));
-        return;
+        ChangedResult.IPAddress = Uint32ToIPString(static_cast<uint32>(EndpointKey >> 16));
     }
 
-    // TCP 소켓 생성
-    FSocket* Socket = SocketSubsystem->CreateSocket(NAME_Stream, TEXT("PJLinkScan"), true);
-    if (!Socket)
+    PJLINK_LOG_INFO(TEXT("%s device at %s: Name='%s', Model='%s'"), bNew ? TEXT("New") : TEXT("Changed"),
+        *ChangedResult.IPAddress, *ChangedResult.Name, *ChangedResult.ModelName);
+
+    if (OnDeviceChanged.IsBound())
     {
-        PJLINK_LOG_ERROR(TEXT("Failed to create TCP socket for scanning"));
-        return;
+        OnDeviceChanged.Broadcast(ChangedResult, bNew ? EPJLinkDiscoveryChange::New : EPJLinkDiscoveryChange::Changed);
     }
+}
 
-    // 소켓 타임아웃 설정 강화
-    FTimespan ConnectionTimeout = FTimespan::FromSeconds(TimeoutSeconds);
-    Socket->SetReceiveTimeout(ConnectionTimeout);
-    Socket->SetSendTimeout(ConnectionTimeout);
-    Socket->SetConnectionTimeout(ConnectionTimeout);
-
-    // 연결 타임아웃 설정
-    Socket->SetNonBlocking(true);
-
-    // 연결 시도
-    FIPv4Address IP;
-    if (!FIPv4Address::Parse(IPAddress, IP))
+void UPJLinkDiscoveryManager::FinishRescan(const FString& DiscoveryID, bool bSuccess, const TArray<FPJLinkDiscoveryResult>& Results)
+{
+    FPJLinkRescanState Rescan;
+    if (!ActiveRescans.RemoveAndCopyValue(DiscoveryID, Rescan) || !bSuccess)
     {
-        PJLINK_LOG_ERROR(TEXT("Invalid IP address: %s"), *IPAddress);
-        SocketSubsystem->DestroySocket(Socket);
         return;
     }
 
-    TSharedRef<FInternetAddr> Addr = SocketSubsystem->CreateInternetAddr();
-    Addr->SetIp(IP.Value);
-    Addr->SetPort(BroadcastPort);
-
-    // 연결 시도 (비동기)
-    bool bConnected = Socket->Connect(*Addr);
+    FPJLinkKnownHostsIndex& Index = GetKnownHostsIndex();
 
-    if (!bConnected)
+    TSet<uint64> RespondedDevices;
+    for (const FPJLinkDiscoveryResult& Result : Results)
     {
-        ESocketErrors LastError = SocketSubsystem->GetLastErrorCode();
+        Index.RecordSeen(Result);
+        RespondedDevices.Add(MakeEndpointKey(Result));
+    }
 
-        // EWOULDBLOCK은 비동기 연결 진행 중임을 의미
-        if (LastError != SE_EWOULDBLOCK)
+    // 검색 제한 시간에 걸려 스윕이 끝나지 않았으면 응답하지 않은 호스트는 판정을 미룸
+    TArray<FPJLinkDiscoveryResult> MissingDevices;
+    if (Rescan.bSweepFinished)
+    {
+        for (const auto& Pair : Rescan.KnownDevices)
         {
-            // 연결 실패 - 오류 종류에 따른 세부 로깅 추가
-            FString ErrorString = SocketSubsystem->GetSocketError().ToString();
-            if (LastError == SE_ECONNREFUSED)
-            {
-                PJLINK_LOG_VERBOSE(TEXT("Connection refused to %s: %s"), *IPAddress, *ErrorString);
-            }
-            else if (LastError == SE_ENETUNREACH || LastError == SE_EHOSTUNREACH)
+            if (!RespondedDevices.Contains(Pair.Key))
             {
-                PJLINK_LOG_VERBOSE(TEXT("Host unreachable at %s: %s"), *IPAddress, *ErrorString);
+                Index.RecordMissed(Pair.Value.IPv4, Pair.Value.Port);
+                MissingDevices.Add(Pair.Value);
             }
-            else
-            {
-                PJLINK_LOG_VERBOSE(TEXT("Failed to connect to %s: %s (%d)"), *IPAddress, *ErrorString, (int32)LastError);
-            }
-
-            SocketSubsystem->DestroySocket(Socket);
-            return;
         }
     }
 
-    // 연결 대기
-    double StartTime = FPlatformTime::Seconds();
-    double EndTime = StartTime + TimeoutSeconds;
+    if (!Index.Save())
+    {
+        PJLINK_LOG_WARNING(TEXT("Failed to save known hosts to %s"), *Index.GetDirectory());
+    }
 
-    while (FPlatformTime::Seconds() < EndTime)
     {
-        // 작업 중단 여부 확인
+        FScopeLock Lock(&DiscoveryLock);
+        if (FPJLinkDiscoveryStatus* Status = DiscoveryStatuses.Find(DiscoveryID))
         {
-            FScopeLock Lock(&DiscoveryLock);
-            if (DiscoveryStatuses.Contains(DiscoveryID) &&
-                (DiscoveryStatuses[DiscoveryID].bIsComplete || DiscoveryStatuses[DiscoveryID].bWasCancelled))
-            {
-                SocketSubsystem->DestroySocket(Socket);
-                return;
-            }
+            Status->MissingDevices = MissingDevices.Num();
+            Status->bSweepingInBackground = false;
         }
+    }
 
-        // 연결 상태 확인
-        bool bConnectionComplete = false;
-        Socket->HasPendingConnection(bConnectionComplete);
+    PJLINK_LOG_INFO(TEXT("Known hosts updated for %s: %d known, %d responded, %d missing"),
+        *DiscoveryID, Rescan.KnownDevices.Num(), Results.Num(), MissingDevices.Num());
 
-        if (bConnectionComplete)
+    if (OnDeviceChanged.IsBound())
+    {
+        for (const FPJLinkDiscoveryResult& Device : MissingDevices)
         {
-            // 연결 성공, PJLink 명령 보내기
-            FString PJLinkCommand = TEXT("%1CLSS ?\r");
-            FTCHARToUTF8 Utf8Command(*PJLinkCommand);
-
-            int32 BytesSent = 0;
-            bool bSendSuccess = Socket->Send((uint8*)Utf8Command.Get(), Utf8Command.Length(), BytesSent);
-
-            if (bSendSuccess && BytesSent == Utf8Command.Length())
-            {
-                // 응답 대기
-                uint8 RecvBuffer[1024] = { 0 };
-                int32 BytesRead = 0;
-                bool bReadSuccess = Socket->Wait(ESocketWaitConditions::WaitForRead, FTimespan::FromSeconds(2.0));
+            OnDeviceChanged.Broadcast(Device, EPJLinkDiscoveryChange::Missing);
+        }
+    }
+}
 
-                if (bReadSuccess)
-                {
-                    // 응답 읽기
-                    bReadSuccess = Socket->Recv(RecvBuffer, sizeof(RecvBuffer) - 1, BytesRead);
+FPJLinkKnownHostsIndex& UPJLinkDiscoveryManager::GetKnownHostsIndex()
+{
+    if (!KnownHostsIndex.IsValid())
+    {
+        KnownHostsIndex = MakeShared<FPJLinkKnownHostsIndex>(FPaths::ProjectSavedDir() / TEXT("PJLink") / TEXT("KnownHosts"));
+    }
+    return *KnownHostsIndex;
+}
 
-                    if (bReadSuccess && BytesRead > 0)
-                    {
-                        // 널 종료 추가
-                        RecvBuffer[BytesRead] = 0;
+void UPJLinkDiscoveryManager::ClearKnownHosts()
+{
+    GetKnownHostsIndex().Clear();
+    PJLINK_LOG_INFO(TEXT("Cleared known hosts in %s"), *GetKnownHostsIndex().GetDirectory());
+}
 
-                        // UTF-8 문자열로 변환
-                        FString Response = UTF8_TO_TCHAR((const char*)RecvBuffer);
+void UPJLinkDiscoveryManager::StopScan(const FString& DiscoveryID)
+{
+    TSharedPtr<FPJLinkScanEngine, ESPMode::ThreadSafe> Engine;
+    {
+        FScopeLock Lock(&DiscoveryLock);
+        ActiveScans.RemoveAndCopyValue(DiscoveryID, Engine);
+    }
 
-                        // 응답 시간 계산
-                        int32 ResponseTimeMs = FMath::FloorToInt((FPlatformTime::Seconds() - StartTime) * 1000.0);
+    if (!Engine.IsValid())
+    {
+        return;
+    }
 
-                        // 응답 처리
-                        ProcessDiscoveryResponse(DiscoveryID, IPAddress, Response, ResponseTimeMs);
-                    }
-                }
-            }
+    // 진행 콜백이 검색 락을 잡으므로 락 밖에서 종료 대기
+    Engine->Cancel();
+    if (Engine->IsInScanThread())
+    {
+        // 진행 이벤트 처리 중에 취소됨 - 실행 중인 엔진을 여기서 해제할 수 없으므로 게임 스레드로 넘김
+        AsyncTask(ENamedThreads::GameThread, [Engine]() {});
+        return;
+    }
+    Engine->WaitForCompletion();
+}
 
-            break; // 데이터 송수신 완료 후 종료
+void UPJLinkDiscoveryManager::HandleScanFinished(const FString& DiscoveryID, const FPJLinkScanStats& Stats)
+{
+    // 취소된 검색은 이미 100% 로 표시됨
+    FScopeLock Lock(&DiscoveryLock);
+    FPJLinkDiscoveryStatus* Status = DiscoveryStatuses.Find(DiscoveryID);
+    if (Status && !Status->bIsComplete)
+    {
+        ApplyScanStats(*Status, Stats);
+        if (Stats.LastCompletedIPv4 != 0)
+        {
+            Status->CurrentScanningIP = Uint32ToIPString(Stats.LastCompletedIPv4);
         }
+        DirtyProgress.Add(DiscoveryID);
+    }
+}
+
+void UPJLinkDiscoveryManager::ApplyScanStats(FPJLinkDiscoveryStatus& Status, const FPJLinkScanStats& Stats)
+{
+    Status.ScannedAddresses = Stats.ScannedAddresses;
+    Status.WorkerCount = Stats.NumWorkers;
+    Status.WorkerUtilization = static_cast<float>(Stats.WorkerUtilization);
+    Status.TailTimeSeconds = static_cast<float>(Stats.TailSeconds);
+    Status.ConnectTimeoutMs = static_cast<float>(Stats.ConnectTimeoutSeconds * 1000.0);
+    Status.RetriedAddresses = Stats.RetriedHosts;
 
-        FPlatformProcess::Sleep(0.01f); // 10ms 대기
+    if (Status.TotalAddresses > 0)
+    {
+        Status.ProgressPercentage = static_cast<float>(Stats.ScannedAddresses) / static_cast<float>(Status.TotalAddresses) * 100.0f;
     }
 
-    // 소켓 정리
-    Socket->Close();
-    SocketSubsystem->DestroySocket(Socket);
+    // 스캔 속도 계산 (초당 스캔 IP 수) 및 남은 시간 추정
+    if (Stats.ElapsedSeconds > 0.0)
+    {
+        Status.ScanSpeedIPsPerSecond = static_cast<float>(Stats.ScannedAddresses / Stats.ElapsedSeconds);
+        if (Status.ScanSpeedIPsPerSecond > 0.0f && Status.TotalAddresses > Stats.ScannedAddresses)
+        {
+            Status.EstimatedTimeRemaining = FTimespan::FromSeconds(
+                (Status.TotalAddresses - Stats.ScannedAddresses) / Status.ScanSpeedIPsPerSecond);
+        }
+        else
+        {
+            Status.EstimatedTimeRemaining = FTimespan::Zero();
+        }
+    }
 }
 
-void UPJLinkDiscoveryManager::ProcessDiscoveryResponse(const FString& DiscoveryID, const FString& IPAddress,
+void UPJLinkDiscoveryManager::ProcessDiscoveryResponse(const FString& DiscoveryID, uint32 IPv4,
     const FString& Response, int32 ResponseTimeMs)
 {
     // PJLink 응답인지 확인 및 로깅 추가
     if (!Response.StartsWith(TEXT("%")) && !Response.StartsWith(TEXT("PJLINK")))
     {
         PJLINK_LOG_VERBOSE(TEXT("Received invalid response from %s: '%s' (not a PJLink response)"),
-            *IPAddress, *Response);
+            *Uint32ToIPString(IPv4), *Response);
         return;
     }
 
     // 로그 추가
     PJLINK_LOG_VERBOSE(TEXT("Processing valid PJLink response from %s: '%s'"),
-        *IPAddress, *Response);
+        *Uint32ToIPString(IPv4), *Response);
 
-    // 검색 결과 생성
+    // 검색 결과 생성 (IP 문자열은 중복 검사를 통과한 뒤 AddDiscoveryResult 에서 채움)
     FPJLinkDiscoveryResult Result;
-    Result.IPAddress = IPAddress;
+    Result.IPv4 = IPv4;
     Result.Port = BroadcastPort;
     Result.DiscoveryTime = FDateTime::Now();
     Result.ResponseTimeMs = ResponseTimeMs;
 
-    // 응답에서 프로토콜 버전 및 장치 정보 파싱
-    if (Response.Contains(TEXT("=1")))
+    // 스캔 엔진이 보낸 조회 응답 파싱 (식별 정보는 보통 조회 단계가 따로 채움)
+    TArray<FString> ResponseLines;
+    Response.ParseIntoArrayLines(ResponseLines, false);
+
+    for (const FString& Line : ResponseLines)
     {
-        Result.DeviceClass = EPJLinkClass::Class1;
+        ApplyIdentityLine(Result, Line);
     }
-    else if (Response.Contains(TEXT("=2")))
+
+    // 인증 필요 여부 확인 (인증 챌린지가 있는지)
+    Result.bRequiresAuthentication = Response.Contains(TEXT("PJLINK 1"));
+
+    // 인증이 필요한 장치는 조회 단계로 넘어가지 않으므로 더 올 갱신이 없음
+    Result.bIdentityQueried = Result.bRequiresAuthentication || Response.Contains(TEXT("%1NAME="));
+
+    // 결과 저장
+    if (AddDiscoveryResult(DiscoveryID, Result))
     {
-        Result.DeviceClass = EPJLinkClass::Class2;
+        PJLINK_LOG_INFO(TEXT("Discovered PJLink device at %s (Response time: %dms)"),
+            *Uint32ToIPString(IPv4), ResponseTimeMs);
+
+        // 식별 정보가 이미 채워진 결과는 바로 변경 여부를 판단
+        if (Result.bIdentityQueried)
+        {
+            ReportDeviceChange(DiscoveryID, Result);
+        }
     }
+}
 
-    // 추가 정보 파싱 - 응답에서 모델 이름이나 제조사 정보 추출 시도
-    TArray<FString> ResponseLines;
-    Response.ParseIntoArrayLines(ResponseLines, false);
+void UPJLinkDiscoveryManager::ProcessSearchReply(const FString& DiscoveryID, uint32 SourceIPv4,
+    const FString& MacAddress, int32 ResponseTimeMs)
+{
+    // SRCH 에 응답하는 장치는 Class 2 (이름/모델은 연결 후 INF 조회로 채움)
+    FPJLinkDiscoveryResult Result;
+    Result.IPv4 = SourceIPv4;
+    Result.Port = BroadcastPort;
+    Result.MacAddress = MacAddress;
+    Result.DeviceClass = EPJLinkClass::Class2;
+    Result.DiscoveryTime = FDateTime::Now();
+    Result.ResponseTimeMs = ResponseTimeMs;
 
-    for (const FString& Line : ResponseLines)
+    if (AddDiscoveryResult(DiscoveryID, Result))
     {
-        // NAME 정보가 응답에 포함된 경우
-        if (Line.StartsWith(TEXT("%1NAME=")))
+        PJLINK_LOG_INFO(TEXT("Discovered Class 2 device at %s (MAC: %s, Response time: %dms)"),
+            *Uint32ToIPString(SourceIPv4), *MacAddress, ResponseTimeMs);
+
+        // 새 장치만 연결해서 이름/모델 조회 (검색 세션은 계속 응답을 받음)
+        TSharedPtr<FPJLinkDiscoveryEnricher, ESPMode::ThreadSafe> Enricher;
         {
-            Result.Name = Line.Mid(7).TrimEnd();
+            FScopeLock Lock(&DiscoveryLock);
+            Enricher = ActiveEnrichers.FindRef(DiscoveryID);
+        }
+        if (Enricher.IsValid())
+        {
+            Enricher->AddDevice(SourceIPv4);
+        }
+    }
+}
+
+bool UPJLinkDiscoveryManager::AddDiscoveryResult(const FString& DiscoveryID, const FPJLinkDiscoveryResult& Result)
+{
+    const uint64 EndpointKey = MakeEndpointKey(Result);
+    FPJLinkDiscoveryResult AddedResult = Result;
+
+    {
+        FScopeLock Lock(&DiscoveryLock);
+        FPJLinkDiscoveryStatus* Status = DiscoveryStatuses.Find(DiscoveryID);
+        FPJLinkDiscoveryResultSet* ResultSet = DiscoveryResults.Find(DiscoveryID);
+        if (!Status || !ResultSet)
+        {
+            return false;
         }
-        // INF1 (제조사) 정보가 포함된 경우
-        else if (Line.StartsWith(TEXT("%1INF1=")))
+
+        // 중복 체크 (같은 IP+포트, 또는 여러 주소로 응답한 같은 MAC) - 해시 조회라 결과 수와 무관
+        if (ResultSet->EndpointIndices.Contains(EndpointKey)
+            || (!Result.MacAddress.IsEmpty() && ResultSet->MacAddresses.Contains(Result.MacAddress)))
         {
-            Result.Manufacturer = Line.Mid(7).TrimEnd();
+            return false;
         }
-        // INF2 (모델명) 정보가 포함된 경우
-        else if (Line.StartsWith(TEXT("%1INF2=")))
+
+        ResultSet->EndpointIndices.Add(EndpointKey, ResultSet->Results.Num());
+        if (!Result.MacAddress.IsEmpty())
         {
-            Result.ModelName = Line.Mid(7).TrimEnd();
+            ResultSet->MacAddresses.Add(Result.MacAddress);
         }
+
+        // 표시용 문자열은 새 장치로 확인된 결과에만 만듦
+        AddedResult.IPv4 = static_cast<uint32>(EndpointKey >> 16);
+        if (AddedResult.IPAddress.IsEmpty())
+        {
+            AddedResult.IPAddress = Uint32ToIPString(AddedResult.IPv4);
+        }
+        ResultSet->Results.Add(AddedResult);
+        Status->DiscoveredDevices++;
+
+        // 진행 상황 업데이트
+        UpdateDiscoveryProgress(DiscoveryID, Status->ScannedAddresses, Status->DiscoveredDevices);
     }
 
-    // 인증 필요 여부 확인 (인증 챌린지가 있는지)
-    Result.bRequiresAuthentication = Response.Contains(TEXT("PJLINK 1"));
+    // 새 장치 발견 이벤트 발생
+    if (OnDeviceDiscovered.IsBound())
+    {
+        OnDeviceDiscovered.Broadcast(AddedResult);
+    }
+    return true;
+}
 
-    // 결과 저장
-    bool bNewDevice = false;
+TSharedPtr<FPJLinkDiscoveryEnricher, ESPMode::ThreadSafe> UPJLinkDiscoveryManager::StartEnricher(const FString& DiscoveryID)
+{
+    FPJLinkEnrichmentSettings Settings;
+    Settings.Port = static_cast<uint16>(FMath::Clamp(BroadcastPort, 1, 65535));
+    Settings.MaxConcurrent = MaxConcurrentEnrichments;
+    Settings.ConnectTimeoutSeconds = PerAddressWaitTimeMs / 1000.0;
+
+    TWeakObjectPtr<UPJLinkDiscoveryManager> WeakThis(this);
+    FPJLinkEnrichmentCallbacks Callbacks;
+
+    // 결과 갱신과 완료 판단은 게임 스레드에서 처리
+    Callbacks.OnDeviceEnriched = [WeakThis, DiscoveryID](uint32 IPv4, const FString& Response, bool bComplete)
     {
-        FScopeLock Lock(&DiscoveryLock);
-        if (DiscoveryStatuses.Contains(DiscoveryID) && DiscoveryResults.Contains(DiscoveryID))
+        AsyncTask(ENamedThreads::GameThread, [WeakThis, DiscoveryID, IPv4, Response, bComplete]()
         {
-            // 중복 체크
-            bool bDuplicate = false;
-            for (const FPJLinkDiscoveryResult& ExistingResult : DiscoveryResults[DiscoveryID])
+            if (UPJLinkDiscoveryManager* StrongThis = WeakThis.Get())
             {
-                if (ExistingResult.IPAddress == IPAddress)
-                {
-                    bDuplicate = true;
-                    break;
-                }
+                StrongThis->ProcessEnrichment(DiscoveryID, IPv4, Response, bComplete);
             }
+        });
+    };
 
-            if (!bDuplicate)
+    Callbacks.OnIdle = [WeakThis, DiscoveryID]()
+    {
+        AsyncTask(ENamedThreads::GameThread, [WeakThis, DiscoveryID]()
+        {
+            if (UPJLinkDiscoveryManager* StrongThis = WeakThis.Get())
             {
-                DiscoveryResults[DiscoveryID].Add(Result);
-                DiscoveryStatuses[DiscoveryID].DiscoveredDevices++;
-                bNewDevice = true;
-
-                // 진행 상황 업데이트
-                UpdateDiscoveryProgress(DiscoveryID, DiscoveryStatuses[DiscoveryID].ScannedAddresses,
-                    DiscoveryStatuses[DiscoveryID].DiscoveredDevices);
+                StrongThis->HandleEnrichmentIdle(DiscoveryID);
             }
+        });
+    };
+
+    TSharedPtr<FPJLinkDiscoveryEnricher, ESPMode::ThreadSafe> Enricher =
+        MakeShared<FPJLinkDiscoveryEnricher, ESPMode::ThreadSafe>(Settings, MoveTemp(Callbacks));
+
+    {
+        FScopeLock Lock(&DiscoveryLock);
+        ActiveEnrichers.Add(DiscoveryID, Enricher);
+    }
+    return Enricher;
+}
+
+void UPJLinkDiscoveryManager::StopEnricher(const FString& DiscoveryID)
+{
+    TSharedPtr<FPJLinkDiscoveryEnricher, ESPMode::ThreadSafe> Enricher;
+    {
+        FScopeLock Lock(&DiscoveryLock);
+        ActiveEnrichers.RemoveAndCopyValue(DiscoveryID, Enricher);
+    }
+
+    if (!Enricher.IsValid())
+    {
+        return;
+    }
+
+    // 연결의 수신자 락을 잡으므로 검색 락 밖에서 중지
+    Enricher->Cancel();
+
+    const FPJLinkEnrichmentStats Stats = Enricher->GetStats();
+    {
+        FScopeLock Lock(&DiscoveryLock);
+        if (FPJLinkDiscoveryStatus* Status = DiscoveryStatuses.Find(DiscoveryID))
+        {
+            ApplyEnrichmentStats(*Status, Stats);
+            DirtyProgress.Add(DiscoveryID);
         }
     }
 
-    // 새 장치 발견 이벤트 발생
-    if (bNewDevice && OnDeviceDiscovered.IsBound())
+    if (Stats.EnrichedDevices + Stats.FailedDevices > 0)
+    {
+        PJLINK_LOG_INFO(TEXT("Identity queries for %s: %d enriched, %d failed, %.1f devices/s, %.0fms average, %d peak concurrent"),
+            *DiscoveryID, Stats.EnrichedDevices, Stats.FailedDevices, Stats.DevicesPerSecond,
+            Stats.AverageLatencyMs, Stats.PeakActiveDevices);
+    }
+}
+
+void UPJLinkDiscoveryManager::ProcessEnrichment(const FString& DiscoveryID, uint32 IPv4, const FString& Response, bool bComplete)
+{
+    FPJLinkDiscoveryResult UpdatedResult;
     {
-        OnDeviceDiscovered.Broadcast(Result);
+        FScopeLock Lock(&DiscoveryLock);
+        FPJLinkDiscoveryResultSet* ResultSet = DiscoveryResults.Find(DiscoveryID);
+        const int32* ResultIndex = ResultSet ? ResultSet->EndpointIndices.Find(MakeEndpointKey(IPv4, BroadcastPort)) : nullptr;
+        if (!ResultIndex)
+        {
+            return;
+        }
+
+        FPJLinkDiscoveryResult& Result = ResultSet->Results[*ResultIndex];
+
+        TArray<FString> ResponseLines;
+        Response.ParseIntoArrayLines(ResponseLines, false);
+        for (const FString& Line : ResponseLines)
+        {
+            ApplyIdentityLine(Result, Line);
+        }
+
+        // 응답을 다 받지 못했어도 조회는 끝났으므로 더 이상 갱신되지 않음
+        Result.bIdentityQueried = true;
+        UpdatedResult = Result;
+    }
+
+    PJLINK_LOG_VERBOSE(TEXT("Identity of %s: Name='%s', Manufacturer='%s', Model='%s'%s"),
+        *UpdatedResult.IPAddress, *UpdatedResult.Name, *UpdatedResult.Manufacturer, *UpdatedResult.ModelName,
+        bComplete ? TEXT("") : TEXT(" (incomplete)"));
+
+    // 같은 장치의 갱신된 결과 전달 (수신자는 IP+포트로 기존 항목을 찾아 교체)
+    if (OnDeviceDiscovered.IsBound())
+    {
+        OnDeviceDiscovered.Broadcast(UpdatedResult);
     }
 
-    PJLINK_LOG_INFO(TEXT("Discovered PJLink device at %s (Response time: %dms)"), *IPAddress, ResponseTimeMs);
+    ReportDeviceChange(DiscoveryID, UpdatedResult);
+}
+
+void UPJLinkDiscoveryManager::HandleEnrichmentIdle(const FString& DiscoveryID)
+{
+    if (PendingCompletions.Remove(DiscoveryID) > 0)
+    {
+        CompleteDiscovery(DiscoveryID, true);
+    }
+}
+
+void UPJLinkDiscoveryManager::CompleteDiscoveryWhenEnriched(const FString& DiscoveryID)
+{
+    TSharedPtr<FPJLinkDiscoveryEnricher, ESPMode::ThreadSafe> Enricher;
+    {
+        FScopeLock Lock(&DiscoveryLock);
+        Enricher = ActiveEnrichers.FindRef(DiscoveryID);
+    }
+
+    // 조회가 남아 있으면 대기열이 빌 때 HandleEnrichmentIdle 에서 완료
+    if (Enricher.IsValid() && !Enricher->IsIdle())
+    {
+        PendingCompletions.Add(DiscoveryID);
+        PJLINK_LOG_VERBOSE(TEXT("Sweep finished for %s, waiting for identity queries"), *DiscoveryID);
+        return;
+    }
+
+    CompleteDiscovery(DiscoveryID, true);
+}
+
+void UPJLinkDiscoveryManager::ApplyEnrichmentStats(FPJLinkDiscoveryStatus& Status, const FPJLinkEnrichmentStats& Stats)
+{
+    Status.EnrichedDevices = Stats.EnrichedDevices;
+    Status.PendingEnrichments = Stats.QueuedDevices + Stats.ActiveDevices;
+    Status.EnrichmentDevicesPerSecond = static_cast<float>(Stats.DevicesPerSecond);
+    Status.EnrichmentLatencyMs = static_cast<float>(Stats.AverageLatencyMs);
+}
+
+bool UPJLinkDiscoveryManager::ApplyIdentityLine(FPJLinkDiscoveryResult& Result, const FString& Line)
+{
+    // 인증 챌린지 (새로 연결한 장치의 인사말)
+    if (Line.StartsWith(TEXT("PJLINK 1")))
+    {
+        Result.bRequiresAuthentication = true;
+        return true;
+    }
+
+    if (Line.Len() < 7 || Line[0] != TEXT('%') || Line[6] != TEXT('='))
+    {
+        return false;
+    }
+
+    // 지원하지 않는 조회는 "=ERRn" 으로 응답하므로 건너뜀
+    const FString Value = Line.Mid(7).TrimEnd();
+    if (Value.StartsWith(TEXT("ERR"), ESearchCase::CaseSensitive))
+    {
+        return false;
+    }
+
+    // 프로토콜 클래스
+    if (Line.StartsWith(TEXT("%1CLSS=")))
+    {
+        Result.DeviceClass = Value == TEXT("2") ? EPJLinkClass::Class2 : EPJLinkClass::Class1;
+    }
+    // 프로젝터 이름
+    else if (Line.StartsWith(TEXT("%1NAME=")))
+    {
+        Result.Name = Value;
+    }
+    // INF1 (제조사)
+    else if (Line.StartsWith(TEXT("%1INF1=")))
+    {
+        Result.Manufacturer = Value;
+    }
+    // INF2 (모델명)
+    else if (Line.StartsWith(TEXT("%1INF2=")))
+    {
+        Result.ModelName = Value;
+    }
+    // INFO (기타 정보)
+    else if (Line.StartsWith(TEXT("%1INFO=")))
+    {
+        Result.OtherInfo = Value;
+    }
+    else
+    {
+        return false;
+    }
+    return true;
 }
 
 void UPJLinkDiscoveryManager::CompleteDiscovery(const FString& DiscoveryID, bool bSuccess)
 {
+    // 늦게 온 응답이 결과에 섞이지 않도록 스캔/검색 세션부터 중지
+    StopScan(DiscoveryID);
+    StopBroadcastSearch(DiscoveryID);
+    StopEnricher(DiscoveryID);
+
+    // 완료 이벤트보다 먼저 마지막 진행 상황을 게시
+    if (IsInGameThread())
+    {
+        PendingCompletions.Remove(DiscoveryID);
+        PublishProgress();
+    }
+
     TArray<FPJLinkDiscoveryResult> Results;
     bool bAlreadyComplete = false;
 
@@ -1338,12 +1677,18 @@ void UPJLinkDiscoveryManager::CompleteDiscovery(const FString& DiscoveryID, bool
         }
 
         // 결과 가져오기
-        if (DiscoveryResults.Contains(DiscoveryID))
+        if (const FPJLinkDiscoveryResultSet* ResultSet = DiscoveryResults.Find(DiscoveryID))
         {
-            Results = DiscoveryResults[DiscoveryID];
+            Results = ResultSet->Results;
         }
     }
 
+    // 알려진 호스트 색인 갱신과 사라진 장치 보고는 완료 이벤트보다 먼저
+    if (!bAlreadyComplete && IsInGameThread())
+    {
+        FinishRescan(DiscoveryID, bSuccess, Results);
+    }
+
     // 완료 이벤트 발생 (이미 완료된 작업이 아닌 경우에만)
     if (!bAlreadyComplete && OnDiscoveryCompleted.IsBound())
     {
@@ -1360,43 +1705,138 @@ void UPJLinkDiscoveryManager::CompleteDiscovery(const FString& DiscoveryID, bool
 
 void UPJLinkDiscoveryManager::UpdateDiscoveryProgress(const FString& DiscoveryID, int32 ScannedAddresses, int32 DiscoveredDevices)
 {
-    bool bShouldBroadcast = false;
-    FPJLinkDiscoveryStatus StatusCopy;
-
     {
         FScopeLock Lock(&DiscoveryLock);
-        if (!DiscoveryStatuses.Contains(DiscoveryID))
+        FPJLinkDiscoveryStatus* Status = DiscoveryStatuses.Find(DiscoveryID);
+        if (!Status)
         {
             return;
         }
 
-        FPJLinkDiscoveryStatus& Status = DiscoveryStatuses[DiscoveryID];
-
         // 진행률 계산
-        if (Status.TotalAddresses > 0)
+        if (Status->TotalAddresses > 0)
         {
-            Status.ProgressPercentage = static_cast<float>(ScannedAddresses) / static_cast<float>(Status.TotalAddresses) * 100.0f;
+            Status->ProgressPercentage = static_cast<float>(ScannedAddresses) / static_cast<float>(Status->TotalAddresses) * 100.0f;
         }
 
-        // 필요할 때만 업데이트 이벤트 발생 (예: 5% 단위)
-        static const float ProgressStep = 5.0f;
-        static TMap<FString, float> LastReportedProgress;
+        // 이벤트는 게시 티커가 모아서 발생
+        DirtyProgress.Add(DiscoveryID);
+    }
+
+    // 스캔 없이 진행되는 브로드캐스트 검색도 게시되도록 티커 시작
+    if (IsInGameThread())
+    {
+        StartProgressPublisher();
+    }
+}
+
+void UPJLinkDiscoveryManager::StartProgressPublisher()
+{
+    check(IsInGameThread());
+    if (!ProgressTickerHandle.IsValid())
+    {
+        ProgressTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+            FTickerDelegate::CreateUObject(this, &UPJLinkDiscoveryManager::TickProgressPublisher),
+            ProgressPublishIntervalSeconds);
+    }
+}
+
+bool UPJLinkDiscoveryManager::TickProgressPublisher(float DeltaTime)
+{
+    PublishProgress();
+
+    FScopeLock Lock(&DiscoveryLock);
+    if (ActiveScans.Num() == 0 && ActiveEnrichers.Num() == 0 && DirtyProgress.Num() == 0)
+    {
+        // false 를 반환하면 티커가 제거됨
+        ProgressTickerHandle.Reset();
+        return false;
+    }
+    return true;
+}
+
+void UPJLinkDiscoveryManager::PublishProgress()
+{
+    TArray<FPJLinkDiscoveryStatus> ProgressUpdates;
+    TArray<FString> AddressUpdates;
 
-        float LastProgress = LastReportedProgress.Contains(DiscoveryID) ? LastReportedProgress[DiscoveryID] : -1.0f;
-        float CurrentProgress = Status.ProgressPercentage;
+    {
+        FScopeLock Lock(&DiscoveryLock);
 
-        if (LastProgress < 0.0f || CurrentProgress - LastProgress >= ProgressStep || CurrentProgress >= 100.0f)
+        // 엔진 통계는 원자 카운터라 스캔을 멈추지 않고 읽을 수 있음
+        for (const auto& Pair : ActiveScans)
         {
-            LastReportedProgress.Add(DiscoveryID, CurrentProgress);
-            bShouldBroadcast = true;
-            StatusCopy = Status;
+            FPJLinkDiscoveryStatus* Status = DiscoveryStatuses.Find(Pair.Key);
+            if (!Status || Status->bIsComplete)
+            {
+                continue;
+            }
+
+            const FPJLinkScanStats Stats = Pair.Value->GetStats();
+            if (Stats.ScannedAddresses == Status->ScannedAddresses)
+            {
+                continue;
+            }
+
+            ApplyScanStats(*Status, Stats);
+            if (Stats.LastCompletedIPv4 != 0)
+            {
+                // 주기 사이에 끝난 주소들은 마지막 하나로 합쳐 보고
+                const FString CurrentAddress = Uint32ToIPString(Stats.LastCompletedIPv4);
+                if (CurrentAddress != Status->CurrentScanningIP)
+                {
+                    Status->CurrentScanningIP = CurrentAddress;
+                    AddressUpdates.Add(CurrentAddress);
+                }
+            }
+            DirtyProgress.Add(Pair.Key);
+        }
+
+        // 식별 정보 조회는 스윕과 따로 진행되므로 통계도 따로 반영
+        for (const auto& Pair : ActiveEnrichers)
+        {
+            FPJLinkDiscoveryStatus* Status = DiscoveryStatuses.Find(Pair.Key);
+            if (!Status || Status->bIsComplete)
+            {
+                continue;
+            }
+
+            const FPJLinkEnrichmentStats Stats = Pair.Value->GetStats();
+            if (Stats.EnrichedDevices == Status->EnrichedDevices
+                && Stats.QueuedDevices + Stats.ActiveDevices == Status->PendingEnrichments)
+            {
+                continue;
+            }
+
+            ApplyEnrichmentStats(*Status, Stats);
+            DirtyProgress.Add(Pair.Key);
+        }
+
+        for (const FString& DiscoveryID : DirtyProgress)
+        {
+            if (const FPJLinkDiscoveryStatus* Status = DiscoveryStatuses.Find(DiscoveryID))
+            {
+                ProgressUpdates.Add(*Status);
+            }
         }
+        DirtyProgress.Reset();
     }
 
     // 이벤트 발생 (임계 영역 밖에서)
-    if (bShouldBroadcast && OnDiscoveryProgress.IsBound())
+    if (OnCurrentScanAddressChanged.IsBound())
     {
-        OnDiscoveryProgress.Broadcast(StatusCopy);
+        for (const FString& Address : AddressUpdates)
+        {
+            OnCurrentScanAddressChanged.Broadcast(Address);
+        }
+    }
+
+    if (OnDiscoveryProgress.IsBound())
+    {
+        for (const FPJLinkDiscoveryStatus& Status : ProgressUpdates)
+        {
+            OnDiscoveryProgress.Broadcast(Status);
+        }
     }
 }
 
@@ -1411,28 +1851,53 @@ FString UPJLinkDiscoveryManager::GenerateDiscoveryID() const
     return FGuid::NewGuid().ToString();
 }
 
+uint64 UPJLinkDiscoveryManager::MakeEndpointKey(const FPJLinkDiscoveryResult& Result)
+{
+    return MakeEndpointKey(Result.IPv4 != 0 ? Result.IPv4 : IPStringToUint32(Result.IPAddress), Result.Port);
+}
+
+uint64 UPJLinkDiscoveryManager::MakeEndpointKey(uint32 IPv4, int32 Port)
+{
+    return (static_cast<uint64>(IPv4) << 16) | static_cast<uint16>(Port);
+}
+
 uint32 UPJLinkDiscoveryManager::IPStringToUint32(const FString& IPString)
 {
+    // 임시 문자열/배열 없이 한 번에 파싱 ("a.b.c.d" 형식만 허용)
     uint32 Result = 0;
+    uint32 Octet = 0;
+    int32 OctetDigits = 0;
+    int32 OctetCount = 0;
 
-    TArray<FString> Octets;
-    if (IPString.ParseIntoArray(Octets, TEXT("."), true) != 4)
+    for (const TCHAR Char : IPString)
     {
-        return 0;
-    }
-
-    for (int32 i = 0; i < 4; i++)
-    {
-        int32 Octet = FCString::Atoi(*Octets[i]);
-        if (Octet < 0 || Octet > 255)
+        if (Char >= TEXT('0') && Char <= TEXT('9'))
+        {
+            Octet = Octet * 10 + static_cast<uint32>(Char - TEXT('0'));
+            if (++OctetDigits > 3 || Octet > 255)
+            {
+                return 0;
+            }
+        }
+        else if (Char == TEXT('.') && OctetDigits > 0 && OctetCount < 3)
+        {
+            Result = (Result << 8) | Octet;
+            Octet = 0;
+            OctetDigits = 0;
+            OctetCount++;
+        }
+        else
         {
             return 0;
         }
+    }
 
-        Result = (Result << 8) | static_cast<uint32>(Octet);
+    if (OctetDigits == 0 || OctetCount != 3)
+    {
+        return 0;
     }
 
-    return Result;
+    return (Result << 8) | Octet;
 }
 
 FString UPJLinkDiscoveryManager::Uint32ToIPString(uint32 IPAddress)
@@ -79,6 +79,16 @@ void UPJLinkDiscoveryWidget::SetupDiscovery()
     DiscoveryManager->OnDiscoveryProgress.AddDynamic(this, &UPJLinkDiscoveryWidget::OnDiscoveryProgressUpdated);
 }
 
+void UPJLinkDiscoveryWidget::RebuildDiscoveredEndpointIndices()
+{
+    DiscoveredEndpointIndices.Reset();
+    DiscoveredEndpointIndices.Reserve(DiscoveryResults.Num());
+    for (int32 ResultIndex = 0; ResultIndex < DiscoveryResults.Num(); ++ResultIndex)
+    {
+        DiscoveredEndpointIndices.Add(UPJLinkDiscoveryManager::MakeEndpointKey(DiscoveryResults[ResultIndex]), ResultIndex);
+    }
+}
+
 void UPJLinkDiscoveryWidget::StartBroadcastSearch(float TimeoutSeconds)
 {
     if (!DiscoveryManager)
@@ -88,6 +98,7 @@ void UPJLinkDiscoveryWidget::StartBroadcastSearch(float TimeoutSeconds)
 
     // 기존 결과 초기화
     DiscoveryResults.Empty();
+    DiscoveredEndpointIndices.Empty();
     PrepareResultsUpdate(GetFilteredAndSortedResults());
 
     // 상태 업데이트
@@ -117,6 +128,7 @@ void UPJLinkDiscoveryWidget::StartRangeSearch(const FString& StartIP, const FStr
 
     // 기존 결과 초기화
     DiscoveryResults.Empty();
+    DiscoveredEndpointIndices.Empty();
     PrepareResultsUpdate(GetFilteredAndSortedResults());
 
     // 상태 업데이트
@@ -146,6 +158,7 @@ void UPJLinkDiscoveryWidget::StartSubnetSearch(const FString& SubnetAddress, con
 
     // 기존 결과 초기화
     DiscoveryResults.Empty();
+    DiscoveredEndpointIndices.Empty();
     PrepareResultsUpdate(GetFilteredAndSortedResults());
 
     // 상태 업데이트
@@ -305,6 +318,7 @@ void UPJLinkDiscoveryWidget::OnDiscoveryCompleted(const TArray<FPJLinkDiscoveryR
 {
     // 결과 저장
     DiscoveryResults = DiscoveredDevices;
+    RebuildDiscoveredEndpointIndices();
 
     // UI 업데이트
     PrepareResultsUpdate(GetFilteredAndSortedResults());
@@ -346,86 +360,88 @@ void UPJLinkDiscoveryWidget::OnDiscoveryCompleted(const TArray<FPJLinkDiscoveryR
 // PJLinkDiscoveryWidget.cpp 파일에서 OnDeviceDiscovered 함수를 찾아 수정
 void UPJLinkDiscoveryWidget::OnDeviceDiscovered(const FPJLinkDiscoveryResult& DiscoveredDevice)
 {
-    // 이미 같은 장치가 있는지 확인
-    bool bAlreadyExists = false;
-    for (const FPJLinkDiscoveryResult& ExistingDevice : DiscoveryResults)
+    // 이미 같은 장치가 있는지 확인 (IPv4+포트 키 해시 조회)
+    const uint64 EndpointKey = UPJLinkDiscoveryManager::MakeEndpointKey(DiscoveredDevice);
+    if (const int32* ExistingIndex = DiscoveredEndpointIndices.Find(EndpointKey))
     {
-        if (ExistingDevice.IPAddress == DiscoveredDevice.IPAddress)
-        {
-            bAlreadyExists = true;
-            break;
-        }
+        // 식별 정보 조회가 끝나 갱신된 결과 - 같은 자리에서 교체
+        DiscoveryResults[*ExistingIndex] = DiscoveredDevice;
+        RequestResultsUIUpdate();
+        return;
     }
 
-    // 새 장치인 경우에만 추가
-    if (!bAlreadyExists)
-    {
-        // 결과 추가
-        DiscoveryResults.Add(DiscoveredDevice);
+    DiscoveredEndpointIndices.Add(EndpointKey, DiscoveryResults.Num());
 
-        // 마지막 발견 장치 인덱스 업데이트
-        LastDiscoveredDeviceIndex = DiscoveryResults.Num() - 1;
+    // 결과 추가
+    DiscoveryResults.Add(DiscoveredDevice);
 
-        // 장치 발견 효과 재생
-        DeviceFoundEffectTime = DeviceFoundEffectDuration;
-        ShowDeviceFoundEffect(LastDiscoveredDeviceIndex, FoundColor);
+    // 마지막 발견 장치 인덱스 업데이트
+    LastDiscoveredDeviceIndex = DiscoveryResults.Num() - 1;
 
-        // 애니메이션 스피드 조정 (발견 장치 수에 따라 증가)
-        AnimationSpeedMultiplier = FMath::Min(3.0f, 1.0f + (DiscoveryResults.Num() * 0.1f));
+    // 장치 발견 효과 재생
+    DeviceFoundEffectTime = DeviceFoundEffectDuration;
+    ShowDeviceFoundEffect(LastDiscoveredDeviceIndex, FoundColor);
 
-        // 장치 발견 시 애니메이션 효과 재생
-        if (bEnableAdvancedAnimations)
-        {
-            PlayDeviceFoundEffect(LastDiscoveredDeviceIndex);
-        }
+    // 애니메이션 스피드 조정 (발견 장치 수에 따라 증가)
+    AnimationSpeedMultiplier = FMath::Min(3.0f, 1.0f + (DiscoveryResults.Num() * 0.1f));
 
-        // 장치 발견 메시지 표시 - 이름이 있으면 이름과 IP, 없으면 IP만 표시
-        FString DeviceName = DiscoveredDevice.Name.IsEmpty() ? DiscoveredDevice.IPAddress :
-            FString::Printf(TEXT("%s (%s)"), *DiscoveredDevice.Name, *DiscoveredDevice.IPAddress);
+    // 장치 발견 시 애니메이션 효과 재생
+    if (bEnableAdvancedAnimations)
+    {
+        PlayDeviceFoundEffect(LastDiscoveredDeviceIndex);
+    }
 
-        ShowInfoMessage(FString::Printf(TEXT("장치를 발견했습니다: %s"), *DeviceName));
+    // 장치 발견 메시지 표시 - 이름이 있으면 이름과 IP, 없으면 IP만 표시
+    FString DeviceName = DiscoveredDevice.Name.IsEmpty() ? DiscoveredDevice.IPAddress :
+        FString::Printf(TEXT("%s (%s)"), *DiscoveredDevice.Name, *DiscoveredDevice.IPAddress);
 
-        // 발견된 장치 수에 따라 애니메이션 업데이트
-        if (bEnableProgressAnimation)
-        {
-            UpdateProgressAnimation(DiscoveryResults.Num() * 5.0f); // 장치 발견 시 애니메이션 속도 증가
+    ShowInfoMessage(FString::Printf(TEXT("장치를 발견했습니다: %s"), *DeviceName));
 
-            // 애니메이션 속도 계수 업데이트
-            AnimationSpeedMultiplier = FMath::Min(3.0f, 1.0f + (DiscoveryResults.Num() * 0.1f));
-        }
+    // 발견된 장치 수에 따라 애니메이션 업데이트
+    if (bEnableProgressAnimation)
+    {
+        UpdateProgressAnimation(DiscoveryResults.Num() * 5.0f); // 장치 발견 시 애니메이션 속도 증가
 
-        // UI 업데이트 최적화 - 너무 자주 업데이트하지 않도록 조절
-        float CurrentTime = GetWorld()->GetTimeSeconds();
-        if (CurrentTime - LastUIUpdateTime >= UIUpdateInterval)
-        {
-            // 충분한 시간이 경과했으면 즉시 UI 업데이트
-            PrepareResultsUpdate(GetFilteredAndSortedResults());
-            LastUIUpdateTime = CurrentTime;
-            bPendingUIUpdate = false;
+        // 애니메이션 속도 계수 업데이트
+        AnimationSpeedMultiplier = FMath::Min(3.0f, 1.0f + (DiscoveryResults.Num() * 0.1f));
+    }
 
-            // 타이머 취소
-            if (UWorld* World = GetWorld())
-            {
-                World->GetTimerManager().ClearTimer(UIUpdateTimerHandle);
-            }
-        }
-        else
+    RequestResultsUIUpdate();
+}
+
+void UPJLinkDiscoveryWidget::RequestResultsUIUpdate()
+{
+    // UI 업데이트 최적화 - 너무 자주 업데이트하지 않도록 조절
+    float CurrentTime = GetWorld()->GetTimeSeconds();
+    if (CurrentTime - LastUIUpdateTime >= UIUpdateInterval)
+    {
+        // 충분한 시간이 경과했으면 즉시 UI 업데이트
+        PrepareResultsUpdate(GetFilteredAndSortedResults());
+        LastUIUpdateTime = CurrentTime;
+        bPendingUIUpdate = false;
+
+        // 타이머 취소
+        if (UWorld* World = GetWorld())
         {
-            // 그렇지 않으면 업데이트 예약
-            bPendingUIUpdate = true;
+            World->GetTimerManager().ClearTimer(UIUpdateTimerHandle);
+        }
+    }
+    else
+    {
+        // 그렇지 않으면 업데이트 예약
+        bPendingUIUpdate = true;
 
-            // 이미 타이머가 활성화되어 있지 않다면 타이머 설정
-            if (UWorld* World = GetWorld())
+        // 이미 타이머가 활성화되어 있지 않다면 타이머 설정
+        if (UWorld* World = GetWorld())
+        {
+            if (!World->GetTimerManager().IsTimerActive(UIUpdateTimerHandle))
             {
-                if (!World->GetTimerManager().IsTimerActive(UIUpdateTimerHandle))
-                {
-                    World->GetTimerManager().SetTimer(
-                        UIUpdateTimerHandle,
-                        this,
-                        &UPJLinkDiscoveryWidget::PerformDeferredUIUpdate,
-                        UIUpdateInterval - (CurrentTime - LastUIUpdateTime),
-                        false);
-                }
+                World->GetTimerManager().SetTimer(
+                    UIUpdateTimerHandle,
+                    this,
+                    &UPJLinkDiscoveryWidget::PerformDeferredUIUpdate,
+                    UIUpdateInterval - (CurrentTime - LastUIUpdateTime),
+                    false);
             }
         }
     }
@@ -706,8 +722,10 @@ bool UPJLinkDiscoveryWidget::LoadCachedResults()
 
         Result.ResponseTimeMs = ResultObj->GetNumberField(TEXT("ResponseTimeMs"));
 
+        Result.IPv4 = UPJLinkDiscoveryManager::IPStringToUint32(Result.IPAddress);
         DiscoveryResults.Add(Result);
     }
+    RebuildDiscoveredEndpointIndices();
 
     PrepareResultsUpdate(GetFilteredAndSortedResults());  // 변경된 코드
 
@@ -1025,9 +1043,9 @@ TArray<FPJLinkDiscoveryResult> UPJLinkDiscoveryWidget::GetFilteredAndSortedResul
     switch (CurrentSortOption)
     {
     case EPJLinkDiscoverySortOption::ByIPAddress:
-        // IP 주소 기준 정렬
+        // IP 주소 기준 정렬 (문자열 비교 대신 숫자 키로 비교해 10.0.0.9 < 10.0.0.10)
         FilteredResults.Sort([](const FPJLinkDiscoveryResult& A, const FPJLinkDiscoveryResult& B) {
-            return A.IPAddress < B.IPAddress;
+            return UPJLinkDiscoveryManager::MakeEndpointKey(A) < UPJLinkDiscoveryManager::MakeEndpointKey(B);
             });
         break;
 
@@ -0,0 +1,226 @@
+﻿// PJLinkEventDrainScheduler.cpp
+#include "PJLinkEventDrainScheduler.h"
+#include "PJLinkNetworkManager.h"
+#include "PJLinkLog.h"
+#include "Misc/ScopeLock.h"
+
+FPJLinkEventDrainScheduler* FPJLinkEventDrainScheduler::Instance = nullptr;
+FCriticalSection FPJLinkEventDrainScheduler::InstanceLock;
+
+FPJLinkEventDrainScheduler& FPJLinkEventDrainScheduler::Get()
+{
+    FScopeLock Lock(&InstanceLock);
+    if (!Instance)
+    {
+        Instance = new FPJLinkEventDrainScheduler();
+    }
+    return *Instance;
+}
+
+void FPJLinkEventDrainScheduler::Shutdown()
+{
+    FPJLinkEventDrainScheduler* SchedulerToDelete = nullptr;
+    {
+        FScopeLock Lock(&InstanceLock);
+        SchedulerToDelete = Instance;
+        Instance = nullptr;
+    }
+
+    delete SchedulerToDelete;
+}
+
+FPJLinkEventDrainScheduler::FPJLinkEventDrainScheduler()
+    : NextManagerIndex(0)
+    , FrameNumber(0)
+    , FrameDrainSeconds(0.0)
+    , FrameBudgetMicroseconds(1000.0f)
+    , bDraining(false)
+{
+}
+
+FPJLinkEventDrainScheduler::~FPJLinkEventDrainScheduler()
+{
+    if (TickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+        TickerHandle.Reset();
+    }
+
+    for (UPJLinkNetworkManager* Manager : PendingManagers)
+    {
+        if (Manager)
+        {
+            Manager->bEventDrainPending = false;
+        }
+    }
+    PendingManagers.Reset();
+}
+
+void FPJLinkEventDrainScheduler::Schedule(UPJLinkNetworkManager* Manager)
+{
+    check(IsInGameThread());
+
+    if (!Manager || !IsValid(Manager))
+    {
+        return;
+    }
+
+    if (!Manager->bEventDrainPending)
+    {
+        Manager->bEventDrainPending = true;
+        PendingManagers.Add(Manager);
+    }
+
+    // 대리자 안에서 예약되면 진행 중인 처리가 목록 끝까지 돌면서 함께 처리함
+    if (bDraining)
+    {
+        return;
+    }
+
+    DrainFrame();
+
+    // 남은 이벤트는 다음 프레임에 이어서 처리
+    if (PendingManagers.Num() > 0 && !TickerHandle.IsValid())
+    {
+        TickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+            FTickerDelegate::CreateRaw(this, &FPJLinkEventDrainScheduler::Tick));
+    }
+}
+
+void FPJLinkEventDrainScheduler::Remove(UPJLinkNetworkManager* Manager)
+{
+    if (!Manager || !Manager->bEventDrainPending)
+    {
+        return;
+    }
+    Manager->bEventDrainPending = false;
+
+    const int32 Index = PendingManagers.Find(Manager);
+    if (Index == INDEX_NONE)
+    {
+        return;
+    }
+
+    // 처리 중이면 위치가 어긋나지 않도록 비워만 두고 처리가 끝난 뒤 정리
+    if (bDraining)
+    {
+        PendingManagers[Index] = nullptr;
+        return;
+    }
+
+    PendingManagers.RemoveAt(Index);
+    if (NextManagerIndex > Index)
+    {
+        --NextManagerIndex;
+    }
+}
+
+void FPJLinkEventDrainScheduler::SetFrameBudgetMicroseconds(float InBudgetMicroseconds)
+{
+    FrameBudgetMicroseconds = FMath::Max(InBudgetMicroseconds, 10.0f);
+}
+
+int32 FPJLinkEventDrainScheduler::GetNumPendingManagers() const
+{
+    int32 NumPending = 0;
+    for (const UPJLinkNetworkManager* Manager : PendingManagers)
+    {
+        NumPending += Manager ? 1 : 0;
+    }
+    return NumPending;
+}
+
+double FPJLinkEventDrainScheduler::DrainFrame()
+{
+    if (bDraining)
+    {
+        return 0.0;
+    }
+
+    // 예산은 프레임 단위 - 같은 프레임에 여러 번 불려도 합산
+    if (FrameNumber != GFrameCounter)
+    {
+        FrameNumber = GFrameCounter;
+        FrameDrainSeconds = 0.0;
+    }
+
+    const double BudgetSeconds = FrameBudgetMicroseconds * 1.0e-6;
+    const double StartDrainSeconds = FrameDrainSeconds;
+
+    bDraining = true;
+    while (PendingManagers.Num() > 0 && FrameDrainSeconds < BudgetSeconds)
+    {
+        if (NextManagerIndex >= PendingManagers.Num())
+        {
+            NextManagerIndex = 0;
+        }
+
+        UPJLinkNetworkManager* Manager = PendingManagers[NextManagerIndex];
+        if (Manager && !Manager->EventQueue.IsEmpty())
+        {
+            // 남은 예산을 대기 매니저 수로 나눠 한 매니저가 다른 매니저의 몫까지 쓰지 않게 함
+            // (이벤트가 적은 매니저가 남긴 몫은 다음 매니저에게 돌아감)
+            const double SliceSeconds = (BudgetSeconds - FrameDrainSeconds) / PendingManagers.Num();
+            FrameDrainSeconds += Manager->DrainEvents(SliceSeconds);
+
+            // 대리자 안에서 제거되었을 수 있으므로 목록에서 다시 읽음
+            Manager = PendingManagers[NextManagerIndex];
+        }
+
+        if (Manager && !Manager->EventQueue.IsEmpty())
+        {
+            ++NextManagerIndex;
+            continue;
+        }
+
+        if (Manager)
+        {
+            Manager->bEventDrainPending = false;
+        }
+        PendingManagers.RemoveAt(NextManagerIndex);
+    }
+    bDraining = false;
+
+    CompactPendingManagers();
+
+    // 이번 처리에서 예산을 다 써서 미룬 매니저 기록 (이미 예산이 떨어진 뒤의 예약은 세지 않음)
+    const double DrainedSeconds = FrameDrainSeconds - StartDrainSeconds;
+    if (DrainedSeconds > 0.0)
+    {
+        for (UPJLinkNetworkManager* Manager : PendingManagers)
+        {
+            Manager->EventStats.DeferredDrains++;
+            Manager->EventStats.LastDeferredEvents = Manager->EventQueue.Num();
+        }
+    }
+
+    return DrainedSeconds;
+}
+
+void FPJLinkEventDrainScheduler::CompactPendingManagers()
+{
+    for (int32 Index = PendingManagers.Num() - 1; Index >= 0; --Index)
+    {
+        if (!PendingManagers[Index])
+        {
+            PendingManagers.RemoveAt(Index);
+            if (NextManagerIndex > Index)
+            {
+                --NextManagerIndex;
+            }
+        }
+    }
+}
+
+bool FPJLinkEventDrainScheduler::Tick(float DeltaTime)
+{
+    DrainFrame();
+
+    if (PendingManagers.Num() == 0)
+    {
+        // false 를 반환하면 티커가 제거됨
+        TickerHandle.Reset();
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,118 @@
+﻿// PJLinkEventQueue.cpp
+#include "PJLinkEventQueue.h"
+
+void FPJLinkEvent::Reset()
+{
+    Type = EPJLinkEventType::Response;
+    Command = EPJLinkCommand::POWR;
+    Status = EPJLinkResponseStatus::Unknown;
+    ErrorCode = EPJLinkErrorCode::None;
+    bFromProjector = false;
+    bIsSending = false;
+    bIsConnected = false;
+    SequenceId = 0;
+    RoundTripSeconds = 0.0;
+    EnqueueCycles = 0;
+
+    // Reset 은 할당된 버퍼를 유지함
+    Text.Reset();
+    Label.Reset();
+}
+
+FPJLinkEventQueue::FPJLinkEventQueue()
+    : NumQueued(0)
+    , NumPooled(0)
+{
+    FNode* Stub = new FNode();
+    Head.store(Stub);
+    Tail = Stub;
+}
+
+FPJLinkEventQueue::~FPJLinkEventQueue()
+{
+    // 더미 노드부터 남은 이벤트까지 모두 해제
+    FNode* Node = Tail;
+    while (Node)
+    {
+        FNode* Next = Node->Next.load(std::memory_order_acquire);
+        delete Node;
+        Node = Next;
+    }
+
+    while (FNode* Pooled = FreeNodes.Pop())
+    {
+        delete Pooled;
+    }
+}
+
+FPJLinkEventQueue::FNode* FPJLinkEventQueue::AllocateNode()
+{
+    FNode* Node = FreeNodes.Pop();
+    if (Node)
+    {
+        NumPooled.fetch_sub(1, std::memory_order_relaxed);
+        Node->Event.Reset();
+    }
+    else
+    {
+        Node = new FNode();
+    }
+
+    Node->Next.store(nullptr, std::memory_order_relaxed);
+    return Node;
+}
+
+void FPJLinkEventQueue::ReleaseNode(FNode* Node)
+{
+    if (NumPooled.load(std::memory_order_relaxed) >= MaxPooledNodes)
+    {
+        delete Node;
+        return;
+    }
+
+    NumPooled.fetch_add(1, std::memory_order_relaxed);
+    FreeNodes.Push(Node);
+}
+
+void FPJLinkEventQueue::Push(FNode* Node)
+{
+    Node->Event.EnqueueCycles = FPlatformTime::Cycles64();
+    NumQueued.fetch_add(1, std::memory_order_relaxed);
+
+    // 마지막 노드를 교환한 뒤 이전 노드에 연결 (생산자끼리 락 없음)
+    FNode* Previous = Head.exchange(Node, std::memory_order_acq_rel);
+    Previous->Next.store(Node, std::memory_order_release);
+}
+
+FPJLinkEventQueue::FNode* FPJLinkEventQueue::PopNode()
+{
+    // 생산자가 교환과 연결 사이에 있으면 잠시 비어 보이지만,
+    // 그 생산자가 이후에 처리를 다시 예약하므로 이벤트가 누락되지 않음
+    FNode* Next = Tail->Next.load(std::memory_order_acquire);
+    if (!Next)
+    {
+        return nullptr;
+    }
+
+    FNode* OldStub = Tail;
+    Tail = Next;
+    ReleaseNode(OldStub);
+
+    NumQueued.fetch_sub(1, std::memory_order_relaxed);
+    return Next;
+}
+
+int32 FPJLinkEventQueue::Discard()
+{
+    int32 NumDiscarded = 0;
+    while (PopNode())
+    {
+        ++NumDiscarded;
+    }
+    return NumDiscarded;
+}
+
+bool FPJLinkEventQueue::IsEmpty() const
+{
+    return Tail->Next.load(std::memory_order_acquire) == nullptr;
+}
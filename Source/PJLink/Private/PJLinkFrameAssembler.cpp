@@ -0,0 +1,124 @@
+﻿// PJLinkFrameAssembler.cpp
+#include "PJLinkFrameAssembler.h"
+#include "PJLinkLog.h"
+
+static_assert((FPJLinkFrameAssembler::Capacity & (FPJLinkFrameAssembler::Capacity - 1)) == 0, "Capacity must be a power of two");
+static_assert(FPJLinkFrameAssembler::MaxFrameLength < FPJLinkFrameAssembler::Capacity, "Frames must fit in the ring");
+
+FPJLinkFrameAssembler::FPJLinkFrameAssembler()
+    : Head(0)
+    , Tail(0)
+    , ScanPos(0)
+    , bDiscarding(false)
+    , NumDiscardedFrames(0)
+{
+}
+
+int32 FPJLinkFrameAssembler::Write(const uint8* Data, int32 Length)
+{
+    const int32 Free = Capacity - GetPendingBytes();
+    const int32 ToCopy = FMath::Min(Length, Free);
+    if (ToCopy <= 0)
+    {
+        return 0;
+    }
+
+    // 링 끝까지 한 번, 넘치면 앞부분에 한 번 복사
+    const uint32 Start = Tail & IndexMask;
+    const int32 FirstPart = FMath::Min<int32>(ToCopy, Capacity - Start);
+    FMemory::Memcpy(Ring + Start, Data, FirstPart);
+    if (FirstPart < ToCopy)
+    {
+        FMemory::Memcpy(Ring, Data + FirstPart, ToCopy - FirstPart);
+    }
+
+    Tail += ToCopy;
+    return ToCopy;
+}
+
+bool FPJLinkFrameAssembler::NextFrame(const uint8*& OutFrame, int32& OutLength)
+{
+    for (;;)
+    {
+        // 종료 문자 검색
+        uint32 End = ScanPos;
+        while (End != Tail && Ring[End & IndexMask] != '\r')
+        {
+            ++End;
+        }
+
+        if (End == Tail)
+        {
+            ScanPos = Tail;
+
+            // 종료 문자 없이 최대 길이를 넘으면 버림 - 링이 가득 차 멈추는 일을 막음
+            if (GetPendingBytes() > MaxFrameLength)
+            {
+                if (!bDiscarding)
+                {
+                    ++NumDiscardedFrames;
+                    PJLINK_LOG_WARNING(TEXT("Discarding over-long PJLink frame (> %d bytes)"), MaxFrameLength);
+                }
+                bDiscarding = true;
+                Head = Tail;
+            }
+            return false;
+        }
+
+        uint32 FrameStart = Head;
+        Head = End + 1;
+        ScanPos = Head;
+
+        if (bDiscarding)
+        {
+            // 버리던 프레임의 나머지
+            bDiscarding = false;
+            continue;
+        }
+
+        // CRLF 를 보내는 장비 대응 - 앞쪽 LF 무시
+        while (FrameStart != End && Ring[FrameStart & IndexMask] == '\n')
+        {
+            ++FrameStart;
+        }
+
+        const int32 Length = static_cast<int32>(End - FrameStart);
+        if (Length == 0)
+        {
+            continue;
+        }
+
+        if (Length > MaxFrameLength)
+        {
+            ++NumDiscardedFrames;
+            PJLINK_LOG_WARNING(TEXT("Discarding over-long PJLink frame (%d bytes)"), Length);
+            continue;
+        }
+
+        const uint32 StartIndex = FrameStart & IndexMask;
+        if (StartIndex + Length <= static_cast<uint32>(Capacity))
+        {
+            // 연속된 프레임은 링 버퍼를 그대로 가리킴
+            OutFrame = Ring + StartIndex;
+        }
+        else
+        {
+            // 링 끝에서 감긴 프레임만 임시 버퍼로 이어 붙임
+            const int32 FirstPart = Capacity - StartIndex;
+            FMemory::Memcpy(Scratch, Ring + StartIndex, FirstPart);
+            FMemory::Memcpy(Scratch + FirstPart, Ring, Length - FirstPart);
+            OutFrame = Scratch;
+        }
+
+        OutLength = Length;
+        return true;
+    }
+}
+
+void FPJLinkFrameAssembler::Reset()
+{
+    Head = 0;
+    Tail = 0;
+    ScanPos = 0;
+    bDiscarding = false;
+}
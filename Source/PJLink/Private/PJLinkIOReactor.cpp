@@ -0,0 +1,621 @@
+﻿// PJLinkIOReactor.cpp
+#include "PJLinkIOReactor.h"
+#include "PJLinkTimingWheel.h"
+#include "PJLinkLog.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/PlatformMisc.h"
+#include "HAL/PlatformTime.h"
+#include "Containers/Queue.h"
+#include "Misc/ScopeLock.h"
+
+using namespace PJLinkSocketPlatform;
+
+FPJLinkIOReactor* FPJLinkIOReactor::Instance = nullptr;
+FCriticalSection FPJLinkIOReactor::InstanceLock;
+int32 FPJLinkIOReactor::DesiredThreadCount = 0;
+
+// 현재 스레드가 실행 중인 샤드 (I/O 스레드가 아니면 nullptr)
+static thread_local FPJLinkReactorShard* GCurrentReactorShard = nullptr;
+
+/**
+ * 리액터 I/O 스레드 하나와 그 스레드가 감시하는 소켓 집합
+ */
+class FPJLinkReactorShard : public FRunnable
+{
+public:
+    explicit FPJLinkReactorShard(int32 InShardIndex)
+        : ShardIndex(InShardIndex)
+        , WakeSocket(InvalidSocket)
+        , WakePort(0)
+        , bStopping(false)
+        , bWakePending(false)
+        , NumRegistered(0)
+        , NumTimers(0)
+        , bPollSetDirty(true)
+        , TimerWheel(TimerTickSeconds, FPlatformTime::Seconds())
+        , Thread(nullptr)
+    {
+        // 다른 스레드가 poll 을 깨우기 위한 루프백 UDP 소켓
+        WakeSocket = CreateUdpSocket();
+        if (WakeSocket != InvalidSocket && Bind(WakeSocket, LoopbackIPv4, 0))
+        {
+            WakePort = GetBoundPort(WakeSocket);
+        }
+        else
+        {
+            PJLINK_LOG_ERROR(TEXT("Reactor shard %d failed to create wakeup socket"), ShardIndex);
+        }
+
+        Thread = FRunnableThread::Create(this, *FString::Printf(TEXT("PJLinkIOReactor%d"), ShardIndex),
+            0, TPri_AboveNormal);
+    }
+
+    virtual ~FPJLinkReactorShard()
+    {
+        if (Thread)
+        {
+            Thread->Kill(true);
+            delete Thread;
+            Thread = nullptr;
+        }
+
+        // 남은 등록 소켓 정리
+        for (const FRegistration& Registration : Registrations)
+        {
+            if (Registration.bCloseOnRemove)
+            {
+                Close(Registration.Socket);
+            }
+        }
+        Registrations.Empty();
+
+        FPendingOp Op;
+        while (PendingOps.Dequeue(Op))
+        {
+            if (Op.Type == EOpType::Unregister && Op.bCloseSocket)
+            {
+                Close(Op.Socket);
+            }
+        }
+
+        Close(WakeSocket);
+    }
+
+    // FRunnable 인터페이스
+    virtual uint32 Run() override
+    {
+        GCurrentReactorShard = this;
+
+        while (!bStopping.load(std::memory_order_acquire))
+        {
+            ApplyPendingOps();
+
+            if (bPollSetDirty)
+            {
+                RebuildPollSet();
+            }
+
+            const int32 ReadyCount = Poll(PollEntries.GetData(), PollEntries.Num(), GetPollTimeoutMs());
+
+            // 마감된 타이머 호출 (poll 결과와 무관하게 매 루프)
+            if (TimerWheel.Num() > 0)
+            {
+                TimerWheel.Advance(FPlatformTime::Seconds());
+                NumTimers.store(TimerWheel.Num(), std::memory_order_relaxed);
+            }
+
+            if (ReadyCount < 0)
+            {
+                PJLINK_LOG_ERROR(TEXT("Reactor shard %d poll failed: %d"), ShardIndex, GetLastErrorCode());
+                FPlatformProcess::Sleep(0.01f);
+                continue;
+            }
+
+            if (ReadyCount == 0)
+            {
+                continue;
+            }
+
+            // 0번 항목은 깨우기 소켓
+            if (PollEntries[0].Returned & EPollFlags::Readable)
+            {
+                DrainWakeSocket();
+            }
+
+            DispatchEvents();
+        }
+
+        GCurrentReactorShard = nullptr;
+        return 0;
+    }
+
+    virtual void Stop() override
+    {
+        bStopping.store(true, std::memory_order_release);
+        Wake();
+    }
+
+    void Register(FNativeSocket Socket, const FPJLinkIOHandlerRef& Handler, uint8 Interest)
+    {
+        FPendingOp Op;
+        Op.Type = EOpType::Register;
+        Op.Socket = Socket;
+        Op.Handler = Handler;
+        Op.Interest = Interest;
+        PendingOps.Enqueue(MoveTemp(Op));
+        Wake();
+    }
+
+    void SetInterest(FNativeSocket Socket, uint8 Interest)
+    {
+        // I/O 스레드 자신의 요청은 즉시 반영 (송신 완료 후 쓰기 관심 해제 등)
+        // 대기열에 남아 있는 다른 스레드의 이전 요청은 다음 루프에서 그 뒤에 적용됨
+        if (GCurrentReactorShard == this)
+        {
+            if (const int32* Index = SocketToIndex.Find(Socket))
+            {
+                Registrations[*Index].Interest = Interest;
+                bPollSetDirty = true;
+            }
+            return;
+        }
+
+        FPendingOp Op;
+        Op.Type = EOpType::SetInterest;
+        Op.Socket = Socket;
+        Op.Interest = Interest;
+        PendingOps.Enqueue(MoveTemp(Op));
+        Wake();
+    }
+
+    void Unregister(FNativeSocket Socket, bool bCloseSocket)
+    {
+        FPendingOp Op;
+        Op.Type = EOpType::Unregister;
+        Op.Socket = Socket;
+        Op.bCloseSocket = bCloseSocket;
+        PendingOps.Enqueue(MoveTemp(Op));
+        Wake();
+    }
+
+    void ScheduleTimer(FPJLinkTimerId TimerId, double DeadlineSeconds, TUniqueFunction<void()>&& Callback)
+    {
+        // I/O 스레드 자신의 요청은 바로 휠에 넣음 (응답 처리 중 재예약 등)
+        if (GCurrentReactorShard == this)
+        {
+            TimerWheel.Schedule(TimerId, DeadlineSeconds, MoveTemp(Callback));
+            NumTimers.store(TimerWheel.Num(), std::memory_order_relaxed);
+            return;
+        }
+
+        FPendingOp Op;
+        Op.Type = EOpType::ScheduleTimer;
+        Op.TimerId = TimerId;
+        Op.Deadline = DeadlineSeconds;
+        Op.TimerCallback = MoveTemp(Callback);
+        PendingOps.Enqueue(MoveTemp(Op));
+        Wake();
+    }
+
+    void CancelTimer(FPJLinkTimerId TimerId)
+    {
+        if (GCurrentReactorShard == this)
+        {
+            TimerWheel.Cancel(TimerId);
+            NumTimers.store(TimerWheel.Num(), std::memory_order_relaxed);
+            return;
+        }
+
+        FPendingOp Op;
+        Op.Type = EOpType::CancelTimer;
+        Op.TimerId = TimerId;
+        PendingOps.Enqueue(MoveTemp(Op));
+        Wake();
+    }
+
+    int32 GetNumRegistered() const
+    {
+        return NumRegistered.load(std::memory_order_relaxed);
+    }
+
+    int32 GetNumTimers() const
+    {
+        return NumTimers.load(std::memory_order_relaxed);
+    }
+
+    bool IsCurrentThread() const
+    {
+        return GCurrentReactorShard == this;
+    }
+
+    int32 GetShardIndex() const
+    {
+        return ShardIndex;
+    }
+
+private:
+    enum class EOpType : uint8
+    {
+        Register,
+        SetInterest,
+        Unregister,
+        ScheduleTimer,
+        CancelTimer
+    };
+
+    struct FPendingOp
+    {
+        EOpType Type = EOpType::Register;
+        FNativeSocket Socket = InvalidSocket;
+        TSharedPtr<IPJLinkIOHandler, ESPMode::ThreadSafe> Handler;
+        uint8 Interest = EPollFlags::None;
+        bool bCloseSocket = false;
+        FPJLinkTimerId TimerId = 0;
+        double Deadline = 0.0;
+        TUniqueFunction<void()> TimerCallback;
+    };
+
+    struct FRegistration
+    {
+        FNativeSocket Socket = InvalidSocket;
+        TSharedPtr<IPJLinkIOHandler, ESPMode::ThreadSafe> Handler;
+        uint8 Interest = EPollFlags::None;
+        bool bCloseOnRemove = true;
+    };
+
+    // 관심 이벤트가 없을 때 poll 대기 상한
+    static constexpr int32 IdlePollTimeoutMs = 1000;
+
+    // 타이밍 휠 한 칸의 길이 (타임아웃 정밀도)
+    static constexpr double TimerTickSeconds = 0.01;
+
+    // 다음 타이머 마감까지만 대기
+    int32 GetPollTimeoutMs() const
+    {
+        const double SecondsUntilTimer = TimerWheel.GetSecondsUntilNextEvent(FPlatformTime::Seconds());
+        if (SecondsUntilTimer < 0.0)
+        {
+            return IdlePollTimeoutMs;
+        }
+        return FMath::Clamp(FMath::CeilToInt(SecondsUntilTimer * 1000.0), 0, IdlePollTimeoutMs);
+    }
+
+    void Wake()
+    {
+        // I/O 스레드 자신은 다음 루프에서 대기열을 처리하므로 깨울 필요 없음
+        if (GCurrentReactorShard == this)
+        {
+            return;
+        }
+
+        // 이미 깨우기 신호가 나가 있으면 중복 전송하지 않음
+        if (!bWakePending.exchange(true) && WakeSocket != InvalidSocket)
+        {
+            const uint8 Byte = 0;
+            int32 BytesSent = 0;
+            SendTo(WakeSocket, &Byte, 1, LoopbackIPv4, WakePort, BytesSent);
+        }
+    }
+
+    void DrainWakeSocket()
+    {
+        uint8 Buffer[64];
+        int32 BytesRead = 0;
+        uint32 FromIP = 0;
+        uint16 FromPort = 0;
+        while (RecvFrom(WakeSocket, Buffer, sizeof(Buffer), BytesRead, FromIP, FromPort) == EIOResult::Ok)
+        {
+        }
+
+        // 플래그를 대기열 처리 전에 내려야 그 사이에 들어온 작업이 다시 깨우기를 요청함
+        bWakePending.store(false);
+    }
+
+    void ApplyPendingOps()
+    {
+        FPendingOp Op;
+        while (PendingOps.Dequeue(Op))
+        {
+            switch (Op.Type)
+            {
+            case EOpType::Register:
+            {
+                if (SocketToIndex.Contains(Op.Socket))
+                {
+                    PJLINK_LOG_WARNING(TEXT("Reactor shard %d: socket already registered"), ShardIndex);
+                    break;
+                }
+
+                FRegistration& Registration = Registrations.AddDefaulted_GetRef();
+                Registration.Socket = Op.Socket;
+                Registration.Handler = MoveTemp(Op.Handler);
+                Registration.Interest = Op.Interest;
+                SocketToIndex.Add(Op.Socket, Registrations.Num() - 1);
+                NumRegistered.store(Registrations.Num(), std::memory_order_relaxed);
+                bPollSetDirty = true;
+                break;
+            }
+
+            case EOpType::SetInterest:
+                if (const int32* Index = SocketToIndex.Find(Op.Socket))
+                {
+                    Registrations[*Index].Interest = Op.Interest;
+                    bPollSetDirty = true;
+                }
+                break;
+
+            case EOpType::Unregister:
+                if (const int32* Index = SocketToIndex.Find(Op.Socket))
+                {
+                    RemoveRegistrationAt(*Index);
+                }
+
+                // poll 목록에서 빠진 뒤에 닫아야 핸들 재사용 문제가 없음
+                if (Op.bCloseSocket)
+                {
+                    Close(Op.Socket);
+                }
+                break;
+
+            case EOpType::ScheduleTimer:
+                TimerWheel.Schedule(Op.TimerId, Op.Deadline, MoveTemp(Op.TimerCallback));
+                NumTimers.store(TimerWheel.Num(), std::memory_order_relaxed);
+                break;
+
+            case EOpType::CancelTimer:
+                TimerWheel.Cancel(Op.TimerId);
+                NumTimers.store(TimerWheel.Num(), std::memory_order_relaxed);
+                break;
+            }
+        }
+    }
+
+    void RemoveRegistrationAt(int32 Index)
+    {
+        const int32 LastIndex = Registrations.Num() - 1;
+        SocketToIndex.Remove(Registrations[Index].Socket);
+
+        if (Index != LastIndex)
+        {
+            Registrations[Index] = MoveTemp(Registrations[LastIndex]);
+            SocketToIndex.Add(Registrations[Index].Socket, Index);
+        }
+
+        Registrations.RemoveAt(LastIndex, 1, EAllowShrinking::No);
+        NumRegistered.store(Registrations.Num(), std::memory_order_relaxed);
+        bPollSetDirty = true;
+    }
+
+    void RebuildPollSet()
+    {
+        PollEntries.SetNum(Registrations.Num() + 1, EAllowShrinking::No);
+
+        PollEntries[0].Socket = WakeSocket;
+        PollEntries[0].Requested = EPollFlags::Readable;
+
+        for (int32 Index = 0; Index < Registrations.Num(); ++Index)
+        {
+            FPollEntry& Entry = PollEntries[Index + 1];
+            Entry.Socket = Registrations[Index].Socket;
+            Entry.Requested = Registrations[Index].Interest;
+        }
+
+        bPollSetDirty = false;
+    }
+
+    void DispatchEvents()
+    {
+        // poll 결과는 PollEntries 기준이므로, 콜백 중 등록 변경이 있어도 안전하도록
+        // 처리기 참조를 복사한 뒤 호출함 (변경은 다음 루프에서 반영)
+        const int32 NumEntries = PollEntries.Num();
+        for (int32 EntryIndex = 1; EntryIndex < NumEntries; ++EntryIndex)
+        {
+            const uint8 Returned = PollEntries[EntryIndex].Returned;
+            if (Returned == EPollFlags::None)
+            {
+                continue;
+            }
+
+            const int32* RegistrationIndex = SocketToIndex.Find(PollEntries[EntryIndex].Socket);
+            if (!RegistrationIndex)
+            {
+                continue;
+            }
+
+            TSharedPtr<IPJLinkIOHandler, ESPMode::ThreadSafe> Handler = Registrations[*RegistrationIndex].Handler;
+            if (!Handler.IsValid())
+            {
+                continue;
+            }
+
+            if (Returned & EPollFlags::Error)
+            {
+                Handler->OnPollError();
+                continue;
+            }
+            if (Returned & EPollFlags::Writable)
+            {
+                Handler->OnWritable();
+            }
+            if (Returned & EPollFlags::Readable)
+            {
+                Handler->OnReadable();
+            }
+        }
+    }
+
+    int32 ShardIndex;
+
+    FNativeSocket WakeSocket;
+    uint16 WakePort;
+
+    TAtomic<bool> bStopping;
+    TAtomic<bool> bWakePending;
+    TAtomic<int32> NumRegistered;
+    TAtomic<int32> NumTimers;
+
+    // 다른 스레드에서 들어오는 등록 변경 요청
+    TQueue<FPendingOp, EQueueMode::Mpsc> PendingOps;
+
+    // 아래 항목은 I/O 스레드 전용
+    TArray<FRegistration> Registrations;
+    TMap<FNativeSocket, int32> SocketToIndex;
+    TArray<FPollEntry> PollEntries;
+    bool bPollSetDirty;
+    FPJLinkTimingWheel TimerWheel;
+
+    FRunnableThread* Thread;
+};
+
+FPJLinkIOReactor& FPJLinkIOReactor::Get()
+{
+    FScopeLock Lock(&InstanceLock);
+    if (!Instance)
+    {
+        int32 ThreadCount = DesiredThreadCount;
+        if (ThreadCount <= 0)
+        {
+            // 코어 4개당 I/O 스레드 1개 (최대 4개) - 소켓 수와는 무관
+            ThreadCount = FMath::Clamp(FPlatformMisc::NumberOfCores() / 4, 1, 4);
+        }
+        Instance = new FPJLinkIOReactor(ThreadCount);
+    }
+    return *Instance;
+}
+
+void FPJLinkIOReactor::Shutdown()
+{
+    FPJLinkIOReactor* ReactorToDelete = nullptr;
+    {
+        FScopeLock Lock(&InstanceLock);
+        ReactorToDelete = Instance;
+        Instance = nullptr;
+    }
+
+    // 락 밖에서 스레드 종료 (콜백 내부의 Get() 호출과 교착 방지)
+    delete ReactorToDelete;
+}
+
+void FPJLinkIOReactor::SetDesiredThreadCount(int32 ThreadCount)
+{
+    FScopeLock Lock(&InstanceLock);
+    if (Instance)
+    {
+        PJLINK_LOG_WARNING(TEXT("Reactor already running with %d threads; new thread count applies after restart"),
+            Instance->GetNumThreads());
+    }
+    DesiredThreadCount = ThreadCount;
+}
+
+FPJLinkIOReactor::FPJLinkIOReactor(int32 ThreadCount)
+    : NextTimerSerial(1)
+{
+    for (int32 Index = 0; Index < ThreadCount; ++Index)
+    {
+        Shards.Add(new FPJLinkReactorShard(Index));
+    }
+
+    PJLINK_LOG_INFO(TEXT("PJLink I/O reactor started with %d thread(s)"), ThreadCount);
+}
+
+FPJLinkIOReactor::~FPJLinkIOReactor()
+{
+    for (FPJLinkReactorShard* Shard : Shards)
+    {
+        delete Shard;
+    }
+    Shards.Empty();
+
+    PJLINK_LOG_INFO(TEXT("PJLink I/O reactor stopped"));
+}
+
+FPJLinkReactorShard& FPJLinkIOReactor::GetShard(FNativeSocket Socket) const
+{
+    // 같은 소켓은 항상 같은 샤드로 (등록/변경/해제 순서 보장)
+    // Windows 소켓 핸들은 4 단위로 증가하므로 하위 비트를 버리고 분배
+    const uint32 Slot = static_cast<uint32>(Socket >> 2);
+    return *Shards[Slot % static_cast<uint32>(Shards.Num())];
+}
+
+void FPJLinkIOReactor::Register(FNativeSocket Socket, const FPJLinkIOHandlerRef& Handler, uint8 Interest)
+{
+    GetShard(Socket).Register(Socket, Handler, Interest);
+}
+
+void FPJLinkIOReactor::SetInterest(FNativeSocket Socket, uint8 Interest)
+{
+    GetShard(Socket).SetInterest(Socket, Interest);
+}
+
+void FPJLinkIOReactor::Unregister(FNativeSocket Socket, bool bCloseSocket)
+{
+    GetShard(Socket).Unregister(Socket, bCloseSocket);
+}
+
+FPJLinkTimerId FPJLinkIOReactor::ScheduleTimer(double DelaySeconds, TUniqueFunction<void()>&& Callback)
+{
+    // I/O 스레드에서 예약하면 같은 스레드에서 호출되도록 현재 샤드에 넣고, 아니면 순서대로 분배
+    const uint64 Serial = NextTimerSerial.fetch_add(1, std::memory_order_relaxed);
+    FPJLinkReactorShard* Shard = GCurrentReactorShard;
+    if (!Shard)
+    {
+        Shard = Shards[static_cast<int32>(Serial % static_cast<uint64>(Shards.Num()))];
+    }
+    return ScheduleTimerOnShard(*Shard, Serial, DelaySeconds, MoveTemp(Callback));
+}
+
+FPJLinkTimerId FPJLinkIOReactor::ScheduleSocketTimer(FNativeSocket Socket, double DelaySeconds, TUniqueFunction<void()>&& Callback)
+{
+    const uint64 Serial = NextTimerSerial.fetch_add(1, std::memory_order_relaxed);
+    return ScheduleTimerOnShard(GetShard(Socket), Serial, DelaySeconds, MoveTemp(Callback));
+}
+
+FPJLinkTimerId FPJLinkIOReactor::ScheduleTimerOnShard(FPJLinkReactorShard& Shard, uint64 Serial,
+    double DelaySeconds, TUniqueFunction<void()>&& Callback)
+{
+    // 하위 8비트에 샤드 번호를 담아 취소 요청을 같은 샤드로 보냄
+    const FPJLinkTimerId TimerId = (Serial << TimerShardBits) | static_cast<uint64>(Shard.GetShardIndex());
+    const double Deadline = FPlatformTime::Seconds() + FMath::Max(DelaySeconds, 0.0);
+    Shard.ScheduleTimer(TimerId, Deadline, MoveTemp(Callback));
+    return TimerId;
+}
+
+void FPJLinkIOReactor::CancelTimer(FPJLinkTimerId TimerId)
+{
+    if (TimerId == 0)
+    {
+        return;
+    }
+
+    const int32 ShardIndex = static_cast<int32>(TimerId & ((1ull << TimerShardBits) - 1));
+    if (Shards.IsValidIndex(ShardIndex))
+    {
+        Shards[ShardIndex]->CancelTimer(TimerId);
+    }
+}
+
+int32 FPJLinkIOReactor::GetNumPendingTimers() const
+{
+    int32 Total = 0;
+    for (const FPJLinkReactorShard* Shard : Shards)
+    {
+        Total += Shard->GetNumTimers();
+    }
+    return Total;
+}
+
+int32 FPJLinkIOReactor::GetNumRegistered() const
+{
+    int32 Total = 0;
+    for (const FPJLinkReactorShard* Shard : Shards)
+    {
+        Total += Shard->GetNumRegistered();
+    }
+    return Total;
+}
+
+bool FPJLinkIOReactor::IsInIOThread()
+{
+    return GCurrentReactorShard != nullptr;
+}
@@ -0,0 +1,147 @@
+﻿// PJLinkIOThreadPool.cpp
+#include "PJLinkIOThreadPool.h"
+#include "PJLinkLog.h"
+#include "Misc/QueuedThreadPool.h"
+#include "Misc/IQueuedWork.h"
+#include "Misc/ScopeLock.h"
+#include "HAL/PlatformMisc.h"
+
+FPJLinkIOThreadPool* FPJLinkIOThreadPool::Instance = nullptr;
+FCriticalSection FPJLinkIOThreadPool::InstanceLock;
+int32 FPJLinkIOThreadPool::DesiredThreadCount = 0;
+EThreadPriority FPJLinkIOThreadPool::DesiredThreadPriority = TPri_Normal;
+
+/**
+ * 풀에 넣는 작업 하나 (실행 또는 취소 후 스스로 삭제)
+ */
+class FPJLinkIOThreadPool::FWork : public IQueuedWork
+{
+public:
+    FWork(FPJLinkIOThreadPool& InOwner, TUniqueFunction<void()>&& InWork, TUniqueFunction<void()>&& InOnAbandoned)
+        : Owner(InOwner)
+        , Work(MoveTemp(InWork))
+        , OnAbandoned(MoveTemp(InOnAbandoned))
+    {
+    }
+
+    virtual void DoThreadedWork() override
+    {
+        Owner.NumQueued--;
+        Owner.NumActive++;
+        Work();
+        Owner.NumActive--;
+        delete this;
+    }
+
+    virtual void Abandon() override
+    {
+        // 풀 종료 시 시작하지 못한 작업 - 종료를 붙잡지 않도록 작업은 건너뛰고 포기 통지만 호출
+        Owner.NumQueued--;
+        if (OnAbandoned)
+        {
+            OnAbandoned();
+        }
+        delete this;
+    }
+
+private:
+    FPJLinkIOThreadPool& Owner;
+    TUniqueFunction<void()> Work;
+    TUniqueFunction<void()> OnAbandoned;
+};
+
+FPJLinkIOThreadPool& FPJLinkIOThreadPool::Get()
+{
+    FScopeLock Lock(&InstanceLock);
+    if (!Instance)
+    {
+        int32 ThreadCount = DesiredThreadCount;
+        if (ThreadCount <= 0)
+        {
+            // 코어 4개당 1개 (최소 2개, 최대 4개) - 엔진 풀과 별개이므로 작게 유지
+            ThreadCount = FMath::Clamp(FPlatformMisc::NumberOfCores() / 4, 2, 4);
+        }
+        Instance = new FPJLinkIOThreadPool(FMath::Min(ThreadCount, MaxThreadCount), DesiredThreadPriority);
+    }
+    return *Instance;
+}
+
+void FPJLinkIOThreadPool::Shutdown()
+{
+    FPJLinkIOThreadPool* PoolToDelete = nullptr;
+    {
+        FScopeLock Lock(&InstanceLock);
+        PoolToDelete = Instance;
+        Instance = nullptr;
+    }
+
+    // 락 밖에서 스레드 종료 (작업 내부의 Get() 호출과 교착 방지)
+    delete PoolToDelete;
+}
+
+void FPJLinkIOThreadPool::SetDesiredThreadCount(int32 ThreadCount)
+{
+    FScopeLock Lock(&InstanceLock);
+    if (Instance)
+    {
+        PJLINK_LOG_WARNING(TEXT("I/O thread pool already running with %d threads; new thread count applies after restart"),
+            Instance->GetNumThreads());
+    }
+    DesiredThreadCount = ThreadCount;
+}
+
+void FPJLinkIOThreadPool::SetDesiredThreadPriority(EThreadPriority Priority)
+{
+    FScopeLock Lock(&InstanceLock);
+    if (Instance)
+    {
+        PJLINK_LOG_WARNING(TEXT("I/O thread pool already running; new priority applies after restart"));
+    }
+    DesiredThreadPriority = Priority;
+}
+
+FPJLinkIOThreadPool::FPJLinkIOThreadPool(int32 InNumThreads, EThreadPriority InPriority)
+    : Pool(nullptr)
+    , NumThreads(0)
+    , NumActive(0)
+    , NumQueued(0)
+{
+    Pool = FQueuedThreadPool::Allocate();
+    if (Pool->Create(InNumThreads, 128 * 1024, InPriority, TEXT("PJLinkIOPool")))
+    {
+        NumThreads = InNumThreads;
+        PJLINK_LOG_INFO(TEXT("PJLink I/O thread pool started with %d thread(s)"), NumThreads);
+    }
+    else
+    {
+        PJLINK_LOG_ERROR(TEXT("Failed to create PJLink I/O thread pool with %d thread(s)"), InNumThreads);
+        delete Pool;
+        Pool = nullptr;
+    }
+}
+
+FPJLinkIOThreadPool::~FPJLinkIOThreadPool()
+{
+    if (Pool)
+    {
+        // 큐에 남은 작업은 Abandon, 실행 중인 작업은 끝날 때까지 대기
+        Pool->Destroy();
+        delete Pool;
+        Pool = nullptr;
+    }
+
+    PJLINK_LOG_INFO(TEXT("PJLink I/O thread pool stopped"));
+}
+
+bool FPJLinkIOThreadPool::Launch(TUniqueFunction<void()>&& Work, TUniqueFunction<void()>&& OnAbandoned)
+{
+    if (!Pool)
+    {
+        PJLINK_LOG_ERROR(TEXT("PJLink I/O thread pool is not available"));
+        return false;
+    }
+
+    NumQueued++;
+    Pool->AddQueuedWork(new FWork(*this, MoveTemp(Work), MoveTemp(OnAbandoned)));
+    return true;
+}
@@ -0,0 +1,336 @@
+﻿// PJLinkKnownHostsIndex.cpp
+#include "PJLinkKnownHostsIndex.h"
+#include "PJLinkLog.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonWriter.h"
+#include "Misc/Paths.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFilemanager.h"
+
+FPJLinkKnownHostsIndex::FPJLinkKnownHostsIndex(const FString& InDirectory)
+    : Directory(InDirectory)
+    , bScannedDirectory(false)
+{
+}
+
+void FPJLinkKnownHostsIndex::FindHostsInRange(uint32 FirstIPv4, uint32 LastIPv4, int32 Port, TArray<FPJLinkKnownHost>& OutHosts)
+{
+    OutHosts.Reset();
+    if (LastIPv4 < FirstIPv4)
+    {
+        return;
+    }
+
+    ScanDirectory();
+
+    // 범위의 /24 를 하나씩 보지 않고 파일이 있거나 이미 읽은 /24 만 확인 (넓은 범위도 파일 수만큼만)
+    TSet<uint32> Candidates = StoredSubnets;
+    for (const auto& Pair : Subnets)
+    {
+        Candidates.Add(Pair.Key);
+    }
+
+    for (const uint32 Subnet : Candidates)
+    {
+        if (Subnet < (FirstIPv4 >> 8) || Subnet > (LastIPv4 >> 8))
+        {
+            continue;
+        }
+
+        for (const auto& Pair : GetSubnet(Subnet).Hosts)
+        {
+            const FPJLinkDiscoveryResult& Device = Pair.Value.Device;
+            if (Device.IPv4 >= FirstIPv4 && Device.IPv4 <= LastIPv4 && Device.Port == Port)
+            {
+                OutHosts.Add(Pair.Value);
+            }
+        }
+    }
+
+    OutHosts.Sort([](const FPJLinkKnownHost& A, const FPJLinkKnownHost& B)
+    {
+        return A.Device.IPv4 < B.Device.IPv4;
+    });
+}
+
+const FPJLinkKnownHost* FPJLinkKnownHostsIndex::FindHost(uint32 IPv4, int32 Port)
+{
+    ScanDirectory();
+    return GetSubnet(IPv4 >> 8).Hosts.Find(UPJLinkDiscoveryManager::MakeEndpointKey(IPv4, Port));
+}
+
+void FPJLinkKnownHostsIndex::RecordSeen(const FPJLinkDiscoveryResult& Result)
+{
+    const uint32 IPv4 = Result.IPv4 != 0 ? Result.IPv4 : UPJLinkDiscoveryManager::IPStringToUint32(Result.IPAddress);
+    if (IPv4 == 0)
+    {
+        return;
+    }
+
+    ScanDirectory();
+    FSubnetHosts& SubnetHosts = GetSubnet(IPv4 >> 8);
+    FPJLinkKnownHost& Host = SubnetHosts.Hosts.FindOrAdd(UPJLinkDiscoveryManager::MakeEndpointKey(IPv4, Result.Port));
+
+    // 이번에 조회하지 못한 식별 정보는 이전 값을 유지
+    const FPJLinkDiscoveryResult Previous = Host.Device;
+    Host.Device = Result;
+    Host.Device.IPv4 = IPv4;
+    Host.Device.IPAddress = UPJLinkDiscoveryManager::Uint32ToIPString(IPv4);
+    Host.Device.Name = Result.Name.IsEmpty() ? Previous.Name : Result.Name;
+    Host.Device.ModelName = Result.ModelName.IsEmpty() ? Previous.ModelName : Result.ModelName;
+    Host.Device.Manufacturer = Result.Manufacturer.IsEmpty() ? Previous.Manufacturer : Result.Manufacturer;
+    Host.Device.MacAddress = Result.MacAddress.IsEmpty() ? Previous.MacAddress : Result.MacAddress;
+    Host.Device.OtherInfo = Result.OtherInfo.IsEmpty() ? Previous.OtherInfo : Result.OtherInfo;
+    Host.MissedScans = 0;
+    SubnetHosts.bDirty = true;
+}
+
+bool FPJLinkKnownHostsIndex::RecordMissed(uint32 IPv4, int32 Port)
+{
+    ScanDirectory();
+    FSubnetHosts& SubnetHosts = GetSubnet(IPv4 >> 8);
+    const uint64 EndpointKey = UPJLinkDiscoveryManager::MakeEndpointKey(IPv4, Port);
+
+    FPJLinkKnownHost* Host = SubnetHosts.Hosts.Find(EndpointKey);
+    if (!Host)
+    {
+        return false;
+    }
+
+    SubnetHosts.bDirty = true;
+    if (++Host->MissedScans < MaxMissedScans)
+    {
+        return false;
+    }
+
+    SubnetHosts.Hosts.Remove(EndpointKey);
+    return true;
+}
+
+bool FPJLinkKnownHostsIndex::Save()
+{
+    bool bSuccess = true;
+    for (auto& Pair : Subnets)
+    {
+        if (!Pair.Value.bDirty)
+        {
+            continue;
+        }
+
+        if (SaveSubnet(Pair.Key, Pair.Value))
+        {
+            Pair.Value.bDirty = false;
+        }
+        else
+        {
+            bSuccess = false;
+        }
+    }
+    return bSuccess;
+}
+
+void FPJLinkKnownHostsIndex::Clear()
+{
+    ScanDirectory();
+
+    IFileManager& FileManager = IFileManager::Get();
+    for (const uint32 Subnet : StoredSubnets)
+    {
+        FileManager.Delete(*GetSubnetFilePath(Subnet), false, false, true);
+    }
+
+    StoredSubnets.Reset();
+    Subnets.Reset();
+}
+
+bool FPJLinkKnownHostsIndex::HasIdentityChanged(const FPJLinkDiscoveryResult& Known, const FPJLinkDiscoveryResult& Current)
+{
+    auto Differs = [](const FString& KnownValue, const FString& CurrentValue)
+    {
+        return !CurrentValue.IsEmpty() && !KnownValue.Equals(CurrentValue, ESearchCase::CaseSensitive);
+    };
+
+    return Differs(Known.Name, Current.Name)
+        || Differs(Known.ModelName, Current.ModelName)
+        || Differs(Known.Manufacturer, Current.Manufacturer)
+        || Differs(Known.MacAddress, Current.MacAddress)
+        || Known.bRequiresAuthentication != Current.bRequiresAuthentication
+        || (Current.bIdentityQueried && !Current.bRequiresAuthentication && Known.DeviceClass != Current.DeviceClass);
+}
+
+FPJLinkKnownHostsIndex::FSubnetHosts& FPJLinkKnownHostsIndex::GetSubnet(uint32 Subnet)
+{
+    if (FSubnetHosts* Existing = Subnets.Find(Subnet))
+    {
+        return *Existing;
+    }
+
+    FSubnetHosts& SubnetHosts = Subnets.Add(Subnet);
+    if (StoredSubnets.Contains(Subnet))
+    {
+        LoadSubnet(Subnet, SubnetHosts);
+    }
+    return SubnetHosts;
+}
+
+void FPJLinkKnownHostsIndex::ScanDirectory()
+{
+    if (bScannedDirectory)
+    {
+        return;
+    }
+    bScannedDirectory = true;
+
+    TArray<FString> FileNames;
+    IFileManager::Get().FindFiles(FileNames, *(Directory / TEXT("*.json")), true, false);
+
+    // "a.b.c.json" 형식만 /24 파일로 인정
+    for (const FString& FileName : FileNames)
+    {
+        TArray<FString> Octets;
+        FPaths::GetBaseFilename(FileName).ParseIntoArray(Octets, TEXT("."), false);
+        if (Octets.Num() != 3)
+        {
+            continue;
+        }
+
+        uint32 Subnet = 0;
+        bool bValid = true;
+        for (const FString& Octet : Octets)
+        {
+            const int32 Value = Octet.IsNumeric() ? FCString::Atoi(*Octet) : -1;
+            bValid &= Value >= 0 && Value <= 255;
+            Subnet = (Subnet << 8) | static_cast<uint32>(Value & 0xFF);
+        }
+
+        if (bValid)
+        {
+            StoredSubnets.Add(Subnet);
+        }
+    }
+}
+
+void FPJLinkKnownHostsIndex::LoadSubnet(uint32 Subnet, FSubnetHosts& OutHosts) const
+{
+    const FString FilePath = GetSubnetFilePath(Subnet);
+
+    FString JsonString;
+    if (!FFileHelper::LoadFileToString(JsonString, *FilePath))
+    {
+        PJLINK_LOG_WARNING(TEXT("Failed to read known hosts file: %s"), *FilePath);
+        return;
+    }
+
+    TSharedPtr<FJsonObject> RootObject;
+    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonString);
+    if (!FJsonSerializer::Deserialize(Reader, RootObject) || !RootObject.IsValid())
+    {
+        PJLINK_LOG_WARNING(TEXT("Failed to parse known hosts file: %s"), *FilePath);
+        return;
+    }
+
+    const TArray<TSharedPtr<FJsonValue>>* HostArray = nullptr;
+    if (!RootObject->TryGetArrayField(TEXT("Hosts"), HostArray))
+    {
+        return;
+    }
+
+    for (const TSharedPtr<FJsonValue>& JsonValue : *HostArray)
+    {
+        TSharedPtr<FJsonObject> HostObj = JsonValue->AsObject();
+        if (!HostObj.IsValid())
+        {
+            continue;
+        }
+
+        FPJLinkKnownHost Host;
+        FPJLinkDiscoveryResult& Device = Host.Device;
+        Device.IPAddress = HostObj->GetStringField(TEXT("IPAddress"));
+        Device.IPv4 = UPJLinkDiscoveryManager::IPStringToUint32(Device.IPAddress);
+        if ((Device.IPv4 >> 8) != Subnet)
+        {
+            continue;
+        }
+
+        Device.Port = HostObj->GetIntegerField(TEXT("Port"));
+        Device.Name = HostObj->GetStringField(TEXT("Name"));
+        Device.ModelName = HostObj->GetStringField(TEXT("ModelName"));
+        Device.Manufacturer = HostObj->GetStringField(TEXT("Manufacturer"));
+        Device.MacAddress = HostObj->GetStringField(TEXT("MacAddress"));
+        Device.OtherInfo = HostObj->GetStringField(TEXT("OtherInfo"));
+        Device.DeviceClass = static_cast<EPJLinkClass>(HostObj->GetIntegerField(TEXT("DeviceClass")));
+        Device.bRequiresAuthentication = HostObj->GetBoolField(TEXT("RequiresAuthentication"));
+        Device.bIdentityQueried = true;
+        Device.ResponseTimeMs = HostObj->GetIntegerField(TEXT("ResponseTimeMs"));
+        FDateTime::Parse(HostObj->GetStringField(TEXT("LastSeen")), Device.DiscoveryTime);
+        Host.MissedScans = HostObj->GetIntegerField(TEXT("MissedScans"));
+
+        OutHosts.Hosts.Add(UPJLinkDiscoveryManager::MakeEndpointKey(Device.IPv4, Device.Port), Host);
+    }
+}
+
+bool FPJLinkKnownHostsIndex::SaveSubnet(uint32 Subnet, const FSubnetHosts& Hosts)
+{
+    const FString FilePath = GetSubnetFilePath(Subnet);
+
+    // 남은 호스트가 없으면 다음 스캔에서 읽지 않도록 파일 삭제
+    if (Hosts.Hosts.Num() == 0)
+    {
+        IFileManager::Get().Delete(*FilePath, false, false, true);
+        StoredSubnets.Remove(Subnet);
+        return true;
+    }
+
+    TSharedPtr<FJsonObject> RootObject = MakeShareable(new FJsonObject);
+    RootObject->SetStringField(TEXT("Subnet"), UPJLinkDiscoveryManager::Uint32ToIPString(Subnet << 8) + TEXT("/24"));
+
+    TArray<TSharedPtr<FJsonValue>> HostArray;
+    for (const auto& Pair : Hosts.Hosts)
+    {
+        const FPJLinkKnownHost& Host = Pair.Value;
+        const FPJLinkDiscoveryResult& Device = Host.Device;
+
+        TSharedPtr<FJsonObject> HostObj = MakeShareable(new FJsonObject);
+        HostObj->SetStringField(TEXT("IPAddress"), UPJLinkDiscoveryManager::Uint32ToIPString(Device.IPv4));
+        HostObj->SetNumberField(TEXT("Port"), Device.Port);
+        HostObj->SetStringField(TEXT("Name"), Device.Name);
+        HostObj->SetStringField(TEXT("ModelName"), Device.ModelName);
+        HostObj->SetStringField(TEXT("Manufacturer"), Device.Manufacturer);
+        HostObj->SetStringField(TEXT("MacAddress"), Device.MacAddress);
+        HostObj->SetStringField(TEXT("OtherInfo"), Device.OtherInfo);
+        HostObj->SetNumberField(TEXT("DeviceClass"), static_cast<int32>(Device.DeviceClass));
+        HostObj->SetBoolField(TEXT("RequiresAuthentication"), Device.bRequiresAuthentication);
+        HostObj->SetNumberField(TEXT("ResponseTimeMs"), Device.ResponseTimeMs);
+        HostObj->SetStringField(TEXT("LastSeen"), Device.DiscoveryTime.ToString());
+        HostObj->SetNumberField(TEXT("MissedScans"), Host.MissedScans);
+
+        HostArray.Add(MakeShareable(new FJsonValueObject(HostObj)));
+    }
+    RootObject->SetArrayField(TEXT("Hosts"), HostArray);
+
+    FString OutputString;
+    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutputString);
+    FJsonSerializer::Serialize(RootObject.ToSharedRef(), Writer);
+
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    if (!PlatformFile.DirectoryExists(*Directory))
+    {
+        PlatformFile.CreateDirectoryTree(*Directory);
+    }
+
+    if (!FFileHelper::SaveStringToFile(OutputString, *FilePath))
+    {
+        PJLINK_LOG_ERROR(TEXT("Failed to save known hosts file: %s"), *FilePath);
+        return false;
+    }
+
+    StoredSubnets.Add(Subnet);
+    return true;
+}
+
+FString FPJLinkKnownHostsIndex::GetSubnetFilePath(uint32 Subnet) const
+{
+    return Directory / FString::Printf(TEXT("%u.%u.%u.json"), (Subnet >> 16) & 0xFF, (Subnet >> 8) & 0xFF, Subnet & 0xFF);
+}
@@ -8,6 +8,7 @@
 #include "Misc/FileHelper.h"
 #include "Misc/Paths.h"
 #include "HAL/PlatformFilemanager.h"
+#include "Async/Async.h"
 
 UPJLinkManagerComponent::UPJLinkManagerComponent()
 {
@@ -58,6 +59,15 @@ void UPJLinkManagerComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
         }
     }
 
+    // 네이티브 이벤트 전달 해제
+    for (const auto& ProjectorPair : ProjectorMap)
+    {
+        if (ProjectorPair.Value)
+        {
+            ProjectorPair.Value->GetNativeEvents().RemoveAll(this);
+        }
+    }
+
     // 맵 초기화
     ProjectorMap.Empty();
     GroupMap.Empty();
@@ -106,6 +116,9 @@ bool UPJLinkManagerComponent::AddProjector(UPJLinkComponent* ProjectorComponent)
     ProjectorComponent->OnConnectionChanged.AddDynamic(this, &UPJLinkManagerComponent::HandleConnectionChanged);
     ProjectorComponent->OnErrorStatus.AddDynamic(this, &UPJLinkManagerComponent::HandleErrorStatus);
 
+    // 네이티브 이벤트 전달
+    ProjectorComponent->GetNativeEvents().ForwardTo(NativeEvents, this);
+
     // 상태 맵에 초기 상태 추가
     FPJLinkProjectorStatus NewStatus(ProjectorID, ProjectorInfo);
     ProjectorStatusMap.Add(ProjectorID, NewStatus);
@@ -146,6 +159,9 @@ UPJLinkComponent* UPJLinkManagerComponent::AddProjectorByInfo(const FPJLinkProje
     // 맵에 추가
     ProjectorMap.Add(ProjectorID, NewComponent);
 
+    // 네이티브 이벤트 전달
+    NewComponent->GetNativeEvents().ForwardTo(NativeEvents, this);
+
     // 지정된 그룹에 추가
     if (!GroupName.IsEmpty())
     {
@@ -209,6 +225,9 @@ bool UPJLinkManagerComponent::AddProjector(UPJLinkComponent* ProjectorComponent)
     ProjectorComponent->OnConnectionChanged.AddDynamic(this, &UPJLinkManagerComponent::HandleConnectionChanged);
     ProjectorComponent->OnErrorStatus.AddDynamic(this, &UPJLinkManagerComponent::HandleErrorStatus);
 
+    // 네이티브 이벤트 전달
+    ProjectorComponent->GetNativeEvents().ForwardTo(NativeEvents, this);
+
     // 상태 맵에 초기 상태 추가
     FPJLinkProjectorStatus NewStatus(ProjectorID, ProjectorInfo);
     ProjectorStatusMap.Add(ProjectorID, NewStatus);
@@ -230,6 +249,15 @@ void UPJLinkManagerComponent::RemoveAllProjectors()
         GroupPair.Value.Empty();
     }
 
+    // 네이티브 이벤트 전달 해제
+    for (const auto& ProjectorPair : ProjectorMap)
+    {
+        if (ProjectorPair.Value)
+        {
+            ProjectorPair.Value->GetNativeEvents().RemoveAll(this);
+        }
+    }
+
     // 프로젝터 맵 비우기
     ProjectorMap.Empty();
 
@@ -525,18 +553,22 @@ FString UPJLinkManagerComponent::StartGroupCommand(const FString& GroupName, EPJ
             FString ProjectorID = GenerateProjectorID(ProjectorInfo);
             ProjectorIDs.Add(ProjectorID);
 
-            // 특별한 CONNECT 명령 처리
+            // 특별한 CONNECT 명령 처리 - 모든 프로젝터에 동시에 비동기 연결 시작
+            // 결과는 I/O 스레드에서 완료되므로 게임 스레드로 넘겨 집계
             if (Parameter == TEXT("CONNECT"))
             {
-                if (Projector->Connect())
-                {
-                    CommandResult.AddSuccess(ProjectorID);
-                    SuccessCount++;
-                }
-                else
+                TWeakObjectPtr<UPJLinkManagerComponent> WeakThis(this);
+                Projector->StartConnect().Next([WeakThis, CommandID, ProjectorID](bool bConnected)
                 {
-                    CommandResult.AddFailure(ProjectorID);
-                }
+                    AsyncTask(ENamedThreads::GameThread, [WeakThis, CommandID, ProjectorID, bConnected]()
+                    {
+                        if (UPJLinkManagerComponent* StrongThis = WeakThis.Get())
+                        {
+                            StrongThis->HandleConnectResult(CommandID, ProjectorID, bConnected);
+                        }
+                    });
+                });
+                SuccessCount++;
             }
             else if (ExecuteCommandOnProjector(Projector, Command, Parameter, CommandID))
             {
@@ -549,6 +581,10 @@ FString UPJLinkManagerComponent::StartGroupCommand(const FString& GroupName, EPJ
         }
     }
 
+    // 즉시 실패한 결과를 맵에 반영
+    // 비동기 연결 결과는 게임 스레드 태스크로 전달되므로 이 함수가 끝난 뒤에 집계됨
+    CommandResults.Add(CommandID, CommandResult);
+
     // 타임아웃 타이머 설정
     if (SuccessCount > 0 && !CommandResult.HasAllResponded())
     {
@@ -705,6 +741,46 @@ void UPJLinkManagerComponent::HandleCommandCompleted(UPJLinkComponent* Projector
     }
 }
 
+void UPJLinkManagerComponent::HandleConnectResult(const FString& CommandID, const FString& ProjectorID, bool bConnected)
+{
+    FPJLinkGroupCommandResult* Result = CommandResults.Find(CommandID);
+    if (!Result || Result->HasAllResponded() || Result->ProjectorResults.Contains(ProjectorID))
+    {
+        // 이미 타임아웃 처리되었거나 정리된 명령
+        return;
+    }
+
+    if (bConnected)
+    {
+        Result->AddSuccess(ProjectorID);
+    }
+    else
+    {
+        Result->AddFailure(ProjectorID);
+        PJLINK_LOG_WARNING(TEXT("Connect failed on projector: %s"), *ProjectorID);
+    }
+
+    // 모든 프로젝터가 응답했는지 확인
+    if (Result->HasAllResponded())
+    {
+        // 타이머 정리
+        if (UWorld* World = GetWorld())
+        {
+            if (CommandTimeoutHandles.Contains(CommandID))
+            {
+                World->GetTimerManager().ClearTimer(CommandTimeoutHandles[CommandID]);
+                CommandTimeoutHandles.Remove(CommandID);
+            }
+        }
+
+        // 명령 완료 이벤트 발생
+        OnGroupCommandCompleted.Broadcast(*Result);
+
+        PJLINK_LOG_INFO(TEXT("Group connect completed: %s - Success: %d/%d, Time: %.2f seconds"),
+            *CommandID, Result->SuccessCount, Result->TotalCount, Result->GetElapsedTimeSeconds());
+    }
+}
+
 void UPJLinkManagerComponent::HandleCommandTimeout(const FString& CommandID)
 {
     if (!CommandResults.Contains(CommandID))
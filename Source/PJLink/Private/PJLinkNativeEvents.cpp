@@ -0,0 +1,48 @@
+﻿// PJLinkNativeEvents.cpp
+#include "PJLinkNativeEvents.h"
+
+void FPJLinkNativeEvents::ForwardTo(FPJLinkNativeEvents& Target, UObject* Owner)
+{
+    // Target 은 Owner 의 멤버 - Owner 가 유효한 동안만 호출됨
+    FPJLinkNativeEvents* TargetPtr = &Target;
+
+    OnResponse.AddWeakLambda(Owner, [TargetPtr](UPJLinkNetworkManager* Source, const FPJLinkNativeResponse& Response)
+    {
+        TargetPtr->OnResponse.Broadcast(Source, Response);
+    });
+
+    OnConnectionChanged.AddWeakLambda(Owner, [TargetPtr](UPJLinkNetworkManager* Source, bool bIsConnected)
+    {
+        TargetPtr->OnConnectionChanged.Broadcast(Source, bIsConnected);
+    });
+
+    OnPowerStatusChanged.AddWeakLambda(Owner, [TargetPtr](UPJLinkNetworkManager* Source, EPJLinkPowerStatus OldStatus, EPJLinkPowerStatus NewStatus)
+    {
+        TargetPtr->OnPowerStatusChanged.Broadcast(Source, OldStatus, NewStatus);
+    });
+
+    OnInputSourceChanged.AddWeakLambda(Owner, [TargetPtr](UPJLinkNetworkManager* Source, EPJLinkInputSource OldSource, EPJLinkInputSource NewSource)
+    {
+        TargetPtr->OnInputSourceChanged.Broadcast(Source, OldSource, NewSource);
+    });
+
+    OnError.AddWeakLambda(Owner, [TargetPtr](UPJLinkNetworkManager* Source, EPJLinkErrorCode ErrorCode, FStringView Message, EPJLinkCommand RelatedCommand)
+    {
+        TargetPtr->OnError.Broadcast(Source, ErrorCode, Message, RelatedCommand);
+    });
+
+    OnCommunicationLog.AddWeakLambda(Owner, [TargetPtr](UPJLinkNetworkManager* Source, bool bIsSending, const TCHAR* CommandOrResponse, TArrayView<const uint8> RawData)
+    {
+        TargetPtr->OnCommunicationLog.Broadcast(Source, bIsSending, CommandOrResponse, RawData);
+    });
+}
+
+void FPJLinkNativeEvents::RemoveAll(const void* Owner)
+{
+    OnResponse.RemoveAll(Owner);
+    OnConnectionChanged.RemoveAll(Owner);
+    OnPowerStatusChanged.RemoveAll(Owner);
+    OnInputSourceChanged.RemoveAll(Owner);
+    OnError.RemoveAll(Owner);
+    OnCommunicationLog.RemoveAll(Owner);
+}
@@ -1,133 +1,228 @@
 ﻿// PJLinkNetworkManager.cpp
 #include "PJLinkNetworkManager.h"
-#include "Sockets.h"
-#include "SocketSubsystem.h"
+#include "PJLinkSocketPlatform.h"
+#include "PJLinkResponseParser.h"
+#include "PJLinkCommandEncoder.h"
+#include "PJLinkReconnectScheduler.h"
+#include "PJLinkNotificationListener.h"
+#include "PJLinkEventDrainScheduler.h"
 #include "Interfaces/IPv4/IPv4Address.h"
-#include "Common/TcpSocketBuilder.h"
 #include "Async/Async.h"
-#include "HAL/RunnableThread.h"
 #include "Misc/ScopeLock.h"
 #include "Misc/CString.h"
 #include "Misc/SecureHash.h" // FMD5를 위한 헤더
-#include <string>  // std::string 사용을 위한 헤더
+
+using namespace PJLinkSocketPlatform;
+
+// 수신 프레임을 로그용 문자열로 변환
+static FString FrameToString(const uint8* Frame, int32 Length)
+{
+    FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Frame), Length);
+    return FString(Converted.Length(), Converted.Get());
+}
 
 UPJLinkNetworkManager::UPJLinkNetworkManager()
-    : Socket(nullptr)
-    , ReceiverThread(nullptr)
-    , bThreadStop(false)
+    : bResponseDrainScheduled(false)
+    , NextSequenceId(1)
     , bConnected(false)
+    , bHandshakePending(false)
+    , LastActivityCycles(0)
+    , NotificationCount(0)
+    , DroppedEventCount(0)
     , LastErrorCode(EPJLinkErrorCode::None)
     , LastErrorMessage(TEXT(""))
 {
-    // 응답 큐 처리 타이머 설정 - 0.1초마다 큐 확인
-    if (UWorld* World = GetWorld())
-    {
-        World->GetTimerManager().SetTimer(
-            ResponseQueueTimerHandle,
-            this,
-            &UPJLinkNetworkManager::ProcessResponseQueue,
-            0.1f,
-            true);
-    }
+    // 응답 큐는 항목이 들어올 때 ScheduleResponseDrain()으로 게임 스레드 처리가 예약됨
 }
 
-// PJLinkNetworkManager.cpp의 ProcessResponseQueue 함수 최적화
-void UPJLinkNetworkManager::ProcessResponseQueue()
+void UPJLinkNetworkManager::ScheduleResponseDrain()
 {
-    // 유효하지 않은 객체 체크
-    if (!IsValid(this))
+    // 이미 예약되어 있으면 같은 게임 스레드 작업에서 함께 처리됨
+    if (bResponseDrainScheduled.exchange(true))
     {
         return;
     }
 
-    FPJLinkResponseQueueItem Item;
-    int32 ProcessedItems = 0;
-    const int32 MaxItemsPerFrame = 10;
-    bool bShouldReschedule = false;
+    TWeakObjectPtr<UPJLinkNetworkManager> WeakThis(this);
+    AsyncTask(ENamedThreads::GameThread, [WeakThis]()
+        {
+            if (UPJLinkNetworkManager* StrongThis = WeakThis.Get())
+            {
+                // 플래그를 먼저 내려야 처리 중에 들어온 이벤트가 다시 예약됨
+                StrongThis->bResponseDrainScheduled.store(false);
+
+                // 프레임 예산은 모든 매니저가 함께 씀
+                FPJLinkEventDrainScheduler::Get().Schedule(StrongThis);
+            }
+        });
+}
+
+double UPJLinkNetworkManager::DrainEvents(double BudgetSeconds)
+{
+    const uint64 StartCycles = FPlatformTime::Cycles64();
+    EventStats.PeakQueueDepth = FMath::Max(EventStats.PeakQueueDepth, EventQueue.Num());
+
+    double ElapsedSeconds = 0.0;
+    int32 BatchSize = 1;
 
-    // 큐에 항목이 있으면 처리
+    for (;;)
     {
-        FScopeLock QueueLock(&ResponseQueueLock); // 큐 접근 시 락 사용
+        // 남은 예산을 평균 처리 비용으로 나눠 한 번에 꺼낼 수를 정함
+        // 시각 확인은 묶음 사이에서만 하므로 이벤트가 가벼울수록 확인 횟수가 줄어듦
+        if (AverageEventCostSeconds > 0.0)
+        {
+            const double Affordable = (BudgetSeconds - ElapsedSeconds) / AverageEventCostSeconds;
+            BatchSize = static_cast<int32>(FMath::Clamp(Affordable, 1.0, static_cast<double>(MaxDrainBatchSize)));
+        }
 
-        while (!ResponseQueue.IsEmpty() && ProcessedItems < MaxItemsPerFrame)
+        const uint64 BatchStartCycles = FPlatformTime::Cycles64();
+        const int32 NumDrained = EventQueue.Drain([this, BatchStartCycles](const FPJLinkEvent& Event)
         {
-            ResponseQueue.Dequeue(Item);
-            ProcessedItems++;
+            const double LatencyMs = Event.EnqueueCycles < BatchStartCycles
+                ? FPlatformTime::ToMilliseconds64(BatchStartCycles - Event.EnqueueCycles) : 0.0;
+            EventStats.AverageDrainLatencyMs += (static_cast<float>(LatencyMs) - EventStats.AverageDrainLatencyMs) * 0.05f;
+            EventStats.MaxDrainLatencyMs = FMath::Max(EventStats.MaxDrainLatencyMs, static_cast<float>(LatencyMs));
 
-            // 락 밖에서 처리하기 위해 복사본 생성에 대한 비용을 줄이기 위해
-            // 각 항목을 처리하는 로직은 바깥에서 실행
-            Item.WeakThis = TWeakObjectPtr<UPJLinkNetworkManager>(this);
+            ProcessEvent(Event);
+        }, BatchSize);
 
-            // 여기서 항목 처리
-            ProcessResponseItem(Item);
+        const uint64 NowCycles = FPlatformTime::Cycles64();
+        if (NumDrained > 0)
+        {
+            const double BatchCost = FPlatformTime::ToSeconds64(NowCycles - BatchStartCycles) / NumDrained;
+            AverageEventCostSeconds = AverageEventCostSeconds > 0.0
+                ? AverageEventCostSeconds + (BatchCost - AverageEventCostSeconds) * 0.25
+                : BatchCost;
+            EventStats.EventsDispatched += NumDrained;
         }
 
-        // 큐에 항목이 더 있는지 확인
-        bShouldReschedule = !ResponseQueue.IsEmpty();
-    }
-
-    // 아직 처리할 항목이 남아있으면 다음 프레임에 계속 처리
-    if (bShouldReschedule)
-    {
-        if (UWorld* World = GetWorld())
+        ElapsedSeconds = FPlatformTime::ToSeconds64(NowCycles - StartCycles);
+        if (NumDrained < BatchSize || ElapsedSeconds >= BudgetSeconds)
         {
-            // 성능 최적화: 호출 빈도 제한 (최소 16ms = 약 60fps)
-            static const float MinProcessInterval = 0.016f;
-            World->GetTimerManager().SetTimer(
-                ResponseQueueTimerHandle,
-                this,
-                &UPJLinkNetworkManager::ProcessResponseQueue,
-                MinProcessInterval,
-                false);
+            break;
         }
     }
+
+    EventStats.LastBatchSize = BatchSize;
+    EventStats.LastDrainTimeMicroseconds = static_cast<float>(ElapsedSeconds * 1.0e6);
+    return ElapsedSeconds;
+}
+
+FPJLinkEventQueueStats UPJLinkNetworkManager::GetEventQueueStats() const
+{
+    FPJLinkEventQueueStats Stats = EventStats;
+    Stats.QueueDepth = EventQueue.Num();
+    Stats.DroppedEvents = DroppedEventCount.load(std::memory_order_relaxed);
+    return Stats;
 }
 
-// 응답 항목 처리를 별도 함수로 분리
-void UPJLinkNetworkManager::ProcessResponseItem(const FPJLinkResponseQueueItem& Item)
+void UPJLinkNetworkManager::ResetEventQueueStats()
 {
-    // 통신 로그 이벤트인지 확인
-    if (Item.ResponseText.StartsWith(TEXT("COMMUNICATION_LOG")))
+    EventStats = FPJLinkEventQueueStats();
+    DroppedEventCount.store(0, std::memory_order_relaxed);
+}
+
+// 이벤트 종류별 대리자 호출 - 문자열은 이벤트가 가진 버퍼를 참조로 넘김
+void UPJLinkNetworkManager::ProcessEvent(const FPJLinkEvent& Event)
+{
+    switch (Event.Type)
     {
-        // 통신 로그 이벤트 처리
-        TArray<FString> Parts;
-        Item.ResponseText.ParseIntoArray(Parts, TEXT("|"));
+    case EPJLinkEventType::CommunicationLog:
+        if (OnCommunicationLog.IsBound())
+        {
+            OnCommunicationLog.Broadcast(Event.bIsSending, Event.Label, Event.Text);
+        }
+        break;
 
-        if (Parts.Num() >= 4)
+    case EPJLinkEventType::Error:
+        if (OnExtendedError.IsBound())
         {
-            bool bIsSending = (Parts[1] == TEXT("1"));
-            if (OnCommunicationLog.IsBound())
-            {
-                OnCommunicationLog.Broadcast(bIsSending, Parts[2], Parts[3]);
-            }
+            OnExtendedError.Broadcast(Event.ErrorCode, Event.Text, Event.Command);
         }
-    }
-    // 오류 이벤트인지 확인
-    else if (Item.ResponseText.StartsWith(TEXT("ERROR")))
-    {
-        // 오류 이벤트 처리
-        TArray<FString> Parts;
-        Item.ResponseText.ParseIntoArray(Parts, TEXT("|"));
+        break;
 
-        if (Parts.Num() >= 3)
+    case EPJLinkEventType::ConnectionChanged:
+        if (OnConnectionChanged.IsBound())
         {
-            EPJLinkErrorCode ErrorCode = static_cast<EPJLinkErrorCode>(FCString::Atoi(*Parts[1]));
-            if (OnExtendedError.IsBound())
-            {
-                OnExtendedError.Broadcast(ErrorCode, Parts[2], Item.Command);
-            }
+            OnConnectionChanged.Broadcast(Event.bIsConnected);
         }
-    }
-    else
-    {
-        // 일반 응답 이벤트 처리
+        break;
+
+    case EPJLinkEventType::ConnectCompleted:
+        // 진단 데이터는 게임 스레드에서만 갱신
+        PJLINK_CAPTURE_DIAGNOSTIC(ConnectionDiagnosticData, TEXT("Async connection %s (%s)"),
+            Event.bIsConnected ? TEXT("succeeded") : TEXT("failed"), *UEnum::GetValueAsString(Event.ErrorCode));
+
+        if (OnConnectCompleted.IsBound())
+        {
+            OnConnectCompleted.Broadcast(Event.bIsConnected, Event.ErrorCode);
+        }
+        break;
+
+    case EPJLinkEventType::Response:
         if (OnResponseReceived.IsBound())
         {
-            OnResponseReceived.Broadcast(Item.Command, Item.Status, Item.ResponseText);
+            OnResponseReceived.Broadcast(Event.Command, Event.Status, Event.Text);
+        }
+
+        if (Event.SequenceId != 0 && OnSequencedResponse.IsBound())
+        {
+            OnSequencedResponse.Broadcast(Event.SequenceId, Event.Command, Event.Status, Event.Text);
         }
+        break;
+    }
+}
+
+void UPJLinkNetworkManager::EnqueueResponseEvent(EPJLinkCommand Command, EPJLinkResponseStatus Status, const TCHAR* Text, int32 SequenceId)
+{
+    if (NativeEvents.OnResponse.IsBound())
+    {
+        // 내부 알림 문구는 ASCII - 스택 버퍼로 변환
+        const auto AnsiText = StringCast<ANSICHAR>(Text);
+
+        FPJLinkNativeResponse Response;
+        Response.SequenceId = SequenceId;
+        Response.Command = Command;
+        Response.Status = Status;
+        Response.Parameter = FAnsiStringView(AnsiText.Get(), AnsiText.Length());
+        NativeEvents.OnResponse.Broadcast(this, Response);
     }
+
+    EventQueue.Enqueue([Command, Status, Text, SequenceId](FPJLinkEvent& Event)
+    {
+        Event.Type = EPJLinkEventType::Response;
+        Event.Command = Command;
+        Event.Status = Status;
+        Event.SequenceId = SequenceId;
+        Event.Text.Append(Text);
+    });
+    ScheduleResponseDrain();
+}
+
+void UPJLinkNetworkManager::EnqueueConnectCompleted(bool bSuccess, EPJLinkErrorCode ErrorCode)
+{
+    EventQueue.Enqueue([bSuccess, ErrorCode](FPJLinkEvent& Event)
+    {
+        Event.Type = EPJLinkEventType::ConnectCompleted;
+        Event.bIsConnected = bSuccess;
+        Event.ErrorCode = ErrorCode;
+    });
+    ScheduleResponseDrain();
+}
+
+void UPJLinkNetworkManager::EnqueueConnectionChanged(bool bIsConnected)
+{
+    NativeEvents.OnConnectionChanged.Broadcast(this, bIsConnected);
+
+    EventQueue.Enqueue([bIsConnected](FPJLinkEvent& Event)
+    {
+        Event.Type = EPJLinkEventType::ConnectionChanged;
+        Event.bIsConnected = bIsConnected;
+    });
+    ScheduleResponseDrain();
 }
 
+
 UPJLinkNetworkManager::~UPJLinkNetworkManager()
 {
     // 모든 리소스 안전하게 정리
@@ -136,60 +231,51 @@ UPJLinkNetworkManager::~UPJLinkNetworkManager()
 
 void UPJLinkNetworkManager::Shutdown()
 {
-    // 타이머 정지
-    if (UWorld* World = GetWorld())
+    // 공유 이벤트 처리기의 대기 목록에서 제거
+    if (bEventDrainPending)
     {
-        World->GetTimerManager().ClearTimer(ResponseQueueTimerHandle);
+        FPJLinkEventDrainScheduler::Get().Remove(this);
     }
 
-    // 1. 먼저 스레드 종료 신호 설정
-    bThreadStop.store(true, std::memory_order_release);
+    // 예약된 재연결과 알림 수신 해제 (반환 후에는 스케줄러/수신기가 이 객체를 호출하지 않음)
+    FPJLinkReconnectScheduler::Get().Cancel(this);
+    FPJLinkNotificationListener::Get().Unregister(this);
 
-    // 2. 스레드 종료 대기
-    FRunnableThread* ThreadToDelete = nullptr;
-    {
-        FScopeLock Lock(&SocketCriticalSection);
-        ThreadToDelete = ReceiverThread;
-        ReceiverThread = nullptr;
-    }
+    // 진행 중인 비동기 연결 취소
+    CancelConnect();
+
+    // 유휴 세션 대기 명령 폐기
+    DiscardDeferredBatches(TEXT("Network manager shut down"));
 
-    // 임계 영역 밖에서 스레드 종료 (교착 상태 방지)
-    if (ThreadToDelete)
+    // 1. 연결 분리 - 수신자를 먼저 떼어내 이후 I/O 스레드 콜백을 차단
+    TSharedPtr<FPJLinkConnection, ESPMode::ThreadSafe> ConnectionToClose;
+    FPJLinkTimerId KeepAliveTimerToCancel = 0;
     {
-        ThreadToDelete->Kill(true);
-        delete ThreadToDelete;
+        FScopeLock Lock(&ConnectionLock);
+        ConnectionToClose = MoveTemp(Connection);
+        Connection.Reset();
+        KeepAliveTimerToCancel = KeepAliveTimerId;
+        KeepAliveTimerId = 0;
     }
 
-    // 3. 소켓 종료
-    FSocket* SocketToClose = nullptr;
+    if (KeepAliveTimerToCancel != 0)
     {
-        FScopeLock Lock(&SocketCriticalSection);
-        SocketToClose = Socket;
-        Socket = nullptr;
+        FPJLinkIOReactor::Get().CancelTimer(KeepAliveTimerToCancel);
     }
 
-    // 임계 영역 밖에서 소켓 종료 (교착 상태 방지)
-    if (SocketToClose)
+    // 락 밖에서 종료 (콜백 중인 I/O 스레드와의 교착 방지)
+    if (ConnectionToClose.IsValid())
     {
-        ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
-        if (SocketSubsystem)
-        {
-            SocketToClose->Close();
-            SocketSubsystem->DestroySocket(SocketToClose);
-        }
+        ConnectionToClose->Close();
     }
 
-    // 4. 연결 상태 업데이트
+    // 2. 연결 상태 업데이트
     bConnected.store(false, std::memory_order_release);
 
-    // 5. 큐 비우기
-    {
-        FScopeLock QueueLock(&ResponseQueueLock);
-        FPJLinkResponseQueueItem DummyItem;
-        while (ResponseQueue.Dequeue(DummyItem)) {}
-    }
+    // 3. 큐 비우기
+    EventQueue.Discard();
 
-    // 6. 프로젝터 정보 초기화
+    // 4. 프로젝터 정보 초기화
     {
         FScopeLock InfoLock(&ProjectorInfoLock);
         CurrentProjectorInfo.bIsConnected = false;
@@ -205,21 +291,33 @@ bool UPJLinkNetworkManager::ConnectToProjector(const FPJLinkProjectorInfo& Proje
     PJLINK_CAPTURE_DIAGNOSTIC(ConnectionDiagnosticData,
         TEXT("Starting connection to %s:%d"), *ProjectorInfo.IPAddress, ProjectorInfo.Port);
 
-    FScopeLock InfoLock(&ProjectorInfoLock);
+    // 기존 연결 정리
+    bool bHasConnection = false;
+    {
+        FScopeLock Lock(&ConnectionLock);
+        bHasConnection = Connection.IsValid();
+    }
+    if (bHasConnection)
+    {
+        PJLINK_CAPTURE_DIAGNOSTIC(ConnectionDiagnosticData, TEXT("Cleaning up existing socket connection"));
+        CloseConnection();
+    }
 
-    // 프로젝터 정보 저장 - 재연결을 위해 LastProjectorInfo도 업데이트
-    CurrentProjectorInfo = ProjectorInfo;
-    LastProjectorInfo = ProjectorInfo;
+    {
+        FScopeLock Lock(&ConnectionLock);
+        ConnectStartTime = FPlatformTime::Seconds();
+    }
 
-    // 기존 소켓 정리
-    if (Socket)
+    // 프로젝터 정보 저장 - 재연결을 위해 LastProjectorInfo도 업데이트
     {
-        PJLINK_CAPTURE_DIAGNOSTIC(ConnectionDiagnosticData, TEXT("Cleaning up existing socket connection"));
-        DisconnectFromProjector();
+        FScopeLock InfoLock(&ProjectorInfoLock);
+        CurrentProjectorInfo = ProjectorInfo;
+        LastProjectorInfo = ProjectorInfo;
     }
 
     // 소켓 생성
-    if (!CreateSocket())
+    FNativeSocket NewSocket = InvalidSocket;
+    if (!CreateSocket(NewSocket))
     {
         PJLINK_CAPTURE_DIAGNOSTIC(ConnectionDiagnosticData, TEXT("Failed to create socket"));
         return false;
@@ -227,45 +325,46 @@ bool UPJLinkNetworkManager::ConnectToProjector(const FPJLinkProjectorInfo& Proje
 
     // 서버 연결
     PJLINK_CAPTURE_DIAGNOSTIC(ConnectionDiagnosticData, TEXT("Attempting to connect to server"));
-    if (!ConnectToServer(ProjectorInfo.IPAddress, ProjectorInfo.Port, TimeoutSeconds))
+    if (!ConnectToServer(NewSocket, ProjectorInfo.IPAddress, ProjectorInfo.Port, TimeoutSeconds))
     {
         PJLINK_CAPTURE_DIAGNOSTIC(ConnectionDiagnosticData, TEXT("Failed to connect to server"));
-        DisconnectFromProjector();
+        Close(NewSocket);
         return false;
     }
 
-    // 인증 처리 (필요한 경우)
-    if (ProjectorInfo.bRequiresAuthentication)
+    // 인사말 수신 및 인증 처리 (인증 여부는 프로젝터 인사말이 결정)
+    PJLINK_CAPTURE_DIAGNOSTIC(ConnectionDiagnosticData, TEXT("Waiting for projector greeting"));
+    if (!HandleAuthentication(NewSocket, ProjectorInfo, TimeoutSeconds))
     {
-        PJLINK_CAPTURE_DIAGNOSTIC(ConnectionDiagnosticData, TEXT("Authentication required, attempting..."));
-        if (!HandleAuthentication(ProjectorInfo))
-        {
-            PJLINK_CAPTURE_DIAGNOSTIC(ConnectionDiagnosticData, TEXT("Authentication failed"));
-            DisconnectFromProjector();
-            return false;
-        }
-        PJLINK_CAPTURE_DIAGNOSTIC(ConnectionDiagnosticData, TEXT("Authentication successful"));
+        PJLINK_CAPTURE_DIAGNOSTIC(ConnectionDiagnosticData, TEXT("Authentication failed"));
+        Close(NewSocket);
+        return false;
+    }
+    PJLINK_CAPTURE_DIAGNOSTIC(ConnectionDiagnosticData, TEXT("Greeting handled"));
+
+    // 리액터에 연결 등록 (이후 소켓 소유권은 리액터가 가짐)
+    if (!StartConnection(NewSocket))
+    {
+        PJLINK_CAPTURE_DIAGNOSTIC(ConnectionDiagnosticData, TEXT("Failed to register connection with I/O reactor"));
+        Close(NewSocket);
+        return false;
     }
+    PJLINK_CAPTURE_DIAGNOSTIC(ConnectionDiagnosticData, TEXT("Connection registered with I/O reactor"));
 
     // 연결 상태 업데이트
     this->bConnected.store(true, std::memory_order_release);
-    CurrentProjectorInfo.bIsConnected = true;
-    PJLINK_CAPTURE_DIAGNOSTIC(ConnectionDiagnosticData, TEXT("Connection successful, bConnected set to true"));
-
-    // 재연결 시도 카운트 리셋 - 연결 성공 시
-    ReconnectAttemptCount = 0;
-
-    // 수신 스레드 시작
-    if (!StartReceiverThread())
     {
-        PJLINK_CAPTURE_DIAGNOSTIC(ConnectionDiagnosticData, TEXT("Failed to start receiver thread"));
-        DisconnectFromProjector();
-        return false;
+        FScopeLock InfoLock(&ProjectorInfoLock);
+        CurrentProjectorInfo.bIsConnected = true;
     }
-    PJLINK_CAPTURE_DIAGNOSTIC(ConnectionDiagnosticData, TEXT("Receiver thread started successfully"));
+    EnqueueConnectionChanged(true);
+    PJLINK_CAPTURE_DIAGNOSTIC(ConnectionDiagnosticData, TEXT("Connection successful, bConnected set to true"));
 
-    // 초기 상태 요청
-    RequestStatus();
+    // 예약된 재연결이 있으면 종료
+    FPJLinkReconnectScheduler::Get().ReportResult(this, true);
+
+    // 초기 상태 요청 (유휴 종료 후 대기 중인 명령이 있으면 그것부터 전송)
+    OnSessionEstablished();
 
     PJLINK_LOG_INFO(TEXT("Successfully connected to projector at %s:%d"),
         *ProjectorInfo.IPAddress, ProjectorInfo.Port);
@@ -273,730 +372,1343 @@ bool UPJLinkNetworkManager::ConnectToProjector(const FPJLinkProjectorInfo& Proje
     return true;
 }
 
-void UPJLinkNetworkManager::DisconnectFromProjector()
+TFuture<bool> UPJLinkNetworkManager::StartConnect(const FPJLinkProjectorInfo& ProjectorInfo, float TimeoutSeconds)
 {
-    // 스레드 종료 신호 설정
-    bThreadStop.store(true, std::memory_order_release);
-
-    // 스레드 종료 대기
-    if (ReceiverThread)
+    // 재연결 스케줄러와 유휴 세션 재연결은 I/O 스레드에서 호출하므로 진단 데이터는 게임 스레드에서만 기록
+    if (IsInGameThread())
     {
-        ReceiverThread->Kill(true);
-        delete ReceiverThread;
-        ReceiverThread = nullptr;
+        PJLINK_CAPTURE_DIAGNOSTIC(ConnectionDiagnosticData,
+            TEXT("Starting async connection to %s:%d"), *ProjectorInfo.IPAddress, ProjectorInfo.Port);
     }
 
-    // 소켓 종료 (스레드 안전하게)
+    // 기존 연결 또는 진행 중인 시도 정리
+    bool bHasConnection = false;
     {
-        FScopeLock SocketLock(&SocketCriticalSection);
-        if (Socket)
-        {
-            ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
-            if (SocketSubsystem)
-            {
-                Socket->Close();
-                SocketSubsystem->DestroySocket(Socket);
-            }
-            Socket = nullptr;
-        }
+        FScopeLock Lock(&ConnectionLock);
+        bHasConnection = Connection.IsValid() || ConnectPhase != EPJLinkConnectPhase::Idle;
     }
-
-    // 연결 상태 업데이트
-    bConnected.store(false, std::memory_order_release);
-
-    // 프로젝터 정보 업데이트
+    if (bHasConnection)
     {
-        FScopeLock InfoLock(&ProjectorInfoLock);
-        CurrentProjectorInfo.bIsConnected = false;
+        CloseConnection();
     }
-}
-
-// PJLinkNetworkManager.cpp에서
-bool UPJLinkNetworkManager::SendCommand(EPJLinkCommand Command, const FString& Parameter)
-{
-    // 진단 데이터 기록 시작
-    PJLINK_CAPTURE_DIAGNOSTIC(LastCommandDiagnosticData, TEXT("Sending command: %s, Parameter: %s"),
-        *PJLinkHelpers::CommandToString(Command), *Parameter);
 
-    // 호출 전 NULL 및 연결 상태 검사
-    if (!Socket)
     {
-        PJLINK_CAPTURE_DIAGNOSTIC(LastCommandDiagnosticData, TEXT("Cannot send command: Socket is null"));
-        EmitError(EPJLinkErrorCode::SocketError, TEXT("Cannot send command: Socket is null"), Command);
-        return false;
+        FScopeLock InfoLock(&ProjectorInfoLock);
+        CurrentProjectorInfo = ProjectorInfo;
+        LastProjectorInfo = ProjectorInfo;
     }
 
-    if (!bConnected.load(std::memory_order_acquire))
+    if (TimeoutSeconds <= 0.0f)
     {
-        PJLINK_CAPTURE_DIAGNOSTIC(LastCommandDiagnosticData, TEXT("Cannot send command: Not connected"));
-        EmitError(EPJLinkErrorCode::SocketError, TEXT("Cannot send command: Not connected"), Command);
-        return false;
+        TimeoutSeconds = 5.0f;
     }
 
-    // 명령 문자열 생성
-    FString CommandStr = BuildCommandString(Command, Parameter);
-    if (CommandStr.IsEmpty())
+    TSharedPtr<TPromise<bool>, ESPMode::ThreadSafe> Promise = MakeShared<TPromise<bool>, ESPMode::ThreadSafe>();
+    TFuture<bool> Future = Promise->GetFuture();
     {
-        PJLINK_CAPTURE_DIAGNOSTIC(LastCommandDiagnosticData, TEXT("Failed to build command string"));
-        EmitError(EPJLinkErrorCode::CommandFailed, TEXT("Failed to build command string"), Command);
-        return false;
+        FScopeLock Lock(&ConnectionLock);
+        ConnectPhase = EPJLinkConnectPhase::Connecting;
+        ConnectStartTime = FPlatformTime::Seconds();
+        ConnectPromise = Promise;
+        ConnectTimeoutSeconds = TimeoutSeconds;
+        ConnectPassword = ProjectorInfo.Password;
     }
 
-    // 통신 로깅 (명령 전송)
-    if (bLogCommunication)
+    FIPv4Address IP;
+    if (!FIPv4Address::Parse(ProjectorInfo.IPAddress, IP))
     {
-        LogCommunication(true, PJLinkHelpers::CommandToString(Command), CommandStr);
+        CompleteConnect(false, EPJLinkErrorCode::InvalidIP,
+            FString::Printf(TEXT("Invalid IP address: %s"), *ProjectorInfo.IPAddress));
+        return Future;
     }
 
-    // UTF-8로 변환
-    FTCHARToUTF8 Utf8Command(*CommandStr);
-    const uint8* SendData = (const uint8*)Utf8Command.Get();
-    int32 DataLen = Utf8Command.Length();
-    if (DataLen <= 0)
+    FNativeSocket NewSocket = CreateTcpSocket();
+    if (NewSocket == InvalidSocket)
     {
-        PJLINK_CAPTURE_DIAGNOSTIC(LastCommandDiagnosticData, TEXT("Command string conversion failed"));
-        EmitError(EPJLinkErrorCode::CommandFailed, TEXT("Command string conversion failed"), Command);
-        return false;
+        CompleteConnect(false, EPJLinkErrorCode::SocketCreationFailed,
+            FString::Printf(TEXT("Failed to create socket - Error: %d"), PJLinkSocketPlatform::GetLastErrorCode()));
+        return Future;
     }
+    SetNoDelay(NewSocket, true);
 
-    // 데이터 송신 (임계 영역 내에서)
-    int32 BytesSent = 0;
-    bool bSuccess = false;
-    ESocketErrors LastError = ESocketErrors::SE_NO_ERROR;
-
+    // 논블로킹 연결 시작 - 완료는 I/O 스레드가 쓰기 가능 이벤트로 확인
+    if (Connect(NewSocket, IP.Value, static_cast<uint16>(ProjectorInfo.Port)) == EConnectResult::Failed)
     {
-        FScopeLock ScopeLock(&SocketCriticalSection);
-        // 두 번째 검사 (락 내부에서 다시 확인)
-        if (!Socket || !bConnected.load(std::memory_order_acquire))
-        {
-            PJLINK_CAPTURE_DIAGNOSTIC(LastCommandDiagnosticData, TEXT("Socket disconnected while preparing to send"));
-            EmitError(EPJLinkErrorCode::SocketError, TEXT("Socket disconnected while preparing to send"), Command);
-            return false;
-        }
-
-        bSuccess = Socket->Send(SendData, DataLen, BytesSent);
-        if (!bSuccess)
-        {
-            LastError = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->GetLastErrorCode();
-        }
+        const int32 ErrorCode = PJLinkSocketPlatform::GetLastErrorCode();
+        Close(NewSocket);
+        CompleteConnect(false, EPJLinkErrorCode::ConnectionFailed,
+            FString::Printf(TEXT("Failed to connect to %s:%d - Error: %d"), *ProjectorInfo.IPAddress, ProjectorInfo.Port, ErrorCode));
+        return Future;
     }
 
-    if (!bSuccess || BytesSent != DataLen)
+    // 리액터 등록과 상태 기록을 한 락 안에서 수행 - I/O 스레드의 완료 콜백은 이 락이 풀릴 때까지 기다림
     {
-        FString ErrorString = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->GetSocketError(LastError);
-        FString ErrorMessage = FString::Printf(TEXT("Failed to send command. Error: %s"), *ErrorString);
-        PJLINK_CAPTURE_DIAGNOSTIC(LastCommandDiagnosticData, TEXT("%s"), *ErrorMessage);
-        EmitError(EPJLinkErrorCode::SocketError, ErrorMessage, Command);
-        return false;
+        FScopeLock Lock(&ConnectionLock);
+        FrameAssembler.Reset();
+        Connection = FPJLinkConnection::CreateConnecting(NewSocket, this);
+        ConnectTimeoutTimerId = Connection->ScheduleTimer(TimeoutSeconds, ConnectTimerCookie);
     }
 
-    PJLINK_CAPTURE_DIAGNOSTIC(LastCommandDiagnosticData, TEXT("Command sent successfully. Bytes: %d"), BytesSent);
-    PJLINK_LOG_VERBOSE(TEXT("Sent command: %s"), *CommandStr.TrimEnd());
-    return true;
+    PJLINK_LOG_VERBOSE(TEXT("Async connection started to %s:%d"), *ProjectorInfo.IPAddress, ProjectorInfo.Port);
+    return Future;
 }
 
-FPJLinkProjectorInfo UPJLinkNetworkManager::GetProjectorInfo() const
+bool UPJLinkNetworkManager::ConnectToProjectorAsync(const FPJLinkProjectorInfo& ProjectorInfo, float TimeoutSeconds)
 {
-    FScopeLock InfoLock(&ProjectorInfoLock);
-    return CurrentProjectorInfo;
-}
+    TFuture<bool> Future = StartConnect(ProjectorInfo, TimeoutSeconds);
 
-bool UPJLinkNetworkManager::IsConnected() const
-{
-    // 원자적 변수 사용으로 락이 필요 없음
-    return bConnected.load(std::memory_order_acquire);
+    // 바로 끝난 경우는 즉시 실패 (잘못된 주소, 소켓 생성 실패 등)
+    return !Future.IsReady() || Future.Get();
 }
 
-bool UPJLinkNetworkManager::PowerOn()
+bool UPJLinkNetworkManager::IsConnecting() const
 {
-    return SendCommandWithTimeout(EPJLinkCommand::POWR, TEXT("1"), 10.0f); // 전원 켜기는 더 긴 타임아웃
+    FScopeLock Lock(&ConnectionLock);
+    return ConnectPhase == EPJLinkConnectPhase::Connecting || ConnectPhase == EPJLinkConnectPhase::Handshaking;
 }
 
-bool UPJLinkNetworkManager::PowerOff()
+// 리액터 I/O 스레드에서 호출 - TCP 연결 완료
+void UPJLinkNetworkManager::OnConnectionEstablished()
 {
-    return SendCommandWithTimeout(EPJLinkCommand::POWR, TEXT("0"), 5.0f);
+    {
+        FScopeLock Lock(&ConnectionLock);
+        if (ConnectPhase != EPJLinkConnectPhase::Connecting)
+        {
+            return;
+        }
+
+        // 인증 여부는 프로젝터 인사말이 결정하므로 항상 첫 줄을 기다림 (수신 프레임으로 전달됨)
+        ConnectPhase = EPJLinkConnectPhase::Handshaking;
+        bHandshakePending.store(true);
+    }
 }
 
-bool UPJLinkNetworkManager::SwitchInputSource(EPJLinkInputSource InputSource)
+// 리액터 I/O 스레드에서 호출 - 연결 직후 받은 인사말로 인증 처리
+void UPJLinkNetworkManager::HandleGreeting(const uint8* Frame, int32 Length)
 {
-    FString Parameter;
+    FString Password;
+    {
+        FScopeLock Lock(&ConnectionLock);
+        if (ConnectPhase != EPJLinkConnectPhase::Handshaking)
+        {
+            return;
+        }
+        Password = ConnectPassword;
+    }
 
-    switch (InputSource)
+    const FString Greeting = FrameToString(Frame, Length);
+    FString Digest;
+    EPJLinkErrorCode ErrorCode = EPJLinkErrorCode::None;
+    if (!ParseGreeting(Greeting, Password, Digest, ErrorCode))
     {
-    case EPJLinkInputSource::RGB:
-        Parameter = TEXT("1");
-        break;
-    case EPJLinkInputSource::VIDEO:
-        Parameter = TEXT("2");
-        break;
-    case EPJLinkInputSource::DIGITAL:
-        Parameter = TEXT("3");
-        break;
-    case EPJLinkInputSource::STORAGE:
-        Parameter = TEXT("4");
-        break;
-    case EPJLinkInputSource::NETWORK:
-        Parameter = TEXT("5");
-        break;
-    default:
-        return false;
+        CompleteConnect(false, ErrorCode,
+            FString::Printf(TEXT("Invalid projector greeting: %s"), *Greeting));
+        return;
     }
 
-    return SendCommandWithTimeout(EPJLinkCommand::INPT, Parameter, 5.0f);
+    // 해시는 따로 보내지 않고 연결 직후 상태 조회 묶음 앞에 붙여 한 번에 보냄
+    SetPendingAuthDigest(Digest);
+    CompleteConnect(true);
 }
 
-bool UPJLinkNetworkManager::RequestStatus()
+void UPJLinkNetworkManager::CompleteConnect(bool bSuccess, EPJLinkErrorCode ErrorCode, const FString& ErrorMessage)
 {
-    // 여러 상태 정보 요청
-    bool bSuccess = true;
-
-    bSuccess &= SendCommand(EPJLinkCommand::POWR);  // 전원 상태
-    bSuccess &= SendCommand(EPJLinkCommand::INPT);  // 입력 소스
-    bSuccess &= SendCommand(EPJLinkCommand::NAME);  // 프로젝터 이름
-    bSuccess &= SendCommand(EPJLinkCommand::INF1);  // 제조사
-    bSuccess &= SendCommand(EPJLinkCommand::INF2);  // 제품명
-    bSuccess &= SendCommand(EPJLinkCommand::CLSS);  // 클래스 정보
+    TSharedPtr<TPromise<bool>, ESPMode::ThreadSafe> Promise;
+    TSharedPtr<FPJLinkConnection, ESPMode::ThreadSafe> ConnectionToClose;
+    FPJLinkTimerId TimerId = 0;
+    {
+        FScopeLock Lock(&ConnectionLock);
+        if (ConnectPhase == EPJLinkConnectPhase::Idle || ConnectPhase == EPJLinkConnectPhase::Connected)
+        {
+            // 이미 끝난 시도 (타임아웃과 연결 완료가 겹친 경우 등)
+            return;
+        }
 
-    return bSuccess;
-}
+        Promise = MoveTemp(ConnectPromise);
+        ConnectPromise.Reset();
+        TimerId = ConnectTimeoutTimerId;
+        ConnectTimeoutTimerId = 0;
+        bHandshakePending.store(false);
 
-bool UPJLinkNetworkManager::Init()
-{
-    return true;
-}
+        if (bSuccess)
+        {
+            ConnectPhase = EPJLinkConnectPhase::Connected;
+        }
+        else
+        {
+            ConnectPhase = EPJLinkConnectPhase::Idle;
+            ConnectionToClose = MoveTemp(Connection);
+            Connection.Reset();
+        }
+    }
 
-// PJLinkNetworkManager.cpp의 Run 함수 최적화
-uint32 UPJLinkNetworkManager::Run()
-{
-    // 스레드당 버퍼 메모리 할당 (재사용)
-    uint8 RecvBuffer[2048];
+    if (TimerId != 0)
+    {
+        FPJLinkIOReactor::Get().CancelTimer(TimerId);
+    }
 
-    // 재연결 상태 추적을 위한 이전 상태
-    bool bWasConnected = true;
+    if (bSuccess)
+    {
+        bConnected.store(true, std::memory_order_release);
+        {
+            FScopeLock InfoLock(&ProjectorInfoLock);
+            CurrentProjectorInfo.bIsConnected = true;
+        }
+        EnqueueConnectionChanged(true);
 
-    // 스레드 로컬 캐시 - 직접 전역 상태 대신 사용
-    FSocket* LocalSocket = nullptr;
+        // 초기 상태 요청 또는 대기 명령 전송 (I/O 스레드에서 바로 송신 큐에 넣음)
+        OnSessionEstablished();
 
-    while (!bThreadStop.load(std::memory_order_acquire))
+        PJLINK_LOG_INFO(TEXT("Async connection established"));
+    }
+    else
     {
-        // 로컬 소켓 상태 업데이트 (락 최소화)
-        if (LocalSocket != Socket)
+        // 락 밖에서 종료 (I/O 스레드 콜백 안에서 호출될 수 있음)
+        if (ConnectionToClose.IsValid())
         {
-            FScopeLock ScopeLock(&SocketCriticalSection);
-            LocalSocket = Socket;
+            ConnectionToClose->Close();
         }
+        EmitError(ErrorCode, ErrorMessage);
 
-        // 소켓 유효성 확인
-        bool bIsCurrentlyConnected = IsConnected();
-        if (!LocalSocket || !bIsCurrentlyConnected)
-        {
-            // 연결 상태 변경 탐지 (스레드에서 한 번만 처리)
-            if (bWasConnected && !bIsCurrentlyConnected)
-            {
-                bWasConnected = false;
-
-                // 자동 재연결 설정이 활성화되어 있으면 재연결 시도
-                if (bAutoReconnect && !bThreadStop.load(std::memory_order_acquire))
-                {
-                    PJLINK_CAPTURE_DIAGNOSTIC(ConnectionDiagnosticData,
-                        TEXT("Connection lost in receiver thread. Setting up reconnection..."));
-
-                    // 게임 스레드에서 재연결 시도 예약 (축약된 람다 사용)
-                    AsyncTask(ENamedThreads::GameThread, [this]() {
-                        if (UWorld* World = GetWorld())
-                        {
-                            if (!World->GetTimerManager().IsTimerActive(ReconnectTimerHandle))
-                            {
-                                AttemptReconnect();
-                            }
-                        }
-                        });
-                }
-            }
+        // 다시 연결하려고 기다리던 명령은 보낼 곳이 없음
+        DiscardDeferredBatches(TEXT("Reconnect failed"));
+    }
 
-            // 소켓 없이 계속 진행하면 안됨
-            FPlatformProcess::Sleep(0.1f); // 더 긴 대기 시간으로 CPU 사용량 감소
-            continue;
-        }
+    EnqueueConnectCompleted(bSuccess, ErrorCode);
 
-        // 연결되었는지 확인
-        bWasConnected = true;
+    // 재연결 중이었으면 결과 보고 (실패 시 다음 백오프 예약)
+    FPJLinkReconnectScheduler::Get().ReportResult(this, bSuccess);
 
-        // 데이터 수신 대기
-        int32 BytesRead = 0;
-        bool bReadSuccess = false;
+    if (Promise.IsValid())
+    {
+        Promise->SetValue(bSuccess);
+    }
+}
 
+void UPJLinkNetworkManager::CancelConnect()
+{
+    TSharedPtr<TPromise<bool>, ESPMode::ThreadSafe> Promise;
+    TSharedPtr<FPJLinkConnection, ESPMode::ThreadSafe> ConnectionToClose;
+    FPJLinkTimerId TimerId = 0;
+    {
+        FScopeLock Lock(&ConnectionLock);
+        if (ConnectPhase == EPJLinkConnectPhase::Idle || ConnectPhase == EPJLinkConnectPhase::Connected)
         {
-            FScopeLock ScopeLock(&SocketCriticalSection);
-            if (LocalSocket)
-            {
-                bReadSuccess = LocalSocket->Recv(RecvBuffer, sizeof(RecvBuffer) - 1, BytesRead, ESocketReceiveFlags::None);
-            }
+            return;
         }
 
-        // 데이터 처리 또는 오류 처리
-        if (!bReadSuccess)
-        {
-            // 연결 끊김 또는 오류 처리...
-            // 기존 코드와 동일하게 유지
-        }
-        else if (BytesRead > 0)
-        {
-            // 수신 데이터 처리...
-            // 기존 코드와 동일하게 유지
-        }
-        else
-        {
-            // 데이터가 없으면 짧게 대기 (CPU 사용량 감소)
-            FPlatformProcess::Sleep(0.005f);
-        }
+        Promise = MoveTemp(ConnectPromise);
+        ConnectPromise.Reset();
+        TimerId = ConnectTimeoutTimerId;
+        ConnectTimeoutTimerId = 0;
+        bHandshakePending.store(false);
+        ConnectPhase = EPJLinkConnectPhase::Idle;
+        ConnectionToClose = MoveTemp(Connection);
+        Connection.Reset();
     }
 
-    // 스레드 종료 시 연결 상태 업데이트
-    bConnected.store(false, std::memory_order_release);
-    return 0;
-}
+    if (TimerId != 0)
+    {
+        FPJLinkIOReactor::Get().CancelTimer(TimerId);
+    }
 
-void UPJLinkNetworkManager::Stop()
-{
-    bThreadStop.store(true, std::memory_order_release);
-}
+    if (ConnectionToClose.IsValid())
+    {
+        ConnectionToClose->Close();
+    }
 
-void UPJLinkNetworkManager::Exit()
-{
-    // 스레드 종료 시 필요한 정리 작업
+    // 재연결 예약과 대기 명령 정리는 호출한 쪽 몫 (명시적 해제/종료는 직접 정리, 새 연결 시도는 대기 명령을 이어받음)
+    EnqueueConnectCompleted(false, EPJLinkErrorCode::ConnectionFailed);
+
+    if (Promise.IsValid())
+    {
+        Promise->SetValue(false);
+    }
 }
 
-// PJLinkNetworkManager.cpp의 BuildCommandString 함수 최적화
-FString UPJLinkNetworkManager::BuildCommandString(EPJLinkCommand Command, const FString& Parameter)
+bool UPJLinkNetworkManager::ParseGreeting(const FString& Greeting, const FString& Password, FString& OutDigest, EPJLinkErrorCode& OutErrorCode) const
 {
-    // 메모리 할당 최적화: 필요한 크기를 미리 예약
-    FString CommandStr;
-    CommandStr.Reserve(20 + Parameter.Len()); // 명령어 + 파라미터 + 여유 공간
-
-    // 클래스 접두사
-    CommandStr += (CurrentProjectorInfo.DeviceClass == EPJLinkClass::Class2) ? TEXT("%2") : TEXT("%1");
+    OutDigest.Reset();
+    OutErrorCode = EPJLinkErrorCode::None;
 
-    // 명령 추가 - switch 대신 lookup table 사용
-    static const TCHAR* CommandStrings[] = {
-        TEXT("POWR"), // EPJLinkCommand::POWR
-        TEXT("INPT"), // EPJLinkCommand::INPT
-        TEXT("AVMT"), // EPJLinkCommand::AVMT
-        TEXT("ERST"), // EPJLinkCommand::ERST
-        TEXT("LAMP"), // EPJLinkCommand::LAMP
-        TEXT("INST"), // EPJLinkCommand::INST
-        TEXT("NAME"), // EPJLinkCommand::NAME
-        TEXT("INF1"), // EPJLinkCommand::INF1
-        TEXT("INF2"), // EPJLinkCommand::INF2
-        TEXT("INFO"), // EPJLinkCommand::INFO
-        TEXT("CLSS")  // EPJLinkCommand::CLSS
-    };
+    const FString Line = Greeting.TrimStartAndEnd();
 
-    // 명령 인덱스가 유효한지 확인
-    uint8 CmdIndex = static_cast<uint8>(Command);
-    if (CmdIndex < UE_ARRAY_COUNT(CommandStrings))
+    // "PJLINK 0" - 인증 없음
+    if (Line == TEXT("PJLINK 0"))
     {
-        CommandStr += CommandStrings[CmdIndex];
+        PJLINK_LOG_INFO(TEXT("No authentication required"));
+        return true;
     }
-    else
+
+    // "PJLINK ERRA" - 인증 오류
+    if (Line.StartsWith(TEXT("PJLINK ERRA")))
     {
-        // 예외 처리
-        PJLINK_LOG_ERROR(TEXT("Invalid command index: %d"), CmdIndex);
-        return FString();
+        OutErrorCode = EPJLinkErrorCode::AuthenticationFailed;
+        return false;
     }
 
-    // 파라미터 추가 (있을 경우)
-    if (!Parameter.IsEmpty())
+    // "PJLINK 1 <난수>" - 인증 필요
+    FString Challenge;
+    if (!Line.StartsWith(TEXT("PJLINK 1 ")) || !Line.Split(TEXT("PJLINK 1 "), nullptr, &Challenge))
     {
-        CommandStr += TEXT(" ");
-        CommandStr += Parameter;
+        OutErrorCode = EPJLinkErrorCode::InvalidResponse;
+        return false;
     }
 
-    // 종료 문자 추가
-    CommandStr += TEXT("\r");
-
-    return CommandStr;
-}
-
-// 이 함수 구현만 유지하고 다른 중복된 구현은 제거합니다
-bool UPJLinkNetworkManager::ParseResponse(const FString& ResponseString, EPJLinkCommand& OutCommand, FString& OutParameter, EPJLinkResponseStatus& OutStatus)
-{
-    // 기본값 설정
-    OutStatus = EPJLinkResponseStatus::Unknown;
-
-    // 응답 유효성 검사
-    if (ResponseString.IsEmpty() || ResponseString.Len() < 7)
+    Challenge = Challenge.TrimStartAndEnd();
+    if (Challenge.IsEmpty())
     {
+        OutErrorCode = EPJLinkErrorCode::InvalidResponse;
         return false;
     }
 
-    // 응답 클래스 및 형식 확인
-    if (!ResponseString.StartsWith(TEXT("%")) || ResponseString[2] != TEXT('='))
+    if (Password.IsEmpty())
     {
-        // 오류 응답 확인 (ERR1, ERR2, ERR3, ERR4, ERRA 등)
-        if (ResponseString.StartsWith(TEXT("ERR")))
-        {
-            if (ResponseString.Contains(TEXT("ERR1")))
-            {
-                OutStatus = EPJLinkResponseStatus::UndefinedCommand;
+        PJLINK_LOG_ERROR(TEXT("Projector requires authentication but no password is set"));
+        OutErrorCode = EPJLinkErrorCode::AuthenticationFailed;
+        return false;
+    }
+
+    PJLINK_LOG_INFO(TEXT("Authentication required"));
+
+    // MD5 해시 생성: Challenge + Password (UTF-8)
+    FTCHARToUTF8 Utf8HashSource(*(Challenge + Password));
+
+    uint8 Digest[16];
+    FMD5 Md5Gen;
+    Md5Gen.Update((uint8*)Utf8HashSource.Get(), Utf8HashSource.Length());
+    Md5Gen.Final(Digest);
+
+    // 해시를 16진수 문자열로 변환
+    OutDigest = BytesToHexLower(Digest, 16);
+    return true;
+}
+
+void UPJLinkNetworkManager::SetPendingAuthDigest(const FString& Digest)
+{
+    FScopeLock Lock(&InFlightLock);
+    PendingAuthDigest.Reset();
+    if (!Digest.IsEmpty())
+    {
+        FTCHARToUTF8 Utf8Digest(*Digest);
+        PendingAuthDigest.Append(reinterpret_cast<const uint8*>(Utf8Digest.Get()), Utf8Digest.Length());
+    }
+}
+
+void UPJLinkNetworkManager::DisconnectFromProjector()
+{
+    // 명시적 해제 - 예약된 재연결, 알림 수신, 유휴 세션의 대기 명령도 함께 버림
+    FPJLinkReconnectScheduler::Get().Cancel(this);
+    FPJLinkNotificationListener::Get().Unregister(this);
+    DiscardDeferredBatches(TEXT("Disconnected"));
+    CloseConnection();
+}
+
+void UPJLinkNetworkManager::CloseConnection()
+{
+    // 진행 중인 비동기 연결 취소 (연결 객체도 함께 닫힘)
+    CancelConnect();
+
+    // 연결 분리 (수신자 분리 후 리액터가 소켓을 닫음)
+    TSharedPtr<FPJLinkConnection, ESPMode::ThreadSafe> ConnectionToClose;
+    FPJLinkTimerId KeepAliveTimerToCancel = 0;
+    {
+        FScopeLock Lock(&ConnectionLock);
+        ConnectionToClose = MoveTemp(Connection);
+        Connection.Reset();
+        KeepAliveTimerToCancel = KeepAliveTimerId;
+        KeepAliveTimerId = 0;
+    }
+
+    if (KeepAliveTimerToCancel != 0)
+    {
+        FPJLinkIOReactor::Get().CancelTimer(KeepAliveTimerToCancel);
+    }
+
+    if (ConnectionToClose.IsValid())
+    {
+        ConnectionToClose->Close();
+    }
+
+    // 연결 상태 업데이트
+    const bool bWasConnected = bConnected.exchange(false);
+    {
+        FScopeLock Lock(&ConnectionLock);
+        ConnectPhase = EPJLinkConnectPhase::Idle;
+    }
+    ClearInFlightCommands();
+
+    // 프로젝터 정보 업데이트
+    {
+        FScopeLock InfoLock(&ProjectorInfoLock);
+        CurrentProjectorInfo.bIsConnected = false;
+    }
+
+    if (bWasConnected)
+    {
+        EnqueueConnectionChanged(false);
+    }
+}
+
+bool UPJLinkNetworkManager::DeferUntilReconnected(TArrayView<const FPJLinkBatchCommand> Commands, float TimeoutSeconds, int32& OutFirstSequenceId)
+{
+    if (bConnected.load(std::memory_order_acquire))
+    {
+        return false;
+    }
+
+    bool bStartReconnect = false;
+    {
+        FScopeLock Lock(&ConnectionLock);
+        if (!bSessionDormant)
+        {
+            return false;
+        }
+
+        // 이미 다시 연결 중이면 큐에만 추가
+        bStartReconnect = ConnectPhase == EPJLinkConnectPhase::Idle;
+        if (bStartReconnect)
+        {
+            ++SessionStats.OnDemandReconnectCount;
+        }
+        SessionStats.DeferredCommandCount += Commands.Num();
+
+        // 연결 완료 처리가 큐를 꺼내는 것과 겹치지 않도록 ConnectionLock 안에서 추가
+        FPJLinkDeferredBatch& Batch = DeferredBatches.AddDefaulted_GetRef();
+        Batch.Commands.Append(Commands.GetData(), Commands.Num());
+        Batch.TimeoutSeconds = TimeoutSeconds;
+        Batch.QueuedTime = FPlatformTime::Seconds();
+        {
+            FScopeLock InFlightScope(&InFlightLock);
+            if (NextSequenceId > MAX_int32 - Commands.Num())
+            {
+                NextSequenceId = 1;
             }
-            else if (ResponseString.Contains(TEXT("ERR2")))
+            Batch.FirstSequenceId = NextSequenceId;
+            NextSequenceId += Commands.Num();
+        }
+        OutFirstSequenceId = Batch.FirstSequenceId;
+    }
+
+    if (bStartReconnect)
+    {
+        FPJLinkProjectorInfo ProjectorInfo;
+        {
+            FScopeLock InfoLock(&ProjectorInfoLock);
+            ProjectorInfo = LastProjectorInfo;
+        }
+
+        PJLINK_LOG_VERBOSE(TEXT("Reconnecting idle session to %s:%d for queued command"), *ProjectorInfo.IPAddress, ProjectorInfo.Port);
+        StartConnect(ProjectorInfo);
+    }
+
+    return true;
+}
+
+void UPJLinkNetworkManager::DiscardDeferredBatches(const TCHAR* Reason)
+{
+    TArray<FPJLinkDeferredBatch> Discarded;
+    {
+        FScopeLock Lock(&ConnectionLock);
+        bSessionDormant = false;
+        Discarded = MoveTemp(DeferredBatches);
+        DeferredBatches.Reset();
+    }
+
+    // 호출자가 받은 순번마다 완료가 한 번씩 가도록 응답 없음으로 보고
+    int32 NumDiscarded = 0;
+    for (const FPJLinkDeferredBatch& Batch : Discarded)
+    {
+        for (int32 Index = 0; Index < Batch.Commands.Num(); ++Index)
+        {
+            EnqueueResponseEvent(Batch.Commands[Index].Command, EPJLinkResponseStatus::NoResponse, Reason, Batch.FirstSequenceId + Index);
+        }
+        NumDiscarded += Batch.Commands.Num();
+    }
+
+    if (NumDiscarded > 0)
+    {
+        EmitError(EPJLinkErrorCode::CommandFailed,
+            FString::Printf(TEXT("%d queued command(s) dropped: %s"), NumDiscarded, Reason));
+    }
+}
+
+void UPJLinkNetworkManager::OnSessionEstablished()
+{
+    const double Now = FPlatformTime::Seconds();
+    LastActivityCycles.store(FPlatformTime::Cycles64());
+
+    TArray<FPJLinkDeferredBatch> Batches;
+    {
+        FScopeLock Lock(&ConnectionLock);
+        bSessionDormant = false;
+        Batches = MoveTemp(DeferredBatches);
+        DeferredBatches.Reset();
+
+        // 연결 비용 기록 (TCP 연결 + 인사말/인증)
+        if (ConnectStartTime > 0.0)
+        {
+            const float ConnectMs = static_cast<float>((Now - ConnectStartTime) * 1000.0);
+            ++SessionStats.ConnectCount;
+            SessionStats.LastConnectMs = ConnectMs;
+            SessionStats.AverageConnectMs += (ConnectMs - SessionStats.AverageConnectMs) / SessionStats.ConnectCount;
+            SessionStats.MaxConnectMs = FMath::Max(SessionStats.MaxConnectMs, ConnectMs);
+            ConnectStartTime = 0.0;
+        }
+
+        // 유휴 시간이 차기 전에 조회를 보내도록 세션 유지 타이머 예약
+        if (SessionPolicy == EPJLinkSessionPolicy::KeepAlive && Connection.IsValid() && KeepAliveTimerId == 0)
+        {
+            const double Interval = FMath::Max(SessionIdleTimeoutSeconds - KeepAliveMarginSeconds, MinKeepAliveIntervalSeconds);
+            KeepAliveTimerId = Connection->ScheduleTimer(Interval, KeepAliveTimerCookie);
+        }
+    }
+
+    // 세션이 생긴 프로젝터의 상태 알림 수신 (프로젝터는 마지막으로 명령을 보낸 컨트롤러로 알림을 보냄)
+    UpdateNotificationRegistration();
+
+    if (Batches.Num() == 0)
+    {
+        RequestStatus();
+        return;
+    }
+
+    // 유휴 종료 뒤 큐에 넣었던 명령을 받은 순서대로 전송 (인증 해시는 첫 묶음 앞에 붙음)
+    // 응답 왕복 시간은 큐에 넣은 시점부터 계산되어 재연결 비용이 포함됨
+    for (const FPJLinkDeferredBatch& Batch : Batches)
+    {
+        SendBatchNow(Batch.Commands, Batch.TimeoutSeconds, Batch.FirstSequenceId, Batch.QueuedTime);
+    }
+}
+
+// 리액터 I/O 스레드에서 호출 - 유휴 시간이 차기 전에 가벼운 조회로 세션 유지
+void UPJLinkNetworkManager::HandleKeepAliveTimer()
+{
+    const double Interval = FMath::Max(SessionIdleTimeoutSeconds - KeepAliveMarginSeconds, MinKeepAliveIntervalSeconds);
+    double NextDelay = Interval - GetIdleSeconds();
+
+    const bool bKeepAlive = SessionPolicy == EPJLinkSessionPolicy::KeepAlive && bConnected.load(std::memory_order_acquire);
+    if (bKeepAlive && NextDelay <= 0.0)
+    {
+        // 응답은 일반 전원 상태 응답과 같이 처리됨
+        static const FPJLinkBatchCommand KeepAliveQuery(EPJLinkCommand::POWR, TEXT("?"));
+        if (SendBatchNow(MakeArrayView(&KeepAliveQuery, 1), 0.0f, 0, FPlatformTime::Seconds()) != 0)
+        {
+            FScopeLock Lock(&ConnectionLock);
+            ++SessionStats.KeepAliveCount;
+        }
+        NextDelay = Interval;
+    }
+
+    FScopeLock Lock(&ConnectionLock);
+    KeepAliveTimerId = 0;
+    if (bKeepAlive && Connection.IsValid())
+    {
+        KeepAliveTimerId = Connection->ScheduleTimer(FMath::Max(NextDelay, MinKeepAliveIntervalSeconds), KeepAliveTimerCookie);
+    }
+}
+
+double UPJLinkNetworkManager::GetIdleSeconds() const
+{
+    const uint64 LastCycles = LastActivityCycles.load();
+    return LastCycles != 0 ? FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - LastCycles) : 0.0;
+}
+
+FPJLinkSessionStats UPJLinkNetworkManager::GetSessionStats() const
+{
+    FScopeLock Lock(&ConnectionLock);
+    return SessionStats;
+}
+
+void UPJLinkNetworkManager::ResetSessionStats()
+{
+    FScopeLock Lock(&ConnectionLock);
+    SessionStats = FPJLinkSessionStats();
+}
+
+bool UPJLinkNetworkManager::IsSessionDormant() const
+{
+    FScopeLock Lock(&ConnectionLock);
+    return bSessionDormant;
+}
+
+bool UPJLinkNetworkManager::SendCommand(EPJLinkCommand Command, const FString& Parameter)
+{
+    // 타임아웃 없이 순번만 붙여 전송 (응답 짝짓기를 위해 FIFO 에는 항상 기록)
+    return SendCommandWithSequence(Command, Parameter, 0.0f) != 0;
+}
+
+int32 UPJLinkNetworkManager::SendCommandWithSequence(EPJLinkCommand Command, const FString& Parameter, float TimeoutSeconds)
+{
+    // 진단 데이터 기록 시작
+    PJLINK_CAPTURE_DIAGNOSTIC(LastCommandDiagnosticData, TEXT("Sending command: %s, Parameter: %s"),
+        *PJLinkHelpers::CommandToString(Command), *Parameter);
+
+    const FPJLinkBatchCommand SingleCommand(Command, Parameter);
+    return SendCommandBatch(MakeArrayView(&SingleCommand, 1), TimeoutSeconds);
+}
+
+int32 UPJLinkNetworkManager::SendCommandBatch(TArrayView<const FPJLinkBatchCommand> Commands, float TimeoutSeconds)
+{
+    if (Commands.Num() == 0)
+    {
+        return 0;
+    }
+
+    // 프로젝터가 유휴 세션을 닫았으면 명령을 큐에 넣고 다시 연결 (인사말 직후 한 번에 전송)
+    int32 DeferredSequenceId = 0;
+    if (DeferUntilReconnected(Commands, TimeoutSeconds, DeferredSequenceId))
+    {
+        return DeferredSequenceId;
+    }
+
+    return SendBatchNow(Commands, TimeoutSeconds, 0, FPlatformTime::Seconds());
+}
+
+int32 UPJLinkNetworkManager::SendBatchNow(TArrayView<const FPJLinkBatchCommand> Commands, float TimeoutSeconds, int32 PreassignedSequenceId, double SendTime)
+{
+    const EPJLinkCommand FirstCommand = Commands[0].Command;
+
+    // 연결 직후 I/O 스레드에서도 호출되므로 진단 데이터는 게임 스레드에서만 기록
+    const bool bCaptureDiagnostics = IsInGameThread();
+
+    // 연결 객체 확보
+    TSharedPtr<FPJLinkConnection, ESPMode::ThreadSafe> LocalConnection;
+    {
+        FScopeLock Lock(&ConnectionLock);
+        LocalConnection = Connection;
+    }
+
+    // 호출 전 NULL 및 연결 상태 검사
+    if (!LocalConnection.IsValid())
+    {
+        if (bCaptureDiagnostics)
+        {
+            PJLINK_CAPTURE_DIAGNOSTIC(LastCommandDiagnosticData, TEXT("Cannot send command: Socket is null"));
+        }
+        EmitError(EPJLinkErrorCode::SocketError, TEXT("Cannot send command: Socket is null"), FirstCommand);
+        return 0;
+    }
+
+    if (!bConnected.load(std::memory_order_acquire))
+    {
+        if (bCaptureDiagnostics)
+        {
+            PJLINK_CAPTURE_DIAGNOSTIC(LastCommandDiagnosticData, TEXT("Cannot send command: Not connected"));
+        }
+        EmitError(EPJLinkErrorCode::SocketError, TEXT("Cannot send command: Not connected"), FirstCommand);
+        return 0;
+    }
+
+    EPJLinkClass ProtocolClass;
+    {
+        FScopeLock InfoLock(&ProjectorInfoLock);
+        ProtocolClass = CurrentProjectorInfo.DeviceClass;
+    }
+
+    // 모든 명령을 미리 크기를 잡은 버퍼 하나에 바로 인코딩 (FString 변환 없음)
+    TArray<uint8> SendBuffer;
+    SendBuffer.Reserve(Commands.Num() * PJLinkCommandEncoder::MaxEncodedCommandLength);
+    for (const FPJLinkBatchCommand& BatchCommand : Commands)
+    {
+        const int32 Offset = SendBuffer.Num();
+        if (PJLinkCommandEncoder::AppendCommand(SendBuffer, BatchCommand.Command, ProtocolClass, BatchCommand.Parameter) == 0)
+        {
+            if (bCaptureDiagnostics)
             {
-                OutStatus = EPJLinkResponseStatus::OutOfParameter;
+                PJLINK_CAPTURE_DIAGNOSTIC(LastCommandDiagnosticData, TEXT("Failed to build command string"));
             }
-            else if (ResponseString.Contains(TEXT("ERR3")))
+            EmitError(EPJLinkErrorCode::CommandFailed, TEXT("Failed to build command string"), BatchCommand.Command);
+            return 0;
+        }
+
+        // 통신 로깅 (명령 전송)
+        if (bLogCommunication)
+        {
+            LogCommunication(true, *PJLinkHelpers::CommandToString(BatchCommand.Command),
+                SendBuffer.GetData() + Offset, SendBuffer.Num() - Offset);
+        }
+    }
+
+    const int32 NumBytes = SendBuffer.Num();
+    int32 FirstSequenceId = 0;
+    TArray<FPJLinkCommandInfo, TInlineAllocator<4>> Dropped;
+
+    // FIFO 기록과 송신 큐 삽입을 한 락 안에서 수행해 FIFO 순서와 전송 순서를 일치시킴
+    // (Send 는 큐에 넣기만 하므로 락 구간은 마이크로초 단위)
+    {
+        FScopeLock Lock(&InFlightLock);
+
+        // 한 묶음의 순번은 항상 연속되도록 wrap 은 묶음 단위로 처리
+        // (다시 연결을 기다리던 묶음은 큐에 넣을 때 받은 순번을 그대로 씀)
+        if (PreassignedSequenceId != 0)
+        {
+            FirstSequenceId = PreassignedSequenceId;
+        }
+        else
+        {
+            if (NextSequenceId > MAX_int32 - Commands.Num())
             {
-                OutStatus = EPJLinkResponseStatus::UnavailableTime;
+                NextSequenceId = 1;
             }
-            else if (ResponseString.Contains(TEXT("ERR4")))
+            FirstSequenceId = NextSequenceId;
+            NextSequenceId += Commands.Num();
+        }
+
+        // 연결 후 첫 송신이면 인증 응답 해시를 앞에 붙임 (별도 쓰기/왕복 없음)
+        if (PendingAuthDigest.Num() > 0)
+        {
+            SendBuffer.Insert(PendingAuthDigest, 0);
+            PendingAuthDigest.Reset();
+        }
+
+        // 한 번의 송신으로 전송 - TCP_NODELAY 가 켜져 있으므로 묶음 하나가 곧바로 세그먼트 하나로 나감
+        if (!LocalConnection->Send(MoveTemp(SendBuffer)))
+        {
+            FString ErrorMessage = FString::Printf(TEXT("Failed to send command. Error: %d"), PJLinkSocketPlatform::GetLastErrorCode());
+            if (bCaptureDiagnostics)
             {
-                OutStatus = EPJLinkResponseStatus::ProjectorFailure;
+                PJLINK_CAPTURE_DIAGNOSTIC(LastCommandDiagnosticData, TEXT("%s"), *ErrorMessage);
             }
-            else if (ResponseString.Contains(TEXT("ERRA")))
+            EmitError(EPJLinkErrorCode::SocketError, ErrorMessage, FirstCommand);
+            return 0;
+        }
+        LastActivityCycles.store(FPlatformTime::Cycles64());
+
+        for (int32 Index = 0; Index < Commands.Num(); ++Index)
+        {
+            // 응답 없는 장비에서 FIFO 가 무한히 커지지 않도록 가장 오래된 항목 제거 (완료는 락 밖에서 보고)
+            if (InFlightCommands.Num() >= MaxInFlightCommands)
             {
-                OutStatus = EPJLinkResponseStatus::AuthenticationError;
+                Dropped.Add(InFlightCommands[0]);
+                InFlightCommands.RemoveAt(0, 1, EAllowShrinking::No);
             }
 
-            return true;
+            FPJLinkCommandInfo& CommandInfo = InFlightCommands.AddDefaulted_GetRef();
+            CommandInfo.SequenceId = FirstSequenceId + Index;
+            CommandInfo.Command = Commands[Index].Command;
+            CommandInfo.SendTime = SendTime;
+            CommandInfo.TimeoutSeconds = TimeoutSeconds;
+
+            // 타임아웃은 리액터 타이밍 휠에서 처리 - UWorld 나 게임 스레드 틱 없이도 만료됨
+            // 응답 처리와 같은 I/O 스레드에서 호출되므로 응답과 타임아웃이 경쟁하지 않음
+            if (TimeoutSeconds > 0.0f)
+            {
+                CommandInfo.TimeoutTimerId = LocalConnection->ScheduleTimer(TimeoutSeconds, static_cast<uint64>(CommandInfo.SequenceId));
+            }
         }
+    }
 
+    // 밀려난 명령도 순번마다 완료가 한 번씩 가도록 응답 없음으로 보고 (이미 타임아웃으로 보고된 항목 제외)
+    for (const FPJLinkCommandInfo& Info : Dropped)
+    {
+        if (Info.bTimedOut)
+        {
+            continue;
+        }
+
+        LocalConnection->CancelTimer(Info.TimeoutTimerId);
+        PJLINK_LOG_WARNING(TEXT("Too many commands in flight, dropping %s #%d"),
+            *PJLinkHelpers::CommandToString(Info.Command), Info.SequenceId);
+        EnqueueResponseEvent(Info.Command, EPJLinkResponseStatus::NoResponse, TEXT("No response"), Info.SequenceId);
+    }
+
+    if (bCaptureDiagnostics)
+    {
+        PJLINK_CAPTURE_DIAGNOSTIC(LastCommandDiagnosticData, TEXT("%d command(s) sent from #%d. Bytes: %d"),
+            Commands.Num(), FirstSequenceId, NumBytes);
+    }
+    PJLINK_LOG_VERBOSE(TEXT("Sent %d command(s) from #%d (%d bytes)"), Commands.Num(), FirstSequenceId, NumBytes);
+    return FirstSequenceId;
+}
+
+int32 UPJLinkNetworkManager::GetInFlightCommandCount() const
+{
+    FScopeLock Lock(&InFlightLock);
+    return InFlightCommands.Num();
+}
+
+// 리액터 I/O 스레드에서 호출 - 응답을 전송 순서상 가장 앞선 같은 명령의 요청과 짝지음
+int32 UPJLinkNetworkManager::MatchInFlightCommand(EPJLinkCommand Command, double& OutRoundTripSeconds)
+{
+    OutRoundTripSeconds = 0.0;
+
+    TArray<FPJLinkCommandInfo, TInlineAllocator<4>> Skipped;
+    FPJLinkTimerId MatchedTimerId = 0;
+    int32 SequenceId = 0;
+    {
+        FScopeLock Lock(&InFlightLock);
+
+        const int32 MatchIndex = InFlightCommands.IndexOfByPredicate([Command](const FPJLinkCommandInfo& Info)
+        {
+            return Info.Command == Command;
+        });
+
+        if (MatchIndex == INDEX_NONE)
+        {
+            return 0;
+        }
+
+        // 응답은 요청 순서대로 오므로 앞선 요청들은 응답을 받지 못한 것
+        for (int32 Index = 0; Index < MatchIndex; ++Index)
+        {
+            if (!InFlightCommands[Index].bTimedOut)
+            {
+                Skipped.Add(InFlightCommands[Index]);
+            }
+        }
+
+        const FPJLinkCommandInfo& Matched = InFlightCommands[MatchIndex];
+        MatchedTimerId = Matched.TimeoutTimerId;
+        if (!Matched.bTimedOut)
+        {
+            SequenceId = Matched.SequenceId;
+            OutRoundTripSeconds = FPlatformTime::Seconds() - Matched.SendTime;
+        }
+
+        InFlightCommands.RemoveAt(0, MatchIndex + 1, EAllowShrinking::No);
+    }
+
+    // 같은 I/O 스레드의 휠에서 바로 취소됨 (만료된 타이머면 무시)
+    FPJLinkIOReactor& Reactor = FPJLinkIOReactor::Get();
+    Reactor.CancelTimer(MatchedTimerId);
+
+    for (const FPJLinkCommandInfo& Info : Skipped)
+    {
+        Reactor.CancelTimer(Info.TimeoutTimerId);
+
+        PJLINK_LOG_WARNING(TEXT("No response for %s #%d (answered out of order)"),
+            *PJLinkHelpers::CommandToString(Info.Command), Info.SequenceId);
+
+        // 네이티브/동적 수신자가 같은 완료를 받도록 타임아웃과 같은 경로로 보고
+        EnqueueResponseEvent(Info.Command, EPJLinkResponseStatus::NoResponse, TEXT("No response"), Info.SequenceId);
+    }
+
+    if (SequenceId != 0)
+    {
+        PJLINK_LOG_VERBOSE(TEXT("Response received for %s #%d in %.3f seconds"),
+            *PJLinkHelpers::CommandToString(Command), SequenceId, OutRoundTripSeconds);
+    }
+
+    return SequenceId;
+}
+
+void UPJLinkNetworkManager::ClearInFlightCommands()
+{
+    TArray<FPJLinkCommandInfo> Cleared;
+    {
+        FScopeLock Lock(&InFlightLock);
+        Cleared = MoveTemp(InFlightCommands);
+        InFlightCommands.Reset();
+        PendingAuthDigest.Reset();
+    }
+
+    // 정리된 명령의 타임아웃이 휠에 남지 않도록 취소하고, 순번마다 완료가 한 번씩 가도록 응답 없음으로 보고
+    // (이미 타임아웃으로 보고된 항목 제외)
+    FPJLinkIOReactor& Reactor = FPJLinkIOReactor::Get();
+    for (const FPJLinkCommandInfo& Info : Cleared)
+    {
+        if (Info.bTimedOut)
+        {
+            continue;
+        }
+
+        if (Info.TimeoutTimerId != 0)
+        {
+            Reactor.CancelTimer(Info.TimeoutTimerId);
+        }
+        EnqueueResponseEvent(Info.Command, EPJLinkResponseStatus::NoResponse, TEXT("Connection closed"), Info.SequenceId);
+    }
+}
+
+
+FPJLinkProjectorInfo UPJLinkNetworkManager::GetProjectorInfo() const
+{
+    FScopeLock InfoLock(&ProjectorInfoLock);
+    return CurrentProjectorInfo;
+}
+
+bool UPJLinkNetworkManager::IsConnected() const
+{
+    // 원자적 변수 사용으로 락이 필요 없음
+    return bConnected.load(std::memory_order_acquire);
+}
+
+bool UPJLinkNetworkManager::PowerOn()
+{
+    return SendCommandWithTimeout(EPJLinkCommand::POWR, TEXT("1"), 10.0f); // 전원 켜기는 더 긴 타임아웃
+}
+
+bool UPJLinkNetworkManager::PowerOff()
+{
+    return SendCommandWithTimeout(EPJLinkCommand::POWR, TEXT("0"), 5.0f);
+}
+
+bool UPJLinkNetworkManager::SwitchInputSource(EPJLinkInputSource InputSource)
+{
+    FString Parameter;
+
+    switch (InputSource)
+    {
+    case EPJLinkInputSource::RGB:
+        Parameter = TEXT("1");
+        break;
+    case EPJLinkInputSource::VIDEO:
+        Parameter = TEXT("2");
+        break;
+    case EPJLinkInputSource::DIGITAL:
+        Parameter = TEXT("3");
+        break;
+    case EPJLinkInputSource::STORAGE:
+        Parameter = TEXT("4");
+        break;
+    case EPJLinkInputSource::NETWORK:
+        Parameter = TEXT("5");
+        break;
+    default:
         return false;
     }
 
-    // 명령 파싱
-    FString CommandStr = ResponseString.Mid(2, 4);
+    return SendCommandWithTimeout(EPJLinkCommand::INPT, Parameter, 5.0f);
+}
+
+bool UPJLinkNetworkManager::RequestStatus()
+{
+    // 여러 상태 정보 조회를 한 번의 송신으로 요청 (응답은 순번으로 각각 짝지어짐)
+    static const FPJLinkBatchCommand StatusQueries[] =
+    {
+        FPJLinkBatchCommand(EPJLinkCommand::POWR, TEXT("?")),  // 전원 상태
+        FPJLinkBatchCommand(EPJLinkCommand::INPT, TEXT("?")),  // 입력 소스
+        FPJLinkBatchCommand(EPJLinkCommand::NAME, TEXT("?")),  // 프로젝터 이름
+        FPJLinkBatchCommand(EPJLinkCommand::INF1, TEXT("?")),  // 제조사
+        FPJLinkBatchCommand(EPJLinkCommand::INF2, TEXT("?")),  // 제품명
+        FPJLinkBatchCommand(EPJLinkCommand::CLSS, TEXT("?")),  // 클래스 정보
+    };
+
+    return SendCommandBatch(MakeArrayView(StatusQueries), 0.0f) != 0;
+}
+
+
+// 리액터 I/O 스레드에서 호출 - 수신 데이터를 프레임 단위로 재조립해 처리
+void UPJLinkNetworkManager::OnConnectionData(const uint8* Data, int32 Length)
+{
+    LastActivityCycles.store(FPlatformTime::Cycles64());
+
+    // PJLink 응답은 CR(0x0D)로 끝남 - 수신 조각과 무관하게 완성된 프레임 단위로 처리
+    FrameAssembler.Feed(Data, Length, [this](const uint8* Frame, int32 FrameLength)
+    {
+        HandleResponseFrame(Frame, FrameLength);
+    });
+}
+
+void UPJLinkNetworkManager::HandleResponseFrame(const uint8* Frame, int32 Length)
+{
+    // 통신 로깅 (응답 수신) - 로깅이 켜진 경우에만 문자열 생성
+    if (bLogCommunication)
+    {
+        LogCommunication(false, TEXT("RESPONSE"), Frame, Length);
+    }
+
+    // 비동기 연결의 첫 줄은 인증 인사말
+    if (bHandshakePending.load(std::memory_order_relaxed))
+    {
+        HandleGreeting(Frame, Length);
+        return;
+    }
+
+    // 첫 명령에 붙인 응답 해시가 틀리면 프로젝터가 "PJLINK ERRA" 를 보내고 연결을 끊음
+    static constexpr ANSICHAR AuthErrorLine[] = "PJLINK ERRA";
+    if (Length >= UE_ARRAY_COUNT(AuthErrorLine) - 1 && FMemory::Memcmp(Frame, AuthErrorLine, UE_ARRAY_COUNT(AuthErrorLine) - 1) == 0)
+    {
+        EmitError(EPJLinkErrorCode::AuthenticationFailed, TEXT("Projector rejected the authentication response"));
+        return;
+    }
+
+    FPJLinkParsedFrame Parsed;
+    if (!PJLinkResponseParser::ParseFrame(Frame, Length, Parsed))
+    {
+        PJLINK_LOG_VERBOSE(TEXT("Ignoring unparsed line: %s"), *FrameToString(Frame, Length));
+        return;
+    }
+
+    if (Parsed.Status == EPJLinkResponseStatus::Success)
+    {
+        UpdateProjectorInfo(Frame, Parsed);
+    }
+
+    // 짝짓기를 먼저 해야 건너뛴 요청의 응답 누락 이벤트가 이 응답보다 앞에 놓임
+    int32 SequenceId = 0;
+    double RoundTripSeconds = 0.0;
+    if (Parsed.bHasCommand)
+    {
+        SequenceId = MatchInFlightCommand(Parsed.Command, RoundTripSeconds);
+    }
+
+    DispatchResponseFrame(Frame, Parsed, SequenceId, RoundTripSeconds);
+}
+
+// 알림 수신기에서 호출 (I/O 스레드) - 요청 없이 온 상태 변경 알림
+void UPJLinkNetworkManager::HandleNotificationFrame(const uint8* Frame, int32 Length)
+{
+    NotificationCount++;
+
+    if (bLogCommunication)
+    {
+        LogCommunication(false, TEXT("NOTIFY"), Frame, Length);
+    }
+
+    // "%2LKUP=<MAC>" - 프로젝터 네트워크가 켜짐 (TCP 세션은 이미 끊긴 상태)
+    static constexpr ANSICHAR LinkUpBody[] = "LKUP=";
+    if (Length > 2 + UE_ARRAY_COUNT(LinkUpBody) - 1 && Frame[0] == '%'
+        && FMemory::Memcmp(Frame + 2, LinkUpBody, UE_ARRAY_COUNT(LinkUpBody) - 1) == 0)
+    {
+        PJLINK_LOG_INFO(TEXT("Projector network link up: %s"), *FrameToString(Frame, Length));
+
+        // 끊긴 채로 있던 세션은 재연결 예약 (유휴 종료된 세션은 다음 명령에서 다시 연결)
+        bool bShouldReconnect = false;
+        {
+            FScopeLock Lock(&ConnectionLock);
+            bShouldReconnect = bAutoReconnect && !bSessionDormant && !Connection.IsValid() && ConnectPhase == EPJLinkConnectPhase::Idle;
+        }
+        if (bShouldReconnect)
+        {
+            FPJLinkReconnectScheduler::Get().Schedule(this, ReconnectInterval, MaxReconnectAttempts);
+        }
+        return;
+    }
+
+    FPJLinkParsedFrame Parsed;
+    if (!PJLinkResponseParser::ParseFrame(Frame, Length, Parsed) || !Parsed.bHasCommand)
+    {
+        PJLINK_LOG_VERBOSE(TEXT("Ignoring unparsed notification: %s"), *FrameToString(Frame, Length));
+        return;
+    }
+
+    if (Parsed.Status == EPJLinkResponseStatus::Success)
+    {
+        UpdateProjectorInfo(Frame, Parsed);
+    }
+
+    // 응답과 같은 경로로 전달 - 요청과 짝짓지 않으므로 순번 0
+    DispatchResponseFrame(Frame, Parsed, 0, 0.0);
+}
+
+void UPJLinkNetworkManager::DispatchResponseFrame(const uint8* Frame, const FPJLinkParsedFrame& Parsed, int32 SequenceId, double RoundTripSeconds)
+{
+    // 네이티브 처리기는 게임 스레드 큐를 거치지 않고 여기서 바로 호출 (파라미터는 프레임을 그대로 가리킴)
+    if (NativeEvents.OnResponse.IsBound())
+    {
+        FPJLinkNativeResponse Response;
+        Response.SequenceId = SequenceId;
+        Response.Command = Parsed.Command;
+        Response.Status = Parsed.Status;
+        Response.Parameter = FAnsiStringView(reinterpret_cast<const ANSICHAR*>(Frame + Parsed.ParameterOffset), Parsed.ParameterLength);
+        Response.RoundTripSeconds = RoundTripSeconds;
+        Response.bFromProjector = Parsed.bHasCommand;
+        NativeEvents.OnResponse.Broadcast(this, Response);
+    }
+
+    // 파라미터는 풀링된 이벤트의 문자열 버퍼로 바로 변환
+    EventQueue.Enqueue([Frame, &Parsed, SequenceId, RoundTripSeconds](FPJLinkEvent& Event)
+    {
+        Event.Command = Parsed.Command;
+        Event.Status = Parsed.Status;
+        Event.bFromProjector = Parsed.bHasCommand;
+        Event.SequenceId = SequenceId;
+        Event.RoundTripSeconds = RoundTripSeconds;
+        PJLinkResponseParser::AppendParameter(Event.Text, Frame, Parsed);
+    });
+    ScheduleResponseDrain();
+}
+
+void UPJLinkNetworkManager::UpdateNotificationRegistration()
+{
+    if (!bListenForNotifications)
+    {
+        FPJLinkNotificationListener::Get().Unregister(this);
+        return;
+    }
 
-    // 명령 타입 결정
-    if (CommandStr.Equals(TEXT("POWR")))
+    FString IPAddress;
     {
-        OutCommand = EPJLinkCommand::POWR;
+        FScopeLock InfoLock(&ProjectorInfoLock);
+        IPAddress = CurrentProjectorInfo.IPAddress;
     }
-    else if (CommandStr.Equals(TEXT("INPT")))
+
+    FIPv4Address IP;
+    if (FIPv4Address::Parse(IPAddress, IP))
     {
-        OutCommand = EPJLinkCommand::INPT;
+        FPJLinkNotificationListener::Get().Register(this, IP.Value);
     }
-    else if (CommandStr.Equals(TEXT("AVMT")))
+}
+
+bool UPJLinkNetworkManager::IsReceivingNotifications() const
+{
+    return NotificationCount.load() > 0;
+}
+
+int32 UPJLinkNetworkManager::GetNotificationCount() const
+{
+    return NotificationCount.load();
+}
+
+// 리액터 I/O 스레드에서 호출 - 원격 종료 또는 소켓 오류
+void UPJLinkNetworkManager::OnConnectionClosed(int32 ErrorCode)
+{
+    // 비동기 연결 중 실패 (연결 거부, 인증 중 종료 등) - 재연결 없이 시도만 실패로 완료
+    bool bConnectPending = false;
     {
-        OutCommand = EPJLinkCommand::AVMT;
+        FScopeLock Lock(&ConnectionLock);
+        bConnectPending = ConnectPhase == EPJLinkConnectPhase::Connecting || ConnectPhase == EPJLinkConnectPhase::Handshaking;
+        if (!bConnectPending)
+        {
+            ConnectPhase = EPJLinkConnectPhase::Idle;
+        }
     }
-    else if (CommandStr.Equals(TEXT("ERST")))
+    if (bConnectPending)
     {
-        OutCommand = EPJLinkCommand::ERST;
+        FString Address;
+        {
+            FScopeLock InfoLock(&ProjectorInfoLock);
+            Address = FString::Printf(TEXT("%s:%d"), *CurrentProjectorInfo.IPAddress, CurrentProjectorInfo.Port);
+        }
+        CompleteConnect(false, EPJLinkErrorCode::ConnectionFailed,
+            FString::Printf(TEXT("Failed to connect to %s - Error: %d"), *Address, ErrorCode));
+        return;
     }
-    else if (CommandStr.Equals(TEXT("LAMP")))
+
+    const bool bWasConnected = bConnected.exchange(false);
+    FrameAssembler.Reset();
+    ClearInFlightCommands();
+
     {
-        OutCommand = EPJLinkCommand::LAMP;
+        FScopeLock InfoLock(&ProjectorInfoLock);
+        CurrentProjectorInfo.bIsConnected = false;
     }
-    else if (CommandStr.Equals(TEXT("INST")))
+
+    // 유휴 시간이 거의 찬 상태에서 정상 종료되면 프로젝터의 유휴 세션 종료로 판단
+    // (오류가 아니므로 바로 재연결하지 않고 다음 명령에서 다시 연결)
+    const double IdleSeconds = GetIdleSeconds();
+    const bool bIdleDrop = bWasConnected && ErrorCode == 0 && IdleSeconds >= SessionIdleTimeoutSeconds * IdleDropThreshold;
+    FPJLinkTimerId KeepAliveTimerToCancel = 0;
     {
-        OutCommand = EPJLinkCommand::INST;
+        FScopeLock Lock(&ConnectionLock);
+        KeepAliveTimerToCancel = KeepAliveTimerId;
+        KeepAliveTimerId = 0;
+        if (bIdleDrop)
+        {
+            ++SessionStats.IdleDropCount;
+            bSessionDormant = SessionPolicy == EPJLinkSessionPolicy::ReconnectOnDemand;
+        }
     }
-    else if (CommandStr.Equals(TEXT("NAME")))
+
+    if (KeepAliveTimerToCancel != 0)
     {
-        OutCommand = EPJLinkCommand::NAME;
+        FPJLinkIOReactor::Get().CancelTimer(KeepAliveTimerToCancel);
     }
-    else if (CommandStr.Equals(TEXT("INF1")))
+
+    if (bIdleDrop)
     {
-        OutCommand = EPJLinkCommand::INF1;
+        PJLINK_LOG_INFO(TEXT("Projector closed idle session after %.1f seconds"), IdleSeconds);
     }
-    else if (CommandStr.Equals(TEXT("INF2")))
+    else
     {
-        OutCommand = EPJLinkCommand::INF2;
+        EmitError(EPJLinkErrorCode::ConnectionFailed,
+            FString::Printf(TEXT("Connection closed by projector (socket error %d)"), ErrorCode));
     }
-    else if (CommandStr.Equals(TEXT("INFO")))
+
+    if (bWasConnected)
     {
-        OutCommand = EPJLinkCommand::INFO;
+        EnqueueConnectionChanged(false);
     }
-    else if (CommandStr.Equals(TEXT("CLSS")))
+
+    // 필요할 때 다시 연결하는 유휴 세션은 자동 재연결 대상이 아님
+    if (bIdleDrop && SessionPolicy == EPJLinkSessionPolicy::ReconnectOnDemand)
     {
-        OutCommand = EPJLinkCommand::CLSS;
+        return;
     }
-    else
+
+    // 자동 재연결 - 전체 프로젝터가 공유하는 스케줄러가 백오프와 동시 연결 수를 관리
+    if (bAutoReconnect)
     {
-        // 알 수 없는 명령
-        return false;
+        FPJLinkReconnectScheduler::Get().Schedule(this, ReconnectInterval, MaxReconnectAttempts);
     }
+}
 
-    // 파라미터 추출
-    int32 EqualsPos = ResponseString.Find(TEXT("="));
-    if (EqualsPos != INDEX_NONE)
+// 리액터 I/O 스레드에서 호출 - 명령 타임아웃 타이머 만료
+void UPJLinkNetworkManager::OnConnectionTimer(uint64 Cookie)
+{
+    if (Cookie == ConnectTimerCookie)
     {
-        OutParameter = ResponseString.Mid(EqualsPos + 1).TrimEnd();
-
-        // 마지막 캐리지 리턴 제거
-        if (OutParameter.EndsWith(TEXT("\r")))
+        FString Address;
+        float TimeoutSeconds = 0.0f;
         {
-            OutParameter = OutParameter.LeftChop(1);
+            FScopeLock InfoLock(&ProjectorInfoLock);
+            Address = FString::Printf(TEXT("%s:%d"), *CurrentProjectorInfo.IPAddress, CurrentProjectorInfo.Port);
         }
+        {
+            FScopeLock Lock(&ConnectionLock);
+            TimeoutSeconds = ConnectTimeoutSeconds;
+        }
+        CompleteConnect(false, EPJLinkErrorCode::Timeout,
+            FString::Printf(TEXT("Connection to %s timed out after %.1f seconds"), *Address, TimeoutSeconds));
+        return;
     }
 
-    // 성공 응답
-    OutStatus = EPJLinkResponseStatus::Success;
-
-    // 응답이 성공적으로 파싱되었다면 타임아웃 취소
-    if (OutStatus != EPJLinkResponseStatus::Unknown)
+    if (Cookie == KeepAliveTimerCookie)
     {
-        FScopeLock Lock(&CommandTrackingLock);
-
-        // 해당 명령이 트래킹 중인지 확인
-        if (FPJLinkCommandInfo* CommandInfo = PendingCommands.Find(OutCommand))
-        {
-            // 응답 받음 표시
-            CommandInfo->bResponseReceived = true;
-
-            // 타임아웃 타이머 취소
-            if (FTimerHandle* TimerHandle = CommandTimeoutHandles.Find(OutCommand))
-            {
-                if (UWorld* World = GetWorld())
-                {
-                    World->GetTimerManager().ClearTimer(*TimerHandle);
-                }
-                CommandTimeoutHandles.Remove(OutCommand);
-            }
-
-            // 적절한 시간 내에 응답이 왔는지 확인
-            double ResponseTime = FPlatformTime::Seconds() - CommandInfo->SendTime;
-            PJLINK_CAPTURE_DIAGNOSTIC(LastCommandDiagnosticData,
-                TEXT("Response received for %s in %.2f seconds"),
-                *PJLinkHelpers::CommandToString(OutCommand), ResponseTime);
-
-            PJLINK_LOG_VERBOSE(TEXT("Response received for %s in %.2f seconds"),
-                *PJLinkHelpers::CommandToString(OutCommand), ResponseTime);
-
-            // 트래킹에서 제거
-            PendingCommands.Remove(OutCommand);
-        }
+        HandleKeepAliveTimer();
+        return;
     }
 
-    return (OutStatus != EPJLinkResponseStatus::Unknown);
+    HandleCommandTimeout(static_cast<int32>(Cookie));
 }
 
-void UPJLinkNetworkManager::UpdateProjectorInfo(EPJLinkCommand Command, const FString& Response)
+void UPJLinkNetworkManager::UpdateProjectorInfo(const uint8* Frame, const FPJLinkParsedFrame& Parsed)
 {
-    FScopeLock InfoLock(&ProjectorInfoLock);
+    if (!Parsed.bHasCommand)
+    {
+        return;
+    }
 
-    switch (Command)
+    const uint8* Parameter = Frame + Parsed.ParameterOffset;
+    const int32 ParameterLength = Parsed.ParameterLength;
+
+    switch (Parsed.Command)
     {
     case EPJLinkCommand::POWR:
-        // 전원 상태 업데이트
-        if (Response.Equals(TEXT("0")))
-        {
-            CurrentProjectorInfo.PowerStatus = EPJLinkPowerStatus::PoweredOff;
-        }
-        else if (Response.Equals(TEXT("1")))
-        {
-            CurrentProjectorInfo.PowerStatus = EPJLinkPowerStatus::PoweredOn;
-        }
-        else if (Response.Equals(TEXT("2")))
-        {
-            CurrentProjectorInfo.PowerStatus = EPJLinkPowerStatus::CoolingDown;
-        }
-        else if (Response.Equals(TEXT("3")))
+    {
+        // 전원 상태 업데이트 - 바뀐 경우 네이티브 처리기에 락 밖에서 알림
+        const EPJLinkPowerStatus NewStatus = PJLinkResponseParser::DecodePowerStatus(Parameter, ParameterLength);
+        EPJLinkPowerStatus OldStatus;
         {
-            CurrentProjectorInfo.PowerStatus = EPJLinkPowerStatus::WarmingUp;
+            FScopeLock InfoLock(&ProjectorInfoLock);
+            OldStatus = CurrentProjectorInfo.PowerStatus;
+            CurrentProjectorInfo.PowerStatus = NewStatus;
         }
-        else
+        if (OldStatus != NewStatus)
         {
-            CurrentProjectorInfo.PowerStatus = EPJLinkPowerStatus::Unknown;
+            NativeEvents.OnPowerStatusChanged.Broadcast(this, OldStatus, NewStatus);
         }
-        break;
+        return;
+    }
 
     case EPJLinkCommand::INPT:
+    {
         // 입력 소스 업데이트
-        if (Response.StartsWith(TEXT("1")))
-        {
-            CurrentProjectorInfo.CurrentInputSource = EPJLinkInputSource::RGB;
-        }
-        else if (Response.StartsWith(TEXT("2")))
-        {
-            CurrentProjectorInfo.CurrentInputSource = EPJLinkInputSource::VIDEO;
-        }
-        else if (Response.StartsWith(TEXT("3")))
-        {
-            CurrentProjectorInfo.CurrentInputSource = EPJLinkInputSource::DIGITAL;
-        }
-        else if (Response.StartsWith(TEXT("4")))
-        {
-            CurrentProjectorInfo.CurrentInputSource = EPJLinkInputSource::STORAGE;
-        }
-        else if (Response.StartsWith(TEXT("5")))
+        const EPJLinkInputSource NewSource = PJLinkResponseParser::DecodeInputSource(Parameter, ParameterLength);
+        EPJLinkInputSource OldSource;
         {
-            CurrentProjectorInfo.CurrentInputSource = EPJLinkInputSource::NETWORK;
+            FScopeLock InfoLock(&ProjectorInfoLock);
+            OldSource = CurrentProjectorInfo.CurrentInputSource;
+            CurrentProjectorInfo.CurrentInputSource = NewSource;
         }
-        else
+        if (OldSource != NewSource)
         {
-            CurrentProjectorInfo.CurrentInputSource = EPJLinkInputSource::Unknown;
+            NativeEvents.OnInputSourceChanged.Broadcast(this, OldSource, NewSource);
         }
+        return;
+    }
+
+    default:
         break;
+    }
+
+    // 나머지 정보는 알림 없이 락 안에서 갱신
+    FScopeLock InfoLock(&ProjectorInfoLock);
 
+    switch (Parsed.Command)
+    {
     case EPJLinkCommand::NAME:
         // 프로젝터 이름 업데이트
-        CurrentProjectorInfo.Name = Response;
+        CurrentProjectorInfo.Name = PJLinkResponseParser::ParameterToString(Frame, Parsed);
         break;
 
     case EPJLinkCommand::INF1:
         // 제조사 정보 업데이트
-        CurrentProjectorInfo.ManufacturerName = Response;
+        CurrentProjectorInfo.ManufacturerName = PJLinkResponseParser::ParameterToString(Frame, Parsed);
         break;
 
     case EPJLinkCommand::INF2:
         // 제품명 업데이트
-        CurrentProjectorInfo.ProductName = Response;
+        CurrentProjectorInfo.ProductName = PJLinkResponseParser::ParameterToString(Frame, Parsed);
         break;
 
     case EPJLinkCommand::CLSS:
         // 클래스 정보 업데이트 (1 또는 2)
-        if (Response.Equals(TEXT("1")))
-        {
-            CurrentProjectorInfo.DeviceClass = EPJLinkClass::Class1;
-        }
-        else if (Response.Equals(TEXT("2")))
-        {
-            CurrentProjectorInfo.DeviceClass = EPJLinkClass::Class2;
-        }
+        PJLinkResponseParser::DecodeClass(Parameter, ParameterLength, CurrentProjectorInfo.DeviceClass);
+        break;
+
+    default:
         break;
     }
 }
 
-void UPJLinkComponent::BeginPlay()
-{
-    Super::BeginPlay();
 
-    PJLINK_LOG_INFO(TEXT("PJLink Component Begin Play: %s"), *GetOwner()->GetName());
+void UPJLinkNetworkManager::LogCommunication(bool bIsSending, const FString& CommandOrResponse, const FString& RawData)
+{
+    // 로그에 출력
+    FString DirectionStr = bIsSending ? TEXT("SEND") : TEXT("RECV");
+    PJLINK_LOG_INFO(TEXT("[%s] %s: %s"), *DirectionStr, *CommandOrResponse, *RawData.TrimEnd());
 
-    // 기존 객체 정리 (중복 방지)
-    if (NetworkManager)
+    if (NativeEvents.OnCommunicationLog.IsBound())
     {
-        NetworkManager->OnResponseReceived.RemoveDynamic(this, &UPJLinkComponent::HandleResponseReceived);
-        if (NetworkManager->OnCommunicationLog.IsBound())
-        {
-            NetworkManager->OnCommunicationLog.RemoveDynamic(this, &UPJLinkComponent::HandleCommunicationLog);
-        }
-        NetworkManager = nullptr;
+        FTCHARToUTF8 RawBytes(*RawData, RawData.Len());
+        NativeEvents.OnCommunicationLog.Broadcast(this, bIsSending, *CommandOrResponse,
+            TArrayView<const uint8>(reinterpret_cast<const uint8*>(RawBytes.Get()), RawBytes.Length()));
     }
 
-    if (StateMachine)
+    // 게임 스레드가 밀려 있으면 통신 로그는 버림 (응답/오류 이벤트 자리를 남겨 둠)
+    if (EventQueue.Num() >= MaxQueuedEvents)
     {
-        StateMachine->OnStateChanged.RemoveDynamic(this, &UPJLinkComponent::HandleStateChanged);
-        StateMachine = nullptr;
+        DroppedEventCount.fetch_add(1, std::memory_order_relaxed);
+        return;
     }
 
-    // 네트워크 매니저 생성
-    NetworkManager = NewObject<UPJLinkNetworkManager>(this, NAME_None, RF_Transient);
-    if (NetworkManager)
-    {
-        // 응답 이벤트 바인딩
-        NetworkManager->OnResponseReceived.AddDynamic(this, &UPJLinkComponent::HandleResponseReceived);
-
-        // 통신 로그 이벤트 바인딩
-        NetworkManager->OnCommunicationLog.AddDynamic(this, &UPJLinkComponent::HandleCommunicationLog);
+    // 이벤트 발생 (큐에 넣어서 게임 스레드에서 처리)
+    EventQueue.Enqueue([bIsSending, &CommandOrResponse, &RawData](FPJLinkEvent& Event)
+    {
+        Event.Type = EPJLinkEventType::CommunicationLog;
+        Event.bIsSending = bIsSending;
+        Event.Label.Append(CommandOrResponse);
+        Event.Text.Append(RawData);
+    });
+    ScheduleResponseDrain();
+}
 
-        // 디버깅 설정 전달
-        NetworkManager->bLogCommunication = bVerboseLogging;
-    }
-    else
-    {
-        PJLINK_LOG_ERROR(TEXT("Failed to create NetworkManager for component %s"), *GetOwner()->GetName());
-        return; // 생성 실패 시 초기화 중단
-    }
+void UPJLinkNetworkManager::LogCommunication(bool bIsSending, const TCHAR* CommandOrResponse, const uint8* Data, int32 Length)
+{
+    NativeEvents.OnCommunicationLog.Broadcast(this, bIsSending, CommandOrResponse, TArrayView<const uint8>(Data, Length));
 
-    // 상태 머신 생성
-    StateMachine = NewObject<UPJLinkStateMachine>(this, NAME_None, RF_Transient);
-    if (StateMachine)
+    // 로그는 끝의 CR/LF 를 길이만 줄여서 뺌 (짧은 프레임은 스택 버퍼로 변환되어 할당 없음)
+    int32 TrimmedLength = Length;
+    while (TrimmedLength > 0 && (Data[TrimmedLength - 1] == '\r' || Data[TrimmedLength - 1] == '\n' || Data[TrimmedLength - 1] == ' '))
     {
-        // 상태 변경 이벤트 바인딩
-        StateMachine->OnStateChanged.AddDynamic(this, &UPJLinkComponent::HandleStateChanged);
-        // 초기 상태 설정
-        StateMachine->SetState(EPJLinkProjectorState::Disconnected);
+        --TrimmedLength;
     }
-    else
     {
-        PJLINK_LOG_ERROR(TEXT("Failed to create StateMachine for component %s"), *GetOwner()->GetName());
-        return; // 생성 실패 시 초기화 중단
+        FUTF8ToTCHAR Trimmed(reinterpret_cast<const ANSICHAR*>(Data), TrimmedLength);
+        PJLINK_LOG_INFO(TEXT("[%s] %s: %.*s"), bIsSending ? TEXT("SEND") : TEXT("RECV"), CommandOrResponse,
+            Trimmed.Length(), Trimmed.Get());
     }
 
-    // 초기 상태 설정
-    PreviousPowerStatus = EPJLinkPowerStatus::Unknown;
-    PreviousInputSource = EPJLinkInputSource::Unknown;
-    bPreviousConnectionState = false;
-
-    // 자동 연결 설정이 있는 경우
-    if (bAutoConnect && !ProjectorInfo.IPAddress.IsEmpty())
+    if (EventQueue.Num() >= MaxQueuedEvents)
     {
-        PJLINK_LOG_INFO(TEXT("Auto-connecting to projector: %s - %s:%d"),
-            *ProjectorInfo.Name, *ProjectorInfo.IPAddress, ProjectorInfo.Port);
-
-        // 연결 시도는 지연 실행으로 처리 (BeginPlay 완료 후 수행)
-        UWorld* World = GetWorld();
-        if (World)
-        {
-            FTimerHandle ConnectTimerHandle;
-            World->GetTimerManager().SetTimer(
-                ConnectTimerHandle,
-                this,
-                &UPJLinkComponent::Connect,
-                0.5f,
-                false);
-        }
-        else
-        {
-            PJLINK_LOG_ERROR(TEXT("Failed to get World reference for auto-connect"));
-            // 대체 연결 시도
-            Connect();
-        }
+        DroppedEventCount.fetch_add(1, std::memory_order_relaxed);
+        return;
     }
 
-    // 주기적 상태 확인 설정
-    if (bPeriodicStatusCheck && StatusCheckInterval > 0.0f)
+    // 원문 바이트를 이벤트 버퍼로 바로 변환
+    EventQueue.Enqueue([bIsSending, CommandOrResponse, Data, Length](FPJLinkEvent& Event)
     {
-        UWorld* World = GetWorld();
-        if (World)
-        {
-            World->GetTimerManager().SetTimer(
-                StatusCheckTimerHandle,
-                this,
-                &UPJLinkComponent::CheckStatus,
-                FMath::Max(StatusCheckInterval, 1.0f), // 최소 1초 간격 보장
-                true);
-        }
-        else
-        {
-            PJLINK_LOG_ERROR(TEXT("Failed to get World reference for status check timer"));
-        }
-    }
-}
-
-void UPJLinkNetworkManager::LogCommunication(bool bIsSending, const FString& CommandOrResponse, const FString& RawData)
-{
-    // 로그에 출력
-    FString DirectionStr = bIsSending ? TEXT("SEND") : TEXT("RECV");
-    PJLINK_LOG_INFO(TEXT("[%s] %s: %s"), *DirectionStr, *CommandOrResponse, *RawData.TrimEnd());
-
-    // 이벤트 발생 (큐에 넣어서 게임 스레드에서 처리)
-    ResponseQueue.Enqueue(FPJLinkResponseQueueItem(
-        EPJLinkCommand::POWR, // 더미 명령
-        EPJLinkResponseStatus::Success, // 더미 상태
-        FString::Printf(TEXT("COMMUNICATION_LOG|%d|%s|%s"), bIsSending, *CommandOrResponse, *RawData)
-    ));
-}
+        Event.Type = EPJLinkEventType::CommunicationLog;
+        Event.bIsSending = bIsSending;
+        Event.Label.Append(CommandOrResponse);
 
-FString UPJLinkNetworkManager::GetCommandName(EPJLinkCommand Command) const
-{
-    switch (Command)
-    {
-    case EPJLinkCommand::POWR: return TEXT("POWR");
-    case EPJLinkCommand::INPT: return TEXT("INPT");
-    case EPJLinkCommand::AVMT: return TEXT("AVMT");
-    case EPJLinkCommand::ERST: return TEXT("ERST");
-    case EPJLinkCommand::LAMP: return TEXT("LAMP");
-    case EPJLinkCommand::INST: return TEXT("INST");
-    case EPJLinkCommand::NAME: return TEXT("NAME");
-    case EPJLinkCommand::INF1: return TEXT("INF1");
-    case EPJLinkCommand::INF2: return TEXT("INF2");
-    case EPJLinkCommand::INFO: return TEXT("INFO");
-    case EPJLinkCommand::CLSS: return TEXT("CLSS");
-    default: return TEXT("Unknown");
-    }
+        FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Data), Length);
+        Event.Text.AppendChars(Converted.Get(), Converted.Length());
+    });
+    ScheduleResponseDrain();
 }
 
 void UPJLinkNetworkManager::EmitError(EPJLinkErrorCode ErrorCode, const FString& ErrorMessage, EPJLinkCommand RelatedCommand)
@@ -1006,130 +1718,83 @@ void UPJLinkNetworkManager::EmitError(EPJLinkErrorCode ErrorCode, const FString&
         *UEnum::GetValueAsString(ErrorCode),
         *ErrorMessage);
 
-    // 마지막 오류 정보 저장
-    LastErrorCode = ErrorCode;
-    LastErrorMessage = ErrorMessage;
+    // 마지막 오류 정보 저장 (I/O 스레드에서도 호출됨)
+    {
+        FScopeLock Lock(&ErrorLock);
+        LastErrorCode = ErrorCode;
+        LastErrorMessage = ErrorMessage;
+    }
+
+    NativeEvents.OnError.Broadcast(this, ErrorCode, FStringView(ErrorMessage), RelatedCommand);
 
     // 오류 이벤트 발생 (큐에 추가)
-    ResponseQueue.Enqueue(FPJLinkResponseQueueItem(
-        RelatedCommand,
-        EPJLinkResponseStatus::ProjectorFailure,
-        FString::Printf(TEXT("ERROR|%d|%s"), static_cast<int32>(ErrorCode), *ErrorMessage),
-        TWeakObjectPtr<UPJLinkNetworkManager>(this)
-    ));
+    EventQueue.Enqueue([ErrorCode, &ErrorMessage, RelatedCommand](FPJLinkEvent& Event)
+    {
+        Event.Type = EPJLinkEventType::Error;
+        Event.Command = RelatedCommand;
+        Event.Status = EPJLinkResponseStatus::ProjectorFailure;
+        Event.ErrorCode = ErrorCode;
+        Event.Text.Append(ErrorMessage);
+    });
+    ScheduleResponseDrain();
+}
+
+FString UPJLinkNetworkManager::GetLastErrorMessage() const
+{
+    FScopeLock Lock(&ErrorLock);
+    return LastErrorMessage;
+}
+
+EPJLinkErrorCode UPJLinkNetworkManager::GetLastErrorCode() const
+{
+    FScopeLock Lock(&ErrorLock);
+    return LastErrorCode;
 }
 
-    // 연결 상태 확인
+// 재연결 시도 함수 (재연결 스케줄러, I/O 스레드)
+void UPJLinkNetworkManager::AttemptReconnect(int32 Attempt, int32 MaxAttempts)
+{
+    // 그 사이 직접 연결된 경우 - 예약 종료
     if (bConnected.load(std::memory_order_acquire))
     {
         PJLINK_LOG_INFO(TEXT("Already connected, canceling reconnect attempt"));
-        ReconnectAttemptCount = 0;
+        FPJLinkReconnectScheduler::Get().ReportResult(this, true);
         return;
     }
 
-    PJLINK_LOG_INFO(TEXT("Attempting to reconnect (attempt %d/%s)..."),
-        ReconnectAttemptCount,
-        MaxReconnectAttempts > 0 ? *FString::FromInt(MaxReconnectAttempts) : TEXT("∞"));
-
-    // 이전 소켓 정리 확인
-    {
-        FScopeLock SocketLock(&SocketCriticalSection);
-        if (Socket)
-        {
-            PJLINK_LOG_VERBOSE(TEXT("Cleaning up existing socket before reconnect"));
-            ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
-            if (SocketSubsystem)
-            {
-                Socket->Close();
-                SocketSubsystem->DestroySocket(Socket);
-            }
-            Socket = nullptr;
-        }
-    }
-
-    // 이전 연결 정보로 재연결 시도
-    if (ConnectToProjector(LastProjectorInfo))
+    FPJLinkProjectorInfo ProjectorInfo;
     {
-        PJLINK_LOG_INFO(TEXT("Reconnection successful on attempt %d"), ReconnectAttemptCount);
-        ReconnectAttemptCount = 0;
-
-        // 연결 성공 이벤트 발생
-        FPJLinkResponseQueueItem Item(
-            EPJLinkCommand::POWR,
-            EPJLinkResponseStatus::Success,
-            TEXT("Reconnection successful"),
-            TWeakObjectPtr<UPJLinkNetworkManager>(this)
-        );
-        ResponseQueue.Enqueue(Item);
+        FScopeLock InfoLock(&ProjectorInfoLock);
+        ProjectorInfo = LastProjectorInfo;
     }
-    else
-    {
-        // 연결 실패 - 백오프 지연 적용 (지수적 백오프)
-        float BackoffDelay = ReconnectInterval * FMath::Min(1.0f, 1.0f + (ReconnectAttemptCount * 0.2f));
-
-        PJLINK_LOG_WARNING(TEXT("Reconnection attempt %d failed. Will retry in %.1f seconds."),
-            ReconnectAttemptCount, BackoffDelay);
 
-        // 실패 이벤트 발생
-        FPJLinkResponseQueueItem Item(
-            EPJLinkCommand::POWR,
-            EPJLinkResponseStatus::ProjectorFailure,
-            FString::Printf(TEXT("Reconnection attempt %d failed"), ReconnectAttemptCount),
-            TWeakObjectPtr<UPJLinkNetworkManager>(this)
-        );
-        ResponseQueue.Enqueue(Item);
+    PJLINK_LOG_INFO(TEXT("Attempting to reconnect to %s:%d (attempt %d/%s)..."),
+        *ProjectorInfo.IPAddress, ProjectorInfo.Port, Attempt,
+        MaxAttempts > 0 ? *FString::FromInt(MaxAttempts) : TEXT("∞"));
 
-        if (bAutoReconnect)
-        {
-            if (UWorld* World = GetWorld())
-            {
-                World->GetTimerManager().SetTimer(
-                    ReconnectTimerHandle,
-                    this,
-                    &UPJLinkNetworkManager::AttemptReconnect,
-                    BackoffDelay,
-                    false);
-            }
-        }
-        else
-        {
-            PJLINK_LOG_WARNING(TEXT("Reconnection attempt %d failed. Auto-reconnect is disabled."), ReconnectAttemptCount);
-            ReconnectAttemptCount = 0;
-        }
-    }
+    // 이전 연결 정보로 비동기 재연결 - 성공/실패는 CompleteConnect 에서 스케줄러에 보고
+    StartConnect(ProjectorInfo);
 }
 
 // 소켓 생성 함수
-bool UPJLinkNetworkManager::CreateSocket()
+bool UPJLinkNetworkManager::CreateSocket(FNativeSocket& OutSocket)
 {
-    ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
-    if (!SocketSubsystem)
+    // 리액터가 관리하는 논블로킹 소켓 생성
+    OutSocket = CreateTcpSocket();
+    if (OutSocket == InvalidSocket)
     {
-        return HandleError(EPJLinkErrorCode::SocketCreationFailed, TEXT("Failed to get socket subsystem"));
-    }
-
-    // 소켓 생성
-    Socket = SocketSubsystem->CreateSocket(NAME_Stream, TEXT("PJLinkSocket"), true);
-    if (!Socket)
-    {
-        return HandleError(EPJLinkErrorCode::SocketCreationFailed, TEXT("Failed to create socket"));
+        return HandleError(EPJLinkErrorCode::SocketCreationFailed,
+            FString::Printf(TEXT("Failed to create socket - Error: %d"), PJLinkSocketPlatform::GetLastErrorCode()));
     }
 
     // 소켓 설정 구성
-    Socket->SetNoDelay(true);
+    SetNoDelay(OutSocket, true);
     return true;
 }
 
 // 서버 주소 구성 및 연결 시도 함수
-// PJLinkNetworkManager.cpp에서 ConnectToServer 함수 개선
-bool UPJLinkNetworkManager::ConnectToServer(const FString& IPAddress, int32 Port, float TimeoutSeconds)
+bool UPJLinkNetworkManager::ConnectToServer(FNativeSocket InSocket, const FString& IPAddress, int32 Port, float TimeoutSeconds)
 {
-    ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
-    if (!SocketSubsystem)
-    {
-        return HandleError(EPJLinkErrorCode::ConnectionFailed, TEXT("Failed to get socket subsystem"));
-    }
-
     // IP 주소 파싱
     FIPv4Address IP;
     if (!FIPv4Address::Parse(IPAddress, IP))
@@ -1138,11 +1803,6 @@ bool UPJLinkNetworkManager::ConnectToServer(const FString& IPAddress, int32 Port
             FString::Printf(TEXT("Invalid IP address: %s"), *IPAddress));
     }
 
-    // 서버 주소 생성
-    TSharedRef<FInternetAddr> ServerAddr = SocketSubsystem->CreateInternetAddr();
-    ServerAddr->SetIp(IP.Value);
-    ServerAddr->SetPort(Port);
-
     // 타임아웃 값 설정 (기본값이 너무 크면 사용자 경험이 나빠질 수 있음)
     if (TimeoutSeconds <= 0.0f)
     {
@@ -1150,36 +1810,40 @@ bool UPJLinkNetworkManager::ConnectToServer(const FString& IPAddress, int32 Port
     }
 
     // 연결 전 소켓이 유효한지 확인
-    if (!Socket)
+    if (InSocket == InvalidSocket)
     {
         return HandleError(EPJLinkErrorCode::SocketCreationFailed, TEXT("Socket is null before connection attempt"));
     }
 
-    // 소켓에 타임아웃 설정
-    Socket->SetNonBlocking(false);
-    if (TimeoutSeconds > 0.0f)
+    // 연결 시도 (논블로킹)
+    const EConnectResult ConnectResult = Connect(InSocket, IP.Value, static_cast<uint16>(Port));
+    if (ConnectResult == EConnectResult::Failed)
     {
-        Socket->SetReceiveTimeout(TimeoutSeconds);
-        Socket->SetSendTimeout(TimeoutSeconds);
+        return HandleError(EPJLinkErrorCode::ConnectionFailed,
+            FString::Printf(TEXT("Failed to connect to %s:%d - Error: %d"),
+                *IPAddress, Port, PJLinkSocketPlatform::GetLastErrorCode()));
     }
 
-    // 연결 시도
-    bool bConnected = Socket->Connect(*ServerAddr);
-    if (!bConnected)
+    // 연결 완료까지 대기 (쓰기 가능 = 연결 완료 또는 실패)
+    if (ConnectResult == EConnectResult::InProgress)
     {
-        ESocketErrors LastError = SocketSubsystem->GetLastErrorCode();
+        FPollEntry Entry;
+        Entry.Socket = InSocket;
+        Entry.Requested = EPollFlags::Writable;
 
-        // 이미 연결된 경우 처리 (가끔 발생할 수 있음)
-        if (LastError == SE_EINPROGRESS || LastError == SE_EWOULDBLOCK)
+        const int32 Ready = Poll(&Entry, 1, FMath::CeilToInt(TimeoutSeconds * 1000.0f));
+        if (Ready <= 0)
         {
-            // 비동기 연결 처리 (논블로킹 소켓의 경우)
-            PJLINK_LOG_INFO(TEXT("Connection in progress to %s:%d"), *IPAddress, Port);
-            return true;
+            return HandleError(EPJLinkErrorCode::Timeout,
+                FString::Printf(TEXT("Connection to %s:%d timed out after %.1f seconds"), *IPAddress, Port, TimeoutSeconds));
         }
 
-        return HandleError(EPJLinkErrorCode::ConnectionFailed,
-            FString::Printf(TEXT("Failed to connect to %s:%d - Error: %s"),
-                *IPAddress, Port, *SocketSubsystem->GetSocketError(LastError)));
+        const int32 PendingError = GetPendingError(InSocket);
+        if (PendingError != 0)
+        {
+            return HandleError(EPJLinkErrorCode::ConnectionFailed,
+                FString::Printf(TEXT("Failed to connect to %s:%d - Error: %d"), *IPAddress, Port, PendingError));
+        }
     }
 
     PJLINK_LOG_INFO(TEXT("Successfully connected to %s:%d"), *IPAddress, Port);
@@ -1187,17 +1851,26 @@ bool UPJLinkNetworkManager::ConnectToServer(const FString& IPAddress, int32 Port
 }
 
 // 인증 처리 함수
-bool UPJLinkNetworkManager::HandleAuthentication(const FPJLinkProjectorInfo& ProjectorInfo)
+bool UPJLinkNetworkManager::HandleAuthentication(FNativeSocket InSocket, const FPJLinkProjectorInfo& ProjectorInfo, float TimeoutSeconds)
 {
-    // 인증 챌린지 수신
+    // 인사말 수신 대기
+    FPollEntry Entry;
+    Entry.Socket = InSocket;
+    Entry.Requested = EPollFlags::Readable;
+    const int32 TimeoutMs = FMath::CeilToInt(FMath::Max(TimeoutSeconds, 1.0f) * 1000.0f);
+
     uint8 RecvBuffer[256];
     int32 BytesRead = 0;
-    bool bReadSuccess = Socket->Recv(RecvBuffer, sizeof(RecvBuffer) - 1, BytesRead, ESocketReceiveFlags::None);
+    bool bReadSuccess = false;
+    if (Poll(&Entry, 1, TimeoutMs) > 0)
+    {
+        bReadSuccess = Recv(InSocket, RecvBuffer, sizeof(RecvBuffer) - 1, BytesRead) == EIOResult::Ok;
+    }
 
     if (!bReadSuccess || BytesRead <= 0)
     {
-        PJLINK_LOG_ERROR(TEXT("Failed to receive authentication challenge"));
-        EmitError(EPJLinkErrorCode::AuthenticationFailed, TEXT("Failed to receive authentication challenge"));
+        PJLINK_LOG_ERROR(TEXT("Failed to receive projector greeting"));
+        EmitError(EPJLinkErrorCode::AuthenticationFailed, TEXT("Failed to receive projector greeting"));
         return false;
     }
 
@@ -1205,91 +1878,40 @@ bool UPJLinkNetworkManager::HandleAuthentication(const FPJLinkProjectorInfo& Pro
     RecvBuffer[BytesRead] = 0;
     FString ResponseString = UTF8_TO_TCHAR((const char*)RecvBuffer);
 
-    // 인증이 필요한지 확인
-    if (ResponseString.Contains(TEXT("PJLINK 1")))
+    FString AuthResponse;
+    EPJLinkErrorCode ErrorCode = EPJLinkErrorCode::None;
+    if (!ParseGreeting(ResponseString, ProjectorInfo.Password, AuthResponse, ErrorCode))
     {
-        // 인증 필요 없음
-        PJLINK_LOG_INFO(TEXT("No authentication required"));
-        return true;
+        // 알 수 없는 응답 또는 인증 불가
+        PJLINK_LOG_ERROR(TEXT("Invalid projector greeting: %s"), *ResponseString);
+        EmitError(ErrorCode, FString::Printf(TEXT("Invalid projector greeting: %s"), *ResponseString));
+        return false;
     }
-    else if (ResponseString.Contains(TEXT("PJLINK 0")))
-    {
-        // 인증 필요
-        PJLINK_LOG_INFO(TEXT("Authentication required"));
-
-        // 챌린지 추출
-        FString Challenge;
-        if (!ResponseString.Split(TEXT("PJLINK 0 "), nullptr, &Challenge))
-        {
-            PJLINK_LOG_ERROR(TEXT("Invalid authentication challenge format"));
-            EmitError(EPJLinkErrorCode::AuthenticationFailed, TEXT("Invalid authentication challenge format"));
-            return false;
-        }
-
-        // 공백 및 개행 제거
-        Challenge = Challenge.TrimStartAndEnd();
 
-        // MD5 해시 생성: Challenge + Password
-        FString HashSource = Challenge + ProjectorInfo.Password;
-
-        // UTF-8로 변환
-        FTCHARToUTF8 Utf8HashSource(*HashSource);
-
-        // MD5 해시 계산
-        uint8 Digest[16];
-        FMD5 Md5Gen;
-        Md5Gen.Update((uint8*)Utf8HashSource.Get(), Utf8HashSource.Length());
-        Md5Gen.Final(Digest);
-
-        // 해시를 16진수 문자열로 변환
-        FString AuthResponse;
-        for (int32 i = 0; i < 16; i++)
-        {
-            AuthResponse += FString::Printf(TEXT("%02x"), Digest[i]);
-        }
-
-        // 인증 응답 전송
-        PJLINK_LOG_VERBOSE(TEXT("Sending authentication response: %s"), *AuthResponse);
-
-        // UTF-8로 변환
-        FTCHARToUTF8 Utf8Auth(*AuthResponse);
-        int32 BytesSent = 0;
-        bool bSendSuccess = Socket->Send((uint8*)Utf8Auth.Get(), Utf8Auth.Length(), BytesSent);
-
-        if (!bSendSuccess || BytesSent != Utf8Auth.Length())
-        {
-            PJLINK_LOG_ERROR(TEXT("Failed to send authentication response"));
-            EmitError(EPJLinkErrorCode::AuthenticationFailed, TEXT("Failed to send authentication response"));
-            return false;
-        }
-
-        return true;
-    }
-    else
+    // 인증 응답은 연결 직후 보내는 첫 명령 앞에 붙여 보냄 (PJLink 규격)
+    if (!AuthResponse.IsEmpty())
     {
-        // 알 수 없는 응답
-        PJLINK_LOG_ERROR(TEXT("Unknown response: %s"), *ResponseString);
-        EmitError(EPJLinkErrorCode::InvalidResponse,
-            FString::Printf(TEXT("Unknown response: %s"), *ResponseString));
-        return false;
+        PJLINK_LOG_VERBOSE(TEXT("Authentication response queued for first command: %s"), *AuthResponse);
     }
+    SetPendingAuthDigest(AuthResponse);
+    return true;
 }
 
-// 수신 스레드 시작 함수
-bool UPJLinkNetworkManager::StartReceiverThread()
+// 연결된 소켓을 리액터에 등록
+bool UPJLinkNetworkManager::StartConnection(FNativeSocket InSocket)
 {
-    // 스레드 중지 플래그 초기화
-    bThreadStop = false;
+    FrameAssembler.Reset();
 
-    // 새 스레드 생성
-    ReceiverThread = FRunnableThread::Create(this, TEXT("PJLinkReceiverThread"));
-    if (!ReceiverThread)
+    TSharedPtr<FPJLinkConnection, ESPMode::ThreadSafe> NewConnection = FPJLinkConnection::Create(InSocket, this);
+    if (!NewConnection.IsValid())
     {
-        PJLINK_LOG_ERROR(TEXT("Failed to create receiver thread"));
-        EmitError(EPJLinkErrorCode::UnknownError, TEXT("Failed to create receiver thread"));
+        PJLINK_LOG_ERROR(TEXT("Failed to create reactor connection"));
+        EmitError(EPJLinkErrorCode::UnknownError, TEXT("Failed to create reactor connection"));
         return false;
     }
 
+    FScopeLock Lock(&ConnectionLock);
+    Connection = NewConnection;
     return true;
 }
 
@@ -1331,217 +1953,55 @@ FString UPJLinkNetworkManager::GenerateDiagnosticReport() const
     // 오류 정보 추가
     Report += TEXT("\n4. Last Error\n");
     Report += TEXT("------------\n");
-    Report += FString::Printf(TEXT("Error Code: %s\n"), *UEnum::GetValueAsString(LastErrorCode));
-    Report += FString::Printf(TEXT("Error Message: %s\n"), *LastErrorMessage);
+    Report += FString::Printf(TEXT("Error Code: %s\n"), *UEnum::GetValueAsString(GetLastErrorCode()));
+    Report += FString::Printf(TEXT("Error Message: %s\n"), *GetLastErrorMessage());
 
     return Report;
 }
 
-// PJLinkNetworkManager.cpp에 추가
 bool UPJLinkNetworkManager::SendCommandWithTimeout(EPJLinkCommand Command, const FString& Parameter, float TimeoutSeconds)
 {
-    // 명령 전송 시간 기록
-    double SendTime = FPlatformTime::Seconds();
-
-    // 명령 트래킹 정보 기록
-    FScopeLock Lock(&CommandTrackingLock);
-    FPJLinkCommandInfo CommandInfo;
-    CommandInfo.Command = Command;
-    CommandInfo.Parameter = Parameter;
-    CommandInfo.SendTime = SendTime;
-    CommandInfo.TimeoutSeconds = TimeoutSeconds;
-    CommandInfo.bResponseReceived = false;
-
     PJLINK_CAPTURE_DIAGNOSTIC(LastCommandDiagnosticData,
         TEXT("Setting up command timeout tracking: %s, Timeout: %.1f seconds"),
         *PJLinkHelpers::CommandToString(Command), TimeoutSeconds);
 
-    // 명령 트래킹 맵에 추가
-    PendingCommands.Add(Command, CommandInfo);
-
-    // 실제 명령 전송
-    bool bResult = SendCommand(Command, Parameter);
-
-    // 전송 실패 시 트래킹에서 제거
-    if (!bResult)
-    {
-        PJLINK_CAPTURE_DIAGNOSTIC(LastCommandDiagnosticData,
-            TEXT("Command send failed, removing from tracking: %s"),
-            *PJLinkHelpers::CommandToString(Command));
-        PendingCommands.Remove(Command);
-        return false;
-    }
-
-    // 타임아웃 타이머 설정
-    if (UWorld* World = GetWorld())
-    {
-        FTimerDelegate TimerDelegate;
-        TimerDelegate.BindUObject(this, &UPJLinkNetworkManager::HandleCommandTimeout, Command);
-
-        FTimerHandle& TimerHandle = CommandTimeoutHandles.FindOrAdd(Command);
-        World->GetTimerManager().SetTimer(TimerHandle, TimerDelegate, TimeoutSeconds, false);
-
-        PJLINK_CAPTURE_DIAGNOSTIC(LastCommandDiagnosticData,
-            TEXT("Timeout timer set for command: %s (%.1f seconds)"),
-            *PJLinkHelpers::CommandToString(Command), TimeoutSeconds);
-    }
-    else
-    {
-        PJLINK_CAPTURE_DIAGNOSTIC(LastCommandDiagnosticData,
-            TEXT("Failed to set timeout timer - World not available"));
-    }
-
-    return true;
+    return SendCommandWithSequence(Command, Parameter, TimeoutSeconds) != 0;
 }
 
-// PJLinkNetworkManager.cpp에서
-void UPJLinkNetworkManager::HandleCommandTimeout(EPJLinkCommand Command)
+// 리액터 타이밍 휠에서 호출 (I/O 스레드)
+void UPJLinkNetworkManager::HandleCommandTimeout(int32 SequenceId)
 {
-    FScopeLock Lock(&CommandTrackingLock);
-
-    // 해당 명령이 아직 응답을 받지 못했는지 확인
-    FPJLinkCommandInfo* CommandInfo = PendingCommands.Find(Command);
-    if (!CommandInfo)
-    {
-        // 이미 제거된 경우 (응답을 받았거나 다른 이유로 제거됨)
-        PJLINK_LOG_VERBOSE(TEXT("Timeout handler called for command %s, but command is not pending anymore"),
-            *PJLinkHelpers::CommandToString(Command));
-        return;
-    }
-
-    if (!CommandInfo->bResponseReceived)
+    FPJLinkCommandInfo TimedOut;
     {
-        // 타임아웃 처리
-        FString ErrorMessage = FString::Printf(TEXT("Command timeout: %s after %.1f seconds"),
-            *PJLinkHelpers::CommandToString(Command), CommandInfo->TimeoutSeconds);
+        FScopeLock Lock(&InFlightLock);
 
-        PJLINK_LOG_WARNING(TEXT("%s"), *ErrorMessage);
-        PJLINK_CAPTURE_DIAGNOSTIC(LastCommandDiagnosticData, TEXT("%s"), *ErrorMessage);
-
-        // 오류 이벤트 발생
-        EmitError(EPJLinkErrorCode::Timeout, ErrorMessage, Command);
-
-        // 응답 큐에 타임아웃 항목 추가
-        FPJLinkResponseQueueItem Item(
-            Command,
-            EPJLinkResponseStatus::NoResponse,
-            TEXT("Command timed out"),
-            TWeakObjectPtr<UPJLinkNetworkManager>(this)
-        );
-        ResponseQueue.Enqueue(Item);
-    }
-
-    // 타임아웃 후 명령 정보 제거
-    PendingCommands.Remove(Command);
-
-    // 타이머 핸들 제거
-    FTimerHandle* TimerHandle = CommandTimeoutHandles.Find(Command);
-    if (TimerHandle)
-    {
-        if (UWorld* World = GetWorld())
+        FPJLinkCommandInfo* CommandInfo = InFlightCommands.FindByPredicate([SequenceId](const FPJLinkCommandInfo& Info)
         {
-            World->GetTimerManager().ClearTimer(*TimerHandle);
-        }
-        CommandTimeoutHandles.Remove(Command);
-    }
-}
-
-    // 연결 상태 확인
-    if (bConnected.load(std::memory_order_acquire))
-    {
-        PJLINK_CAPTURE_DIAGNOSTIC(ConnectionDiagnosticData,
-            TEXT("Already connected, canceling reconnect attempt"));
-        PJLINK_LOG_INFO(TEXT("Already connected, canceling reconnect attempt"));
-        ReconnectAttemptCount = 0;
-        return;
-    }
+            return Info.SequenceId == SequenceId;
+        });
 
-    PJLINK_CAPTURE_DIAGNOSTIC(ConnectionDiagnosticData,
-        TEXT("Attempting to reconnect (attempt %d/%s)..."),
-        ReconnectAttemptCount,
-        MaxReconnectAttempts > 0 ? *FString::FromInt(MaxReconnectAttempts) : TEXT("∞"));
-
-    PJLINK_LOG_INFO(TEXT("Attempting to reconnect (attempt %d/%s)..."),
-        ReconnectAttemptCount,
-        MaxReconnectAttempts > 0 ? *FString::FromInt(MaxReconnectAttempts) : TEXT("∞"));
-
-    // 이전 소켓 정리 확인
-    {
-        FScopeLock SocketLock(&SocketCriticalSection);
-        if (Socket)
+        if (!CommandInfo || CommandInfo->bTimedOut)
         {
-            PJLINK_CAPTURE_DIAGNOSTIC(ConnectionDiagnosticData,
-                TEXT("Cleaning up existing socket before reconnect"));
-            PJLINK_LOG_VERBOSE(TEXT("Cleaning up existing socket before reconnect"));
-
-            ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
-            if (SocketSubsystem)
-            {
-                Socket->Close();
-                SocketSubsystem->DestroySocket(Socket);
-            }
-            Socket = nullptr;
+            // 이미 응답을 받았거나 연결 종료로 정리됨
+            PJLINK_LOG_VERBOSE(TEXT("Timeout handler called for command #%d, but command is not pending anymore"), SequenceId);
+            return;
         }
-    }
 
-    // 이전 연결 정보로 재연결 시도
-    if (ConnectToProjector(LastProjectorInfo))
-    {
-        PJLINK_CAPTURE_DIAGNOSTIC(ConnectionDiagnosticData,
-            TEXT("Reconnection successful on attempt %d"), ReconnectAttemptCount);
-        PJLINK_LOG_INFO(TEXT("Reconnection successful on attempt %d"), ReconnectAttemptCount);
-        ReconnectAttemptCount = 0;
-
-        // 연결 성공 이벤트 발생
-        FPJLinkResponseQueueItem Item(
-            EPJLinkCommand::POWR,
-            EPJLinkResponseStatus::Success,
-            TEXT("Reconnection successful")
-        );
-        ResponseQueue.Enqueue(Item);
+        // FIFO 에서 바로 빼지 않고 표시만 함 - 늦은 응답이 이 자리를 소비해야 이후 요청과 어긋나지 않음
+        CommandInfo->bTimedOut = true;
+        TimedOut = *CommandInfo;
     }
-    else
-    {
-        // 연결 실패 - 백오프 지연 적용 (지수적 백오프)
-        float BackoffDelay = ReconnectInterval * FMath::Min(1.0f, 1.0f + (ReconnectAttemptCount * 0.2f));
 
-        PJLINK_CAPTURE_DIAGNOSTIC(ConnectionDiagnosticData,
-            TEXT("Reconnection attempt %d failed. Will retry in %.1f seconds."),
-            ReconnectAttemptCount, BackoffDelay);
+    // 타임아웃 처리
+    FString ErrorMessage = FString::Printf(TEXT("Command timeout: %s #%d after %.1f seconds"),
+        *PJLinkHelpers::CommandToString(TimedOut.Command), SequenceId, TimedOut.TimeoutSeconds);
 
-        PJLINK_LOG_WARNING(TEXT("Reconnection attempt %d failed. Will retry in %.1f seconds."),
-            ReconnectAttemptCount, BackoffDelay);
+    // 진단 데이터는 게임 스레드 전용이므로 여기서는 로그만 남김
+    PJLINK_LOG_WARNING(TEXT("%s"), *ErrorMessage);
 
-        // 실패 이벤트 발생
-        FPJLinkResponseQueueItem Item(
-            EPJLinkCommand::POWR,
-            EPJLinkResponseStatus::ProjectorFailure,
-            FString::Printf(TEXT("Reconnection attempt %d failed"), ReconnectAttemptCount)
-        );
-        ResponseQueue.Enqueue(Item);
+    // 오류 이벤트 발생
+    EmitError(EPJLinkErrorCode::Timeout, ErrorMessage, TimedOut.Command);
 
-        if (bAutoReconnect)
-        {
-            if (UWorld* World = GetWorld())
-            {
-                World->GetTimerManager().SetTimer(
-                    ReconnectTimerHandle,
-                    this,
-                    &UPJLinkNetworkManager::AttemptReconnect,
-                    BackoffDelay,
-                    false);
-            }
-        }
-        else
-        {
-            PJLINK_CAPTURE_DIAGNOSTIC(ConnectionDiagnosticData,
-                TEXT("Reconnection attempt %d failed. Auto-reconnect is disabled."), ReconnectAttemptCount);
-            PJLINK_LOG_WARNING(TEXT("Reconnection attempt %d failed. Auto-reconnect is disabled."), ReconnectAttemptCount);
-            ReconnectAttemptCount = 0;
-        }
-    }
+    // 응답 큐에 타임아웃 항목 추가
+    EnqueueResponseEvent(TimedOut.Command, EPJLinkResponseStatus::NoResponse, TEXT("Command timed out"), SequenceId);
 }
-
-
-
-    
\ No newline at end of file
@@ -0,0 +1,320 @@
+﻿// PJLinkNotificationListener.cpp
+#include "PJLinkNotificationListener.h"
+#include "PJLinkIOReactor.h"
+#include "PJLinkNetworkManager.h"
+#include "PJLinkLog.h"
+#include "Misc/ScopeLock.h"
+
+using namespace PJLinkSocketPlatform;
+
+/**
+ * 알림 소켓의 리액터 처리기
+ * 수신기가 먼저 사라질 수 있으므로 데이터그램은 싱글톤을 통해 전달합니다.
+ */
+class FPJLinkNotificationSocketHandler : public IPJLinkIOHandler
+{
+public:
+    explicit FPJLinkNotificationSocketHandler(FNativeSocket InSocket)
+        : Socket(InSocket)
+    {
+    }
+
+    FNativeSocket GetSocket() const { return Socket; }
+
+    virtual void OnReadable() override
+    {
+        // 대기 중인 데이터그램을 모두 읽음
+        for (;;)
+        {
+            int32 BytesRead = 0;
+            uint32 SourceIPv4 = 0;
+            uint16 SourcePort = 0;
+            const EIOResult Result = RecvFrom(Socket, Buffer, sizeof(Buffer), BytesRead, SourceIPv4, SourcePort);
+            if (Result != EIOResult::Ok)
+            {
+                return;
+            }
+
+            FPJLinkNotificationListener::DispatchDatagram(this, Buffer, BytesRead, SourceIPv4);
+        }
+    }
+
+    virtual void OnWritable() override {}
+    virtual void OnPollError() override {}
+
+private:
+    FNativeSocket Socket;
+
+    // 수신 버퍼 (I/O 스레드 전용, 알림은 한 줄이므로 작음)
+    uint8 Buffer[512];
+};
+
+FPJLinkNotificationListener* FPJLinkNotificationListener::Instance = nullptr;
+FCriticalSection FPJLinkNotificationListener::InstanceLock;
+
+FPJLinkNotificationListener& FPJLinkNotificationListener::Get()
+{
+    FScopeLock ScopeLock(&InstanceLock);
+    if (!Instance)
+    {
+        Instance = new FPJLinkNotificationListener();
+    }
+    return *Instance;
+}
+
+void FPJLinkNotificationListener::Shutdown()
+{
+    FPJLinkNotificationListener* ListenerToDelete = nullptr;
+    {
+        FScopeLock ScopeLock(&InstanceLock);
+        ListenerToDelete = Instance;
+        Instance = nullptr;
+    }
+
+    delete ListenerToDelete;
+}
+
+FPJLinkNotificationListener::FPJLinkNotificationListener()
+    : ListenPort(DefaultPort)
+    , BoundPort(0)
+    , bBindFailed(false)
+    , ReceivedCount(0)
+    , UnmatchedCount(0)
+{
+}
+
+FPJLinkNotificationListener::~FPJLinkNotificationListener()
+{
+    FScopeLock ScopeLock(&Lock);
+    CloseSocket();
+    ManagersByAddress.Empty();
+    AddressByManager.Empty();
+    SearchSinks.Empty();
+}
+
+void FPJLinkNotificationListener::Register(UPJLinkNetworkManager* Manager, uint32 IPv4)
+{
+    if (!Manager || IPv4 == 0)
+    {
+        return;
+    }
+
+    FScopeLock ScopeLock(&Lock);
+    if (const uint32* Existing = AddressByManager.Find(Manager))
+    {
+        if (*Existing == IPv4)
+        {
+            return;
+        }
+
+        // 같은 매니저가 다른 프로젝터로 옮겨감
+        if (TArray<UPJLinkNetworkManager*>* Managers = ManagersByAddress.Find(*Existing))
+        {
+            Managers->Remove(Manager);
+            if (Managers->Num() == 0)
+            {
+                ManagersByAddress.Remove(*Existing);
+            }
+        }
+    }
+
+    AddressByManager.Add(Manager, IPv4);
+    ManagersByAddress.FindOrAdd(IPv4).AddUnique(Manager);
+
+    if (!Handler.IsValid() && !bBindFailed)
+    {
+        OpenSocket();
+    }
+}
+
+void FPJLinkNotificationListener::Unregister(UPJLinkNetworkManager* Manager)
+{
+    FScopeLock ScopeLock(&Lock);
+    uint32 IPv4 = 0;
+    if (!AddressByManager.RemoveAndCopyValue(Manager, IPv4))
+    {
+        return;
+    }
+
+    if (TArray<UPJLinkNetworkManager*>* Managers = ManagersByAddress.Find(IPv4))
+    {
+        Managers->Remove(Manager);
+        if (Managers->Num() == 0)
+        {
+            ManagersByAddress.Remove(IPv4);
+        }
+    }
+
+    // 알림을 받을 프로젝터가 없으면 포트를 돌려줌
+    if (!HasSubscribers())
+    {
+        CloseSocket();
+        bBindFailed = false;
+    }
+}
+
+void FPJLinkNotificationListener::AddSearchSink(IPJLinkSearchReplySink* Sink)
+{
+    if (!Sink)
+    {
+        return;
+    }
+
+    FScopeLock ScopeLock(&Lock);
+    SearchSinks.AddUnique(Sink);
+
+    // 검색은 짧게 끝나므로 이전 바인딩 실패와 관계없이 다시 시도
+    if (!Handler.IsValid())
+    {
+        bBindFailed = false;
+        OpenSocket();
+    }
+}
+
+void FPJLinkNotificationListener::RemoveSearchSink(IPJLinkSearchReplySink* Sink)
+{
+    FScopeLock ScopeLock(&Lock);
+    if (SearchSinks.Remove(Sink) == 0)
+    {
+        return;
+    }
+
+    if (!HasSubscribers())
+    {
+        CloseSocket();
+        bBindFailed = false;
+    }
+}
+
+void FPJLinkNotificationListener::SetListenPort(uint16 InPort)
+{
+    FScopeLock ScopeLock(&Lock);
+    if (ListenPort == InPort && (Handler.IsValid() || !HasSubscribers()))
+    {
+        return;
+    }
+
+    ListenPort = InPort;
+    bBindFailed = false;
+    CloseSocket();
+    if (HasSubscribers())
+    {
+        OpenSocket();
+    }
+}
+
+uint16 FPJLinkNotificationListener::GetBoundPort() const
+{
+    FScopeLock ScopeLock(&Lock);
+    return BoundPort;
+}
+
+bool FPJLinkNotificationListener::OpenSocket()
+{
+    FNativeSocket Socket = CreateUdpSocket();
+    if (Socket == InvalidSocket)
+    {
+        PJLINK_LOG_WARNING(TEXT("Failed to create notification socket - Error: %d"), GetLastErrorCode());
+        bBindFailed = true;
+        return false;
+    }
+
+    // 모든 인터페이스에서 알림 수신
+    SetReuseAddress(Socket, true);
+    if (!Bind(Socket, 0, ListenPort))
+    {
+        PJLINK_LOG_WARNING(TEXT("Failed to bind notification port %d - Error: %d. Falling back to status polling."),
+            ListenPort, GetLastErrorCode());
+        Close(Socket);
+        bBindFailed = true;
+        return false;
+    }
+
+    BoundPort = PJLinkSocketPlatform::GetBoundPort(Socket);
+    Handler = MakeShared<FPJLinkNotificationSocketHandler, ESPMode::ThreadSafe>(Socket);
+    FPJLinkIOReactor::Get().Register(Socket, Handler.ToSharedRef(), EPollFlags::Readable);
+
+    PJLINK_LOG_INFO(TEXT("Listening for PJLink notifications on UDP port %d"), BoundPort);
+    return true;
+}
+
+void FPJLinkNotificationListener::CloseSocket()
+{
+    if (Handler.IsValid())
+    {
+        // 리액터가 poll 목록에서 뺀 뒤 소켓을 닫음 (그 전에 읽힌 데이터그램은 DispatchDatagram 에서 버려짐)
+        FPJLinkIOReactor::Get().Unregister(Handler->GetSocket(), true);
+        Handler.Reset();
+    }
+    BoundPort = 0;
+}
+
+void FPJLinkNotificationListener::DispatchDatagram(const FPJLinkNotificationSocketHandler* Sender, const uint8* Data, int32 Length, uint32 SourceIPv4)
+{
+    // 전달이 끝날 때까지 수신기가 삭제되지 않도록 싱글톤 락 보유
+    FScopeLock InstanceScope(&InstanceLock);
+    if (Instance)
+    {
+        Instance->HandleDatagram(Sender, Data, Length, SourceIPv4);
+    }
+}
+
+void FPJLinkNotificationListener::HandleDatagram(const FPJLinkNotificationSocketHandler* Sender, const uint8* Data, int32 Length, uint32 SourceIPv4)
+{
+    FScopeLock ScopeLock(&Lock);
+
+    // 닫았거나 다른 포트로 바꾼 소켓에서 읽힌 데이터그램
+    if (Handler.Get() != Sender)
+    {
+        return;
+    }
+
+    ReceivedCount++;
+    const TArray<UPJLinkNetworkManager*>* Managers = ManagersByAddress.Find(SourceIPv4);
+    bool bMatched = false;
+
+    // 데이터그램 하나에 CR 로 끝나는 알림이 하나 이상 들어 있음 (마지막 CR 은 없어도 허용)
+    int32 LineStart = 0;
+    for (int32 Index = 0; Index <= Length; ++Index)
+    {
+        if (Index < Length && Data[Index] != '\r' && Data[Index] != '\n')
+        {
+            continue;
+        }
+
+        const uint8* Line = Data + LineStart;
+        const int32 LineLength = Index - LineStart;
+        LineStart = Index + 1;
+        if (LineLength <= 0)
+        {
+            continue;
+        }
+
+        // 검색 응답은 아직 등록되지 않은 장치에서 오므로 IP 와 무관하게 검색 수신자로 보냄
+        if (LineLength > 7 && FMemory::Memcmp(Line, "%2ACKN=", 7) == 0)
+        {
+            for (IPJLinkSearchReplySink* Sink : SearchSinks)
+            {
+                Sink->OnSearchReply(SourceIPv4, Line, LineLength);
+            }
+            bMatched |= SearchSinks.Num() > 0;
+            continue;
+        }
+
+        if (Managers)
+        {
+            for (UPJLinkNetworkManager* Manager : *Managers)
+            {
+                Manager->HandleNotificationFrame(Line, LineLength);
+            }
+            bMatched = true;
+        }
+    }
+
+    if (!bMatched)
+    {
+        UnmatchedCount++;
+        PJLINK_LOG_VERBOSE(TEXT("Ignoring notification from unregistered address %u.%u.%u.%u"),
+            (SourceIPv4 >> 24) & 0xFF, (SourceIPv4 >> 16) & 0xFF, (SourceIPv4 >> 8) & 0xFF, SourceIPv4 & 0xFF);
+    }
+}
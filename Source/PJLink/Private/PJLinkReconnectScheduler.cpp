@@ -0,0 +1,317 @@
+﻿// PJLinkReconnectScheduler.cpp
+#include "PJLinkReconnectScheduler.h"
+#include "PJLinkIOReactor.h"
+#include "PJLinkNetworkManager.h"
+#include "PJLinkLog.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/ScopeLock.h"
+
+FPJLinkReconnectScheduler* FPJLinkReconnectScheduler::Instance = nullptr;
+FCriticalSection FPJLinkReconnectScheduler::InstanceLock;
+
+FPJLinkReconnectScheduler& FPJLinkReconnectScheduler::Get()
+{
+    FScopeLock Lock(&InstanceLock);
+    if (!Instance)
+    {
+        Instance = new FPJLinkReconnectScheduler();
+    }
+    return *Instance;
+}
+
+void FPJLinkReconnectScheduler::Shutdown()
+{
+    FPJLinkReconnectScheduler* SchedulerToDelete = nullptr;
+    {
+        FScopeLock Lock(&InstanceLock);
+        SchedulerToDelete = Instance;
+        Instance = nullptr;
+    }
+
+    // 락 밖에서 정리 (진행 중인 시도가 ReportResult 로 Get() 을 호출할 수 있음)
+    delete SchedulerToDelete;
+}
+
+FPJLinkReconnectScheduler::FPJLinkReconnectScheduler()
+    : Random(static_cast<int32>(FPlatformTime::Cycles()))
+    , MaxConcurrentConnects(16)
+    , MaxBackoffSeconds(60.0f)
+    , ActiveConnects(0)
+{
+}
+
+FPJLinkReconnectScheduler::~FPJLinkReconnectScheduler()
+{
+    TArray<FEntryRef> EntriesToCancel;
+    {
+        FScopeLock ScopeLock(&Lock);
+        Entries.GenerateValueArray(EntriesToCancel);
+        for (const FEntryRef& Entry : EntriesToCancel)
+        {
+            RemoveEntry(Entry);
+        }
+    }
+
+    // 시작 중인 시도가 끝날 때까지 기다린 뒤 매니저 포인터를 끊음
+    for (const FEntryRef& Entry : EntriesToCancel)
+    {
+        FScopeLock StartScope(&Entry->StartLock);
+        Entry->Manager = nullptr;
+    }
+}
+
+void FPJLinkReconnectScheduler::Schedule(UPJLinkNetworkManager* Manager, float BaseDelaySeconds, int32 MaxAttempts)
+{
+    if (!Manager)
+    {
+        return;
+    }
+
+    FScopeLock ScopeLock(&Lock);
+    if (Entries.Contains(Manager))
+    {
+        return;
+    }
+
+    FEntryRef Entry = MakeShared<FEntry, ESPMode::ThreadSafe>();
+    Entry->Manager = Manager;
+    Entry->MaxAttempts = FMath::Max(0, MaxAttempts);
+    Entry->BaseDelaySeconds = FMath::Max(0.01f, BaseDelaySeconds);
+    Entries.Add(Manager, Entry);
+
+    ArmBackoffTimer(Entry);
+}
+
+void FPJLinkReconnectScheduler::ReportResult(UPJLinkNetworkManager* Manager, bool bConnected)
+{
+    FScopeLock ScopeLock(&Lock);
+    const FEntryRef* Found = Entries.Find(Manager);
+    if (!Found)
+    {
+        return;
+    }
+
+    const FEntryRef Entry = *Found;
+    if (bConnected)
+    {
+        // 직접 연결에 성공해도 예약은 끝남
+        if (Entry->Attempt > 0)
+        {
+            ++Stats.SuccessfulReconnects;
+        }
+        RemoveEntry(Entry);
+        PumpWaitingEntries();
+        return;
+    }
+
+    // 이 스케줄러가 시작하지 않은 시도의 실패는 무시 (백오프 대기 중의 수동 연결 등)
+    if (Entry->State != EEntryState::Connecting)
+    {
+        return;
+    }
+
+    --ActiveConnects;
+    if (Entry->MaxAttempts > 0 && Entry->Attempt >= Entry->MaxAttempts)
+    {
+        PJLINK_LOG_WARNING(TEXT("Maximum reconnect attempts (%d) reached. Giving up."), Entry->MaxAttempts);
+        ++Stats.GaveUpCount;
+        Entry->State = EEntryState::Backoff;
+        RemoveEntry(Entry);
+    }
+    else
+    {
+        ArmBackoffTimer(Entry);
+    }
+
+    PumpWaitingEntries();
+}
+
+void FPJLinkReconnectScheduler::Cancel(UPJLinkNetworkManager* Manager)
+{
+    TSharedPtr<FEntry, ESPMode::ThreadSafe> Entry;
+    {
+        FScopeLock ScopeLock(&Lock);
+        if (const FEntryRef* Found = Entries.Find(Manager))
+        {
+            Entry = *Found;
+            RemoveEntry(*Found);
+            PumpWaitingEntries();
+        }
+    }
+
+    if (Entry.IsValid())
+    {
+        // 이미 시작된 시도가 매니저를 쓰는 중이면 끝날 때까지 대기
+        FScopeLock StartScope(&Entry->StartLock);
+        Entry->Manager = nullptr;
+    }
+}
+
+void FPJLinkReconnectScheduler::SetMaxConcurrentConnects(int32 InMaxConcurrentConnects)
+{
+    FScopeLock ScopeLock(&Lock);
+    MaxConcurrentConnects = FMath::Max(1, InMaxConcurrentConnects);
+    PumpWaitingEntries();
+}
+
+int32 FPJLinkReconnectScheduler::GetMaxConcurrentConnects() const
+{
+    FScopeLock ScopeLock(&Lock);
+    return MaxConcurrentConnects;
+}
+
+void FPJLinkReconnectScheduler::SetMaxBackoffSeconds(float InMaxBackoffSeconds)
+{
+    FScopeLock ScopeLock(&Lock);
+    MaxBackoffSeconds = FMath::Max(0.01f, InMaxBackoffSeconds);
+}
+
+float FPJLinkReconnectScheduler::GetMaxBackoffSeconds() const
+{
+    FScopeLock ScopeLock(&Lock);
+    return MaxBackoffSeconds;
+}
+
+FPJLinkReconnectStats FPJLinkReconnectScheduler::GetStats() const
+{
+    FScopeLock ScopeLock(&Lock);
+    FPJLinkReconnectStats Result = Stats;
+    Result.PendingProjectors = Entries.Num();
+    Result.WaitingForSlot = WaitingEntries.Num();
+    Result.ActiveConnects = ActiveConnects;
+    return Result;
+}
+
+void FPJLinkReconnectScheduler::ResetStats()
+{
+    FScopeLock ScopeLock(&Lock);
+    Stats = FPJLinkReconnectStats();
+    Stats.PeakActiveConnects = ActiveConnects;
+}
+
+bool FPJLinkReconnectScheduler::IsScheduled(const UPJLinkNetworkManager* Manager) const
+{
+    FScopeLock ScopeLock(&Lock);
+    return Entries.Contains(Manager);
+}
+
+double FPJLinkReconnectScheduler::ComputeBackoffSeconds(float BaseSeconds, float MaxSeconds, int32 Attempt, FRandomStream& Random)
+{
+    // 2^30 이상은 어차피 상한에 걸리므로 지수를 제한해 오버플로 방지
+    const double Exponential = static_cast<double>(BaseSeconds) * FMath::Pow(2.0, static_cast<double>(FMath::Clamp(Attempt, 0, 30)));
+    const double Cap = FMath::Min(static_cast<double>(MaxSeconds), Exponential);
+    return Cap * Random.GetFraction();
+}
+
+void FPJLinkReconnectScheduler::ArmBackoffTimer(const FEntryRef& Entry)
+{
+    Entry->State = EEntryState::Backoff;
+    const double DelaySeconds = ComputeBackoffSeconds(Entry->BaseDelaySeconds, MaxBackoffSeconds, Entry->Attempt, Random);
+
+    PJLINK_LOG_VERBOSE(TEXT("Reconnect attempt %d scheduled in %.2f seconds"), Entry->Attempt + 1, DelaySeconds);
+
+    TWeakPtr<FEntry, ESPMode::ThreadSafe> WeakEntry = Entry;
+    Entry->TimerId = FPJLinkIOReactor::Get().ScheduleTimer(DelaySeconds, [WeakEntry]()
+    {
+        TSharedPtr<FEntry, ESPMode::ThreadSafe> StrongEntry = WeakEntry.Pin();
+        if (!StrongEntry.IsValid())
+        {
+            return;
+        }
+
+        // 스케줄러가 이미 종료되었으면 무시
+        FScopeLock InstanceScope(&InstanceLock);
+        if (Instance)
+        {
+            Instance->HandleBackoffExpired(StrongEntry.ToSharedRef());
+        }
+    });
+}
+
+void FPJLinkReconnectScheduler::HandleBackoffExpired(const FEntryRef& Entry)
+{
+    FScopeLock ScopeLock(&Lock);
+    if (Entry->State != EEntryState::Backoff || Entry->bRemoved.load())
+    {
+        return;
+    }
+
+    Entry->TimerId = 0;
+    if (ActiveConnects < MaxConcurrentConnects && WaitingEntries.Num() == 0)
+    {
+        DispatchAttempt(Entry);
+    }
+    else
+    {
+        // 먼저 기다리던 프로젝터부터 순서대로 슬롯을 받음
+        Entry->State = EEntryState::WaitingForSlot;
+        WaitingEntries.Add(Entry);
+        PumpWaitingEntries();
+    }
+}
+
+void FPJLinkReconnectScheduler::PumpWaitingEntries()
+{
+    int32 NumDispatched = 0;
+    while (NumDispatched < WaitingEntries.Num() && ActiveConnects < MaxConcurrentConnects)
+    {
+        DispatchAttempt(WaitingEntries[NumDispatched]);
+        ++NumDispatched;
+    }
+
+    if (NumDispatched > 0)
+    {
+        WaitingEntries.RemoveAt(0, NumDispatched);
+    }
+}
+
+void FPJLinkReconnectScheduler::DispatchAttempt(const FEntryRef& Entry)
+{
+    Entry->State = EEntryState::Connecting;
+    ++Entry->Attempt;
+    ++ActiveConnects;
+    ++Stats.TotalAttempts;
+    Stats.PeakActiveConnects = FMath::Max(Stats.PeakActiveConnects, ActiveConnects);
+
+    // 결과 보고 콜백 안에서 다음 연결을 바로 시작하지 않도록 I/O 스레드에서 시작
+    TWeakPtr<FEntry, ESPMode::ThreadSafe> WeakEntry = Entry;
+    FPJLinkIOReactor::Get().ScheduleTimer(0.0, [WeakEntry]()
+    {
+        if (TSharedPtr<FEntry, ESPMode::ThreadSafe> StrongEntry = WeakEntry.Pin())
+        {
+            StartAttempt(StrongEntry.ToSharedRef());
+        }
+    });
+}
+
+void FPJLinkReconnectScheduler::StartAttempt(const FEntryRef& Entry)
+{
+    FScopeLock StartScope(&Entry->StartLock);
+    if (Entry->Manager && !Entry->bRemoved.load())
+    {
+        Entry->Manager->AttemptReconnect(Entry->Attempt, Entry->MaxAttempts);
+    }
+}
+
+void FPJLinkReconnectScheduler::RemoveEntry(const FEntryRef& Entry)
+{
+    if (Entry->TimerId != 0)
+    {
+        FPJLinkIOReactor::Get().CancelTimer(Entry->TimerId);
+        Entry->TimerId = 0;
+    }
+
+    if (Entry->State == EEntryState::Connecting)
+    {
+        --ActiveConnects;
+    }
+    else if (Entry->State == EEntryState::WaitingForSlot)
+    {
+        WaitingEntries.Remove(Entry);
+    }
+
+    // 시작 대기 중인 시도가 실행되지 않도록 표시
+    Entry->State = EEntryState::Backoff;
+    Entry->bRemoved.store(true);
+    Entries.Remove(Entry->Manager);
+}
@@ -0,0 +1,188 @@
+﻿// PJLinkResponseParser.cpp
+#include "PJLinkResponseParser.h"
+
+namespace PJLinkResponseParser
+{
+    static uint32 LoadCode(const uint8* Data)
+    {
+        return MakeCode(Data[0], Data[1], Data[2], Data[3]);
+    }
+
+    // "ERRn" 파라미터를 오류 상태로 변환 (오류가 아니면 Success)
+    static EPJLinkResponseStatus DecodeStatus(const uint8* Parameter, int32 Length)
+    {
+        if (Length != 4)
+        {
+            return EPJLinkResponseStatus::Success;
+        }
+
+        switch (LoadCode(Parameter))
+        {
+        case MakeCode('E', 'R', 'R', '1'): return EPJLinkResponseStatus::UndefinedCommand;
+        case MakeCode('E', 'R', 'R', '2'): return EPJLinkResponseStatus::OutOfParameter;
+        case MakeCode('E', 'R', 'R', '3'): return EPJLinkResponseStatus::UnavailableTime;
+        case MakeCode('E', 'R', 'R', '4'): return EPJLinkResponseStatus::ProjectorFailure;
+        case MakeCode('E', 'R', 'R', 'A'): return EPJLinkResponseStatus::AuthenticationError;
+        default: return EPJLinkResponseStatus::Success;
+        }
+    }
+
+    static bool IsTrailingSpace(uint8 Char)
+    {
+        return Char == ' ' || Char == '\t' || Char == '\r' || Char == '\n';
+    }
+
+    bool DecodeCommand(uint32 Code, EPJLinkCommand& OutCommand)
+    {
+        switch (Code)
+        {
+        case MakeCode('P', 'O', 'W', 'R'): OutCommand = EPJLinkCommand::POWR; return true;
+        case MakeCode('I', 'N', 'P', 'T'): OutCommand = EPJLinkCommand::INPT; return true;
+        case MakeCode('A', 'V', 'M', 'T'): OutCommand = EPJLinkCommand::AVMT; return true;
+        case MakeCode('E', 'R', 'S', 'T'): OutCommand = EPJLinkCommand::ERST; return true;
+        case MakeCode('L', 'A', 'M', 'P'): OutCommand = EPJLinkCommand::LAMP; return true;
+        case MakeCode('I', 'N', 'S', 'T'): OutCommand = EPJLinkCommand::INST; return true;
+        case MakeCode('N', 'A', 'M', 'E'): OutCommand = EPJLinkCommand::NAME; return true;
+        case MakeCode('I', 'N', 'F', '1'): OutCommand = EPJLinkCommand::INF1; return true;
+        case MakeCode('I', 'N', 'F', '2'): OutCommand = EPJLinkCommand::INF2; return true;
+        case MakeCode('I', 'N', 'F', 'O'): OutCommand = EPJLinkCommand::INFO; return true;
+        case MakeCode('C', 'L', 'S', 'S'): OutCommand = EPJLinkCommand::CLSS; return true;
+        default: return false;
+        }
+    }
+
+    bool ParseFrame(const uint8* Frame, int32 Length, FPJLinkParsedFrame& OutFrame)
+    {
+        OutFrame = FPJLinkParsedFrame();
+
+        if (Frame == nullptr || Length <= 0)
+        {
+            return false;
+        }
+
+        // 단독 오류 응답 ("PJLINK ERRA" 인증 실패 등)
+        if (Frame[0] != '%')
+        {
+            static constexpr int32 PrefixLength = 7; // "PJLINK "
+            int32 ErrorOffset = 0;
+            if (Length >= PrefixLength + 4 && FMemory::Memcmp(Frame, "PJLINK ", PrefixLength) == 0)
+            {
+                ErrorOffset = PrefixLength;
+            }
+
+            if (Length - ErrorOffset < 4 || FMemory::Memcmp(Frame + ErrorOffset, "ERR", 3) != 0)
+            {
+                return false;
+            }
+
+            OutFrame.Status = DecodeStatus(Frame + ErrorOffset, 4);
+            if (OutFrame.Status == EPJLinkResponseStatus::Success)
+            {
+                OutFrame.Status = EPJLinkResponseStatus::Unknown;
+            }
+            return true;
+        }
+
+        // "%1XXXX=..." - 클래스 1자, 명령 4자, '=' 는 7번째 바이트
+        if (Length < 7 || Frame[6] != '=')
+        {
+            return false;
+        }
+
+        if (Frame[1] != '1' && Frame[1] != '2')
+        {
+            return false;
+        }
+
+        if (!DecodeCommand(LoadCode(Frame + 2), OutFrame.Command))
+        {
+            return false;
+        }
+
+        int32 ParameterEnd = Length;
+        while (ParameterEnd > 7 && IsTrailingSpace(Frame[ParameterEnd - 1]))
+        {
+            --ParameterEnd;
+        }
+
+        OutFrame.ProtocolClass = static_cast<uint8>(Frame[1] - '0');
+        OutFrame.bHasCommand = true;
+        OutFrame.ParameterOffset = 7;
+        OutFrame.ParameterLength = ParameterEnd - 7;
+        OutFrame.Status = DecodeStatus(Frame + 7, OutFrame.ParameterLength);
+        return true;
+    }
+
+    EPJLinkPowerStatus DecodePowerStatus(const uint8* Parameter, int32 Length)
+    {
+        if (Length != 1)
+        {
+            return EPJLinkPowerStatus::Unknown;
+        }
+
+        switch (Parameter[0])
+        {
+        case '0': return EPJLinkPowerStatus::PoweredOff;
+        case '1': return EPJLinkPowerStatus::PoweredOn;
+        case '2': return EPJLinkPowerStatus::CoolingDown;
+        case '3': return EPJLinkPowerStatus::WarmingUp;
+        default: return EPJLinkPowerStatus::Unknown;
+        }
+    }
+
+    EPJLinkInputSource DecodeInputSource(const uint8* Parameter, int32 Length)
+    {
+        if (Length < 1)
+        {
+            return EPJLinkInputSource::Unknown;
+        }
+
+        // 첫 글자가 입력 종류, 두 번째 글자는 같은 종류 안의 번호
+        switch (Parameter[0])
+        {
+        case '1': return EPJLinkInputSource::RGB;
+        case '2': return EPJLinkInputSource::VIDEO;
+        case '3': return EPJLinkInputSource::DIGITAL;
+        case '4': return EPJLinkInputSource::STORAGE;
+        case '5': return EPJLinkInputSource::NETWORK;
+        default: return EPJLinkInputSource::Unknown;
+        }
+    }
+
+    bool DecodeClass(const uint8* Parameter, int32 Length, EPJLinkClass& OutClass)
+    {
+        if (Length != 1)
+        {
+            return false;
+        }
+
+        switch (Parameter[0])
+        {
+        case '1': OutClass = EPJLinkClass::Class1; return true;
+        case '2': OutClass = EPJLinkClass::Class2; return true;
+        default: return false;
+        }
+    }
+
+    FString ParameterToString(const uint8* Frame, const FPJLinkParsedFrame& Parsed)
+    {
+        if (Parsed.ParameterLength <= 0)
+        {
+            return FString();
+        }
+
+        FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Frame + Parsed.ParameterOffset), Parsed.ParameterLength);
+        return FString(Converted.Length(), Converted.Get());
+    }
+
+    void AppendParameter(FString& Out, const uint8* Frame, const FPJLinkParsedFrame& Parsed)
+    {
+        if (Parsed.ParameterLength <= 0)
+        {
+            return;
+        }
+
+        FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Frame + Parsed.ParameterOffset), Parsed.ParameterLength);
+        Out.AppendChars(Converted.Get(), Converted.Length());
+    }
+}
@@ -0,0 +1,859 @@
+﻿// PJLinkScanEngine.cpp
+#include "PJLinkScanEngine.h"
+#include "PJLinkIOThreadPool.h"
+#include "PJLinkLog.h"
+#include "HAL/Event.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTLS.h"
+#include "Algo/BinarySearch.h"
+
+using namespace PJLinkSocketPlatform;
+
+namespace
+{
+    // 인사말을 받은 뒤 한 번에 보내는 정보 조회 (응답도 같은 순서로 한 줄씩 옴)
+    const ANSICHAR ScanQueries[] = "%1CLSS ?\r%1NAME ?\r%1INF1 ?\r%1INF2 ?\r";
+    constexpr int32 NumScanQueries = 4;
+
+    // 식별 정보를 다음 단계에 맡길 때 보내는 조회 (PJLink 장치인지와 클래스만 확인)
+    const ANSICHAR ClassQuery[] = "%1CLSS ?\r";
+
+    // 인증이 필요 없는 장치의 인사말
+    const ANSICHAR OpenGreeting[] = "PJLINK 0";
+
+    // 취소 확인 간격 (밀리초)
+    constexpr int32 MaxPollWaitMs = 50;
+}
+
+/**
+ * 스캔 작업 하나 (플러그인 I/O 스레드 풀에서 실행)
+ * 자기 몫의 동시 연결 수만큼 연결을 걸어 두고, 자리가 비면 엔진의 공유 커서에서 주소 묶음을 가져옵니다.
+ * 연결 목록과 poll 항목은 이 작업을 실행하는 스레드만 사용합니다.
+ */
+class FPJLinkScanEngine::FWorker
+{
+public:
+    FWorker(FPJLinkScanEngine& InOwner, int32 InCapacity)
+        : Owner(InOwner)
+        , Capacity(InCapacity)
+        , ChunkNextPosition(1)
+        , ChunkLastPosition(0)
+        , LastCompletedIPv4(InOwner.Settings.FirstIPv4)
+        , DoneEvent(FPlatformProcess::GetSynchEventFromPool(true))
+        , bLaunched(false)
+        , RunningThreadId(0)
+    {
+    }
+
+    ~FWorker()
+    {
+        FPlatformProcess::ReturnSynchEventToPool(DoneEvent);
+    }
+
+    bool Start()
+    {
+        bLaunched = FPJLinkIOThreadPool::Get().Launch([this]()
+        {
+            RunningThreadId.store(FPlatformTLS::GetCurrentThreadId());
+            Run();
+            RunningThreadId.store(0);
+
+            // 이후에는 이 객체에 접근하지 않음 (Join 반환 후 해제될 수 있음)
+            DoneEvent->Trigger();
+        },
+        [this]()
+        {
+            // 풀 종료로 시작하지 못함 - 스캔을 취소하고 이 작업 몫은 끝난 것으로 집계
+            Owner.Cancel();
+            Owner.OnWorkerFinished();
+            DoneEvent->Trigger();
+        });
+        return bLaunched;
+    }
+
+    void Join()
+    {
+        if (bLaunched)
+        {
+            DoneEvent->Wait();
+            bLaunched = false;
+        }
+    }
+
+    bool IsCurrentThread() const
+    {
+        return RunningThreadId.load() == FPlatformTLS::GetCurrentThreadId();
+    }
+
+private:
+    enum class EProbePhase : uint8
+    {
+        // 1단계: TCP 연결 대기 (마감 = 시작 시각 + 그 /24 의 현재 연결 제한 시간)
+        Connecting,
+        // 2단계: 인사말 대기
+        AwaitingGreeting,
+        // 2단계: 한 번에 보낸 정보 조회의 응답 대기
+        AwaitingResponse
+    };
+
+    // 진행 중인 연결 하나
+    struct FProbe
+    {
+        FNativeSocket Socket = InvalidSocket;
+        uint32 IPv4 = 0;
+        EProbePhase Phase = EProbePhase::Connecting;
+        double StartTime = 0.0;
+        double Deadline = 0.0;
+
+        // 재시도 연결의 고정 연결 제한 시간 (0 이면 첫 시도라 /24 추정을 따름)
+        double RetryTimeoutSeconds = 0.0;
+
+        int32 Received = 0;
+        ANSICHAR Buffer[512];
+    };
+
+    // 연결을 걸고 결과를 처리하는 루프 (취소되거나 주소가 떨어지면 반환)
+    void Run();
+
+    // 다음 대상 주소 (현재 묶음을 다 쓰면 공유 커서에서 새 묶음을, 주소가 떨어지면 재시도 대기열에서 가져옴)
+    bool NextTarget(uint32& OutIPv4, double& OutRetryTimeoutSeconds);
+
+    // 다음 주소로 연결 시작 (즉시 끝난 주소면 false, RetryTimeoutSeconds 가 0 보다 크면 재시도)
+    bool LaunchProbe(uint32 IPv4, double RetryTimeoutSeconds, double Now);
+
+    // poll 결과 처리 (연결이 끝났으면 true)
+    bool ProcessProbe(int32 ProbeIndex, uint8 Returned, double Now);
+
+    // 연결 완료 처리 (RTT 표본 반영 후 인사말 대기로 전환)
+    void OnConnected(FProbe& Probe, double Now);
+
+    // 인사말을 받은 뒤 정보 조회를 한 번에 전송 (실패 시 false)
+    bool SendQueries(FProbe& Probe, double Now);
+
+    // 수신 데이터를 버퍼에 모두 읽음 (연결이 닫혔거나 버퍼가 찼으면 true)
+    bool ReadAvailable(FProbe& Probe);
+
+    // 받은 줄 수
+    static int32 CountLines(const FProbe& Probe);
+
+    // 단계에 맞는 마감 시각
+    double GetDeadline(const FProbe& Probe) const;
+
+    // 연결 종료 처리 및 결과 집계 (bHandOff 면 열린 연결을 OnAdoptConnection 으로 넘겨 봄)
+    void FinishProbe(FProbe& Probe, double Now, bool bHandOff = false);
+
+    // 다음 poll 대기 시간 (가장 이른 마감까지, 취소 확인을 위해 최대 50ms)
+    int32 GetPollTimeoutMs(double Now) const;
+
+    FPJLinkScanEngine& Owner;
+    int32 Capacity;
+
+    // 진행 중인 연결과 poll 항목 (같은 인덱스)
+    TArray<FProbe> Probes;
+    TArray<FPollEntry> PollEntries;
+
+    // 가져온 주소 묶음의 남은 위치 (Next > Last 면 비어 있음)
+    uint64 ChunkNextPosition;
+    uint64 ChunkLastPosition;
+
+    // 마지막으로 끝난 주소
+    uint32 LastCompletedIPv4;
+
+    // 작업 종료 통지 (수동 리셋)
+    FEvent* DoneEvent;
+    bool bLaunched;
+
+    // 이 작업을 실행 중인 풀 스레드 (0 = 실행 중 아님)
+    TAtomic<uint32> RunningThreadId;
+};
+
+void FPJLinkScanEngine::FWorker::Run()
+{
+    Probes.Reserve(Capacity);
+    PollEntries.Reserve(Capacity);
+
+    while (!Owner.bCancelRequested.load())
+    {
+        double Now = FPlatformTime::Seconds();
+
+        // 빈 자리를 다음 주소로 채움 (대상 목록을 미리 만들지 않음)
+        bool bProgressed = false;
+        uint32 TargetIPv4 = 0;
+        double RetryTimeoutSeconds = 0.0;
+        while (Probes.Num() < Capacity && NextTarget(TargetIPv4, RetryTimeoutSeconds))
+        {
+            bProgressed |= !LaunchProbe(TargetIPv4, RetryTimeoutSeconds, Now);
+        }
+
+        if (Probes.Num() == 0)
+        {
+            break;
+        }
+
+        const int32 ReadyCount = Poll(PollEntries.GetData(), PollEntries.Num(), GetPollTimeoutMs(Now));
+        if (ReadyCount < 0)
+        {
+            PJLINK_LOG_ERROR(TEXT("Scan poll failed: %d"), GetLastErrorCode());
+            FPlatformProcess::Sleep(0.01f);
+            continue;
+        }
+
+        // 준비된 소켓과 마감이 지난 연결 처리 (뒤에서부터 지워 인덱스 유지)
+        Now = FPlatformTime::Seconds();
+        for (int32 ProbeIndex = Probes.Num() - 1; ProbeIndex >= 0; --ProbeIndex)
+        {
+            if (ProcessProbe(ProbeIndex, PollEntries[ProbeIndex].Returned, Now))
+            {
+                Probes.RemoveAtSwap(ProbeIndex, 1, EAllowShrinking::No);
+                PollEntries.RemoveAtSwap(ProbeIndex, 1, EAllowShrinking::No);
+                Owner.AddInFlight(-1);
+                bProgressed = true;
+            }
+        }
+
+        if (bProgressed && Owner.Callbacks.OnProgress)
+        {
+            Owner.Callbacks.OnProgress(Owner.GetStats(), LastCompletedIPv4);
+        }
+    }
+
+    // 취소되었으면 남은 연결 정리
+    for (FProbe& Probe : Probes)
+    {
+        Close(Probe.Socket);
+    }
+    Owner.AddInFlight(-Probes.Num());
+    Probes.Reset();
+    PollEntries.Reset();
+
+    Owner.OnWorkerFinished();
+}
+
+bool FPJLinkScanEngine::FWorker::NextTarget(uint32& OutIPv4, double& OutRetryTimeoutSeconds)
+{
+    OutRetryTimeoutSeconds = 0.0;
+
+    for (;;)
+    {
+        while (ChunkNextPosition <= ChunkLastPosition)
+        {
+            OutIPv4 = Owner.GetAddressAt(ChunkNextPosition++);
+            if (!Owner.IsExcluded(OutIPv4))
+            {
+                return true;
+            }
+
+            // 이미 확인한 호스트는 연결 없이 끝난 것으로 셈
+            Owner.ScannedAddresses++;
+        }
+
+        uint64 First = 0;
+        uint64 Last = 0;
+        if (!Owner.ClaimChunk(First, Last))
+        {
+            // 첫 시도가 모두 나간 뒤에만 재시도 (그동안 모인 표본으로 /24 추정이 안정됨)
+            FRetryTarget Retry;
+            if (!Owner.ClaimRetry(Retry))
+            {
+                return false;
+            }
+            OutIPv4 = Retry.IPv4;
+            OutRetryTimeoutSeconds = Retry.ConnectTimeoutSeconds;
+            return true;
+        }
+        ChunkNextPosition = First;
+        ChunkLastPosition = Last;
+    }
+}
+
+bool FPJLinkScanEngine::FWorker::LaunchProbe(uint32 IPv4, double RetryTimeoutSeconds, double Now)
+{
+    FProbe Probe;
+    Probe.IPv4 = IPv4;
+    Probe.StartTime = Now;
+    Probe.RetryTimeoutSeconds = RetryTimeoutSeconds;
+    Probe.Socket = CreateTcpSocket();
+    if (Probe.Socket == InvalidSocket)
+    {
+        // 소켓 핸들이 부족하면 이 주소는 건너뜀 (남은 연결이 끝나면 다시 열 수 있음)
+        PJLINK_LOG_WARNING(TEXT("Failed to create scan socket - Error: %d"), GetLastErrorCode());
+        FinishProbe(Probe, Now);
+        return false;
+    }
+
+    FPollEntry Entry;
+    Entry.Socket = Probe.Socket;
+    Entry.Requested = EPollFlags::Writable;
+
+    switch (Connect(Probe.Socket, IPv4, Owner.Settings.Port))
+    {
+    case EConnectResult::InProgress:
+        break;
+
+    case EConnectResult::Connected:
+        // 루프백 등에서 즉시 연결됨
+        if (Probe.RetryTimeoutSeconds > 0.0)
+        {
+            Owner.RetryRecoveredHosts++;
+        }
+        OnConnected(Probe, Now);
+        Entry.Requested = EPollFlags::Readable;
+        break;
+
+    default:
+        // 네트워크/호스트 도달 불가가 즉시 보고된 경우
+        Owner.RefusedHosts++;
+        FinishProbe(Probe, Now);
+        return false;
+    }
+
+    Probes.Add(Probe);
+    PollEntries.Add(Entry);
+    Owner.AddInFlight(1);
+    return true;
+}
+
+bool FPJLinkScanEngine::FWorker::ProcessProbe(int32 ProbeIndex, uint8 Returned, double Now)
+{
+    FProbe& Probe = Probes[ProbeIndex];
+    const bool bReadable = (Returned & (EPollFlags::Readable | EPollFlags::Error)) != 0;
+
+    switch (Probe.Phase)
+    {
+    case EProbePhase::Connecting:
+        // 실패한 연결은 플랫폼에 따라 오류 또는 HUP(읽기 가능)로만 보고됨
+        if (Returned != EPollFlags::None)
+        {
+            // 재시도에서 연결되거나 거부(RST)로 답한 호스트만 되찾은 것으로 셈 (도달 불가/소켓 오류 제외)
+            const int32 PendingError = GetPendingError(Probe.Socket);
+            if (Probe.RetryTimeoutSeconds > 0.0 && (PendingError == 0 || IsConnectionRefused(PendingError)))
+            {
+                Owner.RetryRecoveredHosts++;
+            }
+
+            if (PendingError != 0)
+            {
+                // 거부(RST)도 한 번의 왕복이므로 RTT 표본으로 씀 (라우터가 보낸 도달 불가 오류는 제외)
+                // Windows 는 RST 를 받아도 SYN 을 다시 보내 거부 보고가 1초 가까이 늦으므로 하한보다 빠른 거부만 믿음
+                const double RefusedRttSeconds = Now - Probe.StartTime;
+                if (IsConnectionRefused(PendingError) && RefusedRttSeconds < Owner.Settings.MinConnectTimeoutSeconds)
+                {
+                    Owner.AddConnectRttSample(Probe.IPv4, RefusedRttSeconds);
+                }
+                Owner.RefusedHosts++;
+                FinishProbe(Probe, Now);
+                return true;
+            }
+
+            // 연결을 받아들인 호스트만 같은 연결로 2단계 진행 (같은 인덱스의 poll 항목을 수신 대기로 전환)
+            OnConnected(Probe, Now);
+            PollEntries[ProbeIndex].Requested = EPollFlags::Readable;
+            return false;
+        }
+
+        if (Now >= GetDeadline(Probe))
+        {
+            // 줄인 제한 시간 때문에 놓쳤을 수 있는 호스트는 끝난 것으로 세지 않고 재시도 대기열로
+            if (Probe.RetryTimeoutSeconds <= 0.0 && Owner.QueueRetry(Probe.IPv4, GetDeadline(Probe) - Probe.StartTime))
+            {
+                Close(Probe.Socket);
+                Probe.Socket = InvalidSocket;
+                return true;
+            }
+
+            Owner.TimedOutHosts++;
+            FinishProbe(Probe, Now);
+            return true;
+        }
+        return false;
+
+    case EProbePhase::AwaitingGreeting:
+        if (bReadable)
+        {
+            if (ReadAvailable(Probe))
+            {
+                FinishProbe(Probe, Now);
+                return true;
+            }
+
+            if (CountLines(Probe) >= 1)
+            {
+                // 인증이 필요한 장치는 암호 없이 조회하면 ERRA 로 끊기므로 인사말만 보고
+                const bool bOpen = FCStringAnsi::Strncmp(Probe.Buffer, OpenGreeting, UE_ARRAY_COUNT(OpenGreeting) - 1) == 0;
+                if (!bOpen || !SendQueries(Probe, Now))
+                {
+                    FinishProbe(Probe, Now);
+                    return true;
+                }
+                return false;
+            }
+        }
+        break;
+
+    case EProbePhase::AwaitingResponse:
+        // 인사말 + 조회 응답을 모두 받으면 끝 (연결이 열려 있으면 다음 단계로 넘길 수 있음)
+        if (bReadable)
+        {
+            const bool bClosed = ReadAvailable(Probe);
+            const int32 NumQueries = Owner.Settings.bQueryIdentity ? NumScanQueries : 1;
+            if (bClosed || CountLines(Probe) >= 1 + NumQueries)
+            {
+                FinishProbe(Probe, Now, !bClosed);
+                return true;
+            }
+        }
+        break;
+    }
+
+    if (Now >= GetDeadline(Probe))
+    {
+        // 인사말만 보내고 조회에 답하지 않아도 받은 만큼 보고
+        FinishProbe(Probe, Now);
+        return true;
+    }
+    return false;
+}
+
+void FPJLinkScanEngine::FWorker::OnConnected(FProbe& Probe, double Now)
+{
+    Owner.OpenHosts++;
+    Owner.AddConnectRttSample(Probe.IPv4, Now - Probe.StartTime);
+
+    Probe.Phase = EProbePhase::AwaitingGreeting;
+    Probe.Deadline = Now + Owner.Settings.ResponseTimeoutSeconds;
+}
+
+bool FPJLinkScanEngine::FWorker::SendQueries(FProbe& Probe, double Now)
+{
+    // 조회를 한 번의 send 로 보내고 응답을 한꺼번에 기다림 (명령마다 왕복하지 않음)
+    const ANSICHAR* Queries = Owner.Settings.bQueryIdentity ? ScanQueries : ClassQuery;
+    const int32 QueryLength = Owner.Settings.bQueryIdentity ? sizeof(ScanQueries) - 1 : sizeof(ClassQuery) - 1;
+
+    int32 BytesSent = 0;
+    if (Send(Probe.Socket, reinterpret_cast<const uint8*>(Queries), QueryLength, BytesSent) != EIOResult::Ok
+        || BytesSent != QueryLength)
+    {
+        return false;
+    }
+
+    Probe.Phase = EProbePhase::AwaitingResponse;
+    Probe.Deadline = Now + Owner.Settings.ResponseTimeoutSeconds;
+    return true;
+}
+
+bool FPJLinkScanEngine::FWorker::ReadAvailable(FProbe& Probe)
+{
+    for (;;)
+    {
+        // 버퍼 끝 한 바이트는 널 종료용
+        const int32 Space = UE_ARRAY_COUNT(Probe.Buffer) - 1 - Probe.Received;
+        if (Space <= 0)
+        {
+            return true;
+        }
+
+        int32 BytesRead = 0;
+        const EIOResult Result = Recv(Probe.Socket, reinterpret_cast<uint8*>(Probe.Buffer + Probe.Received), Space, BytesRead);
+        if (Result == EIOResult::WouldBlock)
+        {
+            return false;
+        }
+        if (Result != EIOResult::Ok)
+        {
+            return true;
+        }
+        Probe.Received += BytesRead;
+    }
+}
+
+int32 FPJLinkScanEngine::FWorker::CountLines(const FProbe& Probe)
+{
+    int32 LineCount = 0;
+    for (int32 ByteIndex = 0; ByteIndex < Probe.Received; ++ByteIndex)
+    {
+        LineCount += Probe.Buffer[ByteIndex] == '\r' ? 1 : 0;
+    }
+    return LineCount;
+}
+
+double FPJLinkScanEngine::FWorker::GetDeadline(const FProbe& Probe) const
+{
+    if (Probe.Phase != EProbePhase::Connecting)
+    {
+        return Probe.Deadline;
+    }
+
+    // 연결 대기 마감은 그 /24 의 RTT 추정이 바뀌면 이미 걸어 둔 연결에도 바로 반영 (재시도는 고정)
+    return Probe.StartTime + (Probe.RetryTimeoutSeconds > 0.0
+        ? Probe.RetryTimeoutSeconds : Owner.GetConnectTimeoutSeconds(Probe.IPv4));
+}
+
+void FPJLinkScanEngine::FWorker::FinishProbe(FProbe& Probe, double Now, bool bHandOff)
+{
+    if (Probe.Received > 0)
+    {
+        Owner.FoundHosts++;
+        if (Owner.Callbacks.OnHostFound)
+        {
+            Probe.Buffer[Probe.Received] = 0;
+            const int32 ResponseTimeMs = FMath::FloorToInt((Now - Probe.StartTime) * 1000.0);
+            Owner.Callbacks.OnHostFound(Probe.IPv4, FString(UTF8_TO_TCHAR(Probe.Buffer)), ResponseTimeMs);
+        }
+    }
+
+    // 발견 보고 뒤에 넘겨야 받는 쪽이 결과를 먼저 알게 됨
+    const bool bAdopted = bHandOff && Owner.Callbacks.OnAdoptConnection
+        && Owner.Callbacks.OnAdoptConnection(Probe.IPv4, Probe.Socket);
+    if (!bAdopted)
+    {
+        Close(Probe.Socket);
+    }
+    Probe.Socket = InvalidSocket;
+
+    LastCompletedIPv4 = Probe.IPv4;
+    Owner.LastCompletedIPv4.store(Probe.IPv4, std::memory_order_relaxed);
+    Owner.ScannedAddresses++;
+}
+
+int32 FPJLinkScanEngine::FWorker::GetPollTimeoutMs(double Now) const
+{
+    double EarliestDeadline = Now + MaxPollWaitMs / 1000.0;
+    for (const FProbe& Probe : Probes)
+    {
+        EarliestDeadline = FMath::Min(EarliestDeadline, GetDeadline(Probe));
+    }
+    return FMath::Clamp(FMath::CeilToInt((EarliestDeadline - Now) * 1000.0), 0, MaxPollWaitMs);
+}
+
+FPJLinkScanEngine::FPJLinkScanEngine(const FPJLinkScanSettings& InSettings, FPJLinkScanCallbacks&& InCallbacks)
+    : Settings(InSettings)
+    , Callbacks(MoveTemp(InCallbacks))
+    , NumPositions(0)
+    , NextChunkPosition(0)
+    , StartTime(0.0)
+    , bCancelRequested(false)
+    , bFinished(false)
+    , ScannedAddresses(0)
+    , InFlight(0)
+    , PeakInFlight(0)
+    , OpenHosts(0)
+    , FoundHosts(0)
+    , RefusedHosts(0)
+    , TimedOutHosts(0)
+    , RetriedHosts(0)
+    , RetryRecoveredHosts(0)
+    , LastCompletedIPv4(0)
+    , RunningWorkers(0)
+    , FinishedWorkerMicros(0)
+    , FirstWorkerFinishMicros(-1)
+    , LastWorkerFinishMicros(-1)
+    , NumSubnetEstimates(1)
+    , FirstSubnet(InSettings.FirstIPv4 >> 8)
+    , RttSubnets(0)
+{
+    Settings.MaxInFlight = FMath::Clamp(Settings.MaxInFlight, 1, MaxInFlightLimit);
+    Settings.NumWorkers = FMath::Clamp(Settings.NumWorkers, 1, FMath::Min(MaxWorkersLimit, Settings.MaxInFlight));
+    Settings.ChunkSize = FMath::Max(1, Settings.ChunkSize);
+    Settings.ConnectTimeoutSeconds = FMath::Max(0.01, Settings.ConnectTimeoutSeconds);
+    Settings.MinConnectTimeoutSeconds = FMath::Min(Settings.MinConnectTimeoutSeconds, Settings.ConnectTimeoutSeconds);
+    Settings.ResponseTimeoutSeconds = FMath::Max(0.01, Settings.ResponseTimeoutSeconds);
+    Settings.RetryTimeoutMultiplier = FMath::Max(1.0, Settings.RetryTimeoutMultiplier);
+
+    if (Settings.TargetIPv4s.Num() > 0)
+    {
+        NumPositions = Settings.TargetIPv4s.Num();
+    }
+    else if (Settings.LastIPv4 >= Settings.FirstIPv4)
+    {
+        NumPositions = static_cast<uint64>(Settings.LastIPv4) - Settings.FirstIPv4 + 1;
+    }
+
+    // 제외 목록은 주소마다 이진 탐색
+    Settings.ExcludedIPv4s.Sort();
+
+    if (Settings.LastIPv4 >= Settings.FirstIPv4)
+    {
+        NumSubnetEstimates = static_cast<int32>(FMath::Min<uint32>(
+            (Settings.LastIPv4 >> 8) - FirstSubnet + 1, MaxSubnetEstimates));
+    }
+    SubnetEstimates = MakeUnique<FRttEstimate[]>(NumSubnetEstimates);
+
+    // 표본이 모이기 전에는 상한을 그대로 씀
+    const int64 InitialTimeoutMicros = static_cast<int64>(Settings.ConnectTimeoutSeconds * 1000000.0);
+    OverallRtt.ConnectTimeoutMicros.store(InitialTimeoutMicros);
+    for (int32 SubnetIndex = 0; SubnetIndex < NumSubnetEstimates; ++SubnetIndex)
+    {
+        SubnetEstimates[SubnetIndex].ConnectTimeoutMicros.store(InitialTimeoutMicros);
+    }
+}
+
+FPJLinkScanEngine::~FPJLinkScanEngine()
+{
+    Cancel();
+    WaitForCompletion();
+}
+
+bool FPJLinkScanEngine::Start()
+{
+    if (Workers.Num() > 0 || Settings.LastIPv4 < Settings.FirstIPv4 || NumPositions == 0)
+    {
+        return false;
+    }
+
+    // 풀 스레드보다 많은 작업은 큐에서 기다리기만 하므로 풀 크기로 제한
+    FPJLinkIOThreadPool& Pool = FPJLinkIOThreadPool::Get();
+    const int32 NumWorkers = FMath::Clamp(Settings.NumWorkers, 1, FMath::Max(1, Pool.GetNumThreads()));
+
+    // 동시 연결 수를 작업 스레드에 고르게 나눔
+    for (int32 WorkerIndex = 0; WorkerIndex < NumWorkers; ++WorkerIndex)
+    {
+        const int32 Capacity = Settings.MaxInFlight / NumWorkers + (WorkerIndex < Settings.MaxInFlight % NumWorkers ? 1 : 0);
+        Workers.Add(MakeUnique<FWorker>(*this, Capacity));
+    }
+
+    StartTime = FPlatformTime::Seconds();
+    RunningWorkers.store(NumWorkers);
+
+    for (int32 WorkerIndex = 0; WorkerIndex < NumWorkers; ++WorkerIndex)
+    {
+        if (!Workers[WorkerIndex]->Start())
+        {
+            // 시작하지 못한 스레드 몫은 끝난 것으로 집계하고, 이미 시작한 스레드는 중단
+            PJLINK_LOG_ERROR(TEXT("Failed to start scan worker %d"), WorkerIndex);
+            Cancel();
+            for (int32 Remaining = WorkerIndex; Remaining < NumWorkers; ++Remaining)
+            {
+                OnWorkerFinished();
+            }
+            return false;
+        }
+    }
+    return true;
+}
+
+void FPJLinkScanEngine::Cancel()
+{
+    bCancelRequested.store(true);
+}
+
+void FPJLinkScanEngine::WaitForCompletion()
+{
+    // 콜백 안에서 취소한 경우 자기 자신을 기다리면 교착 상태
+    if (IsInScanThread())
+    {
+        Cancel();
+        return;
+    }
+
+    for (TUniquePtr<FWorker>& Worker : Workers)
+    {
+        Worker->Join();
+    }
+}
+
+bool FPJLinkScanEngine::IsInScanThread() const
+{
+    for (const TUniquePtr<FWorker>& Worker : Workers)
+    {
+        if (Worker->IsCurrentThread())
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+FPJLinkScanStats FPJLinkScanEngine::GetStats() const
+{
+    FPJLinkScanStats Stats;
+    Stats.TotalAddresses = static_cast<int32>(FMath::Min<uint64>(NumPositions, MAX_int32));
+    Stats.ScannedAddresses = ScannedAddresses.load();
+    Stats.InFlight = InFlight.load();
+    Stats.PeakInFlight = PeakInFlight.load();
+    Stats.OpenHosts = OpenHosts.load();
+    Stats.FoundHosts = FoundHosts.load();
+    Stats.RefusedHosts = RefusedHosts.load();
+    Stats.TimedOutHosts = TimedOutHosts.load();
+    Stats.RetriedHosts = RetriedHosts.load();
+    Stats.RetryRecoveredHosts = RetryRecoveredHosts.load();
+    Stats.RttSubnets = RttSubnets.load();
+    Stats.LastCompletedIPv4 = LastCompletedIPv4.load(std::memory_order_relaxed);
+    Stats.SmoothedConnectRttSeconds = OverallRtt.SmoothedRttMicros.load(std::memory_order_relaxed) / 1000000.0;
+    Stats.ConnectTimeoutSeconds = OverallRtt.ConnectTimeoutMicros.load(std::memory_order_relaxed) / 1000000.0;
+    Stats.NumWorkers = Workers.Num();
+    Stats.RunningWorkers = RunningWorkers.load();
+
+    // 끝난 뒤에는 마지막 작업 스레드 종료 시점 기준, 진행 중에는 현재 시각 기준
+    const int64 LastFinishMicros = LastWorkerFinishMicros.load();
+    const int64 ElapsedMicros = bFinished.load() && LastFinishMicros >= 0 ? LastFinishMicros : GetElapsedMicros();
+    Stats.ElapsedSeconds = ElapsedMicros / 1000000.0;
+
+    // 실행 중인 스레드는 지금까지 계속 일한 것으로 봄
+    if (Stats.NumWorkers > 0 && ElapsedMicros > 0)
+    {
+        const int64 BusyMicros = FinishedWorkerMicros.load() + static_cast<int64>(Stats.RunningWorkers) * ElapsedMicros;
+        Stats.WorkerUtilization = FMath::Clamp(
+            static_cast<double>(BusyMicros) / (static_cast<double>(ElapsedMicros) * Stats.NumWorkers), 0.0, 1.0);
+    }
+
+    const int64 FirstFinishMicros = FirstWorkerFinishMicros.load();
+    if (FirstFinishMicros >= 0)
+    {
+        Stats.TailSeconds = FMath::Max<int64>(0, ElapsedMicros - FirstFinishMicros) / 1000000.0;
+    }
+    return Stats;
+}
+
+bool FPJLinkScanEngine::ClaimChunk(uint64& OutFirstPosition, uint64& OutLastPosition)
+{
+    // 끝을 넘어선 뒤에도 fetch_add 는 계속되지만 64비트라 넘치지 않음
+    const uint64 First = NextChunkPosition.fetch_add(Settings.ChunkSize);
+    if (First >= NumPositions)
+    {
+        return false;
+    }
+
+    OutFirstPosition = First;
+    OutLastPosition = FMath::Min<uint64>(First + Settings.ChunkSize, NumPositions) - 1;
+    return true;
+}
+
+uint32 FPJLinkScanEngine::GetAddressAt(uint64 Position) const
+{
+    return Settings.TargetIPv4s.Num() > 0
+        ? Settings.TargetIPv4s[static_cast<int32>(Position)]
+        : static_cast<uint32>(Settings.FirstIPv4 + Position);
+}
+
+bool FPJLinkScanEngine::IsExcluded(uint32 IPv4) const
+{
+    return Settings.ExcludedIPv4s.Num() > 0 && Algo::BinarySearch(Settings.ExcludedIPv4s, IPv4) != INDEX_NONE;
+}
+
+bool FPJLinkScanEngine::ClaimRetry(FRetryTarget& OutTarget)
+{
+    FScopeLock Lock(&RetryLock);
+    if (RetryTargets.Num() == 0)
+    {
+        return false;
+    }
+
+    OutTarget = RetryTargets.Pop(EAllowShrinking::No);
+    return true;
+}
+
+bool FPJLinkScanEngine::QueueRetry(uint32 IPv4, double UsedTimeoutSeconds)
+{
+    // 상한을 다 기다린 호스트는 다시 시도해도 결과가 같음
+    if (!Settings.bRetryTimedOut || bCancelRequested.load()
+        || UsedTimeoutSeconds >= Settings.ConnectTimeoutSeconds * 0.999)
+    {
+        return false;
+    }
+
+    FRetryTarget Target;
+    Target.IPv4 = IPv4;
+    Target.ConnectTimeoutSeconds = FMath::Min(Settings.ConnectTimeoutSeconds, UsedTimeoutSeconds * Settings.RetryTimeoutMultiplier);
+
+    {
+        FScopeLock Lock(&RetryLock);
+        RetryTargets.Add(Target);
+    }
+    RetriedHosts++;
+    return true;
+}
+
+void FPJLinkScanEngine::AddInFlight(int32 Delta)
+{
+    const int32 Current = (InFlight += Delta);
+    int32 Peak = PeakInFlight.load();
+    while (Current > Peak && !PeakInFlight.compare_exchange_weak(Peak, Current))
+    {
+    }
+}
+
+void FPJLinkScanEngine::AddConnectRttSample(uint32 IPv4, double RttSeconds)
+{
+    RttSeconds = FMath::Max(0.0, RttSeconds);
+    FRttEstimate& SubnetEstimate = GetSubnetEstimate(IPv4);
+
+    FScopeLock Lock(&RttLock);
+    if (!SubnetEstimate.bHasSample)
+    {
+        RttSubnets++;
+    }
+    UpdateRttEstimate(SubnetEstimate, RttSeconds);
+    UpdateRttEstimate(OverallRtt, RttSeconds);
+}
+
+void FPJLinkScanEngine::UpdateRttEstimate(FRttEstimate& Estimate, double RttSeconds) const
+{
+    if (!Estimate.bHasSample)
+    {
+        Estimate.SmoothedRttSeconds = RttSeconds;
+        Estimate.RttVarianceSeconds = RttSeconds / 2.0;
+        Estimate.bHasSample = true;
+    }
+    else
+    {
+        Estimate.RttVarianceSeconds = 0.75 * Estimate.RttVarianceSeconds + 0.25 * FMath::Abs(Estimate.SmoothedRttSeconds - RttSeconds);
+        Estimate.SmoothedRttSeconds = 0.875 * Estimate.SmoothedRttSeconds + 0.125 * RttSeconds;
+    }
+    Estimate.SmoothedRttMicros.store(static_cast<int64>(Estimate.SmoothedRttSeconds * 1000000.0), std::memory_order_relaxed);
+
+    if (Settings.MinConnectTimeoutSeconds > 0.0)
+    {
+        const double Timeout = FMath::Clamp(Estimate.SmoothedRttSeconds + 4.0 * Estimate.RttVarianceSeconds,
+            Settings.MinConnectTimeoutSeconds, Settings.ConnectTimeoutSeconds);
+        Estimate.ConnectTimeoutMicros.store(static_cast<int64>(Timeout * 1000000.0), std::memory_order_relaxed);
+    }
+}
+
+FPJLinkScanEngine::FRttEstimate& FPJLinkScanEngine::GetSubnetEstimate(uint32 IPv4) const
+{
+    // 스캔 범위 밖 주소는 없지만, /8 보다 넓은 범위는 앞쪽 추정을 나눠 씀
+    const uint32 SubnetOffset = (IPv4 >> 8) - FirstSubnet;
+    return SubnetEstimates[SubnetOffset % static_cast<uint32>(NumSubnetEstimates)];
+}
+
+double FPJLinkScanEngine::GetConnectTimeoutSeconds(uint32 IPv4) const
+{
+    return GetSubnetEstimate(IPv4).ConnectTimeoutMicros.load(std::memory_order_relaxed) / 1000000.0;
+}
+
+int64 FPJLinkScanEngine::GetElapsedMicros() const
+{
+    return StartTime > 0.0 ? static_cast<int64>((FPlatformTime::Seconds() - StartTime) * 1000000.0) : 0;
+}
+
+void FPJLinkScanEngine::OnWorkerFinished()
+{
+    const int64 FinishMicros = GetElapsedMicros();
+    FinishedWorkerMicros.fetch_add(FinishMicros);
+
+    int64 NoFinishYet = -1;
+    FirstWorkerFinishMicros.compare_exchange_strong(NoFinishYet, FinishMicros);
+
+    if (RunningWorkers.fetch_sub(1) != 1)
+    {
+        return;
+    }
+
+    // 마지막 작업 스레드
+    LastWorkerFinishMicros.store(FinishMicros);
+    bFinished.store(true);
+
+    const bool bCancelled = bCancelRequested.load();
+    const FPJLinkScanStats Stats = GetStats();
+    PJLINK_LOG_INFO(TEXT("Scan %s: %d/%d addresses in %.2f s, %d open, %d found, %d refused, %d timed out, %d retried (%d recovered) (connect timeout %.0f ms, SRTT %.1f ms over %d subnets), peak %d in flight, %d workers %.0f%% busy, tail %.3f s"),
+        bCancelled ? TEXT("cancelled") : TEXT("finished"), Stats.ScannedAddresses, Stats.TotalAddresses,
+        Stats.ElapsedSeconds, Stats.OpenHosts, Stats.FoundHosts, Stats.RefusedHosts, Stats.TimedOutHosts,
+        Stats.RetriedHosts, Stats.RetryRecoveredHosts, Stats.ConnectTimeoutSeconds * 1000.0,
+        Stats.SmoothedConnectRttSeconds * 1000.0, Stats.RttSubnets, Stats.PeakInFlight,
+        Stats.NumWorkers, Stats.WorkerUtilization * 100.0, Stats.TailSeconds);
+
+    if (Callbacks.OnFinished)
+    {
+        Callbacks.OnFinished(Stats, bCancelled);
+    }
+}
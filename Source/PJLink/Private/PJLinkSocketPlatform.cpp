@@ -0,0 +1,373 @@
+﻿// PJLinkSocketPlatform.cpp
+#include "PJLinkSocketPlatform.h"
+
+#if PLATFORM_WINDOWS
+#include "Windows/AllowWindowsPlatformTypes.h"
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#include "Windows/HideWindowsPlatformTypes.h"
+#else
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <errno.h>
+#endif
+
+namespace PJLinkSocketPlatform
+{
+#if PLATFORM_WINDOWS
+    using FRawSocket = SOCKET;
+    using FPollFd = WSAPOLLFD;
+    static const FRawSocket RawInvalidSocket = INVALID_SOCKET;
+#else
+    using FRawSocket = int;
+    using FPollFd = pollfd;
+    static const FRawSocket RawInvalidSocket = -1;
+#endif
+
+    static FORCEINLINE FRawSocket ToRaw(FNativeSocket Socket)
+    {
+        return Socket == InvalidSocket ? RawInvalidSocket : static_cast<FRawSocket>(Socket);
+    }
+
+    static FORCEINLINE FNativeSocket FromRaw(FRawSocket Socket)
+    {
+        return Socket == RawInvalidSocket ? InvalidSocket : static_cast<FNativeSocket>(Socket);
+    }
+
+    static bool IsWouldBlock(int32 ErrorCode)
+    {
+#if PLATFORM_WINDOWS
+        return ErrorCode == WSAEWOULDBLOCK;
+#else
+        return ErrorCode == EAGAIN || ErrorCode == EWOULDBLOCK;
+#endif
+    }
+
+    static bool SetNonBlockingInternal(FRawSocket Socket)
+    {
+#if PLATFORM_WINDOWS
+        u_long Mode = 1;
+        return ioctlsocket(Socket, FIONBIO, &Mode) == 0;
+#else
+        const int Flags = fcntl(Socket, F_GETFL, 0);
+        return Flags != -1 && fcntl(Socket, F_SETFL, Flags | O_NONBLOCK) == 0;
+#endif
+    }
+
+    static sockaddr_in MakeAddress(uint32 IPv4, uint16 Port)
+    {
+        sockaddr_in Address;
+        FMemory::Memzero(Address);
+        Address.sin_family = AF_INET;
+        Address.sin_addr.s_addr = htonl(IPv4);
+        Address.sin_port = htons(Port);
+        return Address;
+    }
+
+    static FNativeSocket CreateSocketInternal(int Type, int Protocol)
+    {
+        FRawSocket Socket = ::socket(AF_INET, Type, Protocol);
+        if (Socket == RawInvalidSocket)
+        {
+            return InvalidSocket;
+        }
+
+        if (!SetNonBlockingInternal(Socket))
+        {
+#if PLATFORM_WINDOWS
+            closesocket(Socket);
+#else
+            ::close(Socket);
+#endif
+            return InvalidSocket;
+        }
+
+#if PLATFORM_MAC || PLATFORM_IOS
+        // 끊긴 소켓에 쓸 때 SIGPIPE 방지
+        int NoSigPipe = 1;
+        setsockopt(Socket, SOL_SOCKET, SO_NOSIGPIPE, &NoSigPipe, sizeof(NoSigPipe));
+#endif
+
+        return FromRaw(Socket);
+    }
+
+    FNativeSocket CreateTcpSocket()
+    {
+        return CreateSocketInternal(SOCK_STREAM, IPPROTO_TCP);
+    }
+
+    FNativeSocket CreateUdpSocket()
+    {
+        return CreateSocketInternal(SOCK_DGRAM, IPPROTO_UDP);
+    }
+
+    static bool SetIntOption(FNativeSocket Socket, int Level, int Option, int Value)
+    {
+        return setsockopt(ToRaw(Socket), Level, Option, reinterpret_cast<const char*>(&Value), sizeof(Value)) == 0;
+    }
+
+    bool SetNoDelay(FNativeSocket Socket, bool bNoDelay)
+    {
+        return SetIntOption(Socket, IPPROTO_TCP, TCP_NODELAY, bNoDelay ? 1 : 0);
+    }
+
+    bool SetBroadcast(FNativeSocket Socket, bool bBroadcast)
+    {
+        return SetIntOption(Socket, SOL_SOCKET, SO_BROADCAST, bBroadcast ? 1 : 0);
+    }
+
+    bool SetReuseAddress(FNativeSocket Socket, bool bReuse)
+    {
+        return SetIntOption(Socket, SOL_SOCKET, SO_REUSEADDR, bReuse ? 1 : 0);
+    }
+
+    EConnectResult Connect(FNativeSocket Socket, uint32 IPv4, uint16 Port)
+    {
+        const sockaddr_in Address = MakeAddress(IPv4, Port);
+        if (::connect(ToRaw(Socket), reinterpret_cast<const sockaddr*>(&Address), sizeof(Address)) == 0)
+        {
+            return EConnectResult::Connected;
+        }
+
+        const int32 ErrorCode = GetLastErrorCode();
+#if PLATFORM_WINDOWS
+        if (ErrorCode == WSAEWOULDBLOCK || ErrorCode == WSAEINPROGRESS)
+#else
+        if (ErrorCode == EINPROGRESS || ErrorCode == EWOULDBLOCK)
+#endif
+        {
+            return EConnectResult::InProgress;
+        }
+
+        return EConnectResult::Failed;
+    }
+
+    int32 GetPendingError(FNativeSocket Socket)
+    {
+        int Error = 0;
+#if PLATFORM_WINDOWS
+        int Length = sizeof(Error);
+#else
+        socklen_t Length = sizeof(Error);
+#endif
+        if (getsockopt(ToRaw(Socket), SOL_SOCKET, SO_ERROR, reinterpret_cast<char*>(&Error), &Length) != 0)
+        {
+            return GetLastErrorCode();
+        }
+        return Error;
+    }
+
+    EIOResult Send(FNativeSocket Socket, const uint8* Data, int32 Length, int32& OutBytesSent)
+    {
+        OutBytesSent = 0;
+#if PLATFORM_WINDOWS || PLATFORM_MAC || PLATFORM_IOS
+        const int Flags = 0;
+#else
+        const int Flags = MSG_NOSIGNAL;
+#endif
+        const int Result = ::send(ToRaw(Socket), reinterpret_cast<const char*>(Data), Length, Flags);
+        if (Result >= 0)
+        {
+            OutBytesSent = Result;
+            return EIOResult::Ok;
+        }
+        return IsWouldBlock(GetLastErrorCode()) ? EIOResult::WouldBlock : EIOResult::Error;
+    }
+
+    EIOResult Recv(FNativeSocket Socket, uint8* Buffer, int32 BufferSize, int32& OutBytesRead)
+    {
+        OutBytesRead = 0;
+        const int Result = ::recv(ToRaw(Socket), reinterpret_cast<char*>(Buffer), BufferSize, 0);
+        if (Result > 0)
+        {
+            OutBytesRead = Result;
+            return EIOResult::Ok;
+        }
+        if (Result == 0)
+        {
+            return EIOResult::Closed;
+        }
+        return IsWouldBlock(GetLastErrorCode()) ? EIOResult::WouldBlock : EIOResult::Error;
+    }
+
+    EIOResult SendTo(FNativeSocket Socket, const uint8* Data, int32 Length, uint32 IPv4, uint16 Port, int32& OutBytesSent)
+    {
+        OutBytesSent = 0;
+        const sockaddr_in Address = MakeAddress(IPv4, Port);
+        const int Result = ::sendto(ToRaw(Socket), reinterpret_cast<const char*>(Data), Length, 0,
+            reinterpret_cast<const sockaddr*>(&Address), sizeof(Address));
+        if (Result >= 0)
+        {
+            OutBytesSent = Result;
+            return EIOResult::Ok;
+        }
+        return IsWouldBlock(GetLastErrorCode()) ? EIOResult::WouldBlock : EIOResult::Error;
+    }
+
+    EIOResult RecvFrom(FNativeSocket Socket, uint8* Buffer, int32 BufferSize, int32& OutBytesRead, uint32& OutIPv4, uint16& OutPort)
+    {
+        OutBytesRead = 0;
+        sockaddr_in Address;
+        FMemory::Memzero(Address);
+#if PLATFORM_WINDOWS
+        int AddressLength = sizeof(Address);
+#else
+        socklen_t AddressLength = sizeof(Address);
+#endif
+        const int Result = ::recvfrom(ToRaw(Socket), reinterpret_cast<char*>(Buffer), BufferSize, 0,
+            reinterpret_cast<sockaddr*>(&Address), &AddressLength);
+        if (Result >= 0)
+        {
+            OutBytesRead = Result;
+            OutIPv4 = ntohl(Address.sin_addr.s_addr);
+            OutPort = ntohs(Address.sin_port);
+            return EIOResult::Ok;
+        }
+
+        const int32 ErrorCode = GetLastErrorCode();
+#if PLATFORM_WINDOWS
+        // ICMP port unreachable 이 UDP 소켓에 WSAECONNRESET 으로 보고되는 경우는 무시
+        if (ErrorCode == WSAECONNRESET)
+        {
+            return EIOResult::WouldBlock;
+        }
+#endif
+        return IsWouldBlock(ErrorCode) ? EIOResult::WouldBlock : EIOResult::Error;
+    }
+
+    bool Bind(FNativeSocket Socket, uint32 IPv4, uint16 Port)
+    {
+        const sockaddr_in Address = MakeAddress(IPv4, Port);
+        return ::bind(ToRaw(Socket), reinterpret_cast<const sockaddr*>(&Address), sizeof(Address)) == 0;
+    }
+
+    bool Listen(FNativeSocket Socket, int32 Backlog)
+    {
+        return ::listen(ToRaw(Socket), Backlog) == 0;
+    }
+
+    FNativeSocket Accept(FNativeSocket ListenSocket)
+    {
+        FRawSocket Accepted = ::accept(ToRaw(ListenSocket), nullptr, nullptr);
+        if (Accepted == RawInvalidSocket)
+        {
+            return InvalidSocket;
+        }
+
+        SetNonBlockingInternal(Accepted);
+        return FromRaw(Accepted);
+    }
+
+    uint16 GetBoundPort(FNativeSocket Socket)
+    {
+        sockaddr_in Address;
+        FMemory::Memzero(Address);
+#if PLATFORM_WINDOWS
+        int AddressLength = sizeof(Address);
+#else
+        socklen_t AddressLength = sizeof(Address);
+#endif
+        if (getsockname(ToRaw(Socket), reinterpret_cast<sockaddr*>(&Address), &AddressLength) != 0)
+        {
+            return 0;
+        }
+        return ntohs(Address.sin_port);
+    }
+
+    int32 Poll(FPollEntry* Entries, int32 NumEntries, int32 TimeoutMs)
+    {
+        // 스레드마다 재사용하는 pollfd 배열 (매 호출 할당 방지)
+        static thread_local TArray<FPollFd> PollFds;
+        PollFds.SetNumUninitialized(NumEntries, EAllowShrinking::No);
+
+        for (int32 Index = 0; Index < NumEntries; ++Index)
+        {
+            FPollFd& Fd = PollFds[Index];
+            Fd.fd = ToRaw(Entries[Index].Socket);
+            Fd.events = 0;
+            Fd.revents = 0;
+            if (Entries[Index].Requested & EPollFlags::Readable)
+            {
+                Fd.events |= POLLIN;
+            }
+            if (Entries[Index].Requested & EPollFlags::Writable)
+            {
+                Fd.events |= POLLOUT;
+            }
+        }
+
+#if PLATFORM_WINDOWS
+        const int Result = WSAPoll(PollFds.GetData(), static_cast<ULONG>(NumEntries), TimeoutMs);
+#else
+        const int Result = ::poll(PollFds.GetData(), static_cast<nfds_t>(NumEntries), TimeoutMs);
+#endif
+        if (Result < 0)
+        {
+#if !PLATFORM_WINDOWS
+            if (errno == EINTR)
+            {
+                return 0;
+            }
+#endif
+            return -1;
+        }
+
+        for (int32 Index = 0; Index < NumEntries; ++Index)
+        {
+            const short REvents = PollFds[Index].revents;
+            uint8 Returned = EPollFlags::None;
+            if (REvents & (POLLIN | POLLHUP))
+            {
+                Returned |= EPollFlags::Readable;
+            }
+            if (REvents & POLLOUT)
+            {
+                Returned |= EPollFlags::Writable;
+            }
+            if (REvents & (POLLERR | POLLNVAL))
+            {
+                Returned |= EPollFlags::Error;
+            }
+            Entries[Index].Returned = Returned;
+        }
+
+        return Result;
+    }
+
+    void Close(FNativeSocket Socket)
+    {
+        if (Socket == InvalidSocket)
+        {
+            return;
+        }
+#if PLATFORM_WINDOWS
+        closesocket(ToRaw(Socket));
+#else
+        ::close(ToRaw(Socket));
+#endif
+    }
+
+    int32 GetLastErrorCode()
+    {
+#if PLATFORM_WINDOWS
+        return WSAGetLastError();
+#else
+        return errno;
+#endif
+    }
+
+    bool IsConnectionRefused(int32 ErrorCode)
+    {
+#if PLATFORM_WINDOWS
+        return ErrorCode == WSAECONNREFUSED;
+#else
+        return ErrorCode == ECONNREFUSED;
+#endif
+    }
+}
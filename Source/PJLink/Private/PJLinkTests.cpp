@@ -10,6 +10,748 @@
 #include "Engine/Engine.h"
 #include "TimerManager.h"
 #include "PJLinkLog.h"
+#include "PJLinkIOReactor.h"
+#include "PJLinkConnection.h"
+#include "PJLinkFrameAssembler.h"
+#include "PJLinkResponseParser.h"
+#include "PJLinkTimingWheel.h"
+#include "PJLinkSocketPlatform.h"
+#include "PJLinkReconnectScheduler.h"
+#include "PJLinkEventDrainScheduler.h"
+#include "PJLinkNotificationListener.h"
+#include "PJLinkDiscoveryManager.h"
+#include "PJLinkScanEngine.h"
+#include "PJLinkDiscoveryEnricher.h"
+#include "PJLinkKnownHostsIndex.h"
+#include "PJLinkIOThreadPool.h"
+#include "Async/Async.h"
+#include "Misc/QueuedThreadPool.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "HAL/Event.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "Misc/SecureHash.h"
+#include "Misc/Paths.h"
+#include "HAL/FileManager.h"
+
+#if PLATFORM_WINDOWS
+#include "Windows/AllowWindowsPlatformTypes.h"
+#include <windows.h>
+#include "Windows/HideWindowsPlatformTypes.h"
+#else
+#include <sys/resource.h>
+#endif
+
+// 인증 에뮬레이터가 보내는 챌린지 (PJLink 규격 예시 값)
+#define TEST_AUTH_CHALLENGE "498e4a67"
+
+namespace PJLinkTestUtils
+{
+    using namespace PJLinkSocketPlatform;
+
+    // 프로세스 전체 CPU 사용 시간 (user + kernel, 초)
+    static double GetProcessCPUSeconds()
+    {
+#if PLATFORM_WINDOWS
+        FILETIME CreationTime, ExitTime, KernelTime, UserTime;
+        if (!::GetProcessTimes(::GetCurrentProcess(), &CreationTime, &ExitTime, &KernelTime, &UserTime))
+        {
+            return 0.0;
+        }
+        const uint64 Kernel = (static_cast<uint64>(KernelTime.dwHighDateTime) << 32) | KernelTime.dwLowDateTime;
+        const uint64 User = (static_cast<uint64>(UserTime.dwHighDateTime) << 32) | UserTime.dwLowDateTime;
+        return static_cast<double>(Kernel + User) * 1e-7; // 100ns 단위
+#else
+        rusage Usage;
+        if (getrusage(RUSAGE_SELF, &Usage) != 0)
+        {
+            return 0.0;
+        }
+        return static_cast<double>(Usage.ru_utime.tv_sec + Usage.ru_stime.tv_sec)
+            + static_cast<double>(Usage.ru_utime.tv_usec + Usage.ru_stime.tv_usec) * 1e-6;
+#endif
+    }
+
+    // 엔진 공유 풀(GThreadPool)에서 짧은 시간 안에 작업을 받지 못한 스레드 수
+    // 스레드 수만큼 작업을 넣고 WindowSeconds 안에 시작한 작업 수를 세어 점유 중인 스레드를 추정합니다.
+    static int32 MeasureBusyEnginePoolThreads(double WindowSeconds = 0.05)
+    {
+        const int32 NumThreads = GThreadPool ? GThreadPool->GetNumThreads() : 0;
+        if (NumThreads <= 0)
+        {
+            return 0;
+        }
+
+        TAtomic<int32> StartedCount(0);
+        FEvent* ReleaseEvent = FPlatformProcess::GetSynchEventFromPool(true);
+
+        // 시작한 작업은 잠시 스레드를 붙잡아 한 스레드가 여러 작업을 가져가지 못하게 함
+        TArray<TFuture<void>> Futures;
+        for (int32 Index = 0; Index < NumThreads; ++Index)
+        {
+            Futures.Add(AsyncPool(*GThreadPool, [&StartedCount, ReleaseEvent]()
+            {
+                StartedCount++;
+                ReleaseEvent->Wait(200);
+            }));
+        }
+
+        const double WaitStart = FPlatformTime::Seconds();
+        while (StartedCount.load() < NumThreads && FPlatformTime::Seconds() - WaitStart < WindowSeconds)
+        {
+            FPlatformProcess::Sleep(0.001f);
+        }
+        const int32 BusyThreads = NumThreads - StartedCount.load();
+
+        ReleaseEvent->Trigger();
+        for (TFuture<void>& Future : Futures)
+        {
+            Future.Wait();
+        }
+        FPlatformProcess::ReturnSynchEventToPool(ReleaseEvent);
+        return BusyThreads;
+    }
+
+    // 루프백 리슨 소켓 생성 (OutPort 에 할당된 포트 반환)
+    static FNativeSocket CreateLoopbackListener(uint16& OutPort, int32 Backlog = 1024)
+    {
+        FNativeSocket Listener = CreateTcpSocket();
+        if (Listener == InvalidSocket)
+        {
+            return InvalidSocket;
+        }
+
+        if (!Bind(Listener, LoopbackIPv4, 0) || !Listen(Listener, Backlog))
+        {
+            Close(Listener);
+            return InvalidSocket;
+        }
+
+        OutPort = GetBoundPort(Listener);
+        return Listener;
+    }
+
+    // 리슨 소켓에 연결된 클라이언트/서버 소켓 쌍 생성
+    static bool CreateLoopbackPair(FNativeSocket Listener, uint16 Port, FNativeSocket& OutClient, FNativeSocket& OutServer)
+    {
+        OutClient = CreateTcpSocket();
+        OutServer = InvalidSocket;
+        if (OutClient == InvalidSocket || Connect(OutClient, LoopbackIPv4, Port) == EConnectResult::Failed)
+        {
+            Close(OutClient);
+            OutClient = InvalidSocket;
+            return false;
+        }
+
+        FPollEntry ListenEntry;
+        ListenEntry.Socket = Listener;
+        ListenEntry.Requested = EPollFlags::Readable;
+        if (Poll(&ListenEntry, 1, 1000) > 0)
+        {
+            OutServer = Accept(Listener);
+        }
+
+        FPollEntry ClientEntry;
+        ClientEntry.Socket = OutClient;
+        ClientEntry.Requested = EPollFlags::Writable;
+        const bool bClientReady = Poll(&ClientEntry, 1, 1000) > 0 && GetPendingError(OutClient) == 0;
+
+        if (OutServer == InvalidSocket || !bClientReady)
+        {
+            Close(OutClient);
+            Close(OutServer);
+            OutClient = InvalidSocket;
+            OutServer = InvalidSocket;
+            return false;
+        }
+
+        SetNoDelay(OutClient, true);
+        return true;
+    }
+
+    /**
+     * 바이트 파서 도입 전의 FString 기반 응답 파서 (BenchmarkResponseParser 비교 기준)
+     */
+    bool LegacyParseResponse(const FString& ResponseString, EPJLinkCommand& OutCommand, FString& OutParameter, EPJLinkResponseStatus& OutStatus)
+    {
+        // 기본값 설정
+        OutStatus = EPJLinkResponseStatus::Unknown;
+
+        // 응답 유효성 검사
+        if (ResponseString.IsEmpty() || ResponseString.Len() < 7)
+        {
+            return false;
+        }
+
+        // 응답 클래스 및 형식 확인 ("%1XXXX=..." 형식, '='은 7번째 문자)
+        if (!ResponseString.StartsWith(TEXT("%")) || ResponseString[6] != TEXT('='))
+        {
+            // 오류 응답 확인 (ERR1, ERR2, ERR3, ERR4, ERRA 등)
+            if (ResponseString.StartsWith(TEXT("ERR")))
+            {
+                if (ResponseString.Contains(TEXT("ERR1")))
+                {
+                    OutStatus = EPJLinkResponseStatus::UndefinedCommand;
+                }
+                else if (ResponseString.Contains(TEXT("ERR2")))
+                {
+                    OutStatus = EPJLinkResponseStatus::OutOfParameter;
+                }
+                else if (ResponseString.Contains(TEXT("ERR3")))
+                {
+                    OutStatus = EPJLinkResponseStatus::UnavailableTime;
+                }
+                else if (ResponseString.Contains(TEXT("ERR4")))
+                {
+                    OutStatus = EPJLinkResponseStatus::ProjectorFailure;
+                }
+                else if (ResponseString.Contains(TEXT("ERRA")))
+                {
+                    OutStatus = EPJLinkResponseStatus::AuthenticationError;
+                }
+
+                return true;
+            }
+
+            return false;
+        }
+
+        // 명령 파싱
+        FString CommandStr = ResponseString.Mid(2, 4);
+
+        // 명령 타입 결정
+        if (CommandStr.Equals(TEXT("POWR")))
+        {
+            OutCommand = EPJLinkCommand::POWR;
+        }
+        else if (CommandStr.Equals(TEXT("INPT")))
+        {
+            OutCommand = EPJLinkCommand::INPT;
+        }
+        else if (CommandStr.Equals(TEXT("AVMT")))
+        {
+            OutCommand = EPJLinkCommand::AVMT;
+        }
+        else if (CommandStr.Equals(TEXT("ERST")))
+        {
+            OutCommand = EPJLinkCommand::ERST;
+        }
+        else if (CommandStr.Equals(TEXT("LAMP")))
+        {
+            OutCommand = EPJLinkCommand::LAMP;
+        }
+        else if (CommandStr.Equals(TEXT("INST")))
+        {
+            OutCommand = EPJLinkCommand::INST;
+        }
+        else if (CommandStr.Equals(TEXT("NAME")))
+        {
+            OutCommand = EPJLinkCommand::NAME;
+        }
+        else if (CommandStr.Equals(TEXT("INF1")))
+        {
+            OutCommand = EPJLinkCommand::INF1;
+        }
+        else if (CommandStr.Equals(TEXT("INF2")))
+        {
+            OutCommand = EPJLinkCommand::INF2;
+        }
+        else if (CommandStr.Equals(TEXT("INFO")))
+        {
+            OutCommand = EPJLinkCommand::INFO;
+        }
+        else if (CommandStr.Equals(TEXT("CLSS")))
+        {
+            OutCommand = EPJLinkCommand::CLSS;
+        }
+        else
+        {
+            // 알 수 없는 명령
+            return false;
+        }
+
+        // 파라미터 추출
+        int32 EqualsPos = ResponseString.Find(TEXT("="));
+        if (EqualsPos != INDEX_NONE)
+        {
+            OutParameter = ResponseString.Mid(EqualsPos + 1).TrimEnd();
+
+            // 마지막 캐리지 리턴 제거
+            if (OutParameter.EndsWith(TEXT("\r")))
+            {
+                OutParameter = OutParameter.LeftChop(1);
+            }
+        }
+
+        // 명령 응답 안의 오류 코드 확인 (예: "%1POWR=ERR3")
+        if (OutParameter.StartsWith(TEXT("ERR")))
+        {
+            if (OutParameter.Equals(TEXT("ERR1")))
+            {
+                OutStatus = EPJLinkResponseStatus::UndefinedCommand;
+            }
+            else if (OutParameter.Equals(TEXT("ERR2")))
+            {
+                OutStatus = EPJLinkResponseStatus::OutOfParameter;
+            }
+            else if (OutParameter.Equals(TEXT("ERR3")))
+            {
+                OutStatus = EPJLinkResponseStatus::UnavailableTime;
+            }
+            else if (OutParameter.Equals(TEXT("ERR4")))
+            {
+                OutStatus = EPJLinkResponseStatus::ProjectorFailure;
+            }
+            else if (OutParameter.Equals(TEXT("ERRA")))
+            {
+                OutStatus = EPJLinkResponseStatus::AuthenticationError;
+            }
+            return true;
+        }
+
+        // 성공 응답
+        OutStatus = EPJLinkResponseStatus::Success;
+        return true;
+    }
+
+    /**
+     * 현재 스레드의 힙 할당 횟수를 세는 GMalloc 프록시
+     * 벤치마크 구간 동안만 설치하며, 다른 스레드의 할당은 세지 않습니다.
+     */
+    class FPJLinkCountingMalloc : public FMalloc
+    {
+    public:
+        explicit FPJLinkCountingMalloc(FMalloc* InInner)
+            : Inner(InInner)
+        {
+        }
+
+        static void SetCountingThread(bool bEnable) { bCountThisThread = bEnable; }
+        static uint64 GetAllocationCount() { return AllocationCount; }
+        static void ResetAllocationCount() { AllocationCount = 0; }
+
+        virtual void* Malloc(SIZE_T Count, uint32 Alignment) override
+        {
+            CountAllocation();
+            return Inner->Malloc(Count, Alignment);
+        }
+
+        virtual void* TryMalloc(SIZE_T Count, uint32 Alignment) override
+        {
+            CountAllocation();
+            return Inner->TryMalloc(Count, Alignment);
+        }
+
+        virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+        {
+            CountAllocation();
+            return Inner->Realloc(Original, Count, Alignment);
+        }
+
+        virtual void* TryRealloc(void* Original, SIZE_T Count, uint32 Alignment) override
+        {
+            CountAllocation();
+            return Inner->TryRealloc(Original, Count, Alignment);
+        }
+
+        virtual void Free(void* Original) override
+        {
+            Inner->Free(Original);
+        }
+
+        virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override
+        {
+            return Inner->QuantizeSize(Count, Alignment);
+        }
+
+        virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override
+        {
+            return Inner->GetAllocationSize(Original, SizeOut);
+        }
+
+        virtual void Trim(bool bTrimThreadCaches) override
+        {
+            Inner->Trim(bTrimThreadCaches);
+        }
+
+        virtual bool IsInternallyThreadSafe() const override
+        {
+            return Inner->IsInternallyThreadSafe();
+        }
+
+        virtual const TCHAR* GetDescriptiveName() override
+        {
+            return TEXT("PJLinkCountingMalloc");
+        }
+
+    private:
+        static void CountAllocation()
+        {
+            if (bCountThisThread)
+            {
+                ++AllocationCount;
+            }
+        }
+
+        FMalloc* Inner;
+        static thread_local bool bCountThisThread;
+        static thread_local uint64 AllocationCount;
+    };
+
+    thread_local bool FPJLinkCountingMalloc::bCountThisThread = false;
+    thread_local uint64 FPJLinkCountingMalloc::AllocationCount = 0;
+
+    /**
+     * 루프백 PJLink 프로젝터 에뮬레이터
+     * 접속 시 인사말을 보내고, bRespond 이면 수신한 명령마다 미리 정한 응답을 돌려줍니다.
+     * bRespond 가 false 면 응답하지 않아 클라이언트 쪽 수신이 계속 대기 상태로 남습니다.
+     * 암호를 지정하면 "PJLINK 1 <난수>" 로 인사하고 첫 명령 앞에 붙은 응답 해시를 검사합니다.
+     * 유휴 시간을 지정하면 실제 장비처럼 그 시간 동안 명령이 없는 세션을 닫습니다.
+     */
+    class FPJLinkTestProjector : public FRunnable
+    {
+    public:
+        explicit FPJLinkTestProjector(bool bInRespond)
+            : bRespond(bInRespond)
+            , ListenSocket(InvalidSocket)
+            , Port(0)
+            , bStopping(false)
+            , ReceivedCommandCount(0)
+            , ReceivedReadCount(0)
+            , AuthenticatedCount(0)
+            , AuthFailureCount(0)
+            , AcceptedCount(0)
+            , IdleCloseCount(0)
+            , IdleTimeoutSeconds(0.0)
+            , bDropClients(false)
+            , Thread(nullptr)
+        {
+        }
+
+        virtual ~FPJLinkTestProjector()
+        {
+            StopEmulator();
+        }
+
+        bool Start()
+        {
+            ListenSocket = CreateLoopbackListener(Port, 64);
+            if (ListenSocket == InvalidSocket)
+            {
+                return false;
+            }
+
+            Thread = FRunnableThread::Create(this, TEXT("PJLinkTestProjector"));
+            return Thread != nullptr;
+        }
+
+        void StopEmulator()
+        {
+            if (Thread)
+            {
+                Thread->Kill(true);
+                delete Thread;
+                Thread = nullptr;
+            }
+
+            for (FClient& Client : Clients)
+            {
+                Close(Client.Socket);
+            }
+            Clients.Empty();
+
+            Close(ListenSocket);
+            ListenSocket = InvalidSocket;
+        }
+
+        // 이 명령에는 응답하지 않음 (응답 누락 시나리오, Start 전에 설정)
+        void SetSilentCommand(const FString& InCommandName) { SilentCommand = InCommandName; }
+
+        // 인증 요구 (Start 전에 설정)
+        void SetPassword(const FString& InPassword) { Password = InPassword; }
+
+        // 유휴 세션 종료 시간 (0 = 닫지 않음, Start 전에 설정)
+        void SetIdleTimeout(double InSeconds) { IdleTimeoutSeconds = InSeconds; }
+
+        // 연결된 클라이언트를 모두 끊음 (스위치 재부팅 시나리오, 에뮬레이터 스레드에서 처리)
+        void DropAllClients() { bDropClients.store(true); }
+
+        // 받아들인 연결 수 / 유휴로 닫은 연결 수
+        int32 GetAcceptedCount() const { return AcceptedCount.load(); }
+        int32 GetIdleCloseCount() const { return IdleCloseCount.load(); }
+
+        // 첫 명령 앞의 응답 해시가 맞았던/틀렸던 연결 수
+        int32 GetAuthenticatedCount() const { return AuthenticatedCount.load(); }
+        int32 GetAuthFailureCount() const { return AuthFailureCount.load(); }
+
+        uint16 GetPort() const { return Port; }
+        int32 GetReceivedCommandCount() const { return ReceivedCommandCount.load(); }
+
+        // 데이터를 받은 recv 호출 수 (루프백에서는 송신 측 send 횟수와 거의 같음)
+        int32 GetReceivedReadCount() const { return ReceivedReadCount.load(); }
+
+        FPJLinkProjectorInfo MakeProjectorInfo() const
+        {
+            FPJLinkProjectorInfo Info;
+            Info.Name = TEXT("Loopback Emulator");
+            Info.IPAddress = TEXT("127.0.0.1");
+            Info.Port = Port;
+            return Info;
+        }
+
+        virtual uint32 Run() override
+        {
+            TArray<FPollEntry> Entries;
+            uint8 Buffer[1024];
+
+            while (!bStopping.load())
+            {
+                if (bDropClients.exchange(false))
+                {
+                    for (FClient& Client : Clients)
+                    {
+                        Close(Client.Socket);
+                    }
+                    Clients.Empty();
+                }
+
+                Entries.Reset();
+                FPollEntry& ListenEntry = Entries.AddDefaulted_GetRef();
+                ListenEntry.Socket = ListenSocket;
+                ListenEntry.Requested = EPollFlags::Readable;
+                for (const FClient& Client : Clients)
+                {
+                    FPollEntry& Entry = Entries.AddDefaulted_GetRef();
+                    Entry.Socket = Client.Socket;
+                    Entry.Requested = EPollFlags::Readable;
+                }
+
+                // 유휴 세션 종료 (정상 종료이므로 클라이언트는 오류 없이 닫힘을 받음)
+                if (IdleTimeoutSeconds > 0.0)
+                {
+                    const double Now = FPlatformTime::Seconds();
+                    bool bClosedAny = false;
+                    for (int32 Index = Clients.Num() - 1; Index >= 0; --Index)
+                    {
+                        if (Now - Clients[Index].LastActivityTime >= IdleTimeoutSeconds)
+                        {
+                            Close(Clients[Index].Socket);
+                            Clients.RemoveAt(Index);
+                            IdleCloseCount++;
+                            bClosedAny = true;
+                        }
+                    }
+                    if (bClosedAny)
+                    {
+                        continue;
+                    }
+                }
+
+                if (Poll(Entries.GetData(), Entries.Num(), IdleTimeoutSeconds > 0.0 ? 10 : 50) <= 0)
+                {
+                    continue;
+                }
+
+                if (Entries[0].Returned & EPollFlags::Readable)
+                {
+                    FNativeSocket Accepted = Accept(ListenSocket);
+                    if (Accepted != InvalidSocket)
+                    {
+                        FClient& Client = Clients.AddDefaulted_GetRef();
+                        Client.Socket = Accepted;
+                        Client.bAuthenticated = Password.IsEmpty();
+                        Client.LastActivityTime = FPlatformTime::Seconds();
+                        AcceptedCount++;
+                        SendLine(Accepted, Password.IsEmpty() ? "PJLINK 0" : "PJLINK 1 " TEST_AUTH_CHALLENGE);
+                    }
+                }
+
+                for (int32 Index = Clients.Num() - 1; Index >= 0; --Index)
+                {
+                    if (!(Entries.IsValidIndex(Index + 1) && Entries[Index + 1].Returned))
+                    {
+                        continue;
+                    }
+
+                    int32 BytesRead = 0;
+                    const EIOResult Result = Recv(Clients[Index].Socket, Buffer, sizeof(Buffer), BytesRead);
+                    if (Result == EIOResult::Ok)
+                    {
+                        ReceivedReadCount++;
+                        Clients[Index].LastActivityTime = FPlatformTime::Seconds();
+                        if (!HandleBytes(Clients[Index], Buffer, BytesRead))
+                        {
+                            Close(Clients[Index].Socket);
+                            Clients.RemoveAt(Index);
+                        }
+                    }
+                    else if (Result != EIOResult::WouldBlock)
+                    {
+                        Close(Clients[Index].Socket);
+                        Clients.RemoveAt(Index);
+                    }
+                }
+            }
+            return 0;
+        }
+
+        virtual void Stop() override
+        {
+            bStopping.store(true);
+        }
+
+    private:
+        struct FClient
+        {
+            FNativeSocket Socket = InvalidSocket;
+            TArray<uint8> Pending;
+            bool bAuthenticated = true;
+            double LastActivityTime = 0.0;
+        };
+
+        static void SendLine(FNativeSocket Socket, const ANSICHAR* Line)
+        {
+            TArray<uint8> Data;
+            Data.Append(reinterpret_cast<const uint8*>(Line), FCStringAnsi::Strlen(Line));
+            Data.Add('\r');
+            int32 BytesSent = 0;
+            PJLinkSocketPlatform::Send(Socket, Data.GetData(), Data.Num(), BytesSent);
+        }
+
+        // 수신 바이트 처리 (인증 실패로 연결을 끊어야 하면 false)
+        bool HandleBytes(FClient& Client, const uint8* Data, int32 Length)
+        {
+            Client.Pending.Append(Data, Length);
+
+            int32 LineStart = 0;
+            for (int32 Index = 0; Index < Client.Pending.Num(); ++Index)
+            {
+                if (Client.Pending[Index] != '\r')
+                {
+                    continue;
+                }
+
+                const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Client.Pending.GetData() + LineStart), Index - LineStart);
+                FString Line(Converted.Length(), Converted.Get());
+                LineStart = Index + 1;
+
+                // 인증 연결의 첫 명령은 응답 해시(32자) 바로 뒤에 붙어 옴
+                if (!Client.bAuthenticated)
+                {
+                    if (!Line.StartsWith(ExpectedDigest(), ESearchCase::CaseSensitive))
+                    {
+                        // 실제 프로젝터처럼 인증 오류를 알리고 연결 종료
+                        AuthFailureCount++;
+                        SendLine(Client.Socket, "PJLINK ERRA");
+                        return false;
+                    }
+
+                    Line.RightChopInline(32);
+                    Client.bAuthenticated = true;
+                    AuthenticatedCount++;
+                }
+
+                ReceivedCommandCount++;
+
+                if (bRespond && !(SilentCommand.Len() == 4 && Line.Mid(2, 4) == SilentCommand))
+                {
+                    SendLine(Client.Socket, TCHAR_TO_UTF8(*MakeResponse(Line)));
+                }
+            }
+
+            Client.Pending.RemoveAt(0, LineStart, EAllowShrinking::No);
+            return true;
+        }
+
+        // 챌린지 + 암호의 MD5 (소문자 16진수)
+        FString ExpectedDigest() const
+        {
+            return FMD5::HashAnsiString(*(FString(TEXT(TEST_AUTH_CHALLENGE)) + Password));
+        }
+
+        static FString MakeResponse(const FString& Command)
+        {
+            // "%1POWR ?" -> "%1POWR=1", "%1POWR 1" -> "%1POWR=OK"
+            if (Command.Len() < 7 || Command[0] != TEXT('%'))
+            {
+                return TEXT("PJLINK ERR1");
+            }
+
+            const FString Header = Command.Left(6);
+            const FString Body = Command.Mid(7);
+            if (Body != TEXT("?"))
+            {
+                return Header + TEXT("=OK");
+            }
+
+            const FString Name = Command.Mid(2, 4);
+            if (Name == TEXT("POWR")) return Header + TEXT("=1");
+            if (Name == TEXT("INPT")) return Header + TEXT("=31");
+            if (Name == TEXT("NAME")) return Header + TEXT("=Loopback Emulator");
+            if (Name == TEXT("INF1")) return Header + TEXT("=PJLinkTest");
+            if (Name == TEXT("INF2")) return Header + TEXT("=Emulator");
+            if (Name == TEXT("INFO")) return Header + TEXT("=Test Build");
+            if (Name == TEXT("CLSS")) return Header + TEXT("=1");
+            return Header + TEXT("=ERR1");
+        }
+
+        bool bRespond;
+        FString SilentCommand;
+        FString Password;
+        FNativeSocket ListenSocket;
+        uint16 Port;
+        TAtomic<bool> bStopping;
+        TAtomic<int32> ReceivedCommandCount;
+        TAtomic<int32> ReceivedReadCount;
+        TAtomic<int32> AuthenticatedCount;
+        TAtomic<int32> AuthFailureCount;
+        TAtomic<int32> AcceptedCount;
+        TAtomic<int32> IdleCloseCount;
+        double IdleTimeoutSeconds;
+        TAtomic<bool> bDropClients;
+        FRunnableThread* Thread;
+
+        // 에뮬레이터 스레드 전용
+        TArray<FClient> Clients;
+    };
+
+    // 이전 응답 큐 항목 (문자열에 이벤트 종류를 인코딩하던 방식, 벤치마크 비교용)
+    struct FLegacyResponseQueueItem
+    {
+        EPJLinkCommand Command = EPJLinkCommand::POWR;
+        EPJLinkResponseStatus Status = EPJLinkResponseStatus::Unknown;
+        FString ResponseText;
+    };
+
+    // 이전 ProcessResponseItem 의 문자열 해석 부분 (대리자 호출 대신 체크섬 계산)
+    int32 LegacyDecodeItem(const FLegacyResponseQueueItem& Item)
+    {
+        if (Item.ResponseText.StartsWith(TEXT("COMMUNICATION_LOG")))
+        {
+            TArray<FString> Parts;
+            Item.ResponseText.ParseIntoArray(Parts, TEXT("|"));
+            if (Parts.Num() >= 4)
+            {
+                const bool bIsSending = (Parts[1] == TEXT("1"));
+                return (bIsSending ? 1 : 0) + Parts[2].Len() + Parts[3].Len();
+            }
+            return 0;
+        }
+
+        if (Item.ResponseText.StartsWith(TEXT("ERROR")))
+        {
+            TArray<FString> Parts;
+            Item.ResponseText.ParseIntoArray(Parts, TEXT("|"));
+            if (Parts.Num() >= 3)
+            {
+                return FCString::Atoi(*Parts[1]) + Parts[2].Len();
+            }
+            return 0;
+        }
+
+        return static_cast<int32>(Item.Status) + Item.ResponseText.Len();
+    }
+}
 
 bool UPJLinkTests::TestConnection(const FString& IPAddress, int32 Port)
 {
@@ -462,4 +1204,3381 @@ bool UPJLinkTests::TestDiagnosticSystem(const FPJLinkProjectorInfo& ProjectorInf
     NetworkManager->DisconnectFromProjector();
 
     return bAllSectionsPresent;
-}
\ No newline at end of file
+}
+
+bool UPJLinkTests::BenchmarkReactorIdleConnections(int32 NumConnections, float DurationSeconds)
+{
+    using namespace PJLinkSocketPlatform;
+    using namespace PJLinkTestUtils;
+
+    NumConnections = FMath::Clamp(NumConnections, 1, 10000);
+    DurationSeconds = FMath::Clamp(DurationSeconds, 1.0f, 60.0f);
+
+    PJLINK_LOG_INFO(TEXT("Starting reactor idle benchmark: %d connections, %.1f seconds"), NumConnections, DurationSeconds);
+
+    uint16 Port = 0;
+    FNativeSocket Listener = CreateLoopbackListener(Port);
+    if (Listener == InvalidSocket)
+    {
+        PJLINK_LOG_ERROR(TEXT("Failed to create loopback listener for benchmark"));
+        return false;
+    }
+
+    FPJLinkIOReactor& Reactor = FPJLinkIOReactor::Get();
+    const int32 RegisteredBefore = Reactor.GetNumRegistered();
+
+    // 서버 측 소켓은 프로젝터 역할 (아무것도 보내지 않는 유휴 연결)
+    TArray<TSharedPtr<FPJLinkConnection, ESPMode::ThreadSafe>> Connections;
+    TArray<FNativeSocket> ServerSockets;
+    Connections.Reserve(NumConnections);
+    ServerSockets.Reserve(NumConnections);
+
+    for (int32 Index = 0; Index < NumConnections; ++Index)
+    {
+        FNativeSocket Client = InvalidSocket;
+        FNativeSocket Server = InvalidSocket;
+        if (!CreateLoopbackPair(Listener, Port, Client, Server))
+        {
+            PJLINK_LOG_WARNING(TEXT("Could only open %d loopback connections"), Index);
+            break;
+        }
+
+        Connections.Add(FPJLinkConnection::Create(Client, nullptr));
+        ServerSockets.Add(Server);
+    }
+
+    bool bSuccess = Connections.Num() > 0;
+    if (bSuccess)
+    {
+        // 등록이 I/O 스레드에 반영될 때까지 잠시 대기
+        FPlatformProcess::Sleep(0.2f);
+
+        const double CPUStart = GetProcessCPUSeconds();
+        const double WallStart = FPlatformTime::Seconds();
+        FPlatformProcess::Sleep(DurationSeconds);
+        const double WallElapsed = FPlatformTime::Seconds() - WallStart;
+        const double CPUElapsed = GetProcessCPUSeconds() - CPUStart;
+
+        const double CPUMsPerSecond = CPUElapsed * 1000.0 / WallElapsed;
+        const double CPUMsPerSecondPer1000 = CPUMsPerSecond * 1000.0 / Connections.Num();
+
+        PJLINK_LOG_INFO(TEXT("Reactor benchmark: %d idle connections on %d I/O thread(s) (registered: %d)"),
+            Connections.Num(), Reactor.GetNumThreads(), Reactor.GetNumRegistered() - RegisteredBefore);
+        PJLINK_LOG_INFO(TEXT("Process CPU: %.2f ms/s total, %.2f ms/s per 1000 connections (includes other engine threads)"),
+            CPUMsPerSecond, CPUMsPerSecondPer1000);
+        PJLINK_LOG_INFO(TEXT("Thread-per-connection design would have used %d receiver threads"), Connections.Num());
+    }
+
+    // 정리
+    for (const TSharedPtr<FPJLinkConnection, ESPMode::ThreadSafe>& Connection : Connections)
+    {
+        if (Connection.IsValid())
+        {
+            Connection->Close();
+        }
+    }
+    for (FNativeSocket Server : ServerSockets)
+    {
+        Close(Server);
+    }
+    Close(Listener);
+
+    return bSuccess;
+}
+
+bool UPJLinkTests::TestSendLatencyWhileReadPending(int32 Iterations)
+{
+    using namespace PJLinkTestUtils;
+
+    Iterations = FMath::Clamp(Iterations, 1, 100000);
+    PJLINK_LOG_INFO(TEXT("Starting send latency test (%d commands, read pending)"), Iterations);
+
+    // 응답하지 않는 에뮬레이터 - 클라이언트 소켓은 항상 수신 대기 상태
+    FPJLinkTestProjector Emulator(false);
+    if (!Emulator.Start())
+    {
+        PJLINK_LOG_ERROR(TEXT("Failed to start projector emulator"));
+        return false;
+    }
+
+    UPJLinkNetworkManager* NetworkManager = NewObject<UPJLinkNetworkManager>();
+    NetworkManager->bAutoReconnect = false;
+    if (!NetworkManager->ConnectToProjector(Emulator.MakeProjectorInfo(), 2.0f))
+    {
+        PJLINK_LOG_ERROR(TEXT("Failed to connect to projector emulator"));
+        return false;
+    }
+
+    TArray<double> LatenciesUs;
+    LatenciesUs.Reserve(Iterations);
+
+    bool bAllSent = true;
+    for (int32 Index = 0; Index < Iterations; ++Index)
+    {
+        const double Start = FPlatformTime::Seconds();
+        bAllSent &= NetworkManager->SendCommand(EPJLinkCommand::POWR, TEXT("?"));
+        LatenciesUs.Add((FPlatformTime::Seconds() - Start) * 1000000.0);
+    }
+
+    // 에뮬레이터가 모든 명령을 받았는지 확인 (연결 시 RequestStatus 6개 포함)
+    const int32 ExpectedCommands = Iterations + 6;
+    const double WaitStart = FPlatformTime::Seconds();
+    while (Emulator.GetReceivedCommandCount() < ExpectedCommands && FPlatformTime::Seconds() - WaitStart < 5.0)
+    {
+        FPlatformProcess::Sleep(0.01f);
+    }
+    const int32 Delivered = Emulator.GetReceivedCommandCount();
+
+    NetworkManager->DisconnectFromProjector();
+    Emulator.StopEmulator();
+
+    LatenciesUs.Sort();
+    double Total = 0.0;
+    for (double Latency : LatenciesUs)
+    {
+        Total += Latency;
+    }
+    const double AverageUs = Total / LatenciesUs.Num();
+    const double P99Us = LatenciesUs[FMath::Min(LatenciesUs.Num() - 1, FMath::FloorToInt(LatenciesUs.Num() * 0.99))];
+    const double MaxUs = LatenciesUs.Last();
+
+    PJLINK_LOG_INFO(TEXT("SendCommand latency: avg %.1f us, p99 %.1f us, max %.1f us (%d/%d delivered)"),
+        AverageUs, P99Us, MaxUs, Delivered, ExpectedCommands);
+
+    // 수신 대기 중에도 송신이 마이크로초 단위로 반환되어야 함 (p99 1ms 미만)
+    const bool bFastEnough = P99Us < 1000.0;
+    if (!bFastEnough)
+    {
+        PJLINK_LOG_ERROR(TEXT("SendCommand blocked while a read was pending (p99 %.1f us)"), P99Us);
+    }
+
+    return bAllSent && bFastEnough && Delivered >= ExpectedCommands;
+}
+
+bool UPJLinkTests::TestFrameAssembler()
+{
+    PJLINK_LOG_INFO(TEXT("Starting frame assembler test"));
+
+    // 길이가 제각각인 응답 프레임 생성
+    TArray<FString> Expected;
+    TArray<uint8> Stream;
+    FRandomStream Random(4352);
+    for (int32 Index = 0; Index < 5000; ++Index)
+    {
+        FString Frame = FString::Printf(TEXT("%%1POWR=%d"), Index);
+        Frame.Append(FString::ChrN(Random.RandRange(0, 200), TEXT('A') + (Index % 26)));
+        Expected.Add(Frame);
+
+        FTCHARToUTF8 Utf8(*Frame);
+        Stream.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+        Stream.Add('\r');
+    }
+
+    // 임의 크기 조각으로 나눠 입력 (한 조각에 여러 프레임, 여러 조각에 걸친 프레임 모두 포함)
+    FPJLinkFrameAssembler Assembler;
+    TArray<FString> Received;
+    int32 Offset = 0;
+    while (Offset < Stream.Num())
+    {
+        const int32 ChunkSize = FMath::Min(Random.RandRange(1, 3000), Stream.Num() - Offset);
+        Assembler.Feed(Stream.GetData() + Offset, ChunkSize, [&Received](const uint8* Frame, int32 Length)
+        {
+            FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Frame), Length);
+            Received.Emplace(Converted.Length(), Converted.Get());
+        });
+        Offset += ChunkSize;
+    }
+
+    bool bSuccess = Received == Expected && Assembler.GetPendingBytes() == 0;
+    if (!bSuccess)
+    {
+        PJLINK_LOG_ERROR(TEXT("Frame mismatch: expected %d frames, received %d"), Expected.Num(), Received.Num());
+    }
+
+    // 종료 문자 없이 너무 긴 줄은 버리고 다음 프레임부터 정상 처리
+    TArray<uint8> Garbage;
+    Garbage.Init('x', FPJLinkFrameAssembler::Capacity + 100);
+    Garbage.Append(reinterpret_cast<const uint8*>("\r%1INPT=31\r"), 11);
+
+    Received.Reset();
+    Assembler.Feed(Garbage.GetData(), Garbage.Num(), [&Received](const uint8* Frame, int32 Length)
+    {
+        FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Frame), Length);
+        Received.Emplace(Converted.Length(), Converted.Get());
+    });
+
+    const bool bDiscardOk = Received.Num() == 1 && Received[0] == TEXT("%1INPT=31") && Assembler.GetNumDiscardedFrames() == 1;
+    if (!bDiscardOk)
+    {
+        PJLINK_LOG_ERROR(TEXT("Over-long frame was not discarded correctly"));
+    }
+    bSuccess &= bDiscardOk;
+
+    PJLINK_LOG_INFO(TEXT("Frame assembler test %s (%d frames)"), bSuccess ? TEXT("passed") : TEXT("failed"), Expected.Num());
+    return bSuccess;
+}
+
+bool UPJLinkTests::BenchmarkResponseParser(int32 Iterations)
+{
+    using namespace PJLinkTestUtils;
+
+    Iterations = FMath::Clamp(Iterations, 1, 10000000);
+    PJLINK_LOG_INFO(TEXT("Starting response parser benchmark (%d iterations)"), Iterations);
+
+    // 상태 갱신 시 실제로 받는 응답 구성
+    static const ANSICHAR* const SampleFrames[] =
+    {
+        "%1POWR=1",
+        "%1INPT=31",
+        "%1NAME=Conference Room A",
+        "%1INF1=EPSON",
+        "%1INF2=EB-L1755U",
+        "%1CLSS=2",
+        "%1AVMT=30",
+        "%1POWR=ERR3",
+    };
+    static constexpr int32 NumSamples = UE_ARRAY_COUNT(SampleFrames);
+
+    TArray<FString> SampleStrings;
+    int32 SampleLengths[NumSamples];
+    for (int32 Index = 0; Index < NumSamples; ++Index)
+    {
+        SampleStrings.Add(UTF8_TO_TCHAR(SampleFrames[Index]));
+        SampleLengths[Index] = FCStringAnsi::Strlen(SampleFrames[Index]);
+    }
+
+    // 두 파서의 결과가 같은지 먼저 확인
+    bool bResultsMatch = true;
+    for (int32 Index = 0; Index < NumSamples; ++Index)
+    {
+        EPJLinkCommand LegacyCommand = EPJLinkCommand::POWR;
+        FString LegacyParameter;
+        EPJLinkResponseStatus LegacyStatus = EPJLinkResponseStatus::Unknown;
+        LegacyParseResponse(SampleStrings[Index], LegacyCommand, LegacyParameter, LegacyStatus);
+
+        FPJLinkParsedFrame Parsed;
+        const uint8* Frame = reinterpret_cast<const uint8*>(SampleFrames[Index]);
+        PJLinkResponseParser::ParseFrame(Frame, SampleLengths[Index], Parsed);
+
+        if (Parsed.Command != LegacyCommand || Parsed.Status != LegacyStatus
+            || (Parsed.Status == EPJLinkResponseStatus::Success && PJLinkResponseParser::ParameterToString(Frame, Parsed) != LegacyParameter))
+        {
+            PJLINK_LOG_ERROR(TEXT("Parser mismatch for %s"), *SampleStrings[Index]);
+            bResultsMatch = false;
+        }
+    }
+
+    // 이 스레드의 할당만 세도록 프록시 설치
+    FMalloc* OriginalMalloc = GMalloc;
+    FPJLinkCountingMalloc CountingMalloc(OriginalMalloc);
+    GMalloc = &CountingMalloc;
+    FPJLinkCountingMalloc::SetCountingThread(true);
+
+    // 기존 FString 파서
+    FPJLinkCountingMalloc::ResetAllocationCount();
+    double Start = FPlatformTime::Seconds();
+    int32 LegacyChecksum = 0;
+    for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+    {
+        EPJLinkCommand Command = EPJLinkCommand::POWR;
+        FString Parameter;
+        EPJLinkResponseStatus Status = EPJLinkResponseStatus::Unknown;
+        LegacyParseResponse(SampleStrings[Iteration % NumSamples], Command, Parameter, Status);
+        LegacyChecksum += static_cast<int32>(Command) + static_cast<int32>(Status);
+    }
+    const double LegacySeconds = FPlatformTime::Seconds() - Start;
+    const uint64 LegacyAllocations = FPJLinkCountingMalloc::GetAllocationCount();
+
+    // 바이트 파서
+    FPJLinkCountingMalloc::ResetAllocationCount();
+    Start = FPlatformTime::Seconds();
+    int32 ByteChecksum = 0;
+    for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+    {
+        const int32 Index = Iteration % NumSamples;
+        FPJLinkParsedFrame Parsed;
+        PJLinkResponseParser::ParseFrame(reinterpret_cast<const uint8*>(SampleFrames[Index]), SampleLengths[Index], Parsed);
+        ByteChecksum += static_cast<int32>(Parsed.Command) + static_cast<int32>(Parsed.Status);
+    }
+    const double ByteSeconds = FPlatformTime::Seconds() - Start;
+    const uint64 ByteAllocations = FPJLinkCountingMalloc::GetAllocationCount();
+
+    FPJLinkCountingMalloc::SetCountingThread(false);
+    GMalloc = OriginalMalloc;
+
+    const double LegacyNs = LegacySeconds * 1.0e9 / Iterations;
+    const double ByteNs = ByteSeconds * 1.0e9 / Iterations;
+    PJLINK_LOG_INFO(TEXT("Legacy ParseResponse: %.1f ns/frame, %.2f allocations/frame"),
+        LegacyNs, static_cast<double>(LegacyAllocations) / Iterations);
+    PJLINK_LOG_INFO(TEXT("Byte parser: %.1f ns/frame, %llu allocations total (%.1fx faster)"),
+        ByteNs, ByteAllocations, ByteNs > 0.0 ? LegacyNs / ByteNs : 0.0);
+
+    const bool bSuccess = bResultsMatch && ByteAllocations == 0 && LegacyChecksum == ByteChecksum;
+    if (ByteAllocations != 0)
+    {
+        PJLINK_LOG_ERROR(TEXT("Byte parser allocated %llu times"), ByteAllocations);
+    }
+
+    return bSuccess;
+}
+
+bool UPJLinkTests::TestPipelinedCommandCorrelation(int32 NumCommands)
+{
+    using namespace PJLinkTestUtils;
+
+    NumCommands = FMath::Clamp(NumCommands, 6, UPJLinkNetworkManager::MaxInFlightCommands);
+    PJLINK_LOG_INFO(TEXT("Starting pipelined command correlation test (%d commands)"), NumCommands);
+
+    // INF2 에는 응답하지 않는 에뮬레이터 - 뒤따르는 응답이 도착하면 INF2 는 응답 누락으로 처리되어야 함
+    FPJLinkTestProjector Emulator(true);
+    Emulator.SetSilentCommand(TEXT("INF2"));
+    if (!Emulator.Start())
+    {
+        PJLINK_LOG_ERROR(TEXT("Failed to start projector emulator"));
+        return false;
+    }
+
+    UPJLinkNetworkManager* NetworkManager = NewObject<UPJLinkNetworkManager>();
+    NetworkManager->bAutoReconnect = false;
+    if (!NetworkManager->ConnectToProjector(Emulator.MakeProjectorInfo(), 2.0f))
+    {
+        PJLINK_LOG_ERROR(TEXT("Failed to connect to projector emulator"));
+        return false;
+    }
+
+    auto WaitForInFlight = [NetworkManager](int32 Remaining, double TimeoutSeconds)
+    {
+        const double WaitStart = FPlatformTime::Seconds();
+        while (NetworkManager->GetInFlightCommandCount() > Remaining && FPlatformTime::Seconds() - WaitStart < TimeoutSeconds)
+        {
+            FPlatformProcess::SleepNoStats(0.0f);
+        }
+        return NetworkManager->GetInFlightCommandCount() <= Remaining;
+    };
+
+    // 연결 직후 상태 요청이 끝날 때까지 대기 (응답 없는 INF2 1개는 남을 수 있음)
+    WaitForInFlight(1, 2.0);
+    NetworkManager->EventQueue.Discard();
+    const int32 BaselineInFlight = NetworkManager->GetInFlightCommandCount();
+
+    // 여러 명령을 응답을 기다리지 않고 연달아 전송
+    static const EPJLinkCommand Pattern[] =
+    {
+        EPJLinkCommand::POWR, EPJLinkCommand::INPT, EPJLinkCommand::NAME,
+        EPJLinkCommand::INF1, EPJLinkCommand::INF2, EPJLinkCommand::CLSS,
+    };
+
+    TArray<TPair<int32, EPJLinkCommand>> Sent;
+    const double Start = FPlatformTime::Seconds();
+    for (int32 Index = 0; Index < NumCommands; ++Index)
+    {
+        const EPJLinkCommand Command = Pattern[Index % UE_ARRAY_COUNT(Pattern)];
+        const int32 SequenceId = NetworkManager->SendCommandWithSequence(Command, TEXT("?"), 0.0f);
+        if (SequenceId == 0)
+        {
+            PJLINK_LOG_ERROR(TEXT("SendCommandWithSequence failed at %d"), Index);
+            return false;
+        }
+        Sent.Emplace(SequenceId, Command);
+    }
+
+    // 마지막 명령(INF2 가 아님)까지 응답을 받으면 FIFO 가 비어야 함
+    const bool bDrained = WaitForInFlight(Sent.Last().Value == EPJLinkCommand::INF2 ? 1 : 0, 5.0);
+    const double ElapsedMs = (FPlatformTime::Seconds() - Start) * 1000.0;
+
+    NetworkManager->DisconnectFromProjector();
+    Emulator.StopEmulator();
+
+    // 응답 큐 확인 - 모든 순번이 전송 순서대로 정확히 한 번씩, 올바른 명령/상태로 도착해야 함
+    TMap<int32, EPJLinkResponseStatus> Results;
+    int32 LastSequenceId = 0;
+    bool bOrdered = true;
+    NetworkManager->EventQueue.Drain([&](const FPJLinkEvent& Event)
+    {
+        if (Event.Type != EPJLinkEventType::Response || Event.SequenceId == 0)
+        {
+            return;
+        }
+
+        bOrdered &= Event.SequenceId > LastSequenceId;
+        LastSequenceId = Event.SequenceId;
+        Results.Add(Event.SequenceId, Event.Status);
+
+        const TPair<int32, EPJLinkCommand>* Request = Sent.FindByPredicate([&Event](const TPair<int32, EPJLinkCommand>& Entry)
+        {
+            return Entry.Key == Event.SequenceId;
+        });
+        if (Request && Request->Value != Event.Command)
+        {
+            PJLINK_LOG_ERROR(TEXT("Response #%d matched to wrong command"), Event.SequenceId);
+            bOrdered = false;
+        }
+    });
+
+    int32 Answered = 0;
+    int32 MissingReported = 0;
+    bool bCorrelated = true;
+    for (int32 Index = 0; Index < Sent.Num(); ++Index)
+    {
+        const bool bIsLast = Index == Sent.Num() - 1;
+        const EPJLinkResponseStatus* Status = Results.Find(Sent[Index].Key);
+        if (Sent[Index].Value == EPJLinkCommand::INF2)
+        {
+            // 뒤에 다른 응답이 온 INF2 는 응답 누락으로 보고되어야 함
+            if (!bIsLast)
+            {
+                bCorrelated &= Status && *Status == EPJLinkResponseStatus::NoResponse;
+                MissingReported += Status ? 1 : 0;
+            }
+        }
+        else
+        {
+            bCorrelated &= Status && *Status == EPJLinkResponseStatus::Success;
+            Answered += Status ? 1 : 0;
+        }
+    }
+
+    PJLINK_LOG_INFO(TEXT("Pipelined %d commands in %.2f ms: %d answered, %d reported missing (baseline in flight %d)"),
+        NumCommands, ElapsedMs, Answered, MissingReported, BaselineInFlight);
+
+    const bool bSuccess = bDrained && bOrdered && bCorrelated;
+    if (!bSuccess)
+    {
+        PJLINK_LOG_ERROR(TEXT("Pipelined correlation failed (drained %d, ordered %d, correlated %d)"), bDrained, bOrdered, bCorrelated);
+    }
+    return bSuccess;
+}
+
+bool UPJLinkTests::TestBatchedStatusRefresh(int32 Rounds)
+{
+    using namespace PJLinkTestUtils;
+
+    Rounds = FMath::Clamp(Rounds, 1, 1000);
+    PJLINK_LOG_INFO(TEXT("Starting batched status refresh test (%d rounds)"), Rounds);
+
+    FPJLinkTestProjector Emulator(true);
+    if (!Emulator.Start())
+    {
+        PJLINK_LOG_ERROR(TEXT("Failed to start projector emulator"));
+        return false;
+    }
+
+    UPJLinkNetworkManager* NetworkManager = NewObject<UPJLinkNetworkManager>();
+    NetworkManager->bAutoReconnect = false;
+    if (!NetworkManager->ConnectToProjector(Emulator.MakeProjectorInfo(), 2.0f))
+    {
+        PJLINK_LOG_ERROR(TEXT("Failed to connect to projector emulator"));
+        return false;
+    }
+
+    // 상태 조회 한 번(명령 6개)이 에뮬레이터에 도착하고 응답까지 끝날 때까지 대기
+    auto WaitForRefresh = [&Emulator, NetworkManager](int32 ExpectedCommands)
+    {
+        const double WaitStart = FPlatformTime::Seconds();
+        while ((Emulator.GetReceivedCommandCount() < ExpectedCommands || NetworkManager->GetInFlightCommandCount() > 0)
+            && FPlatformTime::Seconds() - WaitStart < 2.0)
+        {
+            FPlatformProcess::SleepNoStats(0.0f);
+        }
+        return Emulator.GetReceivedCommandCount() >= ExpectedCommands && NetworkManager->GetInFlightCommandCount() == 0;
+    };
+
+    // 연결 직후 자동 상태 요청
+    bool bSuccess = WaitForRefresh(6);
+
+    // 명령마다 따로 보내는 방식 (비교용)
+    static const EPJLinkCommand StatusCommands[] =
+    {
+        EPJLinkCommand::POWR, EPJLinkCommand::INPT, EPJLinkCommand::NAME,
+        EPJLinkCommand::INF1, EPJLinkCommand::INF2, EPJLinkCommand::CLSS,
+    };
+
+    int32 ExpectedCommands = Emulator.GetReceivedCommandCount();
+    int32 ReadsBefore = Emulator.GetReceivedReadCount();
+    for (int32 Round = 0; Round < Rounds; ++Round)
+    {
+        for (EPJLinkCommand Command : StatusCommands)
+        {
+            bSuccess &= NetworkManager->SendCommand(Command, TEXT("?"));
+        }
+        ExpectedCommands += UE_ARRAY_COUNT(StatusCommands);
+        bSuccess &= WaitForRefresh(ExpectedCommands);
+    }
+    const int32 SeparateReads = Emulator.GetReceivedReadCount() - ReadsBefore;
+
+    // 일괄 전송 (RequestStatus)
+    ReadsBefore = Emulator.GetReceivedReadCount();
+    for (int32 Round = 0; Round < Rounds; ++Round)
+    {
+        bSuccess &= NetworkManager->RequestStatus();
+        ExpectedCommands += UE_ARRAY_COUNT(StatusCommands);
+        bSuccess &= WaitForRefresh(ExpectedCommands);
+    }
+    const int32 BatchedReads = Emulator.GetReceivedReadCount() - ReadsBefore;
+
+    NetworkManager->DisconnectFromProjector();
+    Emulator.StopEmulator();
+
+    PJLINK_LOG_INFO(TEXT("Status refresh segments per round: separate %.2f, batched %.2f"),
+        static_cast<double>(SeparateReads) / Rounds, static_cast<double>(BatchedReads) / Rounds);
+
+    // 일괄 전송은 상태 조회 한 번에 세그먼트 하나여야 함
+    if (BatchedReads > Rounds)
+    {
+        PJLINK_LOG_ERROR(TEXT("Batched refresh used %d segments for %d rounds"), BatchedReads, Rounds);
+        bSuccess = false;
+    }
+
+    return bSuccess;
+}
+
+bool UPJLinkTests::TestTimingWheel(int32 NumTimers)
+{
+    using namespace PJLinkTestUtils;
+
+    NumTimers = FMath::Clamp(NumTimers, 100, 1000000);
+    PJLINK_LOG_INFO(TEXT("Starting timing wheel test (%d timers)"), NumTimers);
+
+    bool bSuccess = true;
+
+    // 1. 가상 시간 - 최대 5분 범위의 마감을 예약하고 10%는 취소
+    {
+        const double TickSeconds = 0.01;
+        FPJLinkTimingWheel Wheel(TickSeconds, 0.0);
+        FRandomStream Random(4352);
+
+        TArray<double> Deadlines;
+        TArray<double> FiredAt;
+        Deadlines.SetNumUninitialized(NumTimers);
+        FiredAt.Init(-1.0, NumTimers);
+
+        double SimNow = 0.0;
+        const double ScheduleStart = FPlatformTime::Seconds();
+        for (int32 Index = 0; Index < NumTimers; ++Index)
+        {
+            Deadlines[Index] = Random.FRandRange(0.0f, 300.0f);
+            Wheel.Schedule(static_cast<FPJLinkTimerId>(Index + 1), Deadlines[Index], [&FiredAt, &SimNow, Index]()
+            {
+                FiredAt[Index] = SimNow;
+            });
+        }
+        const double ScheduleSeconds = FPlatformTime::Seconds() - ScheduleStart;
+
+        int32 NumCancelled = 0;
+        const double CancelStart = FPlatformTime::Seconds();
+        for (int32 Index = 0; Index < NumTimers; Index += 10)
+        {
+            NumCancelled += Wheel.Cancel(static_cast<FPJLinkTimerId>(Index + 1)) ? 1 : 0;
+        }
+        const double CancelSeconds = FPlatformTime::Seconds() - CancelStart;
+
+        // 불규칙한 간격으로 진행 (poll 대기 시간이 매번 다른 상황)
+        const double MaxStepSeconds = 0.05;
+        int32 NumFired = 0;
+        const double AdvanceStart = FPlatformTime::Seconds();
+        while (Wheel.Num() > 0 && SimNow < 400.0)
+        {
+            SimNow += Random.FRandRange(0.0f, static_cast<float>(MaxStepSeconds));
+            NumFired += Wheel.Advance(SimNow);
+        }
+        const double AdvanceSeconds = FPlatformTime::Seconds() - AdvanceStart;
+
+        int32 NumEarly = 0;
+        int32 NumLate = 0;
+        int32 NumWrong = 0;
+        double MaxLatenessSeconds = 0.0;
+        for (int32 Index = 0; Index < NumTimers; ++Index)
+        {
+            const bool bCancelled = (Index % 10) == 0;
+            if (bCancelled)
+            {
+                NumWrong += FiredAt[Index] >= 0.0 ? 1 : 0;
+                continue;
+            }
+
+            if (FiredAt[Index] < 0.0)
+            {
+                ++NumWrong;
+                continue;
+            }
+
+            const double Lateness = FiredAt[Index] - Deadlines[Index];
+            MaxLatenessSeconds = FMath::Max(MaxLatenessSeconds, Lateness);
+            NumEarly += Lateness < -1e-9 ? 1 : 0;
+
+            // 늦어도 진행 간격 하나 + 틱 하나 이내
+            NumLate += Lateness > MaxStepSeconds + TickSeconds + 1e-9 ? 1 : 0;
+        }
+
+        PJLINK_LOG_INFO(TEXT("Wheel: schedule %.1f ns/op, cancel %.1f ns/op, advance %.2f ms total, max lateness %.1f ms"),
+            ScheduleSeconds * 1e9 / NumTimers, CancelSeconds * 1e9 / FMath::Max(NumCancelled, 1),
+            AdvanceSeconds * 1000.0, MaxLatenessSeconds * 1000.0);
+
+        const int32 ExpectedFired = NumTimers - NumCancelled;
+        if (NumFired != ExpectedFired || NumEarly > 0 || NumLate > 0 || NumWrong > 0 || Wheel.Num() != 0)
+        {
+            PJLINK_LOG_ERROR(TEXT("Wheel check failed: fired %d/%d, early %d, late %d, wrong %d, remaining %d"),
+                NumFired, ExpectedFired, NumEarly, NumLate, NumWrong, Wheel.Num());
+            bSuccess = false;
+        }
+    }
+
+    // 2. 리액터 - 실제 I/O 스레드에서 만료
+    {
+        struct FReactorTimerState
+        {
+            TAtomic<int32> NumFired{ 0 };
+            TAtomic<int32> NumEarly{ 0 };
+            TAtomic<int32> NumOffThread{ 0 };
+        };
+        TSharedRef<FReactorTimerState, ESPMode::ThreadSafe> State = MakeShared<FReactorTimerState, ESPMode::ThreadSafe>();
+
+        FPJLinkIOReactor& Reactor = FPJLinkIOReactor::Get();
+        const int32 PendingBefore = Reactor.GetNumPendingTimers();
+
+        TArray<FPJLinkTimerId> TimerIds;
+        TimerIds.Reserve(NumTimers);
+
+        const double ScheduleStart = FPlatformTime::Seconds();
+        for (int32 Index = 0; Index < NumTimers; ++Index)
+        {
+            const double Delay = 0.05 + 0.45 * (static_cast<double>(Index) / NumTimers);
+            const double Deadline = ScheduleStart + Delay;
+            TimerIds.Add(Reactor.ScheduleTimer(Delay, [State, Deadline]()
+            {
+                if (FPlatformTime::Seconds() < Deadline)
+                {
+                    ++State->NumEarly;
+                }
+                if (!FPJLinkIOReactor::IsInIOThread())
+                {
+                    ++State->NumOffThread;
+                }
+                ++State->NumFired;
+            }));
+        }
+        const double ScheduleSeconds = FPlatformTime::Seconds() - ScheduleStart;
+
+        int32 NumCancelled = 0;
+        for (int32 Index = 0; Index < NumTimers; Index += 10)
+        {
+            Reactor.CancelTimer(TimerIds[Index]);
+            ++NumCancelled;
+        }
+
+        const int32 ExpectedFired = NumTimers - NumCancelled;
+        const double WaitStart = FPlatformTime::Seconds();
+        while (State->NumFired.Load() < ExpectedFired && FPlatformTime::Seconds() - WaitStart < 5.0)
+        {
+            FPlatformProcess::Sleep(0.01f);
+        }
+        const double CompletionSeconds = FPlatformTime::Seconds() - ScheduleStart;
+
+        // 취소된 타이머가 뒤늦게 호출되지 않는지 잠시 더 확인
+        FPlatformProcess::Sleep(0.1f);
+        const int32 PendingAfter = Reactor.GetNumPendingTimers();
+
+        PJLINK_LOG_INFO(TEXT("Reactor: scheduled %d in %.2f ms, fired %d/%d, all done after %.3f s, pending %d"),
+            NumTimers, ScheduleSeconds * 1000.0, State->NumFired.Load(), ExpectedFired, CompletionSeconds, PendingAfter);
+
+        if (State->NumFired.Load() != ExpectedFired || State->NumEarly.Load() > 0 || State->NumOffThread.Load() > 0
+            || PendingAfter > PendingBefore)
+        {
+            PJLINK_LOG_ERROR(TEXT("Reactor timer check failed: fired %d/%d, early %d, off thread %d, pending %d"),
+                State->NumFired.Load(), ExpectedFired, State->NumEarly.Load(), State->NumOffThread.Load(), PendingAfter);
+            bSuccess = false;
+        }
+    }
+
+    // 3. 월드 없는 매니저의 명령 타임아웃 - 응답하지 않는 명령이 타임아웃으로 보고되어야 함
+    {
+        FPJLinkTestProjector Emulator(true);
+        Emulator.SetSilentCommand(TEXT("LAMP"));
+        if (!Emulator.Start())
+        {
+            PJLINK_LOG_ERROR(TEXT("Failed to start projector emulator"));
+            return false;
+        }
+
+        UPJLinkNetworkManager* NetworkManager = NewObject<UPJLinkNetworkManager>();
+        NetworkManager->bAutoReconnect = false;
+        if (!NetworkManager->ConnectToProjector(Emulator.MakeProjectorInfo(), 2.0f))
+        {
+            PJLINK_LOG_ERROR(TEXT("Failed to connect to projector emulator"));
+            return false;
+        }
+
+        const int32 SequenceId = NetworkManager->SendCommandWithSequence(EPJLinkCommand::LAMP, TEXT("?"), 0.2f);
+
+        bool bTimedOut = false;
+        const double WaitStart = FPlatformTime::Seconds();
+        while (!bTimedOut && FPlatformTime::Seconds() - WaitStart < 2.0)
+        {
+            FPlatformProcess::Sleep(0.01f);
+
+            FScopeLock Lock(&NetworkManager->InFlightLock);
+            bTimedOut = NetworkManager->InFlightCommands.ContainsByPredicate([SequenceId](const FPJLinkCommandInfo& Info)
+            {
+                return Info.SequenceId == SequenceId && Info.bTimedOut;
+            });
+        }
+
+        NetworkManager->DisconnectFromProjector();
+        Emulator.StopEmulator();
+
+        bool bReported = false;
+        NetworkManager->EventQueue.Drain([&bReported, SequenceId](const FPJLinkEvent& Event)
+        {
+            bReported |= Event.SequenceId == SequenceId && Event.Status == EPJLinkResponseStatus::NoResponse;
+        });
+
+        if (SequenceId == 0 || !bTimedOut || !bReported)
+        {
+            PJLINK_LOG_ERROR(TEXT("Command timeout without world failed (sent #%d, timed out %d, reported %d)"),
+                SequenceId, bTimedOut, bReported);
+            bSuccess = false;
+        }
+    }
+
+    return bSuccess;
+}
+
+bool UPJLinkTests::BenchmarkEventDrain(int32 NumEvents)
+{
+    using namespace PJLinkTestUtils;
+
+    NumEvents = FMath::Clamp(NumEvents, 3, 1000000);
+    PJLINK_LOG_INFO(TEXT("Starting event drain benchmark (%d events)"), NumEvents);
+
+    // 응답 / 통신 로그 / 오류를 같은 비율로 섞음
+    const FString CommandName = TEXT("POWR");
+    const FString RawFrame = TEXT("%1POWR=1\r");
+    const FString Parameter = TEXT("1");
+    const FString ErrorMessage = TEXT("Command timeout: POWR #42 after 5.0 seconds");
+
+    // 이전 방식 - 생산자가 문자열로 인코딩하고 소비자가 ParseIntoArray 로 해석
+    TQueue<FLegacyResponseQueueItem, EQueueMode::Mpsc> LegacyQueue;
+    double Start = FPlatformTime::Seconds();
+    for (int32 Index = 0; Index < NumEvents; ++Index)
+    {
+        FLegacyResponseQueueItem Item;
+        switch (Index % 3)
+        {
+        case 0:
+            Item.Status = EPJLinkResponseStatus::Success;
+            Item.ResponseText = Parameter;
+            break;
+        case 1:
+            Item.Status = EPJLinkResponseStatus::Success;
+            Item.ResponseText = FString::Printf(TEXT("COMMUNICATION_LOG|%d|%s|%s"), 0, *CommandName, *RawFrame);
+            break;
+        default:
+            Item.Status = EPJLinkResponseStatus::ProjectorFailure;
+            Item.ResponseText = FString::Printf(TEXT("ERROR|%d|%s"), static_cast<int32>(EPJLinkErrorCode::Timeout), *ErrorMessage);
+            break;
+        }
+        LegacyQueue.Enqueue(MoveTemp(Item));
+    }
+    const double LegacyProduceSeconds = FPlatformTime::Seconds() - Start;
+
+    // 이벤트 큐 - 풀을 채우기 위해 한 번 돌린 뒤 측정
+    FPJLinkEventQueue EventQueue;
+    auto ProduceEvents = [&]()
+    {
+        for (int32 Index = 0; Index < NumEvents; ++Index)
+        {
+            EventQueue.Enqueue([&, Index](FPJLinkEvent& Event)
+            {
+                switch (Index % 3)
+                {
+                case 0:
+                    Event.Type = EPJLinkEventType::Response;
+                    Event.Status = EPJLinkResponseStatus::Success;
+                    Event.Text.Append(Parameter);
+                    break;
+                case 1:
+                    Event.Type = EPJLinkEventType::CommunicationLog;
+                    Event.bIsSending = false;
+                    Event.Label.Append(CommandName);
+                    Event.Text.Append(RawFrame);
+                    break;
+                default:
+                    Event.Type = EPJLinkEventType::Error;
+                    Event.Status = EPJLinkResponseStatus::ProjectorFailure;
+                    Event.ErrorCode = EPJLinkErrorCode::Timeout;
+                    Event.Text.Append(ErrorMessage);
+                    break;
+                }
+            });
+        }
+    };
+
+    auto DecodeEvent = [](const FPJLinkEvent& Event)
+    {
+        switch (Event.Type)
+        {
+        case EPJLinkEventType::CommunicationLog:
+            return (Event.bIsSending ? 1 : 0) + Event.Label.Len() + Event.Text.Len();
+        case EPJLinkEventType::Error:
+            return static_cast<int32>(Event.ErrorCode) + Event.Text.Len();
+        default:
+            return static_cast<int32>(Event.Status) + Event.Text.Len();
+        }
+    };
+
+    ProduceEvents();
+    EventQueue.Discard();
+
+    Start = FPlatformTime::Seconds();
+    ProduceEvents();
+    const double EventProduceSeconds = FPlatformTime::Seconds() - Start;
+
+    // 소비(게임 스레드) 구간만 할당 횟수 측정
+    FMalloc* OriginalMalloc = GMalloc;
+    FPJLinkCountingMalloc CountingMalloc(OriginalMalloc);
+    GMalloc = &CountingMalloc;
+    FPJLinkCountingMalloc::SetCountingThread(true);
+
+    FPJLinkCountingMalloc::ResetAllocationCount();
+    Start = FPlatformTime::Seconds();
+    int32 LegacyChecksum = 0;
+    int32 LegacyDrained = 0;
+    {
+        FLegacyResponseQueueItem Item;
+        while (LegacyQueue.Dequeue(Item))
+        {
+            LegacyChecksum += LegacyDecodeItem(Item);
+            ++LegacyDrained;
+        }
+    }
+    const double LegacyDrainSeconds = FPlatformTime::Seconds() - Start;
+    const uint64 LegacyAllocations = FPJLinkCountingMalloc::GetAllocationCount();
+
+    FPJLinkCountingMalloc::ResetAllocationCount();
+    Start = FPlatformTime::Seconds();
+    int32 EventChecksum = 0;
+    const int32 EventsDrained = EventQueue.Drain([&EventChecksum, &DecodeEvent](const FPJLinkEvent& Event)
+    {
+        EventChecksum += DecodeEvent(Event);
+    });
+    const double EventDrainSeconds = FPlatformTime::Seconds() - Start;
+    const uint64 EventAllocations = FPJLinkCountingMalloc::GetAllocationCount();
+
+    FPJLinkCountingMalloc::SetCountingThread(false);
+    GMalloc = OriginalMalloc;
+
+    PJLINK_LOG_INFO(TEXT("String queue: produce %.2f ms, drain %.2f ms (%.1f ns/event), %llu drain allocations"),
+        LegacyProduceSeconds * 1000.0, LegacyDrainSeconds * 1000.0, LegacyDrainSeconds * 1.0e9 / NumEvents, LegacyAllocations);
+    PJLINK_LOG_INFO(TEXT("Typed event queue: produce %.2f ms, drain %.2f ms (%.1f ns/event), %llu drain allocations (%.1fx faster drain)"),
+        EventProduceSeconds * 1000.0, EventDrainSeconds * 1000.0, EventDrainSeconds * 1.0e9 / NumEvents, EventAllocations,
+        EventDrainSeconds > 0.0 ? LegacyDrainSeconds / EventDrainSeconds : 0.0);
+
+    const bool bSuccess = LegacyDrained == NumEvents && EventsDrained == NumEvents
+        && LegacyChecksum == EventChecksum && EventAllocations == 0;
+    if (!bSuccess)
+    {
+        PJLINK_LOG_ERROR(TEXT("Event drain benchmark failed (drained %d/%d, checksum %d/%d, allocations %llu)"),
+            EventsDrained, LegacyDrained, EventChecksum, LegacyChecksum, EventAllocations);
+    }
+    return bSuccess;
+}
+
+bool UPJLinkTests::TestEventDrainBudget(int32 NumEvents, float BudgetMicroseconds)
+{
+    NumEvents = FMath::Clamp(NumEvents, 100, 10000000);
+    BudgetMicroseconds = FMath::Clamp(BudgetMicroseconds, 10.0f, 100000.0f);
+    PJLINK_LOG_INFO(TEXT("Starting event drain budget test (%d events, %.0f us budget)"), NumEvents, BudgetMicroseconds);
+
+    UPJLinkNetworkManager* NetworkManager = NewObject<UPJLinkNetworkManager>();
+    NetworkManager->bAutoReconnect = false;
+
+    // 여러 프로젝터의 상태 응답이 한꺼번에 도착한 상황
+    for (int32 Index = 0; Index < NumEvents; ++Index)
+    {
+        NetworkManager->EventQueue.Enqueue([Index](FPJLinkEvent& Event)
+        {
+            Event.Type = EPJLinkEventType::Response;
+            Event.Command = EPJLinkCommand::POWR;
+            Event.Status = EPJLinkResponseStatus::Success;
+            Event.SequenceId = Index + 1;
+            Event.Text.Append(TEXT("1"));
+        });
+    }
+
+    // 프레임마다 한 번씩 예산 안에서 처리
+    const double BudgetSeconds = BudgetMicroseconds * 1.0e-6;
+    TArray<double> DrainMicroseconds;
+    int32 Frames = 0;
+    while (!NetworkManager->EventQueue.IsEmpty() && Frames < NumEvents)
+    {
+        DrainMicroseconds.Add(NetworkManager->DrainEvents(BudgetSeconds) * 1.0e6);
+        ++Frames;
+    }
+
+    const FPJLinkEventQueueStats Stats = NetworkManager->GetEventQueueStats();
+    DrainMicroseconds.Sort();
+    const double MedianUs = DrainMicroseconds[DrainMicroseconds.Num() / 2];
+    const double P95Us = DrainMicroseconds[FMath::Min(DrainMicroseconds.Num() - 1, DrainMicroseconds.Num() * 95 / 100)];
+    const double MaxUs = DrainMicroseconds.Last();
+
+    // 이전 방식은 프레임당 10개
+    const int32 FixedBatchFrames = (NumEvents + 9) / 10;
+
+    PJLINK_LOG_INFO(TEXT("Budgeted drain: %d frames (fixed 10/frame would need %d), drain time median %.1f us, p95 %.1f us, max %.1f us"),
+        Frames, FixedBatchFrames, MedianUs, P95Us, MaxUs);
+    PJLINK_LOG_INFO(TEXT("Stats: dispatched %lld, peak depth %d, last batch %d, latency avg %.2f ms max %.2f ms"),
+        Stats.EventsDispatched, Stats.PeakQueueDepth, Stats.LastBatchSize, Stats.AverageDrainLatencyMs, Stats.MaxDrainLatencyMs);
+
+    // 한 프레임 처리 시간은 예산과 묶음 하나의 오차 이내여야 함 (스케줄링 잡음을 고려해 p95 로 판정)
+    bool bSuccess = Stats.EventsDispatched == NumEvents && Stats.QueueDepth == 0;
+    if (P95Us > BudgetMicroseconds * 1.5 + 20.0)
+    {
+        PJLINK_LOG_ERROR(TEXT("Drain exceeded budget: p95 %.1f us for %.0f us budget"), P95Us, BudgetMicroseconds);
+        bSuccess = false;
+    }
+
+    // 예산이 남으면 한 번에 다 처리해야 함 (이벤트가 적을 때 프레임을 낭비하지 않음)
+    for (int32 Index = 0; Index < 10; ++Index)
+    {
+        NetworkManager->EventQueue.Enqueue([](FPJLinkEvent& Event)
+        {
+            Event.Type = EPJLinkEventType::ConnectionChanged;
+        });
+    }
+    NetworkManager->DrainEvents(BudgetSeconds);
+    if (!NetworkManager->EventQueue.IsEmpty())
+    {
+        PJLINK_LOG_ERROR(TEXT("Small burst was not drained in a single frame"));
+        bSuccess = false;
+    }
+
+    NetworkManager->Shutdown();
+    return bSuccess;
+}
+
+void UPJLinkTests::HandleBenchmarkResponse(EPJLinkCommand Command, EPJLinkResponseStatus Status, const FString& Response)
+{
+    BenchmarkResponseCount += Response.Len();
+}
+
+bool UPJLinkTests::BenchmarkNativeDispatch(int32 NumEvents)
+{
+    NumEvents = FMath::Clamp(NumEvents, 1000, 10000000);
+    PJLINK_LOG_INFO(TEXT("Starting native dispatch benchmark (%d events)"), NumEvents);
+
+    UPJLinkNetworkManager* NetworkManager = NewObject<UPJLinkNetworkManager>();
+    NetworkManager->bAutoReconnect = false;
+
+    UPJLinkTests* Listener = NewObject<UPJLinkTests>();
+    NetworkManager->OnResponseReceived.AddDynamic(Listener, &UPJLinkTests::HandleBenchmarkResponse);
+
+    bool bSuccess = true;
+
+    // 수신 프레임 하나로 네이티브 이벤트가 바로 호출되는지 확인
+    {
+        int32 NativeResponses = 0;
+        bool bParameterMatched = false;
+        EPJLinkPowerStatus ReportedStatus = EPJLinkPowerStatus::Unknown;
+
+        FPJLinkNativeEvents& NativeEvents = NetworkManager->GetNativeEvents();
+        const FDelegateHandle ResponseHandle = NativeEvents.OnResponse.AddLambda(
+            [&](UPJLinkNetworkManager* Source, const FPJLinkNativeResponse& Response)
+            {
+                ++NativeResponses;
+                bParameterMatched = Source == NetworkManager && Response.Command == EPJLinkCommand::POWR
+                    && Response.Parameter.Equals("1") && Response.bFromProjector;
+            });
+        const FDelegateHandle PowerHandle = NativeEvents.OnPowerStatusChanged.AddLambda(
+            [&](UPJLinkNetworkManager* Source, EPJLinkPowerStatus OldStatus, EPJLinkPowerStatus NewStatus)
+            {
+                ReportedStatus = NewStatus;
+            });
+
+        const ANSICHAR Frame[] = "%1POWR=1";
+        NetworkManager->HandleResponseFrame(reinterpret_cast<const uint8*>(Frame), sizeof(Frame) - 1);
+
+        NativeEvents.OnResponse.Remove(ResponseHandle);
+        NativeEvents.OnPowerStatusChanged.Remove(PowerHandle);
+        NetworkManager->EventQueue.Discard();
+
+        if (NativeResponses != 1 || !bParameterMatched || ReportedStatus != EPJLinkPowerStatus::PoweredOn)
+        {
+            PJLINK_LOG_ERROR(TEXT("Native events not delivered from response frame (responses %d, parameter %s, power %s)"),
+                NativeResponses, bParameterMatched ? TEXT("ok") : TEXT("mismatch"),
+                *PJLinkHelpers::PowerStatusToString(ReportedStatus));
+            bSuccess = false;
+        }
+    }
+
+    const FString Parameter = TEXT("1");
+
+    // 1. 동적 대리자 직접 호출 (리플렉션 비용만)
+    Listener->BenchmarkResponseCount = 0;
+    double Start = FPlatformTime::Seconds();
+    for (int32 Index = 0; Index < NumEvents; ++Index)
+    {
+        NetworkManager->OnResponseReceived.Broadcast(EPJLinkCommand::POWR, EPJLinkResponseStatus::Success, Parameter);
+    }
+    const double DynamicSeconds = FPlatformTime::Seconds() - Start;
+    const int32 DynamicCount = Listener->BenchmarkResponseCount;
+
+    // 2. 현재 블루프린트 경로 - 이벤트 큐에 넣고 게임 스레드에서 꺼내 동적 대리자 호출
+    Listener->BenchmarkResponseCount = 0;
+    Start = FPlatformTime::Seconds();
+    for (int32 Index = 0; Index < NumEvents; ++Index)
+    {
+        NetworkManager->EventQueue.Enqueue([](FPJLinkEvent& Event)
+        {
+            Event.Type = EPJLinkEventType::Response;
+            Event.Command = EPJLinkCommand::POWR;
+            Event.Status = EPJLinkResponseStatus::Success;
+            Event.Text.Append(TEXT("1"));
+        });
+    }
+    while (!NetworkManager->EventQueue.IsEmpty())
+    {
+        NetworkManager->DrainEvents(1.0);
+    }
+    const double QueuedSeconds = FPlatformTime::Seconds() - Start;
+    const int32 QueuedCount = Listener->BenchmarkResponseCount;
+
+    // 3. 네이티브 대리자 - 응답 프레임을 가리키는 뷰를 그대로 전달
+    int32 NativeCount = 0;
+    const FDelegateHandle Handle = NetworkManager->GetNativeEvents().OnResponse.AddLambda(
+        [&NativeCount](UPJLinkNetworkManager* Source, const FPJLinkNativeResponse& Response)
+        {
+            NativeCount += Response.Parameter.Len();
+        });
+
+    FPJLinkNativeResponse Response;
+    Response.Command = EPJLinkCommand::POWR;
+    Response.Status = EPJLinkResponseStatus::Success;
+    Response.Parameter = "1";
+    Response.bFromProjector = true;
+
+    Start = FPlatformTime::Seconds();
+    for (int32 Index = 0; Index < NumEvents; ++Index)
+    {
+        NetworkManager->GetNativeEvents().OnResponse.Broadcast(NetworkManager, Response);
+    }
+    const double NativeSeconds = FPlatformTime::Seconds() - Start;
+    NetworkManager->GetNativeEvents().OnResponse.Remove(Handle);
+
+    const double DynamicNs = DynamicSeconds * 1.0e9 / NumEvents;
+    const double QueuedNs = QueuedSeconds * 1.0e9 / NumEvents;
+    const double NativeNs = NativeSeconds * 1.0e9 / NumEvents;
+
+    PJLINK_LOG_INFO(TEXT("Dynamic broadcast: %.1f ns/event, queued dynamic (game thread): %.1f ns/event, native: %.1f ns/event (%.1fx faster than queued)"),
+        DynamicNs, QueuedNs, NativeNs, NativeNs > 0.0 ? QueuedNs / NativeNs : 0.0);
+
+    if (DynamicCount != NumEvents || QueuedCount != NumEvents || NativeCount != NumEvents)
+    {
+        PJLINK_LOG_ERROR(TEXT("Event count mismatch: dynamic %d, queued %d, native %d (expected %d)"),
+            DynamicCount, QueuedCount, NativeCount, NumEvents);
+        bSuccess = false;
+    }
+
+    if (NativeSeconds >= QueuedSeconds)
+    {
+        PJLINK_LOG_ERROR(TEXT("Native dispatch was not cheaper than the queued dynamic path"));
+        bSuccess = false;
+    }
+
+    NetworkManager->OnResponseReceived.RemoveDynamic(Listener, &UPJLinkTests::HandleBenchmarkResponse);
+    NetworkManager->Shutdown();
+    return bSuccess;
+}
+
+bool UPJLinkTests::TestAsyncConnect(int32 NumProjectors, float TimeoutSeconds)
+{
+    using namespace PJLinkTestUtils;
+
+    NumProjectors = FMath::Clamp(NumProjectors, 1, 1000);
+    TimeoutSeconds = FMath::Clamp(TimeoutSeconds, 0.1f, 30.0f);
+    PJLINK_LOG_INFO(TEXT("Starting async connect test (%d projectors, %.1f second timeout)"), NumProjectors, TimeoutSeconds);
+
+    bool bSuccess = true;
+
+    // 1. 에뮬레이터에 비동기 연결 - 완료 후 자동 상태 조회(명령 6개)가 도착해야 함
+    {
+        FPJLinkTestProjector Emulator(true);
+        if (!Emulator.Start())
+        {
+            PJLINK_LOG_ERROR(TEXT("Failed to start projector emulator"));
+            return false;
+        }
+
+        UPJLinkNetworkManager* NetworkManager = NewObject<UPJLinkNetworkManager>();
+        NetworkManager->bAutoReconnect = false;
+
+        const double Start = FPlatformTime::Seconds();
+        TFuture<bool> Future = NetworkManager->StartConnect(Emulator.MakeProjectorInfo(), 2.0f);
+        const double StartSeconds = FPlatformTime::Seconds() - Start;
+
+        if (!Future.WaitFor(FTimespan::FromSeconds(3.0)) || !Future.Get() || !NetworkManager->IsConnected())
+        {
+            PJLINK_LOG_ERROR(TEXT("Async connect to projector emulator failed"));
+            bSuccess = false;
+        }
+
+        const double WaitStart = FPlatformTime::Seconds();
+        while (Emulator.GetReceivedCommandCount() < 6 && FPlatformTime::Seconds() - WaitStart < 2.0)
+        {
+            FPlatformProcess::SleepNoStats(0.001f);
+        }
+
+        if (Emulator.GetReceivedCommandCount() < 6)
+        {
+            PJLINK_LOG_ERROR(TEXT("Initial status refresh not received after async connect (%d commands)"),
+                Emulator.GetReceivedCommandCount());
+            bSuccess = false;
+        }
+
+        PJLINK_LOG_INFO(TEXT("Async connect to emulator: start call %.1f us"), StartSeconds * 1.0e6);
+
+        NetworkManager->Shutdown();
+        Emulator.StopEmulator();
+    }
+
+    // 2. 닫힌 포트 - 타임아웃을 기다리지 않고 실패해야 함
+    {
+        uint16 ClosedPort = 0;
+        FNativeSocket Listener = CreateLoopbackListener(ClosedPort);
+        Close(Listener);
+
+        FPJLinkProjectorInfo Info;
+        Info.Name = TEXT("Refused");
+        Info.IPAddress = TEXT("127.0.0.1");
+        Info.Port = ClosedPort;
+
+        UPJLinkNetworkManager* NetworkManager = NewObject<UPJLinkNetworkManager>();
+        NetworkManager->bAutoReconnect = false;
+
+        const double Start = FPlatformTime::Seconds();
+        TFuture<bool> Future = NetworkManager->StartConnect(Info, 5.0f);
+        const bool bCompleted = Future.WaitFor(FTimespan::FromSeconds(4.0));
+        const double ElapsedSeconds = FPlatformTime::Seconds() - Start;
+
+        if (!bCompleted || Future.Get() || NetworkManager->IsConnecting())
+        {
+            PJLINK_LOG_ERROR(TEXT("Connect to refused port did not fail before the timeout"));
+            bSuccess = false;
+        }
+
+        PJLINK_LOG_INFO(TEXT("Refused connect completed in %.1f ms"), ElapsedSeconds * 1000.0);
+        NetworkManager->Shutdown();
+    }
+
+    // 3. 응답 없는 주소(TEST-NET-1) 여러 개에 동시에 연결 시작
+    {
+        TArray<UPJLinkNetworkManager*> Managers;
+        TArray<TFuture<bool>> Futures;
+        Managers.Reserve(NumProjectors);
+        Futures.Reserve(NumProjectors);
+
+        const double Start = FPlatformTime::Seconds();
+        for (int32 Index = 0; Index < NumProjectors; ++Index)
+        {
+            FPJLinkProjectorInfo Info;
+            Info.Name = FString::Printf(TEXT("Unreachable %d"), Index);
+            Info.IPAddress = FString::Printf(TEXT("192.0.2.%d"), 1 + Index % 254);
+            Info.Port = 4352 + Index / 254;
+
+            UPJLinkNetworkManager* NetworkManager = NewObject<UPJLinkNetworkManager>();
+            NetworkManager->bAutoReconnect = false;
+            Managers.Add(NetworkManager);
+            Futures.Add(NetworkManager->StartConnect(Info, TimeoutSeconds));
+        }
+        const double StartSeconds = FPlatformTime::Seconds() - Start;
+
+        // 모든 연결이 타임아웃(또는 라우팅 오류)으로 완료될 때까지 대기
+        const FDateTime Deadline = FDateTime::UtcNow() + FTimespan::FromSeconds(TimeoutSeconds * 2.0);
+        int32 CompletedCount = 0;
+        int32 ConnectedCount = 0;
+        for (TFuture<bool>& Future : Futures)
+        {
+            const FTimespan Remaining = FMath::Max(Deadline - FDateTime::UtcNow(), FTimespan::Zero());
+            if (Future.WaitFor(Remaining))
+            {
+                ++CompletedCount;
+                ConnectedCount += Future.Get() ? 1 : 0;
+            }
+        }
+        const double TotalSeconds = FPlatformTime::Seconds() - Start;
+
+        PJLINK_LOG_INFO(TEXT("Started %d connects in %.2f ms (%.1f us each), all completed in %.2f s (blocking connect would take up to %.0f s)"),
+            NumProjectors, StartSeconds * 1000.0, StartSeconds * 1.0e6 / NumProjectors, TotalSeconds, NumProjectors * TimeoutSeconds);
+
+        if (StartSeconds >= TimeoutSeconds)
+        {
+            PJLINK_LOG_ERROR(TEXT("Starting %d connects took %.2f s - start call is blocking"), NumProjectors, StartSeconds);
+            bSuccess = false;
+        }
+
+        if (CompletedCount != NumProjectors || ConnectedCount != 0)
+        {
+            PJLINK_LOG_ERROR(TEXT("Unreachable connects: %d/%d completed, %d connected"), CompletedCount, NumProjectors, ConnectedCount);
+            bSuccess = false;
+        }
+
+        for (UPJLinkNetworkManager* NetworkManager : Managers)
+        {
+            NetworkManager->Shutdown();
+        }
+    }
+
+    return bSuccess;
+}
+
+bool UPJLinkTests::TestAuthHandshake()
+{
+    using namespace PJLinkTestUtils;
+
+    PJLINK_LOG_INFO(TEXT("Starting authentication handshake test"));
+
+    static const TCHAR* ProjectorPassword = TEXT("JBMIAProjectorLink");
+
+    // 에뮬레이터 하나에 연결해 첫 상태 조회(명령 6개)가 도착할 때까지 기다린 뒤 결과 확인
+    auto RunCase = [](const TCHAR* CaseName, const FString& EmulatorPassword, const FString& ClientPassword, bool bAsync,
+        int32 ExpectedAuthenticated, int32 ExpectedFailures) -> bool
+    {
+        FPJLinkTestProjector Emulator(true);
+        Emulator.SetPassword(EmulatorPassword);
+        if (!Emulator.Start())
+        {
+            PJLINK_LOG_ERROR(TEXT("[%s] Failed to start projector emulator"), CaseName);
+            return false;
+        }
+
+        FPJLinkProjectorInfo Info = Emulator.MakeProjectorInfo();
+        Info.bRequiresAuthentication = !ClientPassword.IsEmpty();
+        Info.Password = ClientPassword;
+
+        UPJLinkNetworkManager* NetworkManager = NewObject<UPJLinkNetworkManager>();
+        NetworkManager->bAutoReconnect = false;
+
+        bool bConnected = false;
+        if (bAsync)
+        {
+            TFuture<bool> Future = NetworkManager->StartConnect(Info, 2.0f);
+            bConnected = Future.WaitFor(FTimespan::FromSeconds(3.0)) && Future.Get();
+        }
+        else
+        {
+            bConnected = NetworkManager->ConnectToProjector(Info, 2.0f);
+        }
+
+        const bool bExpectCommands = ExpectedFailures == 0;
+        const double WaitStart = FPlatformTime::Seconds();
+        while (FPlatformTime::Seconds() - WaitStart < 2.0)
+        {
+            if (bExpectCommands ? Emulator.GetReceivedCommandCount() >= 6 : Emulator.GetAuthFailureCount() >= ExpectedFailures)
+            {
+                break;
+            }
+            FPlatformProcess::SleepNoStats(0.001f);
+        }
+
+        bool bSuccess = bConnected;
+        if (!bConnected)
+        {
+            PJLINK_LOG_ERROR(TEXT("[%s] Connect failed"), CaseName);
+        }
+
+        if (Emulator.GetAuthenticatedCount() != ExpectedAuthenticated || Emulator.GetAuthFailureCount() != ExpectedFailures)
+        {
+            PJLINK_LOG_ERROR(TEXT("[%s] Authenticated %d (expected %d), failures %d (expected %d)"), CaseName,
+                Emulator.GetAuthenticatedCount(), ExpectedAuthenticated, Emulator.GetAuthFailureCount(), ExpectedFailures);
+            bSuccess = false;
+        }
+
+        // 응답 해시와 상태 조회 묶음은 한 번의 쓰기로 도착해야 함
+        if (bExpectCommands && (Emulator.GetReceivedCommandCount() < 6 || Emulator.GetReceivedReadCount() != 1))
+        {
+            PJLINK_LOG_ERROR(TEXT("[%s] Expected digest and status refresh in one segment (%d commands in %d reads)"), CaseName,
+                Emulator.GetReceivedCommandCount(), Emulator.GetReceivedReadCount());
+            bSuccess = false;
+        }
+
+        PJLINK_LOG_INFO(TEXT("[%s] %s - %d commands in %d reads"), CaseName, bSuccess ? TEXT("passed") : TEXT("failed"),
+            Emulator.GetReceivedCommandCount(), Emulator.GetReceivedReadCount());
+
+        NetworkManager->Shutdown();
+        Emulator.StopEmulator();
+        return bSuccess;
+    };
+
+    bool bSuccess = true;
+    bSuccess &= RunCase(TEXT("Sync auth"), ProjectorPassword, ProjectorPassword, false, 1, 0);
+    bSuccess &= RunCase(TEXT("Async auth"), ProjectorPassword, ProjectorPassword, true, 1, 0);
+    bSuccess &= RunCase(TEXT("No auth"), FString(), ProjectorPassword, true, 0, 0);
+    bSuccess &= RunCase(TEXT("Wrong password"), ProjectorPassword, TEXT("wrong"), true, 0, 1);
+    return bSuccess;
+}
+
+bool UPJLinkTests::TestSessionIdlePolicy(int32 Iterations, float IdleTimeoutSeconds)
+{
+    using namespace PJLinkTestUtils;
+
+    Iterations = FMath::Clamp(Iterations, 1, 100);
+    IdleTimeoutSeconds = FMath::Clamp(IdleTimeoutSeconds, 0.2f, 30.0f);
+    PJLINK_LOG_INFO(TEXT("Starting session idle policy test (%d iterations, %.1f second idle timeout)"), Iterations, IdleTimeoutSeconds);
+
+    static const TCHAR* ProjectorPassword = TEXT("JBMIAProjectorLink");
+
+    FPJLinkTestProjector Emulator(true);
+    Emulator.SetPassword(ProjectorPassword);
+    Emulator.SetIdleTimeout(IdleTimeoutSeconds);
+    if (!Emulator.Start())
+    {
+        PJLINK_LOG_ERROR(TEXT("Failed to start projector emulator"));
+        return false;
+    }
+
+    FPJLinkProjectorInfo Info = Emulator.MakeProjectorInfo();
+    Info.bRequiresAuthentication = true;
+    Info.Password = ProjectorPassword;
+
+    // 순번별 응답 왕복 시간 (I/O 스레드에서 기록)
+    FCriticalSection ResponseLock;
+    TMap<int32, double> RoundTrips;
+    auto WaitForResponse = [&ResponseLock, &RoundTrips](int32 SequenceId, double& OutRoundTripSeconds)
+    {
+        const double WaitStart = FPlatformTime::Seconds();
+        while (FPlatformTime::Seconds() - WaitStart < 3.0)
+        {
+            {
+                FScopeLock Lock(&ResponseLock);
+                if (const double* Found = RoundTrips.Find(SequenceId))
+                {
+                    OutRoundTripSeconds = *Found;
+                    return true;
+                }
+            }
+            FPlatformProcess::SleepNoStats(0.0005f);
+        }
+        return false;
+    };
+
+    bool bSuccess = true;
+
+    // 1. ReconnectOnDemand - 유휴 종료 후 명령이 재연결 직후 바로 전송되는지
+    {
+        UPJLinkNetworkManager* NetworkManager = NewObject<UPJLinkNetworkManager>();
+        NetworkManager->bAutoReconnect = false;
+        NetworkManager->SessionPolicy = EPJLinkSessionPolicy::ReconnectOnDemand;
+        NetworkManager->SessionIdleTimeoutSeconds = IdleTimeoutSeconds;
+
+        const FDelegateHandle Handle = NetworkManager->GetNativeEvents().OnResponse.AddLambda(
+            [&ResponseLock, &RoundTrips](UPJLinkNetworkManager* Source, const FPJLinkNativeResponse& Response)
+            {
+                if (Response.SequenceId != 0)
+                {
+                    FScopeLock Lock(&ResponseLock);
+                    RoundTrips.Add(Response.SequenceId, Response.RoundTripSeconds);
+                }
+            });
+
+        if (!NetworkManager->ConnectToProjector(Info, 2.0f))
+        {
+            PJLINK_LOG_ERROR(TEXT("Failed to connect to projector emulator"));
+            Emulator.StopEmulator();
+            return false;
+        }
+
+        TArray<double> WarmTimes;
+        TArray<double> ColdTimes;
+
+        // 연결이 살아 있을 때의 응답 시간
+        for (int32 Index = 0; Index < Iterations; ++Index)
+        {
+            const int32 SequenceId = NetworkManager->SendCommandWithSequence(EPJLinkCommand::POWR, TEXT("?"), 2.0f);
+            double RoundTrip = 0.0;
+            if (SequenceId == 0 || !WaitForResponse(SequenceId, RoundTrip))
+            {
+                PJLINK_LOG_ERROR(TEXT("Warm command %d got no response"), Index);
+                bSuccess = false;
+                break;
+            }
+            WarmTimes.Add(RoundTrip);
+        }
+
+        // 프로젝터가 세션을 닫은 뒤 보낸 명령의 응답 시간 (재연결 비용 포함)
+        for (int32 Index = 0; Index < Iterations && bSuccess; ++Index)
+        {
+            const double WaitStart = FPlatformTime::Seconds();
+            while (!NetworkManager->IsSessionDormant() && FPlatformTime::Seconds() - WaitStart < IdleTimeoutSeconds * 4.0)
+            {
+                FPlatformProcess::SleepNoStats(0.005f);
+            }
+
+            if (!NetworkManager->IsSessionDormant() || NetworkManager->IsConnected())
+            {
+                PJLINK_LOG_ERROR(TEXT("Idle session was not detected as dormant (iteration %d)"), Index);
+                bSuccess = false;
+                break;
+            }
+
+            const int32 SequenceId = NetworkManager->SendCommandWithSequence(EPJLinkCommand::POWR, TEXT("?"), 2.0f);
+            double RoundTrip = 0.0;
+            if (SequenceId == 0 || !WaitForResponse(SequenceId, RoundTrip))
+            {
+                PJLINK_LOG_ERROR(TEXT("Command after idle drop got no response (iteration %d)"), Index);
+                bSuccess = false;
+                break;
+            }
+            ColdTimes.Add(RoundTrip);
+        }
+
+        const FPJLinkSessionStats Stats = NetworkManager->GetSessionStats();
+        NetworkManager->GetNativeEvents().OnResponse.Remove(Handle);
+        NetworkManager->Shutdown();
+
+        if (bSuccess)
+        {
+            WarmTimes.Sort();
+            ColdTimes.Sort();
+            const double WarmP99Ms = WarmTimes[FMath::Min(FMath::CeilToInt(WarmTimes.Num() * 0.99) - 1, WarmTimes.Num() - 1)] * 1000.0;
+            const double ColdP99Ms = ColdTimes[FMath::Min(FMath::CeilToInt(ColdTimes.Num() * 0.99) - 1, ColdTimes.Num() - 1)] * 1000.0;
+
+            PJLINK_LOG_INFO(TEXT("Warm p99 %.3f ms, after idle drop p99 %.3f ms, connect cost avg %.3f ms / max %.3f ms"),
+                WarmP99Ms, ColdP99Ms, Stats.AverageConnectMs, Stats.MaxConnectMs);
+            PJLINK_LOG_INFO(TEXT("Idle drops %d, on-demand reconnects %d, deferred commands %d"),
+                Stats.IdleDropCount, Stats.OnDemandReconnectCount, Stats.DeferredCommandCount);
+
+            if (Stats.OnDemandReconnectCount != Iterations || Stats.DeferredCommandCount != Iterations || Stats.IdleDropCount < Iterations)
+            {
+                PJLINK_LOG_ERROR(TEXT("Unexpected session stats"));
+                bSuccess = false;
+            }
+
+            // 재연결 비용 외에 인증/상태 조회용 왕복이 더 붙으면 안 됨 (연결 비용 + 따뜻한 왕복 한 번 이내)
+            if (ColdP99Ms > Stats.MaxConnectMs + 2.0 * WarmP99Ms + 1.0)
+            {
+                PJLINK_LOG_ERROR(TEXT("Command after idle drop took %.3f ms - more than one extra round trip"), ColdP99Ms);
+                bSuccess = false;
+            }
+        }
+    }
+
+    // 2. KeepAlive - 유휴 시간이 여러 번 지나도 세션 유지
+    {
+        const int32 IdleClosesBefore = Emulator.GetIdleCloseCount();
+
+        UPJLinkNetworkManager* NetworkManager = NewObject<UPJLinkNetworkManager>();
+        NetworkManager->bAutoReconnect = false;
+        NetworkManager->SessionPolicy = EPJLinkSessionPolicy::KeepAlive;
+        NetworkManager->SessionIdleTimeoutSeconds = IdleTimeoutSeconds;
+        NetworkManager->KeepAliveMarginSeconds = IdleTimeoutSeconds * 0.5f;
+
+        if (!NetworkManager->ConnectToProjector(Info, 2.0f))
+        {
+            PJLINK_LOG_ERROR(TEXT("Failed to connect to projector emulator (keep alive)"));
+            bSuccess = false;
+        }
+        else
+        {
+            FPlatformProcess::SleepNoStats(IdleTimeoutSeconds * 4.0f);
+
+            const FPJLinkSessionStats Stats = NetworkManager->GetSessionStats();
+            const bool bStillConnected = NetworkManager->IsConnected();
+            NetworkManager->Shutdown();
+
+            PJLINK_LOG_INFO(TEXT("Keep alive: %d queries, connected %s, emulator idle closes %d"),
+                Stats.KeepAliveCount, bStillConnected ? TEXT("yes") : TEXT("no"), Emulator.GetIdleCloseCount() - IdleClosesBefore);
+
+            if (!bStillConnected || Stats.KeepAliveCount < 2 || Emulator.GetIdleCloseCount() != IdleClosesBefore)
+            {
+                PJLINK_LOG_ERROR(TEXT("Keep alive did not hold the session open"));
+                bSuccess = false;
+            }
+        }
+    }
+
+    // 3. 재연결 실패 - 큐에 넣었던 명령도 순번마다 응답 없음으로 한 번씩 완료되는지
+    {
+        UPJLinkNetworkManager* NetworkManager = NewObject<UPJLinkNetworkManager>();
+        NetworkManager->bAutoReconnect = false;
+        NetworkManager->SessionPolicy = EPJLinkSessionPolicy::ReconnectOnDemand;
+        NetworkManager->SessionIdleTimeoutSeconds = IdleTimeoutSeconds;
+
+        // 순번별 완료 상태 (같은 순번이 두 번 오면 실패)
+        FCriticalSection CompletionLock;
+        TMap<int32, EPJLinkResponseStatus> Completions;
+        bool bDuplicate = false;
+        const FDelegateHandle Handle = NetworkManager->GetNativeEvents().OnResponse.AddLambda(
+            [&CompletionLock, &Completions, &bDuplicate](UPJLinkNetworkManager* Source, const FPJLinkNativeResponse& Response)
+            {
+                if (Response.SequenceId != 0)
+                {
+                    FScopeLock Lock(&CompletionLock);
+                    bDuplicate |= Completions.Contains(Response.SequenceId);
+                    Completions.Add(Response.SequenceId, Response.Status);
+                }
+            });
+
+        if (!NetworkManager->ConnectToProjector(Info, 2.0f))
+        {
+            PJLINK_LOG_ERROR(TEXT("Failed to connect to projector emulator (reconnect failure)"));
+            bSuccess = false;
+        }
+        else
+        {
+            const double WaitStart = FPlatformTime::Seconds();
+            while (!NetworkManager->IsSessionDormant() && FPlatformTime::Seconds() - WaitStart < IdleTimeoutSeconds * 4.0)
+            {
+                FPlatformProcess::SleepNoStats(0.005f);
+            }
+
+            // 에뮬레이터를 내려 큐에 넣은 명령의 재연결이 거부되도록 함
+            Emulator.StopEmulator();
+
+            TArray<int32> Deferred;
+            if (NetworkManager->IsSessionDormant())
+            {
+                for (int32 Index = 0; Index < Iterations; ++Index)
+                {
+                    Deferred.Add(NetworkManager->SendCommandWithSequence(EPJLinkCommand::POWR, TEXT("?"), 2.0f));
+                }
+            }
+
+            const double CompleteStart = FPlatformTime::Seconds();
+            int32 NumCompleted = 0;
+            while (FPlatformTime::Seconds() - CompleteStart < 3.0)
+            {
+                {
+                    FScopeLock Lock(&CompletionLock);
+                    NumCompleted = Completions.Num();
+                }
+                if (Deferred.Num() > 0 && NumCompleted >= Deferred.Num())
+                {
+                    break;
+                }
+                FPlatformProcess::SleepNoStats(0.005f);
+            }
+
+            NetworkManager->GetNativeEvents().OnResponse.Remove(Handle);
+            NetworkManager->Shutdown();
+
+            bool bAllNoResponse = Deferred.Num() == Iterations;
+            for (const int32 SequenceId : Deferred)
+            {
+                const EPJLinkResponseStatus* Status = Completions.Find(SequenceId);
+                bAllNoResponse &= SequenceId != 0 && Status && *Status == EPJLinkResponseStatus::NoResponse;
+            }
+
+            PJLINK_LOG_INFO(TEXT("Reconnect failure: %d deferred commands, %d completions"), Deferred.Num(), Completions.Num());
+
+            if (!bAllNoResponse || Completions.Num() != Deferred.Num() || bDuplicate)
+            {
+                PJLINK_LOG_ERROR(TEXT("Deferred commands were not completed once each after the reconnect failed (completions %d, duplicate %d)"),
+                    Completions.Num(), bDuplicate);
+                bSuccess = false;
+            }
+        }
+    }
+
+    Emulator.StopEmulator();
+    return bSuccess;
+}
+
+bool UPJLinkTests::TestReconnectScheduler(int32 NumProjectors, int32 MaxConcurrentConnects)
+{
+    using namespace PJLinkTestUtils;
+
+    NumProjectors = FMath::Clamp(NumProjectors, 1, 1000);
+    // 에뮬레이터의 수신 대기열(64)을 넘지 않도록 제한
+    MaxConcurrentConnects = FMath::Clamp(MaxConcurrentConnects, 1, 64);
+    PJLINK_LOG_INFO(TEXT("Starting reconnect scheduler test (%d projectors, %d concurrent connects)"), NumProjectors, MaxConcurrentConnects);
+
+    FPJLinkReconnectScheduler& Scheduler = FPJLinkReconnectScheduler::Get();
+    const int32 PreviousMaxConcurrentConnects = Scheduler.GetMaxConcurrentConnects();
+    const float PreviousMaxBackoffSeconds = Scheduler.GetMaxBackoffSeconds();
+
+    bool bSuccess = true;
+
+    // 1. 백오프 분포 - 0 ~ 상한 사이 균등, 상한은 시도마다 두 배 (최대값에서 멈춤)
+    {
+        const float BaseSeconds = 0.1f;
+        const float MaxSeconds = 1.0f;
+        const int32 NumSamples = 4000;
+        FRandomStream Random(1234);
+
+        for (int32 Attempt = 0; Attempt < 6; ++Attempt)
+        {
+            const double Cap = FMath::Min(static_cast<double>(MaxSeconds), BaseSeconds * FMath::Pow(2.0, static_cast<double>(Attempt)));
+            double Sum = 0.0;
+            double MinValue = TNumericLimits<double>::Max();
+            double MaxValue = 0.0;
+            for (int32 Index = 0; Index < NumSamples; ++Index)
+            {
+                const double Value = FPJLinkReconnectScheduler::ComputeBackoffSeconds(BaseSeconds, MaxSeconds, Attempt, Random);
+                Sum += Value;
+                MinValue = FMath::Min(MinValue, Value);
+                MaxValue = FMath::Max(MaxValue, Value);
+            }
+
+            const double Mean = Sum / NumSamples;
+            PJLINK_LOG_INFO(TEXT("Backoff attempt %d: cap %.3f s, mean %.3f s, range %.3f - %.3f s"), Attempt, Cap, Mean, MinValue, MaxValue);
+
+            if (MinValue < 0.0 || MaxValue > Cap || FMath::Abs(Mean - Cap * 0.5) > Cap * 0.05
+                || MinValue > Cap * 0.05 || MaxValue < Cap * 0.95)
+            {
+                PJLINK_LOG_ERROR(TEXT("Backoff for attempt %d is not uniformly jittered up to %.3f s"), Attempt, Cap);
+                bSuccess = false;
+            }
+        }
+    }
+
+    Scheduler.SetMaxConcurrentConnects(MaxConcurrentConnects);
+
+    // 2. 에뮬레이터가 연결을 모두 끊음 - 제한된 동시 연결로 전부 다시 연결
+    {
+        FPJLinkTestProjector Emulator(true);
+        if (!Emulator.Start())
+        {
+            PJLINK_LOG_ERROR(TEXT("Failed to start projector emulator"));
+            return false;
+        }
+
+        const float ReconnectBaseSeconds = 0.5f;
+        Scheduler.SetMaxBackoffSeconds(4.0f);
+
+        // 처음 연결은 하나씩 (한꺼번에 연결하면 에뮬레이터 수신 대기열이 넘침)
+        TArray<UPJLinkNetworkManager*> Managers;
+        Managers.Reserve(NumProjectors);
+        for (int32 Index = 0; Index < NumProjectors && bSuccess; ++Index)
+        {
+            UPJLinkNetworkManager* NetworkManager = NewObject<UPJLinkNetworkManager>();
+            NetworkManager->bAutoReconnect = true;
+            NetworkManager->ReconnectInterval = ReconnectBaseSeconds;
+            NetworkManager->MaxReconnectAttempts = 0;
+            Managers.Add(NetworkManager);
+
+            if (!NetworkManager->ConnectToProjector(Emulator.MakeProjectorInfo(), 2.0f))
+            {
+                PJLINK_LOG_ERROR(TEXT("Initial connect %d to projector emulator failed"), Index);
+                bSuccess = false;
+            }
+        }
+
+        if (bSuccess)
+        {
+            const int32 AcceptedBefore = Emulator.GetAcceptedCount();
+            Scheduler.ResetStats();
+
+            // 스위치 재부팅처럼 모든 연결이 동시에 끊김
+            const double DropTime = FPlatformTime::Seconds();
+            Emulator.DropAllClients();
+
+            // 재연결이 받아들여진 시각 기록
+            TArray<double> AcceptTimes;
+            int32 LastAccepted = AcceptedBefore;
+            int32 MaxObservedActive = 0;
+            while (FPlatformTime::Seconds() - DropTime < 30.0)
+            {
+                const int32 Accepted = Emulator.GetAcceptedCount();
+                const double Now = FPlatformTime::Seconds() - DropTime;
+                for (; LastAccepted < Accepted; ++LastAccepted)
+                {
+                    AcceptTimes.Add(Now);
+                }
+
+                const FPJLinkReconnectStats Stats = Scheduler.GetStats();
+                MaxObservedActive = FMath::Max(MaxObservedActive, Stats.ActiveConnects);
+
+                int32 NumConnected = 0;
+                for (UPJLinkNetworkManager* NetworkManager : Managers)
+                {
+                    NumConnected += NetworkManager->IsConnected() ? 1 : 0;
+                }
+                if (NumConnected == NumProjectors && Stats.PendingProjectors == 0 && Now > 0.1)
+                {
+                    break;
+                }
+                FPlatformProcess::SleepNoStats(0.001f);
+            }
+
+            const FPJLinkReconnectStats Stats = Scheduler.GetStats();
+            const double RecoverySeconds = FPlatformTime::Seconds() - DropTime;
+
+            // 가장 붐빈 50 ms 구간의 재연결 수
+            int32 BurstMax = 0;
+            for (int32 First = 0, Last = 0; Last < AcceptTimes.Num(); ++Last)
+            {
+                while (AcceptTimes[Last] - AcceptTimes[First] > 0.05)
+                {
+                    ++First;
+                }
+                BurstMax = FMath::Max(BurstMax, Last - First + 1);
+            }
+
+            PJLINK_LOG_INFO(TEXT("Recovered %d/%d projectors in %.3f s: %d attempts, %d successes, peak %d concurrent (observed %d), busiest 50 ms window %d"),
+                Stats.SuccessfulReconnects, NumProjectors, RecoverySeconds, Stats.TotalAttempts, Stats.SuccessfulReconnects,
+                Stats.PeakActiveConnects, MaxObservedActive, BurstMax);
+
+            if (Stats.SuccessfulReconnects != NumProjectors || Stats.PendingProjectors != 0)
+            {
+                PJLINK_LOG_ERROR(TEXT("Not every projector reconnected (%d/%d)"), Stats.SuccessfulReconnects, NumProjectors);
+                bSuccess = false;
+            }
+
+            if (Stats.PeakActiveConnects > MaxConcurrentConnects || MaxObservedActive > MaxConcurrentConnects)
+            {
+                PJLINK_LOG_ERROR(TEXT("Concurrent reconnects exceeded the limit (%d > %d)"), Stats.PeakActiveConnects, MaxConcurrentConnects);
+                bSuccess = false;
+            }
+
+            // 지터가 없으면 모든 재연결이 같은 순간에 몰림 (0.5 초에 고르게 퍼지면 50 ms 에 약 10 %)
+            if (NumProjectors >= 20 && BurstMax > FMath::Max(MaxConcurrentConnects, NumProjectors / 3))
+            {
+                PJLINK_LOG_ERROR(TEXT("Reconnects arrived in a burst (%d of %d within 50 ms)"), BurstMax, NumProjectors);
+                bSuccess = false;
+            }
+        }
+
+        for (UPJLinkNetworkManager* NetworkManager : Managers)
+        {
+            NetworkManager->Shutdown();
+        }
+        Emulator.StopEmulator();
+    }
+
+    // 3. 닫힌 포트 - 최대 시도 횟수만큼 시도한 뒤 포기
+    {
+        uint16 ClosedPort = 0;
+        FNativeSocket Listener = CreateLoopbackListener(ClosedPort);
+        Close(Listener);
+
+        FPJLinkProjectorInfo Info;
+        Info.Name = TEXT("Refused");
+        Info.IPAddress = TEXT("127.0.0.1");
+        Info.Port = ClosedPort;
+
+        const int32 MaxAttempts = 3;
+        Scheduler.SetMaxBackoffSeconds(0.2f);
+        Scheduler.ResetStats();
+
+        TArray<UPJLinkNetworkManager*> Managers;
+        Managers.Reserve(NumProjectors);
+        for (int32 Index = 0; Index < NumProjectors; ++Index)
+        {
+            UPJLinkNetworkManager* NetworkManager = NewObject<UPJLinkNetworkManager>();
+            NetworkManager->bAutoReconnect = false;
+            NetworkManager->LastProjectorInfo = Info;
+            Managers.Add(NetworkManager);
+            Scheduler.Schedule(NetworkManager, 0.02f, MaxAttempts);
+        }
+
+        const double Start = FPlatformTime::Seconds();
+        FPJLinkReconnectStats Stats = Scheduler.GetStats();
+        while (Stats.PendingProjectors > 0 && FPlatformTime::Seconds() - Start < 30.0)
+        {
+            FPlatformProcess::SleepNoStats(0.005f);
+            Stats = Scheduler.GetStats();
+        }
+
+        PJLINK_LOG_INFO(TEXT("Refused port: %d attempts, %d gave up, peak %d concurrent in %.3f s"),
+            Stats.TotalAttempts, Stats.GaveUpCount, Stats.PeakActiveConnects, FPlatformTime::Seconds() - Start);
+
+        if (Stats.PendingProjectors != 0 || Stats.GaveUpCount != NumProjectors || Stats.TotalAttempts != NumProjectors * MaxAttempts
+            || Stats.PeakActiveConnects > MaxConcurrentConnects)
+        {
+            PJLINK_LOG_ERROR(TEXT("Refused projectors did not give up after %d attempts each"), MaxAttempts);
+            bSuccess = false;
+        }
+
+        for (UPJLinkNetworkManager* NetworkManager : Managers)
+        {
+            NetworkManager->Shutdown();
+        }
+    }
+
+    Scheduler.SetMaxConcurrentConnects(PreviousMaxConcurrentConnects);
+    Scheduler.SetMaxBackoffSeconds(PreviousMaxBackoffSeconds);
+    return bSuccess;
+}
+
+bool UPJLinkTests::TestNotificationListener()
+{
+    using namespace PJLinkTestUtils;
+
+    PJLINK_LOG_INFO(TEXT("Starting notification listener test"));
+
+    FPJLinkNotificationListener& Listener = FPJLinkNotificationListener::Get();
+    Listener.SetListenPort(0);
+
+    FPJLinkTestProjector Emulator(true);
+    if (!Emulator.Start())
+    {
+        PJLINK_LOG_ERROR(TEXT("Failed to start projector emulator"));
+        Listener.SetListenPort(FPJLinkNotificationListener::DefaultPort);
+        return false;
+    }
+
+    UPJLinkNetworkManager* NetworkManager = NewObject<UPJLinkNetworkManager>();
+    NetworkManager->bAutoReconnect = false;
+
+    // 알림으로 들어온 응답(순번 0)과 상태 변경 (I/O 스레드에서 기록)
+    TAtomic<int32> UnsolicitedCount(0);
+    TAtomic<int32> PowerChangeCount(0);
+    TAtomic<int32> InputChangeCount(0);
+    const FDelegateHandle ResponseHandle = NetworkManager->GetNativeEvents().OnResponse.AddLambda(
+        [&UnsolicitedCount](UPJLinkNetworkManager* Source, const FPJLinkNativeResponse& Response)
+        {
+            if (Response.SequenceId == 0 && Response.bFromProjector)
+            {
+                UnsolicitedCount++;
+            }
+        });
+    const FDelegateHandle PowerHandle = NetworkManager->GetNativeEvents().OnPowerStatusChanged.AddLambda(
+        [&PowerChangeCount](UPJLinkNetworkManager* Source, EPJLinkPowerStatus OldStatus, EPJLinkPowerStatus NewStatus)
+        {
+            PowerChangeCount++;
+        });
+    const FDelegateHandle InputHandle = NetworkManager->GetNativeEvents().OnInputSourceChanged.AddLambda(
+        [&InputChangeCount](UPJLinkNetworkManager* Source, EPJLinkInputSource OldSource, EPJLinkInputSource NewSource)
+        {
+            InputChangeCount++;
+        });
+
+    auto WaitFor = [](TFunctionRef<bool()> Condition)
+    {
+        const double WaitStart = FPlatformTime::Seconds();
+        while (!Condition() && FPlatformTime::Seconds() - WaitStart < 2.0)
+        {
+            FPlatformProcess::SleepNoStats(0.001f);
+        }
+        return Condition();
+    };
+
+    bool bSuccess = true;
+    FNativeSocket Sender = CreateUdpSocket();
+
+    if (!NetworkManager->ConnectToProjector(Emulator.MakeProjectorInfo(), 2.0f))
+    {
+        PJLINK_LOG_ERROR(TEXT("Failed to connect to projector emulator"));
+        bSuccess = false;
+    }
+    // 연결 직후 상태 조회 응답이 모두 도착한 뒤 알림을 보냄 (조회 응답이 알림 값을 덮어쓰지 않도록)
+    else if (!WaitFor([NetworkManager]() { return NetworkManager->GetProjectorInfo().CurrentInputSource != EPJLinkInputSource::Unknown; }))
+    {
+        PJLINK_LOG_ERROR(TEXT("Initial status refresh did not complete"));
+        bSuccess = false;
+    }
+
+    const uint16 ListenPort = Listener.GetBoundPort();
+    if (bSuccess && (ListenPort == 0 || Sender == InvalidSocket))
+    {
+        PJLINK_LOG_ERROR(TEXT("Notification socket is not open"));
+        bSuccess = false;
+    }
+
+    auto SendNotification = [Sender, ListenPort](const ANSICHAR* Datagram)
+    {
+        int32 BytesSent = 0;
+        PJLinkSocketPlatform::SendTo(Sender, reinterpret_cast<const uint8*>(Datagram), FCStringAnsi::Strlen(Datagram),
+            LoopbackIPv4, ListenPort, BytesSent);
+    };
+
+    if (bSuccess)
+    {
+        const bool bPushingBefore = NetworkManager->IsReceivingNotifications();
+        const int32 PowerChangesBefore = PowerChangeCount.load();
+        const int32 InputChangesBefore = InputChangeCount.load();
+
+        // 1. 전원 꺼짐 알림 (에뮬레이터는 조회에 켜짐으로 응답)
+        SendNotification("%1POWR=0\r");
+        if (!WaitFor([NetworkManager]() { return NetworkManager->GetProjectorInfo().PowerStatus == EPJLinkPowerStatus::PoweredOff; })
+            || PowerChangeCount.load() != PowerChangesBefore + 1)
+        {
+            PJLINK_LOG_ERROR(TEXT("Power notification did not update the projector state"));
+            bSuccess = false;
+        }
+
+        // 2. 입력 전환 알림
+        SendNotification("%2INPT=11\r");
+        if (!WaitFor([&InputChangeCount, InputChangesBefore]() { return InputChangeCount.load() == InputChangesBefore + 1; }))
+        {
+            PJLINK_LOG_ERROR(TEXT("Input notification did not fire the change event"));
+            bSuccess = false;
+        }
+
+        // 3. 데이터그램 하나에 든 여러 줄
+        SendNotification("%1AVMT=31\r%2ERST=000000\r");
+
+        // 4. 네트워크 켜짐 (연결된 세션에는 영향 없음)
+        SendNotification("%2LKUP=00:11:22:33:44:55\r");
+
+        if (!WaitFor([NetworkManager]() { return NetworkManager->GetNotificationCount() == 5; }) || UnsolicitedCount.load() != 4)
+        {
+            PJLINK_LOG_ERROR(TEXT("Expected 5 notifications (4 status events), got %d (%d events)"),
+                NetworkManager->GetNotificationCount(), UnsolicitedCount.load());
+            bSuccess = false;
+        }
+
+        if (bPushingBefore || !NetworkManager->IsReceivingNotifications() || !NetworkManager->IsConnected()
+            || FPJLinkReconnectScheduler::Get().IsScheduled(NetworkManager))
+        {
+            PJLINK_LOG_ERROR(TEXT("Notification state is wrong after link up"));
+            bSuccess = false;
+        }
+
+        PJLINK_LOG_INFO(TEXT("Notifications: %d received on port %d, %d status events, %d unmatched datagrams"),
+            NetworkManager->GetNotificationCount(), ListenPort, UnsolicitedCount.load(), Listener.GetUnmatchedCount());
+    }
+
+    NetworkManager->GetNativeEvents().OnResponse.Remove(ResponseHandle);
+    NetworkManager->GetNativeEvents().OnPowerStatusChanged.Remove(PowerHandle);
+    NetworkManager->GetNativeEvents().OnInputSourceChanged.Remove(InputHandle);
+    NetworkManager->Shutdown();
+
+    if (Sender != InvalidSocket)
+    {
+        Close(Sender);
+    }
+    Emulator.StopEmulator();
+    Listener.SetListenPort(FPJLinkNotificationListener::DefaultPort);
+    return bSuccess;
+}
+
+bool UPJLinkTests::TestBroadcastDiscovery(int32 TransmitCount)
+{
+    using namespace PJLinkTestUtils;
+
+    PJLINK_LOG_INFO(TEXT("Starting broadcast discovery test with %d transmits"), TransmitCount);
+
+    // 검색 응답과 완료 처리는 게임 스레드 태스크로 전달됨
+    if (!IsInGameThread())
+    {
+        PJLINK_LOG_ERROR(TEXT("Broadcast discovery test must run on the game thread"));
+        return false;
+    }
+
+    FPJLinkNotificationListener& Listener = FPJLinkNotificationListener::Get();
+    Listener.SetListenPort(0);
+
+    // 브로드캐스트 대신 검색 명령을 받을 루프백 응답기
+    FNativeSocket Responder = CreateUdpSocket();
+    if (Responder == InvalidSocket || !Bind(Responder, LoopbackIPv4, 0))
+    {
+        PJLINK_LOG_ERROR(TEXT("Failed to open responder socket"));
+        Close(Responder);
+        Listener.SetListenPort(FPJLinkNotificationListener::DefaultPort);
+        return false;
+    }
+
+    const ANSICHAR* Reply = "%2ACKN=00:1a:2b:3c:4d:5e\r";
+    const int32 ReplyLength = FCStringAnsi::Strlen(Reply);
+
+    UPJLinkDiscoveryManager* DiscoveryManager = NewObject<UPJLinkDiscoveryManager>();
+    DiscoveryManager->SetBroadcastAddress(TEXT("127.0.0.1"));
+    DiscoveryManager->SetBroadcastPort(GetBoundPort(Responder));
+    DiscoveryManager->SetSearchTransmitCount(TransmitCount);
+
+    const float SearchTimeout = 1.0f;
+    const FString DiscoveryID = DiscoveryManager->StartBroadcastDiscovery(SearchTimeout);
+
+    int32 SearchCount = 0;
+    int32 ReplyCount = 0;
+    FPJLinkDiscoveryStatus Status;
+    const double WaitStart = FPlatformTime::Seconds();
+    while (FPlatformTime::Seconds() - WaitStart < SearchTimeout + 2.0)
+    {
+        // 검색 명령마다 송신 포트(일부 장치)와 알림 포트(규격) 양쪽으로 응답
+        FPollEntry Entry;
+        Entry.Socket = Responder;
+        Entry.Requested = EPollFlags::Readable;
+        if (Poll(&Entry, 1, 5) > 0)
+        {
+            uint8 Buffer[64];
+            int32 BytesRead = 0;
+            uint32 SourceIPv4 = 0;
+            uint16 SourcePort = 0;
+            while (RecvFrom(Responder, Buffer, sizeof(Buffer), BytesRead, SourceIPv4, SourcePort) == EIOResult::Ok)
+            {
+                if (BytesRead != 7 || FMemory::Memcmp(Buffer, "%2SRCH\r", 7) != 0)
+                {
+                    continue;
+                }
+
+                SearchCount++;
+                int32 BytesSent = 0;
+                if (SendTo(Responder, reinterpret_cast<const uint8*>(Reply), ReplyLength, SourceIPv4, SourcePort, BytesSent) == EIOResult::Ok)
+                {
+                    ReplyCount++;
+                }
+
+                const uint16 NotificationPort = Listener.GetBoundPort();
+                if (NotificationPort != 0
+                    && SendTo(Responder, reinterpret_cast<const uint8*>(Reply), ReplyLength, LoopbackIPv4, NotificationPort, BytesSent) == EIOResult::Ok)
+                {
+                    ReplyCount++;
+                }
+            }
+        }
+
+        FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+        if (DiscoveryManager->GetDiscoveryStatus(DiscoveryID, Status) && Status.bIsComplete)
+        {
+            break;
+        }
+    }
+
+    bool bSuccess = true;
+    const double Elapsed = FPlatformTime::Seconds() - WaitStart;
+    const TArray<FPJLinkDiscoveryResult> Results = DiscoveryManager->GetDiscoveryResults(DiscoveryID);
+
+    if (!Status.bIsComplete || Status.bWasCancelled)
+    {
+        PJLINK_LOG_ERROR(TEXT("Broadcast discovery did not complete on its own"));
+        bSuccess = false;
+    }
+
+    if (SearchCount != FMath::Clamp(TransmitCount, 1, 10))
+    {
+        PJLINK_LOG_ERROR(TEXT("Expected %d SRCH transmits, responder received %d"), FMath::Clamp(TransmitCount, 1, 10), SearchCount);
+        bSuccess = false;
+    }
+
+    if (Results.Num() != 1)
+    {
+        PJLINK_LOG_ERROR(TEXT("Expected 1 discovered device from %d ACKN replies, got %d"), ReplyCount, Results.Num());
+        bSuccess = false;
+    }
+    else if (Results[0].IPAddress != TEXT("127.0.0.1") || Results[0].MacAddress != TEXT("00:1A:2B:3C:4D:5E")
+        || Results[0].DeviceClass != EPJLinkClass::Class2)
+    {
+        PJLINK_LOG_ERROR(TEXT("Unexpected discovery result: %s (MAC %s)"), *Results[0].IPAddress, *Results[0].MacAddress);
+        bSuccess = false;
+    }
+
+    PJLINK_LOG_INFO(TEXT("Broadcast discovery: %d SRCH, %d ACKN sent, %d devices, completed in %.2f s"),
+        SearchCount, ReplyCount, Results.Num(), Elapsed);
+
+    DiscoveryManager->CancelAllDiscoveries();
+    Close(Responder);
+    Listener.SetListenPort(FPJLinkNotificationListener::DefaultPort);
+    return bSuccess;
+}
+
+bool UPJLinkTests::TestScanEngine(int32 MaxInFlight, float ConnectTimeoutSeconds, int32 NumWorkers)
+{
+    using namespace PJLinkTestUtils;
+
+    PJLINK_LOG_INFO(TEXT("Starting scan engine test with %d in flight, %.2f s connect timeout, %d workers"),
+        MaxInFlight, ConnectTimeoutSeconds, NumWorkers);
+
+    FPJLinkTestProjector Emulator(true);
+    if (!Emulator.Start())
+    {
+        PJLINK_LOG_ERROR(TEXT("Failed to start loopback emulator"));
+        return false;
+    }
+
+    bool bSuccess = true;
+
+    // 1) 루프백 범위: 127.0.0.1 의 에뮬레이터만 응답하고 나머지는 연결 거부
+    {
+        FCriticalSection FoundLock;
+        TArray<uint32> FoundAddresses;
+        TSet<uint32> ProgressAddresses;
+        FString FoundResponse;
+        TAtomic<int32> FinishedCount(0);
+
+        FPJLinkScanSettings Settings;
+        Settings.FirstIPv4 = LoopbackIPv4;
+        Settings.LastIPv4 = LoopbackIPv4 + 31;
+        Settings.Port = Emulator.GetPort();
+        Settings.ConnectTimeoutSeconds = ConnectTimeoutSeconds;
+        Settings.MaxInFlight = MaxInFlight;
+        Settings.NumWorkers = NumWorkers;
+        Settings.ChunkSize = 4;
+
+        FPJLinkScanCallbacks Callbacks;
+        Callbacks.OnHostFound = [&FoundLock, &FoundAddresses, &FoundResponse](uint32 IPv4, const FString& Response, int32 ResponseTimeMs)
+        {
+            FScopeLock Lock(&FoundLock);
+            FoundAddresses.Add(IPv4);
+            FoundResponse = Response;
+        };
+        Callbacks.OnProgress = [&FoundLock, &ProgressAddresses](const FPJLinkScanStats& Stats, uint32 LastIPv4)
+        {
+            FScopeLock Lock(&FoundLock);
+            ProgressAddresses.Add(LastIPv4);
+        };
+        Callbacks.OnFinished = [&FinishedCount](const FPJLinkScanStats& Stats, bool bCancelled)
+        {
+            FinishedCount++;
+        };
+
+        FPJLinkScanEngine Engine(Settings, MoveTemp(Callbacks));
+        if (!Engine.Start())
+        {
+            PJLINK_LOG_ERROR(TEXT("Failed to start loopback scan"));
+            Emulator.StopEmulator();
+            return false;
+        }
+        Engine.WaitForCompletion();
+
+        const FPJLinkScanStats Stats = Engine.GetStats();
+        if (FoundAddresses.Num() != 1 || FoundAddresses[0] != LoopbackIPv4
+            || !FoundResponse.StartsWith(TEXT("PJLINK 0")) || !FoundResponse.Contains(TEXT("%1CLSS=1")))
+        {
+            PJLINK_LOG_ERROR(TEXT("Expected the emulator as the only host, got %d hosts (response '%s')"),
+                FoundAddresses.Num(), *FoundResponse.ReplaceCharWithEscapedChar());
+            bSuccess = false;
+        }
+
+        if (Stats.ScannedAddresses != 32 || Stats.TotalAddresses != 32 || FinishedCount.load() != 1
+            || Stats.RunningWorkers != 0 || Stats.InFlight != 0)
+        {
+            PJLINK_LOG_ERROR(TEXT("Loopback scan finished %d/%d addresses, %d finish callbacks, %d workers still running"),
+                Stats.ScannedAddresses, Stats.TotalAddresses, FinishedCount.load(), Stats.RunningWorkers);
+            bSuccess = false;
+        }
+
+        // 진행 보고에 범위 밖 주소가 섞이면 묶음 경계 계산이 틀린 것
+        for (uint32 Address : ProgressAddresses)
+        {
+            if (Address < Settings.FirstIPv4 || Address > Settings.LastIPv4)
+            {
+                PJLINK_LOG_ERROR(TEXT("Progress reported an address outside the range: %08x"), Address);
+                bSuccess = false;
+                break;
+            }
+        }
+
+        PJLINK_LOG_INFO(TEXT("Loopback scan: %d found, %d refused, %d timed out in %.3f s"),
+            Stats.FoundHosts, Stats.RefusedHosts, Stats.TimedOutHosts, Stats.ElapsedSeconds);
+    }
+
+    // 2) 응답하지 않는 /24: 주소마다 기다리지 않고 연결 제한 시간 한두 번 안에 끝나야 함
+    {
+        FPJLinkScanSettings Settings;
+        Settings.FirstIPv4 = 0xC0000201;
+        Settings.LastIPv4 = 0xC00002FE;
+        Settings.Port = 4352;
+        Settings.ConnectTimeoutSeconds = ConnectTimeoutSeconds;
+        Settings.MaxInFlight = MaxInFlight;
+        Settings.NumWorkers = NumWorkers;
+
+        FPJLinkScanEngine Engine(Settings, FPJLinkScanCallbacks());
+        const double ScanStart = FPlatformTime::Seconds();
+        if (!Engine.Start())
+        {
+            PJLINK_LOG_ERROR(TEXT("Failed to start TEST-NET scan"));
+            Emulator.StopEmulator();
+            return false;
+        }
+        Engine.WaitForCompletion();
+        const double Elapsed = FPlatformTime::Seconds() - ScanStart;
+
+        const FPJLinkScanStats Stats = Engine.GetStats();
+        const int32 ExpectedRounds = FMath::DivideAndRoundUp(254, FMath::Clamp(MaxInFlight, 1, FPJLinkScanEngine::MaxInFlightLimit));
+        const double Budget = ExpectedRounds * ConnectTimeoutSeconds * 2.0 + 0.5;
+        if (Stats.ScannedAddresses != 254 || Stats.FoundHosts != 0)
+        {
+            PJLINK_LOG_ERROR(TEXT("TEST-NET scan finished %d/254 addresses with %d hosts"), Stats.ScannedAddresses, Stats.FoundHosts);
+            bSuccess = false;
+        }
+
+        if (Elapsed > Budget || (MaxInFlight > 1 && Stats.PeakInFlight <= 1 && Stats.TimedOutHosts > 0))
+        {
+            PJLINK_LOG_ERROR(TEXT("TEST-NET scan took %.2f s (budget %.2f s), peak %d in flight"),
+                Elapsed, Budget, Stats.PeakInFlight);
+            bSuccess = false;
+        }
+
+        // 정적 분할이면 시간 초과 구간을 맡은 스레드만 늦게 끝나지만, 공유 커서에서는 모두 함께 끝나야 함
+        if (Stats.TailSeconds > ConnectTimeoutSeconds + 0.25)
+        {
+            PJLINK_LOG_ERROR(TEXT("TEST-NET scan tail %.3f s exceeds one connect timeout"), Stats.TailSeconds);
+            bSuccess = false;
+        }
+
+        PJLINK_LOG_INFO(TEXT("TEST-NET scan: %d timed out, %d refused, peak %d in flight, %.2f s, %d workers %.0f%% busy, tail %.3f s"),
+            Stats.TimedOutHosts, Stats.RefusedHosts, Stats.PeakInFlight, Elapsed,
+            Stats.NumWorkers, Stats.WorkerUtilization * 100.0, Stats.TailSeconds);
+    }
+
+    Emulator.StopEmulator();
+    return bSuccess;
+}
+
+bool UPJLinkTests::TestScanThreadPoolIsolation(float ConnectTimeoutSeconds)
+{
+    using namespace PJLinkTestUtils;
+
+    ConnectTimeoutSeconds = FMath::Clamp(ConnectTimeoutSeconds, 0.5f, 10.0f);
+    PJLINK_LOG_INFO(TEXT("Starting scan thread pool isolation test (%.2f s connect timeout)"), ConnectTimeoutSeconds);
+
+    if (!GThreadPool)
+    {
+        PJLINK_LOG_ERROR(TEXT("Engine thread pool is not available"));
+        return false;
+    }
+
+    // 엔진 작업이 잠깐씩 풀을 쓰므로 여러 번 재서 가장 작은 값을 사용
+    auto SampleBusyThreads = []()
+    {
+        int32 MinBusy = MAX_int32;
+        for (int32 Sample = 0; Sample < 3; ++Sample)
+        {
+            MinBusy = FMath::Min(MinBusy, MeasureBusyEnginePoolThreads());
+        }
+        return MinBusy;
+    };
+
+    const int32 EnginePoolThreads = GThreadPool->GetNumThreads();
+    const int32 BusyBeforeScan = SampleBusyThreads();
+
+    FPJLinkScanSettings Settings;
+    Settings.FirstIPv4 = 0xC6120001;
+    Settings.LastIPv4 = 0xC61203FE;
+    Settings.ConnectTimeoutSeconds = ConnectTimeoutSeconds;
+    Settings.MaxInFlight = 1024;
+    Settings.NumWorkers = 4;
+
+    FPJLinkScanEngine Engine(Settings, FPJLinkScanCallbacks());
+    if (!Engine.Start())
+    {
+        PJLINK_LOG_ERROR(TEXT("Failed to start /22 scan"));
+        return false;
+    }
+
+    // 연결이 모두 걸린 뒤 (연결 제한 시간 안) 측정
+    FPlatformProcess::Sleep(0.1f);
+    const bool bScanRunning = !Engine.IsFinished();
+    const int32 BusyDuringScan = SampleBusyThreads();
+    const int32 PoolActive = FPJLinkIOThreadPool::Get().GetNumActive();
+    const FPJLinkScanStats RunningStats = Engine.GetStats();
+
+    Engine.WaitForCompletion();
+    const FPJLinkScanStats Stats = Engine.GetStats();
+
+    bool bSuccess = true;
+    if (!bScanRunning || PoolActive < RunningStats.RunningWorkers || PoolActive <= 0)
+    {
+        PJLINK_LOG_ERROR(TEXT("Scan workers were not running on the plugin pool (%d active, %d running workers)"),
+            PoolActive, RunningStats.RunningWorkers);
+        bSuccess = false;
+    }
+
+    if (BusyDuringScan > BusyBeforeScan)
+    {
+        PJLINK_LOG_ERROR(TEXT("Engine pool occupancy rose during scan: %d -> %d of %d threads"),
+            BusyBeforeScan, BusyDuringScan, EnginePoolThreads);
+        bSuccess = false;
+    }
+
+    if (Stats.ScannedAddresses != 1022)
+    {
+        PJLINK_LOG_ERROR(TEXT("/22 scan finished %d/1022 addresses"), Stats.ScannedAddresses);
+        bSuccess = false;
+    }
+
+    PJLINK_LOG_INFO(TEXT("Engine pool occupancy: %d/%d busy before scan, %d/%d during /22 scan; plugin pool %d threads, %d active, %d in flight"),
+        BusyBeforeScan, EnginePoolThreads, BusyDuringScan, EnginePoolThreads,
+        FPJLinkIOThreadPool::Get().GetNumThreads(), PoolActive, RunningStats.InFlight);
+    return bSuccess;
+}
+
+void UPJLinkTests::HandleDiscoveryProgress(const FPJLinkDiscoveryStatus& Status)
+{
+    ProgressEventCount++;
+    OffGameThreadEventCount += IsInGameThread() ? 0 : 1;
+    LastProgressPercentage = Status.ProgressPercentage;
+}
+
+void UPJLinkTests::HandleCurrentScanAddress(const FString& CurrentAddress)
+{
+    ScanAddressEventCount++;
+    OffGameThreadEventCount += IsInGameThread() ? 0 : 1;
+}
+
+bool UPJLinkTests::TestDiscoveryProgressPublishing(float ConnectTimeoutSeconds)
+{
+    ConnectTimeoutSeconds = FMath::Clamp(ConnectTimeoutSeconds, 0.1f, 5.0f);
+    PJLINK_LOG_INFO(TEXT("Starting discovery progress publishing test (%.2f s connect timeout)"), ConnectTimeoutSeconds);
+
+    // 게시 티커와 완료 처리는 게임 스레드에서 실행됨
+    if (!IsInGameThread())
+    {
+        PJLINK_LOG_ERROR(TEXT("Discovery progress test must run on the game thread"));
+        return false;
+    }
+
+    UPJLinkDiscoveryManager* DiscoveryManager = NewObject<UPJLinkDiscoveryManager>();
+    DiscoveryManager->SetPerAddressWaitTime(FMath::RoundToInt(ConnectTimeoutSeconds * 1000.0f));
+    DiscoveryManager->SetMaxInFlight(1024);
+
+    UPJLinkTests* Listener = NewObject<UPJLinkTests>();
+    DiscoveryManager->OnDiscoveryProgress.AddDynamic(Listener, &UPJLinkTests::HandleDiscoveryProgress);
+    DiscoveryManager->OnCurrentScanAddressChanged.AddDynamic(Listener, &UPJLinkTests::HandleCurrentScanAddress);
+
+    const double ScanStart = FPlatformTime::Seconds();
+    const FString DiscoveryID = DiscoveryManager->StartRangeScan(TEXT("198.18.0.1"), TEXT("198.18.3.254"), 30.0f);
+
+    // 엔진 루프 밖에서 실행되므로 코어 티커를 직접 돌림
+    FPJLinkDiscoveryStatus Status;
+    double LastTickTime = ScanStart;
+    while (FPlatformTime::Seconds() - ScanStart < ConnectTimeoutSeconds * 4.0 + 5.0)
+    {
+        FPlatformProcess::Sleep(0.005f);
+        const double Now = FPlatformTime::Seconds();
+        FTSTicker::GetCoreTicker().Tick(static_cast<float>(Now - LastTickTime));
+        LastTickTime = Now;
+
+        FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+        if (DiscoveryManager->GetDiscoveryStatus(DiscoveryID, Status) && Status.bIsComplete)
+        {
+            break;
+        }
+    }
+    const double Elapsed = FPlatformTime::Seconds() - ScanStart;
+
+    bool bSuccess = true;
+    if (!Status.bIsComplete || Status.bWasCancelled || Status.ScannedAddresses != 1022)
+    {
+        PJLINK_LOG_ERROR(TEXT("Range scan did not finish on its own: %d/1022 scanned"), Status.ScannedAddresses);
+        bSuccess = false;
+    }
+
+    // 주소마다 이벤트를 보내면 1022 개 이상, 게시 주기로 모으면 경과 시간 x 10 개 정도
+    const int32 MaxExpectedEvents = FMath::CeilToInt(Elapsed / 0.1) + 2;
+    if (Listener->ProgressEventCount == 0 || Listener->ProgressEventCount > MaxExpectedEvents
+        || Listener->ScanAddressEventCount > MaxExpectedEvents)
+    {
+        PJLINK_LOG_ERROR(TEXT("Expected 1..%d coalesced events, got %d progress and %d address events"),
+            MaxExpectedEvents, Listener->ProgressEventCount, Listener->ScanAddressEventCount);
+        bSuccess = false;
+    }
+
+    if (Listener->OffGameThreadEventCount != 0)
+    {
+        PJLINK_LOG_ERROR(TEXT("%d discovery events were raised off the game thread"), Listener->OffGameThreadEventCount);
+        bSuccess = false;
+    }
+
+    if (Listener->LastProgressPercentage < 100.0f)
+    {
+        PJLINK_LOG_ERROR(TEXT("Last progress event reported %.1f%%"), Listener->LastProgressPercentage);
+        bSuccess = false;
+    }
+
+    PJLINK_LOG_INFO(TEXT("Progress publishing: %d addresses in %.2f s, %d progress events, %d address events"),
+        Status.ScannedAddresses, Elapsed, Listener->ProgressEventCount, Listener->ScanAddressEventCount);
+
+    DiscoveryManager->OnDiscoveryProgress.RemoveAll(Listener);
+    DiscoveryManager->OnCurrentScanAddressChanged.RemoveAll(Listener);
+    DiscoveryManager->CancelAllDiscoveries();
+    return bSuccess;
+}
+
+
+bool UPJLinkTests::TestDiscoveryResultDedupe(int32 NumResults)
+{
+    PJLINK_LOG_INFO(TEXT("Running discovery result dedupe test (%d results)..."), NumResults);
+
+    bool bSuccess = true;
+
+    // IP 문자열 파서 경계 입력
+    struct FParseCase
+    {
+        const TCHAR* Text;
+        uint32 Expected;
+    };
+    const FParseCase ParseCases[] = {
+        { TEXT("192.168.0.10"), 0xC0A8000A },
+        { TEXT("0.0.0.1"), 0x00000001 },
+        { TEXT("255.255.255.255"), 0xFFFFFFFF },
+        { TEXT("256.1.1.1"), 0 },
+        { TEXT("1.2.3"), 0 },
+        { TEXT("1.2.3.4.5"), 0 },
+        { TEXT("1..3.4"), 0 },
+        { TEXT("1.2.3.4 "), 0 },
+        { TEXT("0001.2.3.4"), 0 },
+        { TEXT(""), 0 },
+    };
+    for (const FParseCase& Case : ParseCases)
+    {
+        const uint32 Parsed = UPJLinkDiscoveryManager::IPStringToUint32(Case.Text);
+        if (Parsed != Case.Expected)
+        {
+            PJLINK_LOG_ERROR(TEXT("IPStringToUint32('%s') = 0x%08X, expected 0x%08X"), Case.Text, Parsed, Case.Expected);
+            bSuccess = false;
+        }
+    }
+
+    UPJLinkDiscoveryManager* DiscoveryManager = NewObject<UPJLinkDiscoveryManager>();
+    const FString DiscoveryID = TEXT("DedupeTest");
+    {
+        FScopeLock Lock(&DiscoveryManager->DiscoveryLock);
+        FPJLinkDiscoveryStatus Status;
+        Status.DiscoveryID = DiscoveryID;
+        Status.TotalAddresses = NumResults;
+        DiscoveryManager->DiscoveryStatuses.Add(DiscoveryID, Status);
+        DiscoveryManager->DiscoveryResults.Add(DiscoveryID, FPJLinkDiscoveryResultSet());
+    }
+
+    // 10.0.0.0/8 안의 서로 다른 주소, 절반은 MAC 포함
+    auto MakeResult = [](int32 Index, bool bWithMac)
+    {
+        FPJLinkDiscoveryResult Result;
+        Result.IPv4 = 0x0A000000 | static_cast<uint32>(Index + 1);
+        if (bWithMac && (Index % 2) == 0)
+        {
+            Result.MacAddress = FString::Printf(TEXT("00:11:22:%02X:%02X:%02X"),
+                (Index >> 16) & 0xFF, (Index >> 8) & 0xFF, Index & 0xFF);
+        }
+        return Result;
+    };
+
+    // 앞/뒤 절반의 추가 시간을 비교 (선형 검색이면 뒤쪽 절반이 약 3배 느림)
+    const int32 HalfCount = NumResults / 2;
+    double FirstHalfSeconds = 0.0;
+    double SecondHalfSeconds = 0.0;
+    int32 AddedCount = 0;
+    double PhaseStart = FPlatformTime::Seconds();
+    for (int32 Index = 0; Index < NumResults; ++Index)
+    {
+        if (Index == HalfCount)
+        {
+            FirstHalfSeconds = FPlatformTime::Seconds() - PhaseStart;
+            PhaseStart = FPlatformTime::Seconds();
+        }
+        AddedCount += DiscoveryManager->AddDiscoveryResult(DiscoveryID, MakeResult(Index, true)) ? 1 : 0;
+    }
+    SecondHalfSeconds = FPlatformTime::Seconds() - PhaseStart;
+
+    if (AddedCount != NumResults)
+    {
+        PJLINK_LOG_ERROR(TEXT("Only %d of %d distinct results were added"), AddedCount, NumResults);
+        bSuccess = false;
+    }
+
+    // 같은 주소 재응답, 같은 MAC 을 가진 다른 주소 응답은 모두 거부
+    int32 DuplicateAccepted = 0;
+    for (int32 Index = 0; Index < NumResults; ++Index)
+    {
+        DuplicateAccepted += DiscoveryManager->AddDiscoveryResult(DiscoveryID, MakeResult(Index, false)) ? 1 : 0;
+
+        if ((Index % 2) == 0)
+        {
+            FPJLinkDiscoveryResult SameMac = MakeResult(Index, true);
+            SameMac.IPv4 = 0x0B000000 | static_cast<uint32>(Index + 1);
+            DuplicateAccepted += DiscoveryManager->AddDiscoveryResult(DiscoveryID, SameMac) ? 1 : 0;
+        }
+    }
+
+    // 문자열로 들어온 같은 주소도 같은 키로 취급
+    FPJLinkDiscoveryResult FromString;
+    FromString.IPAddress = TEXT("10.0.0.1");
+    DuplicateAccepted += DiscoveryManager->AddDiscoveryResult(DiscoveryID, FromString) ? 1 : 0;
+
+    if (DuplicateAccepted != 0)
+    {
+        PJLINK_LOG_ERROR(TEXT("%d duplicate results were accepted"), DuplicateAccepted);
+        bSuccess = false;
+    }
+
+    // 같은 주소라도 포트가 다르면 다른 장치
+    FPJLinkDiscoveryResult OtherPort = MakeResult(0, false);
+    OtherPort.Port = 4353;
+    if (!DiscoveryManager->AddDiscoveryResult(DiscoveryID, OtherPort))
+    {
+        PJLINK_LOG_ERROR(TEXT("Result on a different port was rejected as a duplicate"));
+        bSuccess = false;
+    }
+
+    const TArray<FPJLinkDiscoveryResult> Results = DiscoveryManager->GetDiscoveryResults(DiscoveryID);
+    if (Results.Num() != NumResults + 1 || Results[0].IPAddress != TEXT("10.0.0.1")
+        || Results.Last().IPAddress != TEXT("10.0.0.1") || Results.Last().Port != 4353)
+    {
+        PJLINK_LOG_ERROR(TEXT("Unexpected stored results: %d entries, first '%s'"),
+            Results.Num(), Results.Num() > 0 ? *Results[0].IPAddress : TEXT(""));
+        bSuccess = false;
+    }
+
+    // 여유를 두고 2배 이상 느려지면 결과 수에 비례하는 검색으로 판단
+    if (HalfCount > 0 && SecondHalfSeconds > FirstHalfSeconds * 2.0 + 0.005)
+    {
+        PJLINK_LOG_ERROR(TEXT("Dedupe cost grows with result count: first half %.2f ms, second half %.2f ms"),
+            FirstHalfSeconds * 1000.0, SecondHalfSeconds * 1000.0);
+        bSuccess = false;
+    }
+
+    PJLINK_LOG_INFO(TEXT("Result dedupe: %d results, first half %.2f ms, second half %.2f ms (%.2f us/result)"),
+        NumResults, FirstHalfSeconds * 1000.0, SecondHalfSeconds * 1000.0,
+        (FirstHalfSeconds + SecondHalfSeconds) * 1.0e6 / FMath::Max(1, NumResults));
+
+    {
+        FScopeLock Lock(&DiscoveryManager->DiscoveryLock);
+        DiscoveryManager->DiscoveryStatuses.Remove(DiscoveryID);
+        DiscoveryManager->DiscoveryResults.Remove(DiscoveryID);
+        DiscoveryManager->DirtyProgress.Remove(DiscoveryID);
+    }
+    return bSuccess;
+}
+
+
+bool UPJLinkTests::TestTwoPhaseScan(float ConnectTimeoutSeconds, float MinConnectTimeoutSeconds)
+{
+    using namespace PJLinkTestUtils;
+
+    PJLINK_LOG_INFO(TEXT("Running two-phase scan test (%.2f s connect cap, %.2f s floor)..."),
+        ConnectTimeoutSeconds, MinConnectTimeoutSeconds);
+
+    // 에뮬레이터 하나를 127.0.0.1 에서 스캔하고 보고된 응답과 통계를 돌려줌
+    auto ScanEmulator = [ConnectTimeoutSeconds, MinConnectTimeoutSeconds](FPJLinkTestProjector& Emulator,
+        TArray<FString>& OutResponses, FPJLinkScanStats& OutStats)
+    {
+        FCriticalSection FoundLock;
+
+        FPJLinkScanSettings Settings;
+        Settings.FirstIPv4 = LoopbackIPv4;
+        Settings.LastIPv4 = LoopbackIPv4 + 7;
+        Settings.Port = Emulator.GetPort();
+        Settings.ConnectTimeoutSeconds = ConnectTimeoutSeconds;
+        Settings.MinConnectTimeoutSeconds = MinConnectTimeoutSeconds;
+        Settings.MaxInFlight = 8;
+
+        FPJLinkScanCallbacks Callbacks;
+        Callbacks.OnHostFound = [&FoundLock, &OutResponses](uint32 IPv4, const FString& Response, int32 ResponseTimeMs)
+        {
+            FScopeLock Lock(&FoundLock);
+            OutResponses.Add(Response);
+        };
+
+        FPJLinkScanEngine Engine(Settings, MoveTemp(Callbacks));
+        if (!Engine.Start())
+        {
+            return false;
+        }
+        Engine.WaitForCompletion();
+        OutStats = Engine.GetStats();
+        return true;
+    };
+
+    bool bSuccess = true;
+
+    // 1) 인증 없는 장치: 인사말 뒤 조회 네 개를 한 연결로 보내고 응답 다섯 줄을 모두 받음
+    {
+        FPJLinkTestProjector Emulator(true);
+        if (!Emulator.Start())
+        {
+            PJLINK_LOG_ERROR(TEXT("Failed to start loopback emulator"));
+            return false;
+        }
+
+        TArray<FString> Responses;
+        FPJLinkScanStats Stats;
+        if (!ScanEmulator(Emulator, Responses, Stats))
+        {
+            PJLINK_LOG_ERROR(TEXT("Failed to start loopback scan"));
+            return false;
+        }
+
+        const FString Response = Responses.Num() == 1 ? Responses[0] : FString();
+        if (!Response.StartsWith(TEXT("PJLINK 0\r")) || !Response.Contains(TEXT("%1CLSS=1\r"))
+            || !Response.Contains(TEXT("%1NAME=Loopback Emulator\r")) || !Response.Contains(TEXT("%1INF1=PJLinkTest\r"))
+            || !Response.Contains(TEXT("%1INF2=Emulator\r")))
+        {
+            PJLINK_LOG_ERROR(TEXT("Expected one full handshake, got %d hosts (response '%s')"),
+                Responses.Num(), *Response.ReplaceCharWithEscapedChar());
+            bSuccess = false;
+        }
+
+        // 2단계는 연결된 호스트에만, 연결은 하나만
+        if (Stats.OpenHosts != 1 || Stats.FoundHosts != 1 || Emulator.GetAcceptedCount() != 1
+            || Emulator.GetReceivedCommandCount() != 4)
+        {
+            PJLINK_LOG_ERROR(TEXT("Expected 1 open host with 4 queries on 1 connection, got %d open, %d connections, %d queries"),
+                Stats.OpenHosts, Emulator.GetAcceptedCount(), Emulator.GetReceivedCommandCount());
+            bSuccess = false;
+        }
+
+        // 루프백 RTT 는 거의 0 이므로 연결 제한 시간은 하한까지 줄어야 함
+        if (FMath::Abs(Stats.ConnectTimeoutSeconds - MinConnectTimeoutSeconds) > 0.001
+            || Stats.SmoothedConnectRttSeconds > 0.05)
+        {
+            PJLINK_LOG_ERROR(TEXT("Connect timeout did not adapt: %.3f s (SRTT %.3f s)"),
+                Stats.ConnectTimeoutSeconds, Stats.SmoothedConnectRttSeconds);
+            bSuccess = false;
+        }
+
+        PJLINK_LOG_INFO(TEXT("Open device: handshake in one round trip, connect timeout %.0f ms (SRTT %.2f ms)"),
+            Stats.ConnectTimeoutSeconds * 1000.0, Stats.SmoothedConnectRttSeconds * 1000.0);
+        Emulator.StopEmulator();
+    }
+
+    // 2) 인증이 필요한 장치: 암호 없이 조회하면 끊기므로 인사말만 보고하고 명령은 보내지 않음
+    {
+        FPJLinkTestProjector Emulator(true);
+        Emulator.SetPassword(TEXT("secret"));
+        if (!Emulator.Start())
+        {
+            PJLINK_LOG_ERROR(TEXT("Failed to start authenticated emulator"));
+            return false;
+        }
+
+        TArray<FString> Responses;
+        FPJLinkScanStats Stats;
+        if (!ScanEmulator(Emulator, Responses, Stats))
+        {
+            PJLINK_LOG_ERROR(TEXT("Failed to start authenticated scan"));
+            return false;
+        }
+
+        if (Responses.Num() != 1 || !Responses[0].StartsWith(TEXT("PJLINK 1 ")))
+        {
+            PJLINK_LOG_ERROR(TEXT("Expected the authentication greeting only, got %d hosts"), Responses.Num());
+            bSuccess = false;
+        }
+
+        if (Emulator.GetReceivedCommandCount() != 0 || Emulator.GetAuthFailureCount() != 0)
+        {
+            PJLINK_LOG_ERROR(TEXT("Scanner queried an authenticated device: %d commands, %d auth failures"),
+                Emulator.GetReceivedCommandCount(), Emulator.GetAuthFailureCount());
+            bSuccess = false;
+        }
+        Emulator.StopEmulator();
+    }
+
+    return bSuccess;
+}
+
+
+bool UPJLinkTests::TestDiscoveryEnrichment(int32 NumDevices, int32 MaxConcurrent)
+{
+    using namespace PJLinkTestUtils;
+
+    NumDevices = FMath::Clamp(NumDevices, 1, 256);
+    MaxConcurrent = FMath::Clamp(MaxConcurrent, 1, NumDevices);
+
+    PJLINK_LOG_INFO(TEXT("Running discovery enrichment test (%d devices, %d concurrent)..."), NumDevices, MaxConcurrent);
+
+    // 조회가 모두 끝날 때까지 대기 (제한 시간 안에 끝나면 true)
+    auto WaitForIdle = [](const FPJLinkDiscoveryEnricher& Enricher, double TimeoutSeconds)
+    {
+        const double WaitStart = FPlatformTime::Seconds();
+        while (!Enricher.IsIdle())
+        {
+            if (FPlatformTime::Seconds() - WaitStart > TimeoutSeconds)
+            {
+                return false;
+            }
+            FPlatformProcess::SleepNoStats(0.005f);
+        }
+        return true;
+    };
+
+    bool bSuccess = true;
+
+    // 1) 스윕은 CLSS 만 조회하고, 넘겨받은 같은 연결로 식별 정보 네 개를 한 번에 조회
+    {
+        FPJLinkTestProjector Emulator(true);
+        if (!Emulator.Start())
+        {
+            PJLINK_LOG_ERROR(TEXT("Failed to start loopback emulator"));
+            return false;
+        }
+
+        FCriticalSection EventLock;
+        TArray<FString> HostResponses;
+        TArray<FString> EnrichedResponses;
+        int32 CompleteCount = 0;
+
+        FPJLinkEnrichmentCallbacks EnrichmentCallbacks;
+        EnrichmentCallbacks.OnDeviceEnriched = [&EventLock, &EnrichedResponses, &CompleteCount](uint32 IPv4, const FString& Response, bool bComplete)
+        {
+            FScopeLock Lock(&EventLock);
+            EnrichedResponses.Add(Response);
+            CompleteCount += bComplete ? 1 : 0;
+        };
+
+        TSharedPtr<FPJLinkDiscoveryEnricher, ESPMode::ThreadSafe> Enricher =
+            MakeShared<FPJLinkDiscoveryEnricher, ESPMode::ThreadSafe>(FPJLinkEnrichmentSettings(), MoveTemp(EnrichmentCallbacks));
+
+        FPJLinkScanSettings Settings;
+        Settings.FirstIPv4 = LoopbackIPv4;
+        Settings.LastIPv4 = LoopbackIPv4;
+        Settings.Port = Emulator.GetPort();
+        Settings.bQueryIdentity = false;
+
+        FPJLinkScanCallbacks Callbacks;
+        Callbacks.OnHostFound = [&EventLock, &HostResponses](uint32 IPv4, const FString& Response, int32 ResponseTimeMs)
+        {
+            FScopeLock Lock(&EventLock);
+            HostResponses.Add(Response);
+        };
+        Callbacks.OnAdoptConnection = [Enricher](uint32 IPv4, FNativeSocket Socket)
+        {
+            Enricher->AddConnectedDevice(IPv4, Socket);
+            return true;
+        };
+
+        {
+            FPJLinkScanEngine Engine(Settings, MoveTemp(Callbacks));
+            if (!Engine.Start())
+            {
+                PJLINK_LOG_ERROR(TEXT("Failed to start loopback scan"));
+                return false;
+            }
+            Engine.WaitForCompletion();
+        }
+
+        if (!WaitForIdle(*Enricher, 5.0))
+        {
+            PJLINK_LOG_ERROR(TEXT("Identity queries did not finish"));
+            bSuccess = false;
+        }
+
+        FScopeLock Lock(&EventLock);
+        const FString HostResponse = HostResponses.Num() == 1 ? HostResponses[0] : FString();
+        if (!HostResponse.Contains(TEXT("%1CLSS=1\r")) || HostResponse.Contains(TEXT("%1NAME=")))
+        {
+            PJLINK_LOG_ERROR(TEXT("Sweep should report the class only, got %d hosts (response '%s')"),
+                HostResponses.Num(), *HostResponse.ReplaceCharWithEscapedChar());
+            bSuccess = false;
+        }
+
+        const FString Enriched = EnrichedResponses.Num() == 1 ? EnrichedResponses[0] : FString();
+        if (CompleteCount != 1 || !Enriched.Contains(TEXT("%1NAME=Loopback Emulator\r"))
+            || !Enriched.Contains(TEXT("%1INF1=PJLinkTest\r")) || !Enriched.Contains(TEXT("%1INF2=Emulator\r"))
+            || !Enriched.Contains(TEXT("%1INFO=Test Build\r")))
+        {
+            PJLINK_LOG_ERROR(TEXT("Expected one complete identity response, got %d (response '%s')"),
+                EnrichedResponses.Num(), *Enriched.ReplaceCharWithEscapedChar());
+            bSuccess = false;
+        }
+
+        // 스윕의 CLSS 하나 + 조회 네 개가 모두 한 연결로 감
+        if (Emulator.GetAcceptedCount() != 1 || Emulator.GetReceivedCommandCount() != 1 + FPJLinkDiscoveryEnricher::NumIdentityQueries)
+        {
+            PJLINK_LOG_ERROR(TEXT("Expected 5 queries on 1 connection, got %d queries on %d connections"),
+                Emulator.GetReceivedCommandCount(), Emulator.GetAcceptedCount());
+            bSuccess = false;
+        }
+
+        Enricher->Cancel();
+        Emulator.StopEmulator();
+    }
+
+    // 2) 넘겨받은 연결이 많아도 동시에 조회하는 장치 수는 MaxConcurrent 로 제한
+    {
+        uint16 Port = 0;
+        FNativeSocket Listener = CreateLoopbackListener(Port, NumDevices);
+        if (Listener == InvalidSocket)
+        {
+            PJLINK_LOG_ERROR(TEXT("Failed to create loopback listener"));
+            return false;
+        }
+
+        TArray<FNativeSocket> ClientSockets;
+        TArray<FNativeSocket> ServerSockets;
+        for (int32 Index = 0; Index < NumDevices; ++Index)
+        {
+            FNativeSocket Client = InvalidSocket;
+            FNativeSocket Server = InvalidSocket;
+            if (!CreateLoopbackPair(Listener, Port, Client, Server))
+            {
+                break;
+            }
+            ClientSockets.Add(Client);
+            ServerSockets.Add(Server);
+        }
+
+        if (ClientSockets.Num() != NumDevices)
+        {
+            PJLINK_LOG_ERROR(TEXT("Only %d of %d loopback connections were created"), ClientSockets.Num(), NumDevices);
+            for (FNativeSocket Socket : ClientSockets)
+            {
+                Close(Socket);
+            }
+            for (FNativeSocket Socket : ServerSockets)
+            {
+                Close(Socket);
+            }
+            Close(Listener);
+            return false;
+        }
+
+        TAtomic<int32> CompleteCount(0);
+        FPJLinkEnrichmentCallbacks EnrichmentCallbacks;
+        EnrichmentCallbacks.OnDeviceEnriched = [&CompleteCount](uint32 IPv4, const FString& Response, bool bComplete)
+        {
+            CompleteCount += bComplete ? 1 : 0;
+        };
+
+        FPJLinkEnrichmentSettings Settings;
+        Settings.MaxConcurrent = MaxConcurrent;
+        Settings.ResponseTimeoutSeconds = 5.0;
+
+        TSharedPtr<FPJLinkDiscoveryEnricher, ESPMode::ThreadSafe> Enricher =
+            MakeShared<FPJLinkDiscoveryEnricher, ESPMode::ThreadSafe>(Settings, MoveTemp(EnrichmentCallbacks));
+
+        // 주소는 결과를 구분하는 키일 뿐이므로 서로 다른 가짜 주소로 넘김
+        for (int32 Index = 0; Index < NumDevices; ++Index)
+        {
+            Enricher->AddConnectedDevice(0x0A000001 + Index, ClientSockets[Index]);
+        }
+
+        // 아직 아무도 응답하지 않았으므로 MaxConcurrent 개만 조회 중
+        const FPJLinkEnrichmentStats BeforeStats = Enricher->GetStats();
+        if (BeforeStats.ActiveDevices != MaxConcurrent || BeforeStats.QueuedDevices != NumDevices - MaxConcurrent)
+        {
+            PJLINK_LOG_ERROR(TEXT("Expected %d active and %d queued devices, got %d active and %d queued"),
+                MaxConcurrent, NumDevices - MaxConcurrent, BeforeStats.ActiveDevices, BeforeStats.QueuedDevices);
+            bSuccess = false;
+        }
+
+        // 조회를 받은 연결에만 응답 (응답한 자리에 다음 장치가 들어옴)
+        const ANSICHAR IdentityResponse[] = "%1NAME=Enriched\r%1INF1=Vendor\r%1INF2=Model\r%1INFO=Info\r";
+        TArray<bool> Answered;
+        Answered.Init(false, NumDevices);
+        int32 MaxQueriedAtOnce = 0;
+        uint8 Buffer[256];
+
+        const double WaitStart = FPlatformTime::Seconds();
+        while (!Enricher->IsIdle() && FPlatformTime::Seconds() - WaitStart < 10.0)
+        {
+            TArray<int32> Queried;
+            for (int32 Index = 0; Index < NumDevices; ++Index)
+            {
+                int32 BytesRead = 0;
+                if (!Answered[Index] && Recv(ServerSockets[Index], Buffer, sizeof(Buffer), BytesRead) == EIOResult::Ok)
+                {
+                    Queried.Add(Index);
+                }
+            }
+
+            MaxQueriedAtOnce = FMath::Max(MaxQueriedAtOnce, Queried.Num());
+            for (int32 Index : Queried)
+            {
+                int32 BytesSent = 0;
+                PJLinkSocketPlatform::Send(ServerSockets[Index], reinterpret_cast<const uint8*>(IdentityResponse),
+                    sizeof(IdentityResponse) - 1, BytesSent);
+                Answered[Index] = true;
+            }
+            FPlatformProcess::SleepNoStats(0.005f);
+        }
+
+        const FPJLinkEnrichmentStats Stats = Enricher->GetStats();
+        if (!Enricher->IsIdle() || CompleteCount.load() != NumDevices || Stats.EnrichedDevices != NumDevices)
+        {
+            PJLINK_LOG_ERROR(TEXT("Expected %d enriched devices, got %d (%d reported, %d failed)"),
+                NumDevices, Stats.EnrichedDevices, CompleteCount.load(), Stats.FailedDevices);
+            bSuccess = false;
+        }
+
+        if (Stats.PeakActiveDevices != MaxConcurrent || MaxQueriedAtOnce > MaxConcurrent)
+        {
+            PJLINK_LOG_ERROR(TEXT("Concurrency exceeded %d: peak %d active, %d queried at once"),
+                MaxConcurrent, Stats.PeakActiveDevices, MaxQueriedAtOnce);
+            bSuccess = false;
+        }
+
+        if (Stats.DevicesPerSecond <= 0.0 || Stats.AverageLatencyMs <= 0.0 || Stats.BusySeconds <= 0.0)
+        {
+            PJLINK_LOG_ERROR(TEXT("Enrichment throughput was not reported"));
+            bSuccess = false;
+        }
+
+        PJLINK_LOG_INFO(TEXT("Enrichment: %d devices, peak %d concurrent, %.1f devices/s, %.2f ms average"),
+            Stats.EnrichedDevices, Stats.PeakActiveDevices, Stats.DevicesPerSecond, Stats.AverageLatencyMs);
+
+        Enricher->Cancel();
+        for (FNativeSocket Socket : ServerSockets)
+        {
+            Close(Socket);
+        }
+        Close(Listener);
+    }
+
+    return bSuccess;
+}
+
+
+bool UPJLinkTests::TestSubnetRttTimeouts()
+{
+    PJLINK_LOG_INFO(TEXT("Running per-subnet RTT timeout test..."));
+
+    // 10.0.0.0/24 (LAN), 10.0.1.0/24 (라우터 너머), 10.0.2.0/24 (응답 없음) - 시작하지 않고 추정만 확인
+    const uint32 FastSubnet = 0x0A000000;
+    const uint32 SlowSubnet = 0x0A000100;
+    const uint32 SilentSubnet = 0x0A000200;
+
+    FPJLinkScanSettings Settings;
+    Settings.FirstIPv4 = FastSubnet;
+    Settings.LastIPv4 = SilentSubnet + 255;
+    Settings.ConnectTimeoutSeconds = 2.0;
+    Settings.MinConnectTimeoutSeconds = 0.05;
+    Settings.RetryTimeoutMultiplier = 2.0;
+
+    FPJLinkScanEngine Engine(Settings, FPJLinkScanCallbacks());
+
+    for (uint32 HostIndex = 1; HostIndex <= 16; ++HostIndex)
+    {
+        Engine.AddConnectRttSample(FastSubnet + HostIndex, 0.005);
+        Engine.AddConnectRttSample(SlowSubnet + HostIndex, 0.3 + (HostIndex % 2) * 0.05);
+    }
+
+    bool bSuccess = true;
+
+    const double FastTimeout = Engine.GetConnectTimeoutSeconds(FastSubnet + 200);
+    const double SlowTimeout = Engine.GetConnectTimeoutSeconds(SlowSubnet + 200);
+    const double SilentTimeout = Engine.GetConnectTimeoutSeconds(SilentSubnet + 200);
+    PJLINK_LOG_INFO(TEXT("Connect timeouts: fast %.0f ms, slow %.0f ms, silent %.0f ms"),
+        FastTimeout * 1000.0, SlowTimeout * 1000.0, SilentTimeout * 1000.0);
+
+    // 느린 /24 의 표본이 빠른 /24 의 제한 시간을 늘리면 안 됨
+    if (FMath::Abs(FastTimeout - Settings.MinConnectTimeoutSeconds) > 0.001)
+    {
+        PJLINK_LOG_ERROR(TEXT("Fast subnet should use the floor, got %.3f s"), FastTimeout);
+        bSuccess = false;
+    }
+
+    if (SlowTimeout <= 0.3 || SlowTimeout >= Settings.ConnectTimeoutSeconds)
+    {
+        PJLINK_LOG_ERROR(TEXT("Slow subnet timeout should sit between its RTT and the cap, got %.3f s"), SlowTimeout);
+        bSuccess = false;
+    }
+
+    if (FMath::Abs(SilentTimeout - Settings.ConnectTimeoutSeconds) > 0.001)
+    {
+        PJLINK_LOG_ERROR(TEXT("Subnet without samples should use the cap, got %.3f s"), SilentTimeout);
+        bSuccess = false;
+    }
+
+    const FPJLinkScanStats Stats = Engine.GetStats();
+    if (Stats.RttSubnets != 2)
+    {
+        PJLINK_LOG_ERROR(TEXT("Expected RTT estimates for 2 subnets, got %d"), Stats.RttSubnets);
+        bSuccess = false;
+    }
+
+    // 줄인 제한 시간으로 놓친 호스트는 두 배 제한 시간으로 재시도, 상한을 다 기다린 호스트는 재시도 안 함
+    FPJLinkScanEngine::FRetryTarget Retry;
+    if (!Engine.QueueRetry(FastSubnet + 7, FastTimeout) || !Engine.ClaimRetry(Retry)
+        || Retry.IPv4 != FastSubnet + 7 || FMath::Abs(Retry.ConnectTimeoutSeconds - FastTimeout * 2.0) > 0.001)
+    {
+        PJLINK_LOG_ERROR(TEXT("Host timed out at the floor was not queued for a longer retry"));
+        bSuccess = false;
+    }
+
+    if (Engine.QueueRetry(SilentSubnet + 7, SilentTimeout) || Engine.ClaimRetry(Retry))
+    {
+        PJLINK_LOG_ERROR(TEXT("Host timed out at the cap should not be retried"));
+        bSuccess = false;
+    }
+
+    if (Engine.GetStats().RetriedHosts != 1)
+    {
+        PJLINK_LOG_ERROR(TEXT("Expected 1 retried host, got %d"), Engine.GetStats().RetriedHosts);
+        bSuccess = false;
+    }
+
+    PJLINK_LOG_INFO(TEXT("Per-subnet RTT timeout test %s"), bSuccess ? TEXT("passed") : TEXT("failed"));
+    return bSuccess;
+}
+
+
+bool UPJLinkTests::TestKnownHostsRescan()
+{
+    using namespace PJLinkTestUtils;
+
+    PJLINK_LOG_INFO(TEXT("Running known hosts rescan test..."));
+
+    bool bSuccess = true;
+    const FString Directory = FPaths::ProjectSavedDir() / TEXT("PJLink") / TEXT("Tests")
+        / FString::Printf(TEXT("KnownHosts-%s"), *FGuid::NewGuid().ToString());
+
+    auto MakeDevice = [](const TCHAR* IPAddress, const TCHAR* Name, int32 ResponseTimeMs)
+    {
+        FPJLinkDiscoveryResult Device;
+        Device.IPAddress = IPAddress;
+        Device.IPv4 = UPJLinkDiscoveryManager::IPStringToUint32(Device.IPAddress);
+        Device.Port = 4352;
+        Device.Name = Name;
+        Device.ModelName = TEXT("Emulator");
+        Device.Manufacturer = TEXT("PJLinkTest");
+        Device.ResponseTimeMs = ResponseTimeMs;
+        Device.DiscoveryTime = FDateTime::Now();
+        Device.bIdentityQueried = true;
+        return Device;
+    };
+
+    const FPJLinkDiscoveryResult DeviceA = MakeDevice(TEXT("10.20.1.5"), TEXT("Hall A"), 3);
+    const FPJLinkDiscoveryResult DeviceB = MakeDevice(TEXT("10.20.1.200"), TEXT("Hall B"), 12);
+    const FPJLinkDiscoveryResult DeviceC = MakeDevice(TEXT("10.20.2.7"), TEXT("Lobby"), 40);
+
+    // 1) 두 /24 에 기록하고 저장
+    {
+        FPJLinkKnownHostsIndex Index(Directory);
+        Index.RecordSeen(DeviceA);
+        Index.RecordSeen(DeviceB);
+        Index.RecordSeen(DeviceC);
+        if (!Index.Save())
+        {
+            PJLINK_LOG_ERROR(TEXT("Failed to save known hosts to %s"), *Directory);
+            bSuccess = false;
+        }
+    }
+
+    // 2) 새 색인 객체에서 범위별로 다시 읽음
+    {
+        FPJLinkKnownHostsIndex Index(Directory);
+
+        TArray<FPJLinkKnownHost> Hosts;
+        Index.FindHostsInRange(DeviceA.IPv4 & 0xFFFFFF00, DeviceA.IPv4 | 0xFF, 4352, Hosts);
+        if (Hosts.Num() != 2 || Hosts[0].Device.IPv4 != DeviceA.IPv4 || Hosts[1].Device.IPv4 != DeviceB.IPv4
+            || Hosts[1].Device.Name != DeviceB.Name || Hosts[1].Device.ResponseTimeMs != DeviceB.ResponseTimeMs
+            || FMath::Abs((Hosts[1].Device.DiscoveryTime - DeviceB.DiscoveryTime).GetTotalSeconds()) > 1.0)
+        {
+            PJLINK_LOG_ERROR(TEXT("Expected 2 hosts in 10.20.1.0/24 with the saved identity, got %d"), Hosts.Num());
+            bSuccess = false;
+        }
+
+        // 두 /24 에 걸친 범위, 다른 포트
+        Index.FindHostsInRange(DeviceB.IPv4, DeviceC.IPv4, 4352, Hosts);
+        const int32 SpanningHosts = Hosts.Num();
+        Index.FindHostsInRange(DeviceA.IPv4, DeviceC.IPv4, 4353, Hosts);
+        if (SpanningHosts != 2 || Hosts.Num() != 0)
+        {
+            PJLINK_LOG_ERROR(TEXT("Expected 2 hosts across two /24s and none on another port, got %d and %d"),
+                SpanningHosts, Hosts.Num());
+            bSuccess = false;
+        }
+
+        // 조회하지 못한 항목(빈 값)은 변경으로 보지 않고, 이름이 바뀌면 변경
+        FPJLinkDiscoveryResult Partial = DeviceA;
+        Partial.Name.Empty();
+        FPJLinkDiscoveryResult Renamed = DeviceA;
+        Renamed.Name = TEXT("Hall A (renamed)");
+        if (FPJLinkKnownHostsIndex::HasIdentityChanged(DeviceA, Partial)
+            || !FPJLinkKnownHostsIndex::HasIdentityChanged(DeviceA, Renamed))
+        {
+            PJLINK_LOG_ERROR(TEXT("Identity change detection is wrong"));
+            bSuccess = false;
+        }
+
+        // 연속 미응답은 MaxMissedScans 번째에 제거되고, 그 사이 응답하면 다시 처음부터 셈
+        Index.RecordMissed(DeviceB.IPv4, 4352);
+        Index.RecordSeen(DeviceB);
+        bool bRemoved = false;
+        int32 Misses = 0;
+        while (!bRemoved && Misses < FPJLinkKnownHostsIndex::MaxMissedScans + 1)
+        {
+            bRemoved = Index.RecordMissed(DeviceB.IPv4, 4352);
+            Misses++;
+        }
+        if (!bRemoved || Misses != FPJLinkKnownHostsIndex::MaxMissedScans || Index.FindHost(DeviceB.IPv4, 4352))
+        {
+            PJLINK_LOG_ERROR(TEXT("Expected removal after %d misses, got %d (removed: %s)"),
+                FPJLinkKnownHostsIndex::MaxMissedScans, Misses, bRemoved ? TEXT("true") : TEXT("false"));
+            bSuccess = false;
+        }
+        Index.Save();
+    }
+
+    // 3) 제거가 저장되었는지
+    {
+        FPJLinkKnownHostsIndex Index(Directory);
+        TArray<FPJLinkKnownHost> Hosts;
+        Index.FindHostsInRange(DeviceA.IPv4, DeviceC.IPv4, 4352, Hosts);
+        if (Hosts.Num() != 2 || Index.FindHost(DeviceB.IPv4, 4352))
+        {
+            PJLINK_LOG_ERROR(TEXT("Expected 2 hosts after pruning, got %d"), Hosts.Num());
+            bSuccess = false;
+        }
+        Index.Clear();
+    }
+    IFileManager::Get().DeleteDirectory(*Directory, false, true);
+
+    // 4) 스캔 엔진: 대상 목록만 확인하고, 제외 목록은 연결 없이 스캔한 주소로 셈
+    FPJLinkTestProjector Emulator(true);
+    if (!Emulator.Start())
+    {
+        PJLINK_LOG_ERROR(TEXT("Failed to start loopback emulator"));
+        return false;
+    }
+
+    auto ScanEmulator = [&Emulator](const TArray<uint32>& Targets, const TArray<uint32>& Excluded, FPJLinkScanStats& OutStats)
+    {
+        FPJLinkScanSettings Settings;
+        Settings.FirstIPv4 = LoopbackIPv4;
+        Settings.LastIPv4 = LoopbackIPv4 + 7;
+        Settings.Port = Emulator.GetPort();
+        Settings.MaxInFlight = 8;
+        Settings.TargetIPv4s = Targets;
+        Settings.ExcludedIPv4s = Excluded;
+
+        FPJLinkScanEngine Engine(Settings, FPJLinkScanCallbacks());
+        if (!Engine.Start())
+        {
+            return false;
+        }
+        Engine.WaitForCompletion();
+        OutStats = Engine.GetStats();
+        return true;
+    };
+
+    FPJLinkScanStats TargetStats;
+    FPJLinkScanStats ExcludedStats;
+    if (!ScanEmulator({ LoopbackIPv4 }, {}, TargetStats) || !ScanEmulator({}, { LoopbackIPv4 }, ExcludedStats))
+    {
+        PJLINK_LOG_ERROR(TEXT("Failed to start loopback scan"));
+        Emulator.StopEmulator();
+        return false;
+    }
+
+    if (TargetStats.TotalAddresses != 1 || TargetStats.ScannedAddresses != 1 || TargetStats.FoundHosts != 1)
+    {
+        PJLINK_LOG_ERROR(TEXT("Target scan: expected 1 of 1 address with 1 host, got %d of %d with %d"),
+            TargetStats.ScannedAddresses, TargetStats.TotalAddresses, TargetStats.FoundHosts);
+        bSuccess = false;
+    }
+
+    if (ExcludedStats.TotalAddresses != 8 || ExcludedStats.ScannedAddresses != 8 || ExcludedStats.FoundHosts != 0
+        || Emulator.GetAcceptedCount() != 1)
+    {
+        PJLINK_LOG_ERROR(TEXT("Excluded scan: expected 8 of 8 addresses with no host, got %d of %d with %d (%d connections)"),
+            ExcludedStats.ScannedAddresses, ExcludedStats.TotalAddresses, ExcludedStats.FoundHosts,
+            Emulator.GetAcceptedCount());
+        bSuccess = false;
+    }
+    Emulator.StopEmulator();
+
+    PJLINK_LOG_INFO(TEXT("Known hosts rescan test %s"), bSuccess ? TEXT("passed") : TEXT("failed"));
+    return bSuccess;
+}
+
+
+bool UPJLinkTests::TestInFlightWindowOverflow(int32 NumOverflow)
+{
+    using namespace PJLinkTestUtils;
+
+    NumOverflow = FMath::Clamp(NumOverflow, 1, UPJLinkNetworkManager::MaxInFlightCommands);
+    PJLINK_LOG_INFO(TEXT("Starting in-flight window overflow test (%d over the limit)"), NumOverflow);
+
+    // INF2 에는 응답하지 않는 에뮬레이터 - 보낸 INF2 는 모두 창에 남음
+    FPJLinkTestProjector Emulator(true);
+    Emulator.SetSilentCommand(TEXT("INF2"));
+    if (!Emulator.Start())
+    {
+        PJLINK_LOG_ERROR(TEXT("Failed to start projector emulator"));
+        return false;
+    }
+
+    UPJLinkNetworkManager* NetworkManager = NewObject<UPJLinkNetworkManager>();
+    NetworkManager->bAutoReconnect = false;
+    if (!NetworkManager->ConnectToProjector(Emulator.MakeProjectorInfo(), 2.0f))
+    {
+        PJLINK_LOG_ERROR(TEXT("Failed to connect to projector emulator"));
+        return false;
+    }
+
+    // 연결 직후 상태 요청이 끝날 때까지 대기 (응답 없는 INF2 1개는 남을 수 있음)
+    const double WaitStart = FPlatformTime::Seconds();
+    while (NetworkManager->GetInFlightCommandCount() > 1 && FPlatformTime::Seconds() - WaitStart < 2.0)
+    {
+        FPlatformProcess::SleepNoStats(0.0f);
+    }
+    NetworkManager->EventQueue.Discard();
+
+    // 창보다 NumOverflow 개 더 보냄 - 앞선 항목(상태 요청의 INF2 포함)부터 밀려남
+    const int32 NumCommands = UPJLinkNetworkManager::MaxInFlightCommands + NumOverflow;
+    TArray<int32> Sent;
+    for (int32 Index = 0; Index < NumCommands; ++Index)
+    {
+        const int32 SequenceId = NetworkManager->SendCommandWithSequence(EPJLinkCommand::INF2, TEXT("?"), 0.0f);
+        if (SequenceId == 0)
+        {
+            PJLINK_LOG_ERROR(TEXT("SendCommandWithSequence failed at %d"), Index);
+            NetworkManager->DisconnectFromProjector();
+            Emulator.StopEmulator();
+            return false;
+        }
+        Sent.Add(SequenceId);
+    }
+
+    const int32 InFlight = NetworkManager->GetInFlightCommandCount();
+
+    // 이번에 보낸 순번의 완료 수집 (같은 순번이 두 번 오면 실패)
+    TMap<int32, EPJLinkResponseStatus> Completions;
+    bool bDuplicate = false;
+    auto CollectCompletions = [&]()
+    {
+        NetworkManager->EventQueue.Drain([&](const FPJLinkEvent& Event)
+        {
+            if (Event.Type != EPJLinkEventType::Response || !Sent.Contains(Event.SequenceId))
+            {
+                return;
+            }
+
+            bDuplicate |= Completions.Contains(Event.SequenceId);
+            Completions.Add(Event.SequenceId, Event.Status);
+        });
+    };
+    CollectCompletions();
+
+    // 밀려난 것은 앞의 NumOverflow 개뿐이고, 각각 응답 없음으로 한 번씩 완료되어야 함
+    bool bDroppedReported = true;
+    for (int32 Index = 0; Index < Sent.Num(); ++Index)
+    {
+        const EPJLinkResponseStatus* Status = Completions.Find(Sent[Index]);
+        if (Index < NumOverflow)
+        {
+            bDroppedReported &= Status && *Status == EPJLinkResponseStatus::NoResponse;
+        }
+        else
+        {
+            bDroppedReported &= Status == nullptr;
+        }
+    }
+    const int32 DroppedCompletions = Completions.Num();
+
+    // 프로젝터 쪽에서 연결을 끊으면 창에 남은 명령도 모두 응답 없음으로 한 번씩 완료되어야 함
+    Emulator.StopEmulator();
+    const double CloseStart = FPlatformTime::Seconds();
+    while ((NetworkManager->IsConnected() || NetworkManager->GetInFlightCommandCount() > 0)
+        && FPlatformTime::Seconds() - CloseStart < 2.0)
+    {
+        FPlatformProcess::SleepNoStats(0.001f);
+    }
+    const bool bClosed = !NetworkManager->IsConnected();
+
+    NetworkManager->DisconnectFromProjector();
+    CollectCompletions();
+
+    bool bClosedReported = true;
+    for (const int32 SequenceId : Sent)
+    {
+        const EPJLinkResponseStatus* Status = Completions.Find(SequenceId);
+        bClosedReported &= Status && *Status == EPJLinkResponseStatus::NoResponse;
+    }
+
+    PJLINK_LOG_INFO(TEXT("Sent %d commands: %d still in flight, %d completed as dropped, %d completed after the connection closed"),
+        NumCommands, InFlight, DroppedCompletions, Completions.Num() - DroppedCompletions);
+
+    const bool bSuccess = InFlight == UPJLinkNetworkManager::MaxInFlightCommands
+        && DroppedCompletions == NumOverflow && bDroppedReported
+        && bClosed && Completions.Num() == NumCommands && bClosedReported && !bDuplicate;
+    if (!bSuccess)
+    {
+        PJLINK_LOG_ERROR(TEXT("In-flight window overflow failed (in flight %d, dropped %d, closed %d, completions %d of %d, duplicate %d)"),
+            InFlight, DroppedCompletions, bClosed, Completions.Num(), NumCommands, bDuplicate);
+    }
+    return bSuccess;
+}
+
+
+bool UPJLinkTests::TestSharedEventDrainBudget(int32 NumManagers, int32 EventsPerManager, float BudgetMicroseconds)
+{
+    NumManagers = FMath::Clamp(NumManagers, 2, 1000);
+    EventsPerManager = FMath::Clamp(EventsPerManager, 10, 1000000);
+    BudgetMicroseconds = FMath::Clamp(BudgetMicroseconds, 10.0f, 100000.0f);
+    PJLINK_LOG_INFO(TEXT("Starting shared event drain budget test (%d managers x %d events, %.0f us budget)"),
+        NumManagers, EventsPerManager, BudgetMicroseconds);
+
+    FPJLinkEventDrainScheduler& Scheduler = FPJLinkEventDrainScheduler::Get();
+    const float PreviousBudget = Scheduler.GetFrameBudgetMicroseconds();
+    Scheduler.SetFrameBudgetMicroseconds(BudgetMicroseconds);
+
+    // 많은 프로젝터의 응답이 한꺼번에 도착한 상황
+    TArray<UPJLinkNetworkManager*> Managers;
+    for (int32 ManagerIndex = 0; ManagerIndex < NumManagers; ++ManagerIndex)
+    {
+        UPJLinkNetworkManager* NetworkManager = NewObject<UPJLinkNetworkManager>();
+        NetworkManager->bAutoReconnect = false;
+        for (int32 Index = 0; Index < EventsPerManager; ++Index)
+        {
+            NetworkManager->EventQueue.Enqueue([Index](FPJLinkEvent& Event)
+            {
+                Event.Type = EPJLinkEventType::Response;
+                Event.Command = EPJLinkCommand::POWR;
+                Event.Status = EPJLinkResponseStatus::Success;
+                Event.SequenceId = Index + 1;
+                Event.Text.Append(TEXT("1"));
+            });
+        }
+        Managers.Add(NetworkManager);
+    }
+
+    // 새 프레임 시작으로 보고 모든 매니저가 같은 프레임에 처리를 예약 (게임 스레드 작업이 한꺼번에 실행된 경우)
+    Scheduler.FrameNumber = GFrameCounter;
+    Scheduler.FrameDrainSeconds = 0.0;
+    const double BurstStart = FPlatformTime::Seconds();
+    for (UPJLinkNetworkManager* NetworkManager : Managers)
+    {
+        Scheduler.Schedule(NetworkManager);
+    }
+    const double BurstFrameUs = (FPlatformTime::Seconds() - BurstStart) * 1.0e6;
+
+    // 이후 프레임마다 공유 예산 안에서 처리
+    const int32 TotalEvents = NumManagers * EventsPerManager;
+    TArray<double> FrameMicroseconds;
+    int32 FramesUntilAllServed = 0;
+    int32 Frames = 0;
+    while (Scheduler.GetNumPendingManagers() > 0 && Frames < TotalEvents)
+    {
+        Scheduler.FrameDrainSeconds = 0.0;
+        FrameMicroseconds.Add(Scheduler.DrainFrame() * 1.0e6);
+        ++Frames;
+
+        // 모든 매니저가 한 번 이상 처리되기까지 걸린 프레임 수 (돌아가며 처리하는지 확인)
+        if (FramesUntilAllServed == 0 && Managers.FindByPredicate([](const UPJLinkNetworkManager* NetworkManager)
+            {
+                return NetworkManager->EventStats.EventsDispatched == 0;
+            }) == nullptr)
+        {
+            FramesUntilAllServed = Frames;
+        }
+    }
+
+    int64 Dispatched = 0;
+    for (UPJLinkNetworkManager* NetworkManager : Managers)
+    {
+        Dispatched += NetworkManager->GetEventQueueStats().EventsDispatched;
+    }
+
+    FrameMicroseconds.Sort();
+    const double P95Us = FrameMicroseconds.Num() > 0
+        ? FrameMicroseconds[FMath::Min(FrameMicroseconds.Num() - 1, FrameMicroseconds.Num() * 95 / 100)] : 0.0;
+    const double MaxUs = FrameMicroseconds.Num() > 0 ? FrameMicroseconds.Last() : 0.0;
+
+    PJLINK_LOG_INFO(TEXT("Shared drain: burst frame %.1f us (per-manager budgets would allow %.0f us), %d frames, p95 %.1f us, max %.1f us, all managers served after %d frames"),
+        BurstFrameUs, BudgetMicroseconds * NumManagers, Frames, P95Us, MaxUs, FramesUntilAllServed);
+
+    // 예산과 묶음 하나의 오차 이내 (스케줄링 잡음을 고려해 이후 프레임은 p95 로 판정)
+    bool bSuccess = Dispatched == TotalEvents && Scheduler.GetNumPendingManagers() == 0;
+    if (BurstFrameUs > BudgetMicroseconds * 1.5 + 50.0)
+    {
+        PJLINK_LOG_ERROR(TEXT("Burst frame exceeded the shared budget: %.1f us for %.0f us"), BurstFrameUs, BudgetMicroseconds);
+        bSuccess = false;
+    }
+    if (P95Us > BudgetMicroseconds * 1.5 + 20.0)
+    {
+        PJLINK_LOG_ERROR(TEXT("Drain exceeded the shared budget: p95 %.1f us for %.0f us"), P95Us, BudgetMicroseconds);
+        bSuccess = false;
+    }
+    // 프레임마다 멈춘 자리 다음 매니저부터 이어 가므로 매니저 수만큼의 프레임 안에 모두 한 번은 처리되어야 함
+    if (FramesUntilAllServed == 0 || FramesUntilAllServed > NumManagers)
+    {
+        PJLINK_LOG_ERROR(TEXT("Managers were not served round-robin (all served after %d frames)"), FramesUntilAllServed);
+        bSuccess = false;
+    }
+    if (Dispatched != TotalEvents)
+    {
+        PJLINK_LOG_ERROR(TEXT("Dispatched %lld of %d events"), Dispatched, TotalEvents);
+    }
+
+    for (UPJLinkNetworkManager* NetworkManager : Managers)
+    {
+        NetworkManager->Shutdown();
+    }
+    Scheduler.SetFrameBudgetMicroseconds(PreviousBudget);
+    return bSuccess;
+}
@@ -0,0 +1,248 @@
+﻿// PJLinkTimingWheel.cpp
+#include "PJLinkTimingWheel.h"
+
+FPJLinkTimingWheel::FPJLinkTimingWheel(double InTickSeconds, double StartSeconds)
+    : CurrentTick(0)
+    , OriginSeconds(StartSeconds)
+    , TickSeconds(FMath::Max(InTickSeconds, 0.0001))
+{
+    for (int32& Head : SlotHeads)
+    {
+        Head = INDEX_NONE;
+    }
+    for (uint64& Occupied : OccupiedSlots)
+    {
+        Occupied = 0;
+    }
+}
+
+uint64 FPJLinkTimingWheel::DeadlineToTick(double Seconds) const
+{
+    const double Ticks = FMath::CeilToDouble((Seconds - OriginSeconds) / TickSeconds);
+    return Ticks > 0.0 ? static_cast<uint64>(Ticks) : 0;
+}
+
+uint64 FPJLinkTimingWheel::NowToTick(double Seconds) const
+{
+    const double Ticks = FMath::FloorToDouble((Seconds - OriginSeconds) / TickSeconds);
+    return Ticks > 0.0 ? static_cast<uint64>(Ticks) : 0;
+}
+
+void FPJLinkTimingWheel::Schedule(FPJLinkTimerId TimerId, double DeadlineSeconds, FCallback&& Callback)
+{
+    // 같은 식별자로 다시 예약하면 이전 예약을 대체
+    Cancel(TimerId);
+
+    const int32 NodeIndex = AllocateNode();
+    FNode& Node = Nodes[NodeIndex];
+    Node.TimerId = TimerId;
+    Node.Callback = MoveTemp(Callback);
+
+    // 현재 틱의 칸은 이미 처리되었으므로 가장 빨라도 다음 틱
+    Node.DeadlineTick = FMath::Max(DeadlineToTick(DeadlineSeconds), CurrentTick + 1);
+
+    TimerToNode.Add(TimerId, NodeIndex);
+    Insert(NodeIndex);
+}
+
+bool FPJLinkTimingWheel::Cancel(FPJLinkTimerId TimerId)
+{
+    int32 NodeIndex = INDEX_NONE;
+    if (!TimerToNode.RemoveAndCopyValue(TimerId, NodeIndex))
+    {
+        return false;
+    }
+
+    Unlink(NodeIndex);
+    FreeNode(NodeIndex);
+    return true;
+}
+
+int32 FPJLinkTimingWheel::Advance(double NowSeconds)
+{
+    const uint64 TargetTick = NowToTick(NowSeconds);
+    int32 NumFired = 0;
+
+    while (CurrentTick < TargetTick)
+    {
+        if (TimerToNode.Num() == 0)
+        {
+            // 예약이 없으면 한 번에 이동
+            CurrentTick = TargetTick;
+            break;
+        }
+
+        NumFired += Step();
+    }
+
+    return NumFired;
+}
+
+double FPJLinkTimingWheel::GetSecondsUntilNextEvent(double NowSeconds) const
+{
+    if (TimerToNode.Num() == 0)
+    {
+        return -1.0;
+    }
+
+    uint64 TicksAhead = 0;
+    if (OccupiedSlots[0] != 0)
+    {
+        // 첫 단에서 다음 틱부터 가장 가까운 사용 중인 칸
+        const uint32 Shift = static_cast<uint32>((CurrentTick + 1) & SlotMask);
+        const uint64 Rotated = (OccupiedSlots[0] >> Shift) | (Shift ? (OccupiedSlots[0] << (SlotsPerLevel - Shift)) : 0);
+        TicksAhead = FMath::CountTrailingZeros64(Rotated) + 1;
+    }
+    else
+    {
+        // 상위 단만 남았으면 다음 재배치 시점까지
+        TicksAhead = SlotsPerLevel - (CurrentTick & SlotMask);
+    }
+
+    const double EventSeconds = OriginSeconds + static_cast<double>(CurrentTick + TicksAhead) * TickSeconds;
+    return FMath::Max(EventSeconds - NowSeconds, 0.0);
+}
+
+void FPJLinkTimingWheel::Insert(int32 NodeIndex)
+{
+    FNode& Node = Nodes[NodeIndex];
+    const uint64 Delta = Node.DeadlineTick > CurrentTick ? Node.DeadlineTick - CurrentTick : 0;
+
+    int32 Level = 0;
+    uint64 SlotTick = Node.DeadlineTick;
+    while (Level < NumLevels - 1 && Delta >= (1ull << (SlotBits * (Level + 1))))
+    {
+        ++Level;
+    }
+
+    // 최상위 단 범위를 넘으면 마지막 칸에 두고 내려올 때 다시 배치
+    const uint64 MaxDelta = 1ull << (SlotBits * NumLevels);
+    if (Delta >= MaxDelta)
+    {
+        SlotTick = CurrentTick + MaxDelta - 1;
+    }
+
+    const int32 Slot = Level * SlotsPerLevel + static_cast<int32>((SlotTick >> (SlotBits * Level)) & SlotMask);
+
+    Node.Slot = Slot;
+    Node.Prev = INDEX_NONE;
+    Node.Next = SlotHeads[Slot];
+    if (Node.Next != INDEX_NONE)
+    {
+        Nodes[Node.Next].Prev = NodeIndex;
+    }
+    SlotHeads[Slot] = NodeIndex;
+    OccupiedSlots[Level] |= 1ull << (Slot & SlotMask);
+}
+
+void FPJLinkTimingWheel::Unlink(int32 NodeIndex)
+{
+    FNode& Node = Nodes[NodeIndex];
+    const int32 Slot = Node.Slot;
+    if (Slot == INDEX_NONE)
+    {
+        return;
+    }
+
+    if (Node.Prev != INDEX_NONE)
+    {
+        Nodes[Node.Prev].Next = Node.Next;
+    }
+    else
+    {
+        SlotHeads[Slot] = Node.Next;
+    }
+
+    if (Node.Next != INDEX_NONE)
+    {
+        Nodes[Node.Next].Prev = Node.Prev;
+    }
+
+    if (SlotHeads[Slot] == INDEX_NONE)
+    {
+        OccupiedSlots[Slot >> SlotBits] &= ~(1ull << (Slot & SlotMask));
+    }
+
+    Node.Prev = INDEX_NONE;
+    Node.Next = INDEX_NONE;
+    Node.Slot = INDEX_NONE;
+}
+
+int32 FPJLinkTimingWheel::Step()
+{
+    ++CurrentTick;
+
+    // 상위 단 경계를 지나면 해당 칸을 위에서부터 차례로 하위 단으로 재배치
+    if ((CurrentTick & SlotMask) == 0)
+    {
+        int32 TopLevel = 1;
+        while (TopLevel < NumLevels - 1 && (CurrentTick & ((1ull << (SlotBits * (TopLevel + 1))) - 1)) == 0)
+        {
+            ++TopLevel;
+        }
+
+        for (int32 Level = TopLevel; Level >= 1; --Level)
+        {
+            Cascade(Level);
+        }
+    }
+
+    return FireSlot(static_cast<int32>(CurrentTick & SlotMask));
+}
+
+void FPJLinkTimingWheel::Cascade(int32 Level)
+{
+    const int32 Slot = Level * SlotsPerLevel + static_cast<int32>((CurrentTick >> (SlotBits * Level)) & SlotMask);
+
+    int32 NodeIndex = SlotHeads[Slot];
+    SlotHeads[Slot] = INDEX_NONE;
+    OccupiedSlots[Level] &= ~(1ull << (Slot & SlotMask));
+
+    while (NodeIndex != INDEX_NONE)
+    {
+        const int32 NextIndex = Nodes[NodeIndex].Next;
+        Nodes[NodeIndex].Slot = INDEX_NONE;
+        Insert(NodeIndex);
+        NodeIndex = NextIndex;
+    }
+}
+
+int32 FPJLinkTimingWheel::FireSlot(int32 Slot)
+{
+    int32 NumFired = 0;
+
+    // 콜백이 Schedule 을 호출해도 다음 틱 이후 칸에만 들어가므로 이 칸은 반드시 비워짐
+    while (SlotHeads[Slot] != INDEX_NONE)
+    {
+        const int32 NodeIndex = SlotHeads[Slot];
+        Unlink(NodeIndex);
+
+        FCallback Callback = MoveTemp(Nodes[NodeIndex].Callback);
+        TimerToNode.Remove(Nodes[NodeIndex].TimerId);
+        FreeNode(NodeIndex);
+
+        if (Callback)
+        {
+            Callback();
+        }
+        ++NumFired;
+    }
+
+    return NumFired;
+}
+
+int32 FPJLinkTimingWheel::AllocateNode()
+{
+    if (FreeNodes.Num() > 0)
+    {
+        return FreeNodes.Pop(EAllowShrinking::No);
+    }
+    return Nodes.AddDefaulted();
+}
+
+void FPJLinkTimingWheel::FreeNode(int32 NodeIndex)
+{
+    Nodes[NodeIndex].Callback = nullptr;
+    Nodes[NodeIndex].TimerId = 0;
+    FreeNodes.Add(NodeIndex);
+}
@@ -26,6 +26,7 @@ UPJLinkComponent::UPJLinkComponent()
     PreviousPowerStatus = EPJLinkPowerStatus::Unknown;
     PreviousInputSource = EPJLinkInputSource::Unknown;
     bPreviousConnectionState = false;
+    LastStatusCheckTime = 0.0;
 
     // 상태 머신 생성
     StateMachine = nullptr;
@@ -48,6 +49,8 @@ void UPJLinkComponent::BeginPlay()
             NetworkManager->OnExtendedError.RemoveDynamic(this, &UPJLinkComponent::HandleExtendedError);
         }
 
+        NetworkManager->OnConnectCompleted.RemoveDynamic(this, &UPJLinkComponent::HandleConnectCompleted);
+        NetworkManager->GetNativeEvents().RemoveAll(this);
         NetworkManager = nullptr;
     }
 
@@ -70,8 +73,19 @@ void UPJLinkComponent::BeginPlay()
         // 확장된 오류 이벤트 바인딩
         NetworkManager->OnExtendedError.AddDynamic(this, &UPJLinkComponent::HandleExtendedError);
 
+        // 비동기 연결 완료 이벤트 바인딩
+        NetworkManager->OnConnectCompleted.AddDynamic(this, &UPJLinkComponent::HandleConnectCompleted);
+
+        // 네이티브 이벤트 전달 (게임 스레드를 거치지 않음)
+        NetworkManager->GetNativeEvents().ForwardTo(NativeEvents, this);
+
         // 디버깅 설정 전달
         NetworkManager->bLogCommunication = bVerboseLogging;
+
+        // 재연결 설정 전달 (재연결은 네트워크 매니저가 전체 재연결 스케줄러로 처리)
+        NetworkManager->bAutoReconnect = bAutoConnect && bAutoReconnect;
+        NetworkManager->ReconnectInterval = ReconnectInterval;
+        NetworkManager->MaxReconnectAttempts = MaxReconnectAttempts;
     }
     else
     {
@@ -106,15 +120,14 @@ void UPJLinkComponent::BeginPlay()
         PJLINK_LOG_INFO(TEXT("Auto-connecting to projector: %s - %s:%d"),
             *ProjectorInfo.Name, *ProjectorInfo.IPAddress, ProjectorInfo.Port);
 
-        // 연결 시도는 지연 실행으로 처리 (BeginPlay 완료 후 수행)
+        // 연결 시도는 지연 실행으로 처리 (BeginPlay 완료 후 수행, 게임 스레드를 막지 않는 비동기 연결)
         UWorld* World = GetWorld();
         if (World)
         {
             FTimerHandle ConnectTimerHandle;
             World->GetTimerManager().SetTimer(
                 ConnectTimerHandle,
-                this,
-                &UPJLinkComponent::Connect,
+                FTimerDelegate::CreateWeakLambda(this, [this]() { ConnectAsync(); }),
                 0.5f,
                 false);
         }
@@ -122,7 +135,7 @@ void UPJLinkComponent::BeginPlay()
         {
             PJLINK_LOG_ERROR(TEXT("Failed to get World reference for auto-connect"));
             // 대체 연결 시도
-            Connect();
+            ConnectAsync();
         }
     }
 
@@ -177,6 +190,8 @@ void UPJLinkComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
     {
         NetworkManagerToDisconnect->OnResponseReceived.RemoveDynamic(this, &UPJLinkComponent::HandleResponseReceived);
         NetworkManagerToDisconnect->OnCommunicationLog.RemoveDynamic(this, &UPJLinkComponent::HandleCommunicationLog);
+        NetworkManagerToDisconnect->OnConnectCompleted.RemoveDynamic(this, &UPJLinkComponent::HandleConnectCompleted);
+        NetworkManagerToDisconnect->GetNativeEvents().RemoveAll(this);
     }
 
     // 5. 상태 머신 이벤트 연결 해제
@@ -196,21 +211,8 @@ void UPJLinkComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActo
 {
     Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
-    // 블루프린트용 간단한 상태 업데이트 (이벤트는 발생시키지 않음)
-    if (NetworkManager && IsConnected())
-    {
-        // 마지막 상태 확인 후 일정 시간 경과한 경우 상태 재확인
-        static float TimeSinceLastStatusCheck = 0.0f;
-        TimeSinceLastStatusCheck += DeltaTime;
-
-        if (TimeSinceLastStatusCheck >= 5.0f)  // 5초마다 자동 상태 확인
-        {
-            TimeSinceLastStatusCheck = 0.0f;
-
-            // 블루프린트에서의 빈번한 폴링을 대신하는 자동 상태 확인
-            RequestStatus();
-        }
-    }
+    // 블루프린트에서의 빈번한 폴링을 대신하는 자동 상태 확인 (CheckStatus 타이머와 시각을 공유해 중복 요청 없음)
+    RequestStatusIfDue();
 }
 
 bool UPJLinkComponent::Connect()
@@ -229,55 +231,90 @@ bool UPJLinkComponent::Connect()
     if (NetworkManager)
     {
         bool bResult = NetworkManager->ConnectToProjector(ProjectorInfo, ConnectionTimeout);
+        ApplyConnectResult(bResult);
+        return bResult;
+    }
 
-        // 연결 결과에 따라 상태 머신 업데이트
-        if (bResult)
-        {
-            PJLINK_LOG_INFO(TEXT("Successfully connected to projector: %s"), *ProjectorInfo.Name);
+    PJLINK_LOG_ERROR(TEXT("NetworkManager is null, cannot connect"));
 
-            if (StateMachine)
-            {
-                StateMachine->UpdateFromConnectionStatus(true);
-            }
+    if (StateMachine)
+    {
+        StateMachine->SetState(EPJLinkProjectorState::Disconnected);
+    }
 
-            // 연결 상태가 실제로 변경되었는지 확인
-            if (!bPreviousConnectionState)
-            {
-                OnConnectionChanged.Broadcast(true);
-                bPreviousConnectionState = true;
-            }
+    return false;
+}
 
-            // 연결 성공 후 초기 상태 요청
-            RequestStatus();
-        }
-        else
-        {
-            PJLINK_LOG_WARNING(TEXT("Failed to connect to projector: %s"), *ProjectorInfo.Name);
+TFuture<bool> UPJLinkComponent::StartConnect()
+{
+    if (!IsComponentValid())
+    {
+        PJLINK_LOG_ERROR(TEXT("Cannot connect - component not valid"));
+        return MakeFulfilledPromise<bool>(false).GetFuture();
+    }
 
-            if (StateMachine)
-            {
-                StateMachine->SetState(EPJLinkProjectorState::Disconnected);
-            }
+    if (StateMachine)
+    {
+        StateMachine->SetState(EPJLinkProjectorState::Connecting);
+    }
 
-            // 연결 상태가 실제로 변경되었는지 확인
-            if (bPreviousConnectionState)
-            {
-                OnConnectionChanged.Broadcast(false);
-                bPreviousConnectionState = false;
-            }
-        }
+    // 연결/인증은 I/O 스레드에서 진행되고 결과는 HandleConnectCompleted 로 돌아옴
+    return NetworkManager->StartConnect(ProjectorInfo, ConnectionTimeout);
+}
 
-        return bResult;
+bool UPJLinkComponent::ConnectAsync()
+{
+    TFuture<bool> Future = StartConnect();
+    return !Future.IsReady() || Future.Get();
+}
+
+void UPJLinkComponent::HandleConnectCompleted(bool bSuccess, EPJLinkErrorCode ErrorCode)
+{
+    if (!bSuccess)
+    {
+        PJLINK_LOG_VERBOSE(TEXT("Async connection failed: %s"), *UEnum::GetValueAsString(ErrorCode));
     }
 
-    PJLINK_LOG_ERROR(TEXT("NetworkManager is null, cannot connect"));
+    ApplyConnectResult(bSuccess);
+}
 
-    if (StateMachine)
+void UPJLinkComponent::ApplyConnectResult(bool bConnected)
+{
+    // 연결 결과에 따라 상태 머신 업데이트
+    if (bConnected)
     {
-        StateMachine->SetState(EPJLinkProjectorState::Disconnected);
+        PJLINK_LOG_INFO(TEXT("Successfully connected to projector: %s"), *ProjectorInfo.Name);
+
+        if (StateMachine)
+        {
+            StateMachine->UpdateFromConnectionStatus(true);
+        }
+
+        // 연결 상태가 실제로 변경되었는지 확인
+        if (!bPreviousConnectionState)
+        {
+            OnConnectionChanged.Broadcast(true);
+            bPreviousConnectionState = true;
+        }
+
+        // 초기 상태 조회는 네트워크 매니저가 세션 수립 직후 이미 보냄 (동기/비동기 연결 모두)
     }
+    else
+    {
+        PJLINK_LOG_WARNING(TEXT("Failed to connect to projector: %s"), *ProjectorInfo.Name);
 
-    return false;
+        if (StateMachine)
+        {
+            StateMachine->SetState(EPJLinkProjectorState::Disconnected);
+        }
+
+        // 연결 상태가 실제로 변경되었는지 확인
+        if (bPreviousConnectionState)
+        {
+            OnConnectionChanged.Broadcast(false);
+            bPreviousConnectionState = false;
+        }
+    }
 }
 
 // 이 함수는 그대로 유지하고, 위의 중복 부분을 제거합니다
@@ -498,52 +535,38 @@ void UPJLinkComponent::CheckStatus()
 
         OnConnectionChanged.Broadcast(bCurrentConnectionState);
         bPreviousConnectionState = bCurrentConnectionState;
+    }
 
-        // 연결이 끊어지고 자동 재연결이 활성화된 경우
-        if (!bCurrentConnectionState && bAutoConnect && bAutoReconnect)
-        {
-            static int32 ReconnectCount = 0;
+    RequestStatusIfDue();
+}
 
-            // 최대 시도 횟수 체크 (0은 무제한)
-            if (MaxReconnectAttempts == 0 || ReconnectCount < MaxReconnectAttempts)
-            {
-                ReconnectCount++;
-                PJLINK_LOG_INFO(TEXT("[%s] Connection lost. Attempting to reconnect (%d/%d)..."),
-                    *ProjectorInfo.Name, ReconnectCount, MaxReconnectAttempts == 0 ? 999 : MaxReconnectAttempts);
-
-                // 재연결 시도를 위한 타이머 설정
-                UWorld* World = GetWorld();
-                if (World)
-                {
-                    FTimerHandle ReconnectTimerHandle;
-                    World->GetTimerManager().SetTimer(
-                        ReconnectTimerHandle,
-                        this,
-                        &UPJLinkComponent::Connect,
-                        ReconnectInterval,
-                        false);
-                }
-                else
-                {
-                    PJLINK_LOG_ERROR(TEXT("Failed to get World reference for reconnect timer"));
-                    // World 없이 즉시 재연결 시도
-                    Connect();
-                }
-            }
-            else if (MaxReconnectAttempts > 0)
-            {
-                PJLINK_LOG_WARNING(TEXT("[%s] Max reconnect attempts (%d) reached. Giving up."),
-                    *ProjectorInfo.Name, MaxReconnectAttempts);
-                // 재연결 카운트 리셋
-                ReconnectCount = 0;
-            }
-        }
+void UPJLinkComponent::RequestStatusIfDue()
+{
+    if (!NetworkManager || !IsConnected())
+    {
+        return;
+    }
+
+    const double Now = FPlatformTime::Seconds();
+    if (Now - LastStatusCheckTime < GetEffectiveStatusCheckInterval())
+    {
+        return;
     }
 
-    if (bCurrentConnectionState)
+    LastStatusCheckTime = Now;
+    RequestStatus();
+}
+
+float UPJLinkComponent::GetEffectiveStatusCheckInterval() const
+{
+    const float Interval = bPeriodicStatusCheck ? FMath::Max(StatusCheckInterval, 1.0f) : 5.0f;
+
+    // 상태 변경을 알림으로 받는 프로젝터는 놓친 알림을 메우는 정도로만 확인
+    if (NetworkManager && NetworkManager->IsReceivingNotifications())
     {
-        RequestStatus();
+        return FMath::Max(Interval, PushStatusCheckInterval);
     }
+    return Interval;
 }
 
 bool UPJLinkComponent::SaveCurrentSettingsAsPreset(const FString& PresetName)
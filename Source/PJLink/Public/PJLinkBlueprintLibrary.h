@@ -92,6 +92,36 @@ public:
     UFUNCTION(BlueprintPure, Category = "PJLink", meta = (WorldContext = "WorldContextObject"))
     static FPJLinkProjectorInfo GetProjectorInfo(const UObject* WorldContextObject);
 
+    /**
+     * 전체 프로젝터의 동시 재연결 수 제한 설정
+     */
+    UFUNCTION(BlueprintCallable, Category = "PJLink|Connection")
+    static void SetMaxConcurrentReconnects(int32 MaxConcurrentConnects = 16);
+
+    /**
+     * 재연결 백오프 상한 설정 (초)
+     */
+    UFUNCTION(BlueprintCallable, Category = "PJLink|Connection")
+    static void SetMaxReconnectBackoff(float MaxBackoffSeconds = 60.0f);
+
+    /**
+     * 전체 프로젝터 재연결 통계 가져오기
+     */
+    UFUNCTION(BlueprintPure, Category = "PJLink|Connection")
+    static FPJLinkReconnectStats GetReconnectStats();
+
+    /**
+     * 전체 프로젝터가 함께 쓰는 프레임당 이벤트 처리 시간 설정 (마이크로초)
+     */
+    UFUNCTION(BlueprintCallable, Category = "PJLink|Performance")
+    static void SetEventDrainBudget(float BudgetMicroseconds = 1000.0f);
+
+    /**
+     * 프레임당 이벤트 처리 시간 가져오기 (마이크로초)
+     */
+    UFUNCTION(BlueprintPure, Category = "PJLink|Performance")
+    static float GetEventDrainBudget();
+
     /**
  * PJLink 장치 검색 매니저 생성
  */
@@ -0,0 +1,28 @@
+﻿// PJLinkCommandEncoder.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PJLinkTypes.h"
+
+/**
+ * PJLink 명령을 전송용 바이트로 직접 인코딩
+ *
+ * FString 을 거치지 않고 호출자가 준비한 바이트 버퍼 끝에 "%1XXXX param\r" 을 덧붙입니다.
+ * 여러 명령을 한 버퍼에 이어 붙여 한 번의 송신으로 보낼 때 사용합니다.
+ */
+namespace PJLinkCommandEncoder
+{
+    // 명령 하나의 최대 인코딩 길이 (클래스 2자 + 명령 4자 + 공백 + 파라미터 최대 128자 + CR)
+    static constexpr int32 MaxEncodedCommandLength = 2 + 4 + 1 + 128 + 1;
+
+    // 명령 이름 (4글자 ASCII, 알 수 없는 명령이면 nullptr)
+    PJLINK_API const ANSICHAR* GetCommandName(EPJLinkCommand Command);
+
+    // 버퍼 끝에 명령 추가 (추가한 바이트 수 반환, 실패 시 0)
+    // Parameter 가 비어 있으면 파라미터 없이 인코딩합니다.
+    PJLINK_API int32 AppendCommand(TArray<uint8>& Buffer, EPJLinkCommand Command, EPJLinkClass ProtocolClass,
+        const ANSICHAR* Parameter, int32 ParameterLength);
+
+    PJLINK_API int32 AppendCommand(TArray<uint8>& Buffer, EPJLinkCommand Command, EPJLinkClass ProtocolClass,
+        const FString& Parameter);
+}
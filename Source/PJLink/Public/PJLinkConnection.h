@@ -0,0 +1,126 @@
+﻿// PJLinkConnection.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PJLinkIOReactor.h"
+#include "Containers/Queue.h"
+
+/**
+ * 연결 이벤트 수신자 (UPJLinkNetworkManager 등 세션 객체가 구현)
+ * 콜백은 리액터 I/O 스레드에서 호출됩니다.
+ */
+class PJLINK_API IPJLinkConnectionListener
+{
+public:
+    virtual ~IPJLinkConnectionListener() {}
+
+    // 비동기 연결 완료 (CreateConnecting 으로 만든 연결만, 실패는 OnConnectionClosed 로 전달)
+    virtual void OnConnectionEstablished() {}
+
+    // 수신 데이터 도착
+    virtual void OnConnectionData(const uint8* Data, int32 Length) = 0;
+
+    // 원격 종료 또는 소켓 오류로 연결이 끊김 (ErrorCode 0 = 정상 종료)
+    virtual void OnConnectionClosed(int32 ErrorCode) = 0;
+
+    // FPJLinkConnection::ScheduleTimer 로 예약한 타이머 만료 (Cookie 는 예약 시 전달한 값)
+    virtual void OnConnectionTimer(uint64 Cookie) {}
+};
+
+/**
+ * 리액터에 등록된 TCP 연결 하나의 상태
+ *
+ * 소켓 소유권은 리액터로 넘어가며, Close() 후에는 I/O 스레드가 소켓을 닫습니다.
+ * 수신자 포인터는 락으로 보호되므로 DetachListener() 반환 후에는 콜백이 호출되지 않습니다.
+ *
+ * 송신은 전이중(full-duplex)으로 동작합니다. Send()는 락 없는 MPSC 큐에 데이터를 넣고
+ * 쓰기 관심만 요청한 뒤 바로 반환하며, 실제 소켓 쓰기는 I/O 스레드가 OnWritable()에서 수행합니다.
+ * 따라서 수신 대기 중인 소켓이 있어도 송신 호출자는 막히지 않습니다.
+ */
+class PJLINK_API FPJLinkConnection
+    : public IPJLinkIOHandler
+    , public TSharedFromThis<FPJLinkConnection, ESPMode::ThreadSafe>
+{
+public:
+    // 연결된 논블로킹 소켓으로 연결 객체를 만들고 리액터에 등록
+    static TSharedPtr<FPJLinkConnection, ESPMode::ThreadSafe> Create(
+        PJLinkSocketPlatform::FNativeSocket ConnectedSocket, IPJLinkConnectionListener* InListener);
+
+    // 연결 중인 논블로킹 소켓으로 연결 객체를 만들고 리액터에 등록
+    // I/O 스레드가 쓰기 가능 이벤트로 연결 완료를 확인한 뒤 OnConnectionEstablished 를 호출합니다.
+    // 완료 전에 Send() 한 데이터는 큐에 남아 있다가 연결 직후 전송됩니다.
+    static TSharedPtr<FPJLinkConnection, ESPMode::ThreadSafe> CreateConnecting(
+        PJLinkSocketPlatform::FNativeSocket ConnectingSocket, IPJLinkConnectionListener* InListener);
+
+    virtual ~FPJLinkConnection();
+
+    // 데이터 전송 요청 (큐에 넣고 즉시 반환, 실제 전송은 I/O 스레드)
+    bool Send(const uint8* Data, int32 Length);
+    bool Send(TArray<uint8>&& Data);
+
+    // 이 연결의 I/O 스레드에서 호출되는 타이머 예약 (수신자 분리 후에는 호출되지 않음)
+    FPJLinkTimerId ScheduleTimer(double DelaySeconds, uint64 Cookie);
+
+    // 타이머 취소
+    void CancelTimer(FPJLinkTimerId TimerId);
+
+    // 연결 종료 (수신자 분리 후 리액터에 해제 요청)
+    void Close();
+
+    // 이후 콜백이 호출되지 않도록 수신자 분리
+    void DetachListener();
+
+    // 연결 유효 여부
+    bool IsOpen() const { return bOpen.load(std::memory_order_acquire); }
+
+    PJLinkSocketPlatform::FNativeSocket GetSocket() const { return Socket; }
+
+    // IPJLinkIOHandler 인터페이스
+    virtual void OnReadable() override;
+    virtual void OnWritable() override;
+    virtual void OnPollError() override;
+
+private:
+    FPJLinkConnection(PJLinkSocketPlatform::FNativeSocket InSocket, IPJLinkConnectionListener* InListener, bool bInConnecting);
+
+    // 연결 완료 확인 (I/O 스레드, 실패 시 false)
+    bool CompleteConnect();
+
+    // 원격 종료/오류 처리 (I/O 스레드)
+    void HandleClosed(int32 ErrorCode);
+
+    // 타이머 만료를 수신자에게 전달 (I/O 스레드)
+    void HandleTimer(uint64 Cookie);
+
+    // 송신 큐 비우기 (I/O 스레드 전용, 소켓 오류 시 false)
+    bool FlushOutbound();
+
+    // I/O 스레드에 송신 처리 요청
+    void RequestFlush();
+
+    PJLinkSocketPlatform::FNativeSocket Socket;
+    TAtomic<bool> bOpen;
+
+    // 수신자 보호
+    FCriticalSection ListenerLock;
+    IPJLinkConnectionListener* Listener;
+
+    // 송신 큐 (생산자: 임의 스레드, 소비자: I/O 스레드)
+    TQueue<TArray<uint8>, EQueueMode::Mpsc> OutboundQueue;
+
+    // 한 번의 send 로 합쳐 보낼 최대 크기
+    static constexpr int32 MaxCoalescedSendBytes = 16 * 1024;
+
+    // 소켓 버퍼가 가득 차 일부만 보낸 데이터 (I/O 스레드 전용)
+    TArray<uint8> PartialSend;
+    int32 PartialSendOffset;
+
+    // 쓰기 관심이 이미 요청되었는지 (중복 깨우기 방지)
+    TAtomic<bool> bFlushRequested;
+
+    // 아직 TCP 연결이 완료되지 않음 (I/O 스레드 전용)
+    bool bConnecting;
+
+    // 수신 버퍼 (I/O 스레드 전용)
+    uint8 RecvBuffer[2048];
+};
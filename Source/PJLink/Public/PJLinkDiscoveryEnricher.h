@@ -0,0 +1,144 @@
+﻿// PJLinkDiscoveryEnricher.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PJLinkSocketPlatform.h"
+
+class FPJLinkEnrichmentJob;
+
+/**
+ * 식별 정보 조회 설정
+ */
+struct PJLINK_API FPJLinkEnrichmentSettings
+{
+    // 새로 연결할 때 쓰는 TCP 포트
+    uint16 Port = 4352;
+
+    // 동시에 조회할 최대 장치 수 (나머지는 대기열에서 순서대로)
+    int32 MaxConcurrent = 16;
+
+    // 새로 연결하는 장치의 연결 제한 시간 (초)
+    double ConnectTimeoutSeconds = 1.0;
+
+    // 인사말과 조회 응답을 받는 제한 시간 (초)
+    double ResponseTimeoutSeconds = 2.0;
+};
+
+/**
+ * 식별 정보 조회 통계 (스윕 통계와 별도)
+ */
+struct PJLINK_API FPJLinkEnrichmentStats
+{
+    // 대기 중 / 조회 중 / 최대 동시 조회 장치 수
+    int32 QueuedDevices = 0;
+    int32 ActiveDevices = 0;
+    int32 PeakActiveDevices = 0;
+
+    // 네 조회에 모두 응답한 장치 / 시간 초과, 연결 실패, 인증 필요로 끝난 장치
+    int32 EnrichedDevices = 0;
+    int32 FailedDevices = 0;
+
+    // 대기열이나 조회 중인 장치가 있던 시간 (초)
+    double BusySeconds = 0.0;
+
+    // 바쁜 시간 기준 초당 처리 장치 수 / 장치당 평균 조회 시간 (밀리초)
+    double DevicesPerSecond = 0.0;
+    double AverageLatencyMs = 0.0;
+};
+
+/**
+ * 식별 정보 조회 이벤트 (리액터 I/O 스레드 또는 Add 를 호출한 스레드에서 호출)
+ * 발생 순서를 지키기 위해 조회 단계의 락 안에서 호출되므로, 수신자는 게임 스레드로 넘기는 정도로 가볍게 처리해야 합니다.
+ */
+struct PJLINK_API FPJLinkEnrichmentCallbacks
+{
+    // 조회가 끝난 장치 (Response = 받은 응답 줄, bComplete = 네 조회에 모두 응답함)
+    TFunction<void(uint32 IPv4, const FString& Response, bool bComplete)> OnDeviceEnriched;
+
+    // 대기 중이거나 조회 중인 장치가 모두 끝남
+    TFunction<void()> OnIdle;
+};
+
+/**
+ * 발견된 장치의 이름/제조사/모델/기타 정보를 조회하는 단계
+ *
+ * 스윕은 연결과 CLSS 확인까지만 하고, 응답한 연결을 AddConnectedDevice 로 넘깁니다.
+ * 이 단계는 넘겨받은 소켓을 그대로 리액터에 등록해 NAME/INF1/INF2/INFO 조회를 한 번에 보내고 응답을 모읍니다.
+ * 브로드캐스트 검색처럼 연결이 없는 장치는 AddDevice 로 새로 연결해 인사말을 확인한 뒤 같은 방식으로 조회합니다.
+ *
+ * 조회는 리액터 I/O 스레드에서 진행되므로 스윕 작업 스레드를 붙잡지 않으며,
+ * 동시에 조회하는 장치 수는 MaxConcurrent 로 제한됩니다.
+ */
+class PJLINK_API FPJLinkDiscoveryEnricher : public TSharedFromThis<FPJLinkDiscoveryEnricher, ESPMode::ThreadSafe>
+{
+public:
+    // 한 번에 보내는 식별 정보 조회 수
+    static constexpr int32 NumIdentityQueries = 4;
+
+    FPJLinkDiscoveryEnricher(const FPJLinkEnrichmentSettings& InSettings, FPJLinkEnrichmentCallbacks&& InCallbacks);
+    ~FPJLinkDiscoveryEnricher();
+
+    // 인사말("PJLINK 0")을 이미 받은 연결을 넘겨받아 조회 (소켓 소유권 이전, 취소 후에는 바로 닫음)
+    void AddConnectedDevice(uint32 IPv4, PJLinkSocketPlatform::FNativeSocket Socket);
+
+    // 새로 연결해서 조회
+    void AddDevice(uint32 IPv4);
+
+    // 대기열을 비우고 진행 중인 조회의 연결을 닫음 (이후 이벤트 없음)
+    void Cancel();
+
+    // 대기 중이거나 조회 중인 장치가 없는지
+    bool IsIdle() const;
+
+    // 현재 통계
+    FPJLinkEnrichmentStats GetStats() const;
+
+private:
+    friend class FPJLinkEnrichmentJob;
+
+    // 조회를 기다리는 장치 (Socket 이 유효하면 넘겨받은 연결)
+    struct FPendingDevice
+    {
+        uint32 IPv4 = 0;
+        PJLinkSocketPlatform::FNativeSocket Socket = PJLinkSocketPlatform::InvalidSocket;
+    };
+
+    // 대기열에 추가 후 빈 자리만큼 조회 시작
+    void Enqueue(const FPendingDevice& Device);
+
+    // 동시 조회 수가 허용하는 만큼 대기열에서 꺼내 시작
+    void StartQueuedJobs();
+
+    // 조회 종료 보고 (I/O 스레드) - 집계 후 빈 자리에 다음 장치 시작
+    void OnJobFinished(uint32 IPv4, const FString& Response, bool bComplete, double LatencySeconds);
+
+    // 조회 종료 집계와 이벤트 발생 (대기열은 건드리지 않음)
+    void RecordJobFinished(uint32 IPv4, const FString& Response, bool bComplete, double LatencySeconds);
+
+    // 대기/조회 장치 수가 바뀐 뒤 바쁜 시간 집계 (Lock 안에서 호출)
+    void UpdateBusyTime(double Now);
+
+    FPJLinkEnrichmentSettings Settings;
+    FPJLinkEnrichmentCallbacks Callbacks;
+
+    mutable FCriticalSection Lock;
+
+    // 도착 순서대로 처리할 대기열
+    TArray<FPendingDevice> Pending;
+
+    // 조회 중인 장치
+    TMap<uint32, TSharedPtr<FPJLinkEnrichmentJob, ESPMode::ThreadSafe>> ActiveJobs;
+
+    // 이미 받은 장치 (같은 장치를 두 번 조회하지 않음)
+    TSet<uint32> KnownDevices;
+
+    bool bCancelled;
+
+    // 통계 (Lock 으로 보호)
+    int32 PeakActive;
+    int32 EnrichedCount;
+    int32 FailedCount;
+    double TotalLatencySeconds;
+    double BusyStartTime;
+    double AccumulatedBusySeconds;
+};
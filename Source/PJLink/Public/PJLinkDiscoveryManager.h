@@ -4,56 +4,76 @@
 #include "CoreMinimal.h"
 #include "UObject/NoExportTypes.h"
 #include "PJLinkTypes.h"
+#include "Containers/Ticker.h"
 #include "Networking/Public/Interfaces/IPv4/IPv4SubnetInfo.h"
 #include "PJLinkDiscoveryManager.generated.h"
 
+/**
+ * 알려진 호스트 색인과 비교한 장치 변화
+ */
+UENUM(BlueprintType)
+enum class EPJLinkDiscoveryChange : uint8
+{
+    // 색인에 없던 장치
+    New UMETA(DisplayName = "새 장치"),
+    // 같은 주소에서 이름/모델/제조사/MAC/인증 여부가 바뀐 장치
+    Changed UMETA(DisplayName = "변경된 장치"),
+    // 색인에 있었지만 스캔 끝까지 응답하지 않은 장치
+    Missing UMETA(DisplayName = "사라진 장치")
+};
+
 /**
  * PJLink 장치 검색 결과를 나타내는 구조체
  */
 USTRUCT(BlueprintType)
-struct PJLINK_API FPJLinkDiscoveryStatus
+struct PJLINK_API FPJLinkDiscoveryResult
 {
     GENERATED_BODY()
 
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "PJLink|Discovery")
-    FString DiscoveryID;
+    FString IPAddress;
 
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "PJLink|Discovery")
-    int32 TotalAddresses = 0;
+    int32 Port = 4352;
 
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "PJLink|Discovery")
-    int32 ScannedAddresses = 0;
+    FString Name;
 
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "PJLink|Discovery")
-    int32 DiscoveredDevices = 0;
+    FString ModelName;
 
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "PJLink|Discovery")
-    float ProgressPercentage = 0.0f;
+    FString Manufacturer;
 
+    // Class 2 검색 응답(ACKN)으로 받은 MAC 주소 (TCP 스캔으로 찾은 장치는 비어 있음)
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "PJLink|Discovery")
-    bool bIsComplete = false;
+    FString MacAddress;
 
+    // 기타 정보 (INFO 응답)
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "PJLink|Discovery")
-    bool bWasCancelled = false;
+    FString OtherInfo;
 
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "PJLink|Discovery")
-    FDateTime StartTime;
+    EPJLinkClass DeviceClass = EPJLinkClass::Class1;
 
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "PJLink|Discovery")
-    FTimespan ElapsedTime;
+    bool bRequiresAuthentication = false;
 
-    // 추가된 필드
+    // 식별 정보(NAME/INF1/INF2/INFO) 조회가 끝났는지 (false 면 이후 같은 장치로 갱신 이벤트가 다시 옴)
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "PJLink|Discovery")
-    FString CurrentScanningIP;
+    bool bIdentityQueried = false;
 
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "PJLink|Discovery")
-    float ScanSpeedIPsPerSecond = 0.0f;
+    int32 ResponseTimeMs = 0;
 
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "PJLink|Discovery")
-    FTimespan EstimatedTimeRemaining;
+    FDateTime DiscoveryTime;
+
+    // 호스트 바이트 순서 IPv4 (중복 검사/정렬용, 0 이면 IPAddress 문자열에서 계산)
+    uint32 IPv4 = 0;
 
     // 기본 생성자
-    FPJLinkDiscoveryStatus() : StartTime(FDateTime::Now()) {}
+    FPJLinkDiscoveryResult() : DiscoveryTime(FDateTime::Now()) {}
 };
 
 /**
@@ -91,10 +111,116 @@ struct PJLINK_API FPJLinkDiscoveryStatus
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "PJLink|Discovery")
     FTimespan ElapsedTime;
 
+    // 추가된 필드
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "PJLink|Discovery")
+    FString CurrentScanningIP;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "PJLink|Discovery")
+    float ScanSpeedIPsPerSecond = 0.0f;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "PJLink|Discovery")
+    FTimespan EstimatedTimeRemaining;
+
+    // 범위/서브넷 스캔 작업 스레드 수
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "PJLink|Discovery")
+    int32 WorkerCount = 0;
+
+    // 작업 스레드가 일한 시간의 비율 (0~1)
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "PJLink|Discovery")
+    float WorkerUtilization = 0.0f;
+
+    // 첫 작업 스레드가 끝난 뒤 마지막 작업 스레드가 끝날 때까지 걸린 시간 (초)
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "PJLink|Discovery")
+    float TailTimeSeconds = 0.0f;
+
+    // 현재 연결 제한 시간 (밀리초, 응답한 /24 들의 RTT 로 하한까지 줄어듦) / 줄인 제한 시간으로 놓쳐 다시 시도한 주소 수
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "PJLink|Discovery")
+    float ConnectTimeoutMs = 0.0f;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "PJLink|Discovery")
+    int32 RetriedAddresses = 0;
+
+    // 식별 정보 조회를 마친 장치 수 / 조회를 기다리거나 진행 중인 장치 수
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "PJLink|Discovery")
+    int32 EnrichedDevices = 0;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "PJLink|Discovery")
+    int32 PendingEnrichments = 0;
+
+    // 식별 정보 조회 처리량 (초당 장치 수, 스윕 속도와 별도) / 장치당 평균 조회 시간 (밀리초)
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "PJLink|Discovery")
+    float EnrichmentDevicesPerSecond = 0.0f;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "PJLink|Discovery")
+    float EnrichmentLatencyMs = 0.0f;
+
+    // 범위 안에서 알려진 호스트 색인에 있던 장치 수 (먼저 다시 확인함)
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "PJLink|Discovery")
+    int32 KnownDevices = 0;
+
+    // 알려진 호스트 확인이 끝나고 나머지 주소를 낮은 동시 연결 수로 스윕 중인지
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "PJLink|Discovery")
+    bool bSweepingInBackground = false;
+
+    // 색인과 비교한 새 장치 / 변경된 장치 / 사라진 장치 수 (OnDeviceChanged 로 보고한 수)
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "PJLink|Discovery")
+    int32 NewDevices = 0;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "PJLink|Discovery")
+    int32 ChangedDevices = 0;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "PJLink|Discovery")
+    int32 MissingDevices = 0;
+
     // 기본 생성자
     FPJLinkDiscoveryStatus() : StartTime(FDateTime::Now()) {}
 };
 
+class FPJLinkBroadcastSearch;
+class FPJLinkScanEngine;
+class FPJLinkDiscoveryEnricher;
+class FPJLinkKnownHostsIndex;
+struct FPJLinkScanSettings;
+struct FPJLinkScanStats;
+struct FPJLinkEnrichmentStats;
+
+/**
+ * 검색 작업 하나의 결과 목록과 중복 검사 색인
+ * 결과는 발견 순서대로 배열에 두고, 중복 검사는 숫자 키 해시 집합으로 O(1)에 처리합니다.
+ */
+struct FPJLinkDiscoveryResultSet
+{
+    // 발견 순서대로 쌓인 결과
+    TArray<FPJLinkDiscoveryResult> Results;
+
+    // 이미 추가된 IPv4+포트 (UPJLinkDiscoveryManager::MakeEndpointKey) -> Results 인덱스
+    TMap<uint64, int32> EndpointIndices;
+
+    // 여러 주소로 응답한 같은 장치를 거르기 위한 MAC 주소
+    TSet<FString> MacAddresses;
+};
+
+/**
+ * 알려진 호스트 색인을 쓰는 범위/서브넷 스캔 하나의 상태 (게임 스레드 전용)
+ * 색인에 있던 호스트를 먼저 확인한 뒤 나머지 주소를 스윕하고, 끝나면 결과를 색인에 반영합니다.
+ */
+struct FPJLinkRescanState
+{
+    // 스캔 범위와 검색 제한 시간 (나머지 주소 스윕에 다시 씀)
+    uint32 FirstIPv4 = 0;
+    uint32 LastIPv4 = 0;
+    float TimeoutSeconds = 0.0f;
+
+    // 스캔 전 색인에 있던 범위 안 장치 (IPv4+포트 키)
+    TMap<uint64, FPJLinkDiscoveryResult> KnownDevices;
+
+    // 새 장치나 변경된 장치로 이미 보고한 장치
+    TSet<uint64> ReportedDevices;
+
+    // 나머지 주소 스윕까지 끝났는지 (끝나야 응답하지 않은 알려진 장치를 사라진 것으로 판정)
+    bool bSweepFinished = false;
+};
+
 // 검색 완료 이벤트 델리게이트
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FPJLinkDiscoveryCompletedDelegate,
     const TArray<FPJLinkDiscoveryResult>&, DiscoveredDevices,
@@ -108,6 +234,11 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FPJLinkDeviceDiscoveredDelegate,
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FPJLinkDiscoveryProgressDelegate,
     const FPJLinkDiscoveryStatus&, Status);
 
+// 알려진 호스트 색인과 비교한 장치 변화 이벤트 델리게이트
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FPJLinkDeviceChangedDelegate,
+    const FPJLinkDiscoveryResult&, Device,
+    EPJLinkDiscoveryChange, Change);
+
 /**
  * PJLink 장치 검색을 담당하는 클래스
  */
@@ -124,6 +255,8 @@ public:
 
     /**
      * UDP 브로드캐스트를 통한 PJLink 장치 검색 시작
+     * Class 2 검색 명령(%2SRCH)을 여러 번 브로드캐스트하고 제한 시간 동안 ACKN 응답을 모읍니다.
+     * Class 1 전용 장치는 응답하지 않으므로 범위/서브넷 스캔으로 찾아야 합니다.
      * @param TimeoutSeconds 검색 제한 시간 (초)
      * @return 검색 작업 식별자
      */
@@ -132,6 +265,9 @@ public:
 
     /**
      * IP 주소 범위를 스캔하여 PJLink 장치 검색
+     * 최대 MaxInFlight 개의 논블로킹 연결을 동시에 걸어 두고 응답한 호스트만 결과로 보고합니다.
+     * 알려진 호스트 색인을 쓰면 범위 안에서 전에 응답한 장치를 먼저 확인해 바로 보고하고,
+     * 나머지 주소는 그 뒤에 낮은 동시 연결 수로 스윕합니다. 색인과 다른 점은 OnDeviceChanged 로 보고합니다.
      * @param StartIPAddress 시작 IP 주소
      * @param EndIPAddress 종료 IP 주소
      * @param TimeoutSeconds 검색 제한 시간 (초)
@@ -221,6 +357,21 @@ public:
     UFUNCTION(BlueprintCallable, Category = "PJLink|Discovery")
     void SetBroadcastPort(int32 Port) { BroadcastPort = Port; }
 
+    /**
+     * 브로드캐스트 검색 대상 주소 설정 (기본 255.255.255.255)
+     * 라우터를 넘는 서브넷은 지정 브로드캐스트 주소(예: 192.168.1.255)를 사용합니다.
+     * @param Address 대상 IPv4 주소
+     */
+    UFUNCTION(BlueprintCallable, Category = "PJLink|Discovery")
+    void SetBroadcastAddress(const FString& Address) { BroadcastAddress = Address; }
+
+    /**
+     * 브로드캐스트 검색 명령 전송 횟수 설정 (UDP 손실 대비 재전송, 응답은 IP/MAC 으로 중복 제거)
+     * @param Count 전송 횟수
+     */
+    UFUNCTION(BlueprintCallable, Category = "PJLink|Discovery")
+    void SetSearchTransmitCount(int32 Count) { SearchTransmitCount = FMath::Clamp(Count, 1, 10); }
+
     /**
      * 검색 제한 시간 설정
      * @param TimeoutSeconds 검색 제한 시간 (초)
@@ -229,18 +380,66 @@ public:
     void SetDefaultTimeout(float TimeoutSeconds) { DefaultTimeoutSeconds = FMath::Max(1.0f, TimeoutSeconds); }
 
     /**
-     * 최대 동시 검색 스레드 수 설정
+     * 범위/서브넷 스캔 작업 스레드 수 설정
+     * 작업 스레드들은 MaxInFlight 를 나눠 갖고 공유 커서에서 작은 주소 묶음을 가져가 함께 끝납니다.
      * @param MaxThreads 최대 스레드 수
      */
     UFUNCTION(BlueprintCallable, Category = "PJLink|Discovery")
     void SetMaxConcurrentThreads(int32 MaxThreads) { MaxConcurrentThreads = FMath::Clamp(MaxThreads, 1, 16); }
 
     /**
-     * 검색 대기 시간 설정 (각 IP당)
+     * 검색 대기 시간 설정 (각 IP당 연결 제한 시간의 상한)
+     * 범위/서브넷 스캔은 /24 마다 연결 완료/거부 RTT 를 재서 응답이 빠른 망에서는 하한까지 줄여 씁니다.
+     * 응답이 없는 /24 는 이 값을 그대로 쓰므로 느린 WAN 구간을 위해 크게 잡아도 됩니다.
+     * @param WaitTimeMs 대기 시간 (밀리초)
+     */
+    UFUNCTION(BlueprintCallable, Category = "PJLink|Discovery")
+    void SetPerAddressWaitTime(int32 WaitTimeMs) { PerAddressWaitTimeMs = FMath::Clamp(WaitTimeMs, 50, 30000); }
+
+    /**
+     * RTT 로 줄이는 각 IP당 연결 제한 시간의 하한 설정 (0 이면 줄이지 않음)
      * @param WaitTimeMs 대기 시간 (밀리초)
      */
     UFUNCTION(BlueprintCallable, Category = "PJLink|Discovery")
-    void SetPerAddressWaitTime(int32 WaitTimeMs) { PerAddressWaitTimeMs = FMath::Clamp(WaitTimeMs, 50, 5000); }
+    void SetMinPerAddressWaitTime(int32 WaitTimeMs) { MinPerAddressWaitTimeMs = FMath::Clamp(WaitTimeMs, 0, 30000); }
+
+    /**
+     * 발견된 장치의 식별 정보(NAME/INF1/INF2/INFO)를 동시에 조회할 최대 장치 수 설정
+     * 조회는 스윕과 별도로 진행되며, 나머지 장치는 대기열에서 순서대로 조회됩니다.
+     * @param MaxDevices 최대 동시 조회 장치 수
+     */
+    UFUNCTION(BlueprintCallable, Category = "PJLink|Discovery")
+    void SetMaxConcurrentEnrichments(int32 MaxDevices) { MaxConcurrentEnrichments = FMath::Clamp(MaxDevices, 1, 256); }
+
+    /**
+     * 범위/서브넷 스캔에서 동시에 진행할 최대 연결 수 설정
+     * /24 를 연결 제한 시간 한 번에 끝내려면 254 이상이어야 합니다.
+     * @param InMaxInFlight 최대 동시 연결 수
+     */
+    UFUNCTION(BlueprintCallable, Category = "PJLink|Discovery")
+    void SetMaxInFlight(int32 InMaxInFlight) { MaxInFlight = FMath::Clamp(InMaxInFlight, 1, 8192); }
+
+    /**
+     * 범위/서브넷 스캔에서 알려진 호스트 색인 사용 여부 설정
+     * 색인은 Saved/PJLink/KnownHosts 에 /24 마다 파일 하나로 저장되며, 검색이 끝날 때 갱신됩니다.
+     * @param bEnable 알려진 호스트를 먼저 확인하고 결과를 색인에 반영할지 여부
+     */
+    UFUNCTION(BlueprintCallable, Category = "PJLink|Discovery")
+    void SetUseKnownHosts(bool bEnable) { bUseKnownHosts = bEnable; }
+
+    /**
+     * 알려진 호스트 확인 뒤 나머지 주소를 스윕할 때의 최대 동시 연결 수 설정
+     * 뒤에서 도는 스윕이 제어 중인 프로젝터 연결과 네트워크를 덜 차지하도록 MaxInFlight 보다 낮게 둡니다.
+     * @param InMaxInFlight 최대 동시 연결 수
+     */
+    UFUNCTION(BlueprintCallable, Category = "PJLink|Discovery")
+    void SetBackgroundSweepMaxInFlight(int32 InMaxInFlight) { BackgroundSweepMaxInFlight = FMath::Clamp(InMaxInFlight, 1, 8192); }
+
+    /**
+     * 저장된 알려진 호스트 색인 삭제 (다음 스캔은 처음부터 전체 범위를 스윕)
+     */
+    UFUNCTION(BlueprintCallable, Category = "PJLink|Discovery")
+    void ClearKnownHosts();
 
     // 이벤트
     UPROPERTY(BlueprintAssignable, Category = "PJLink|Discovery|Events")
@@ -252,6 +451,10 @@ public:
     UPROPERTY(BlueprintAssignable, Category = "PJLink|Discovery|Events")
     FPJLinkDiscoveryProgressDelegate OnDiscoveryProgress;
 
+    // 알려진 호스트 색인과 비교한 새 장치/변경된 장치(식별 정보 조회 후)와 사라진 장치(스캔 끝)
+    UPROPERTY(BlueprintAssignable, Category = "PJLink|Discovery|Events")
+    FPJLinkDeviceChangedDelegate OnDeviceChanged;
+
     // 현재 스캔 중인 IP 주소 이벤트 (추가)
     DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FPJLinkCurrentScanAddressDelegate, const FString&, CurrentAddress);
 
@@ -261,31 +464,105 @@ public:
     UFUNCTION(BlueprintCallable, Category = "PJLink|Discovery|Diagnostic")
     FPJLinkDiagnosticData GetDiscoveryDiagnosticData() const { return DiscoveryDiagnosticData; }
 
+    // 검색 결과의 IPv4+포트를 64비트 키로 묶음 (중복 검사/정렬용)
+    static uint64 MakeEndpointKey(const FPJLinkDiscoveryResult& Result);
+    static uint64 MakeEndpointKey(uint32 IPv4, int32 Port);
+
+    // IP 문자열을 uint32로 변환 (호스트 바이트 순서, 형식이 잘못되면 0)
+    static uint32 IPStringToUint32(const FString& IPString);
+
+    // uint32를 IP 문자열로 변환
+    static FString Uint32ToIPString(uint32 IPAddress);
+
 private:
-    // 브로드캐스트 준비
-    bool SetupBroadcastSocket();
+    friend class FPJLinkBroadcastSearch;
 
-    // UDP 브로드캐스트 수행
-    void PerformBroadcastDiscovery(const FString& DiscoveryID, float TimeoutSeconds);
+    // 테스트에서 결과 색인을 직접 채워 중복 검사 비용 확인
+    friend class UPJLinkTests;
 
-    // IP 범위 스캔 수행
-    void PerformRangeScan(const FString& DiscoveryID, uint32 StartIP, uint32 EndIP, float TimeoutSeconds,
-        TAtomic<bool>* CancellationFlag = nullptr);
+    // UDP 브로드캐스트 수행 (검색 세션 시작, 실패 시 false)
+    bool PerformBroadcastDiscovery(const FString& DiscoveryID, float TimeoutSeconds);
 
-    // 서브넷 스캔 수행
-    void PerformSubnetScan(const FString& DiscoveryID, uint32 NetworkAddress, uint32 SubnetMask, float TimeoutSeconds);
+    // 브로드캐스트 검색 응답 처리 (게임 스레드)
+    void ProcessSearchReply(const FString& DiscoveryID, uint32 SourceIPv4, const FString& MacAddress, int32 ResponseTimeMs);
 
-    // 단일 IP 주소 스캔
-    void ScanIPAddress(const FString& DiscoveryID, const FString& IPAddress, float TimeoutSeconds);
+    // 검색 결과 추가 (중복이면 false, 새 장치면 OnDeviceDiscovered 발생)
+    bool AddDiscoveryResult(const FString& DiscoveryID, const FPJLinkDiscoveryResult& Result);
 
-    // 검색 결과 처리
-    void ProcessDiscoveryResponse(const FString& DiscoveryID, const FString& IPAddress,
+    // 식별 정보 조회 단계 생성 및 등록 (발견된 장치를 넘겨받아 스윕과 별도로 조회)
+    TSharedPtr<FPJLinkDiscoveryEnricher, ESPMode::ThreadSafe> StartEnricher(const FString& DiscoveryID);
+
+    // 식별 정보 조회 중지 및 최종 통계 반영
+    void StopEnricher(const FString& DiscoveryID);
+
+    // 식별 정보 조회 응답을 기존 결과에 반영하고 OnDeviceDiscovered 로 갱신된 결과 전달 (게임 스레드)
+    void ProcessEnrichment(const FString& DiscoveryID, uint32 IPv4, const FString& Response, bool bComplete);
+
+    // 조회 대기열이 비었을 때 (게임 스레드) - 스윕이 먼저 끝났으면 검색 완료
+    void HandleEnrichmentIdle(const FString& DiscoveryID);
+
+    // 스윕/브로드캐스트가 끝난 뒤 호출 - 조회가 남아 있으면 끝날 때까지 완료를 미룸 (게임 스레드)
+    void CompleteDiscoveryWhenEnriched(const FString& DiscoveryID);
+
+    // 조회 통계를 검색 상태에 복사 (DiscoveryLock 안에서 호출)
+    static void ApplyEnrichmentStats(FPJLinkDiscoveryStatus& Status, const FPJLinkEnrichmentStats& Stats);
+
+    // 응답 한 줄(%1CLSS=, %1NAME= 등)을 결과에 반영 (오류 응답이나 모르는 줄이면 false)
+    static bool ApplyIdentityLine(FPJLinkDiscoveryResult& Result, const FString& Line);
+
+    // 진행 중인 브로드캐스트 검색 세션 중지
+    void StopBroadcastSearch(const FString& DiscoveryID);
+
+    // IP 범위 스캔 시작 (양 끝 포함, 실패 시 false) - 알려진 호스트가 있으면 그 호스트부터 확인
+    bool StartScanEngine(const FString& DiscoveryID, uint32 FirstIP, uint32 LastIP, float TimeoutSeconds);
+
+    // 범위와 제한 시간으로 기본 스캔 설정 생성
+    FPJLinkScanSettings MakeScanSettings(uint32 FirstIP, uint32 LastIP, float TimeoutSeconds) const;
+
+    // 스캔 엔진 생성 및 시작 (bVerifyingKnownHosts 면 끝난 뒤 나머지 주소 스윕, 아니면 검색 완료)
+    bool LaunchScanEngine(const FString& DiscoveryID, const FPJLinkScanSettings& Settings, bool bVerifyingKnownHosts);
+
+    // 스캔 엔진 하나가 끝났을 때 (게임 스레드)
+    void HandleScanPhaseFinished(const FString& DiscoveryID, bool bVerifyingKnownHosts);
+
+    // 알려진 호스트 확인이 끝난 뒤 확인된 호스트를 빼고 나머지 주소 스윕 시작 (게임 스레드)
+    void StartBackgroundSweep(const FString& DiscoveryID);
+
+    // 식별 정보가 확정된 결과를 색인과 비교해 새 장치/변경된 장치 보고 (게임 스레드)
+    void ReportDeviceChange(const FString& DiscoveryID, const FPJLinkDiscoveryResult& Result);
+
+    // 검색 결과를 색인에 반영하고 사라진 장치 보고 (게임 스레드, 성공한 검색만 색인 갱신)
+    void FinishRescan(const FString& DiscoveryID, bool bSuccess, const TArray<FPJLinkDiscoveryResult>& Results);
+
+    // 알려진 호스트 색인 (처음 호출 시 생성)
+    FPJLinkKnownHostsIndex& GetKnownHostsIndex();
+
+    // 진행 중인 스캔 중지 및 종료 대기
+    void StopScan(const FString& DiscoveryID);
+
+    // 스캔 종료 통계 반영 (마지막 스캔 작업 스레드)
+    void HandleScanFinished(const FString& DiscoveryID, const FPJLinkScanStats& Stats);
+
+    // 스캔 통계를 검색 상태에 복사 (DiscoveryLock 안에서 호출)
+    static void ApplyScanStats(FPJLinkDiscoveryStatus& Status, const FPJLinkScanStats& Stats);
+
+    // 진행 상황 게시 티커 시작 (게임 스레드, 이미 실행 중이면 무시)
+    void StartProgressPublisher();
+
+    // 게시 주기마다 호출 (게시할 스캔이 없으면 false 를 반환해 티커 제거)
+    bool TickProgressPublisher(float DeltaTime);
+
+    // 스캔 통계를 읽어 바뀐 진행 상황과 현재 주소를 한 번에 이벤트로 발생 (게임 스레드)
+    void PublishProgress();
+
+    // 검색 결과 처리 (IP 문자열은 새 장치로 확인된 뒤에만 만듦)
+    void ProcessDiscoveryResponse(const FString& DiscoveryID, uint32 IPv4,
         const FString& Response, int32 ResponseTimeMs);
 
     // 검색 완료 처리
     void CompleteDiscovery(const FString& DiscoveryID, bool bSuccess);
 
-    // 검색 상태 업데이트
+    // 진행률 갱신 (이벤트는 다음 게시 주기에 발생, DiscoveryLock 안에서도 호출 가능)
     void UpdateDiscoveryProgress(const FString& DiscoveryID, int32 ScannedAddresses, int32 DiscoveredDevices);
 
     // 검색 타임아웃 처리
@@ -294,32 +571,45 @@ private:
     // 고유 ID 생성
     FString GenerateDiscoveryID() const;
 
-    // IP 문자열을 uint32로 변환
-    static uint32 IPStringToUint32(const FString& IPString);
-
-    // uint32를 IP 문자열로 변환
-    static FString Uint32ToIPString(uint32 IPAddress);
-
-    // UDP 소켓
-    class FSocket* BroadcastSocket;
+    // 진행 중인 브로드캐스트 검색 세션
+    TMap<FString, TSharedPtr<FPJLinkBroadcastSearch, ESPMode::ThreadSafe>> ActiveBroadcastSearches;
 
     // 브로드캐스트 포트
     int32 BroadcastPort = 4352;
 
+    // 브로드캐스트 대상 주소
+    FString BroadcastAddress = TEXT("255.255.255.255");
+
+    // 검색 명령 전송 횟수
+    int32 SearchTransmitCount = 3;
+
     // 기본 타임아웃 시간 (초)
     float DefaultTimeoutSeconds = 5.0f;
 
-    // 최대 동시 스레드 수
+    // 스캔 작업 스레드 수
     int32 MaxConcurrentThreads = 4;
 
-    // 각 IP당 대기 시간 (밀리초)
-    int32 PerAddressWaitTimeMs = 200;
+    // 각 IP당 연결 제한 시간 상한 / RTT 로 줄일 때의 하한 (밀리초)
+    int32 PerAddressWaitTimeMs = 1000;
+    int32 MinPerAddressWaitTimeMs = 250;
+
+    // 스캔 최대 동시 연결 수
+    int32 MaxInFlight = 1024;
+
+    // 식별 정보 최대 동시 조회 장치 수
+    int32 MaxConcurrentEnrichments = 16;
+
+    // 범위/서브넷 스캔에서 알려진 호스트 색인 사용
+    bool bUseKnownHosts = true;
+
+    // 알려진 호스트 확인 뒤 나머지 주소 스윕의 최대 동시 연결 수
+    int32 BackgroundSweepMaxInFlight = 256;
 
     // 진행 중인 검색 작업 상태
     TMap<FString, FPJLinkDiscoveryStatus> DiscoveryStatuses;
 
     // 검색 결과 저장
-    TMap<FString, TArray<FPJLinkDiscoveryResult>> DiscoveryResults;
+    TMap<FString, FPJLinkDiscoveryResultSet> DiscoveryResults;
 
     // 타이머 핸들 저장
     TMap<FString, FTimerHandle> DiscoveryTimerHandles;
@@ -327,19 +617,30 @@ private:
     // 검색 작업 동기화를 위한 임계 영역
     FCriticalSection DiscoveryLock;
 
-    // 검색 스레드 관리
-    TArray<class FRunnableThread*> ScanThreads;
-
     // 진단 데이터
     FPJLinkDiagnosticData DiscoveryDiagnosticData;
 
-    // 활성 스캔 작업 추적을 위한 맵
-    TMap<FString, class FAutoDeleteAsyncTask<FScanWorker>*> ActiveScanTasks;
+    // 활성 스캔 추적을 위한 맵
+    TMap<FString, TSharedPtr<FPJLinkScanEngine, ESPMode::ThreadSafe>> ActiveScans;
+
+    // 검색별 식별 정보 조회 단계
+    TMap<FString, TSharedPtr<FPJLinkDiscoveryEnricher, ESPMode::ThreadSafe>> ActiveEnrichers;
+
+    // 스윕은 끝났지만 식별 정보 조회가 남아 완료를 미룬 검색 (게임 스레드 전용)
+    TSet<FString> PendingCompletions;
+
+    // 알려진 호스트 색인을 쓰는 검색 (게임 스레드 전용)
+    TMap<FString, FPJLinkRescanState> ActiveRescans;
+
+    // 알려진 호스트 색인 (게임 스레드 전용)
+    TSharedPtr<FPJLinkKnownHostsIndex> KnownHostsIndex;
+
+    // 진행 이벤트 게시 주기 (초, 10 Hz)
+    static constexpr float ProgressPublishIntervalSeconds = 0.1f;
 
-    // 현재 스캔 중인 IP 주소 (실시간 업데이트용)
-    FString CurrentScanningIPAddress;
+    // 다음 게시 주기에 진행 이벤트를 발생시킬 검색 (DiscoveryLock 으로 보호)
+    TSet<FString> DirtyProgress;
 
-    // IP 스캔 시간 추적을 위한 변수
-    FDateTime LastIPScanTime;
-    FDateTime CurrentIPScanTime;
+    // 진행 상황 게시 티커 (게임 스레드 전용)
+    FTSTicker::FDelegateHandle ProgressTickerHandle;
 };
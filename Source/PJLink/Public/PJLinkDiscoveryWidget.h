@@ -574,6 +574,11 @@ private:
      */
     void SetupDiscovery();
 
+    /**
+     * 현재 결과 목록으로 중복 검사 색인 다시 만들기
+     */
+    void RebuildDiscoveredEndpointIndices();
+
     // 검색 매니저
     UPROPERTY()
     UPJLinkDiscoveryManager* DiscoveryManager;
@@ -585,6 +590,9 @@ private:
     UPROPERTY()
     TArray<FPJLinkDiscoveryResult> DiscoveryResults;
 
+    // DiscoveryResults 에 있는 장치의 IPv4+포트 키 (UPJLinkDiscoveryManager::MakeEndpointKey) -> 인덱스
+    TMap<uint64, int32> DiscoveredEndpointIndices;
+
     // 정렬 옵션
     UPROPERTY()
     EPJLinkDiscoverySortOption CurrentSortOption = EPJLinkDiscoverySortOption::ByIPAddress;
@@ -641,6 +649,9 @@ private:
     // 지연된 UI 업데이트 수행
     void PerformDeferredUIUpdate();
 
+    // 결과 목록 UI 갱신 요청 (UIUpdateInterval 안에 다시 요청되면 한 번으로 합침)
+    void RequestResultsUIUpdate();
+
     // 결과 목록 업데이트 준비
     void PrepareResultsUpdate(const TArray<FPJLinkDiscoveryResult>& Results);
 
@@ -0,0 +1,75 @@
+﻿// PJLinkEventDrainScheduler.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+
+class UPJLinkNetworkManager;
+
+/**
+ * 모든 네트워크 매니저가 공유하는 게임 스레드 이벤트 처리기
+ *
+ * 매니저마다 프레임 예산과 티커를 따로 두면 연결된 프로젝터 수만큼 예산이 늘어나므로,
+ * 프레임당 예산 하나를 이벤트가 쌓인 매니저들에게 돌아가며 나눠 줍니다.
+ * 한 매니저가 예산을 독차지하지 않도록 남은 예산을 대기 매니저 수로 나눠 주고,
+ * 예산이 떨어지면 다음 프레임에는 멈춘 자리의 다음 매니저부터 이어서 처리합니다.
+ *
+ * 게임 스레드에서만 사용합니다.
+ */
+class PJLINK_API FPJLinkEventDrainScheduler
+{
+    // 테스트에서 프레임 경계를 흉내 냄
+    friend class UPJLinkTests;
+
+public:
+    // 싱글톤 접근
+    static FPJLinkEventDrainScheduler& Get();
+
+    // 티커를 해제하고 대기 목록 정리 (모듈 종료 시 호출)
+    static void Shutdown();
+
+    // 이벤트가 쌓인 매니저를 대기 목록에 넣고 이번 프레임에 남은 예산으로 바로 처리
+    void Schedule(UPJLinkNetworkManager* Manager);
+
+    // 대기 목록에서 제거 (매니저 종료 시) - 반환 후에는 이 매니저를 호출하지 않음
+    void Remove(UPJLinkNetworkManager* Manager);
+
+    // 모든 매니저가 함께 쓰는 프레임당 처리 시간 (마이크로초)
+    void SetFrameBudgetMicroseconds(float InBudgetMicroseconds);
+    float GetFrameBudgetMicroseconds() const { return FrameBudgetMicroseconds; }
+
+    // 이번 프레임에 남은 예산 안에서 대기 매니저를 돌아가며 처리 (이번 호출에 쓴 시간 반환)
+    double DrainFrame();
+
+    // 처리할 이벤트가 남은 매니저 수
+    int32 GetNumPendingManagers() const;
+
+private:
+    FPJLinkEventDrainScheduler();
+    ~FPJLinkEventDrainScheduler();
+
+    // 남은 이벤트가 있으면 매 프레임 처리
+    bool Tick(float DeltaTime);
+
+    // 비운 자리 정리 (처리 중에 제거된 매니저는 nullptr 로 남겨 둠)
+    void CompactPendingManagers();
+
+    // 이벤트가 남은 매니저 (순서대로 돌아가며 처리)
+    TArray<UPJLinkNetworkManager*> PendingManagers;
+
+    // 다음 처리를 시작할 매니저 위치
+    int32 NextManagerIndex;
+
+    // 프레임별 예산 사용량
+    uint64 FrameNumber;
+    double FrameDrainSeconds;
+    float FrameBudgetMicroseconds;
+
+    // 대리자 안에서 다시 호출된 경우 무시
+    bool bDraining;
+
+    FTSTicker::FDelegateHandle TickerHandle;
+
+    static FPJLinkEventDrainScheduler* Instance;
+    static FCriticalSection InstanceLock;
+};
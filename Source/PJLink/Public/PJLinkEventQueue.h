@@ -0,0 +1,146 @@
+﻿// PJLinkEventQueue.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PJLinkTypes.h"
+#include "Containers/LockFreeList.h"
+
+// 게임 스레드로 전달되는 네트워크 이벤트 종류
+enum class EPJLinkEventType : uint8
+{
+    Response,           // 명령 응답 (타임아웃/응답 누락 포함)
+    CommunicationLog,   // 송수신 원문 로그
+    Error,              // 확장 오류
+    ConnectionChanged,  // 연결 상태 변경
+    ConnectCompleted    // 비동기 연결 시도 완료 (성공/실패)
+};
+
+/**
+ * 네트워크 이벤트 하나
+ *
+ * 종류별 필드를 한 구조체에 담아 문자열 인코딩/파싱 없이 전달합니다.
+ * 노드가 풀에서 재사용되므로 문자열 필드는 이전 이벤트의 버퍼 용량을 그대로 씁니다.
+ */
+struct PJLINK_API FPJLinkEvent
+{
+    EPJLinkEventType Type = EPJLinkEventType::Response;
+    EPJLinkCommand Command = EPJLinkCommand::POWR;
+    EPJLinkResponseStatus Status = EPJLinkResponseStatus::Unknown;
+    EPJLinkErrorCode ErrorCode = EPJLinkErrorCode::None;
+
+    // 프로젝터가 보낸 실제 응답인지 (내부 알림과 구분)
+    bool bFromProjector = false;
+
+    // 통신 로그: 송신 방향 여부
+    bool bIsSending = false;
+
+    // 연결 변경/연결 완료: 새 연결 상태
+    bool bIsConnected = false;
+
+    // 짝지어진 요청의 순번 (0 = 순번 없음)
+    int32 SequenceId = 0;
+
+    // 요청 전송부터 응답까지 걸린 시간
+    double RoundTripSeconds = 0.0;
+
+    // 큐에 들어간 시각 (FPlatformTime::Cycles64, 처리 지연 측정용)
+    uint64 EnqueueCycles = 0;
+
+    // 응답 파라미터 / 오류 메시지 / 통신 로그 원문
+    FString Text;
+
+    // 통신 로그의 명령 이름
+    FString Label;
+
+    // 값 초기화 (문자열 버퍼는 유지)
+    void Reset();
+};
+
+/**
+ * 풀링된 노드를 쓰는 락 없는 MPSC 이벤트 큐
+ *
+ * 생산자(I/O 스레드, 게임 스레드 등)는 Enqueue()로 풀에서 꺼낸 이벤트를 직접 채우고,
+ * 소비자 하나가 Drain()으로 꺼내 처리합니다. 처리된 노드는 풀로 돌아가므로
+ * 정상 상태에서는 생산/소비 모두 힙 할당이 없습니다.
+ */
+class PJLINK_API FPJLinkEventQueue
+{
+public:
+    FPJLinkEventQueue();
+    ~FPJLinkEventQueue();
+
+    FPJLinkEventQueue(const FPJLinkEventQueue&) = delete;
+    FPJLinkEventQueue& operator=(const FPJLinkEventQueue&) = delete;
+
+    // 이벤트 추가 (임의 스레드) - Fill(FPJLinkEvent&) 이 초기화된 이벤트를 채움
+    template<typename FillFunc>
+    void Enqueue(FillFunc&& Fill)
+    {
+        FNode* Node = AllocateNode();
+        Fill(Node->Event);
+        Push(Node);
+    }
+
+    // 이벤트를 최대 MaxEvents 개까지 꺼내 Visitor(const FPJLinkEvent&) 로 전달 (소비자 스레드 전용)
+    // Visitor 안에서 Enqueue 는 가능하지만 같은 큐의 Drain 을 다시 호출하면 안 됩니다.
+    template<typename VisitorFunc>
+    int32 Drain(VisitorFunc&& Visitor, int32 MaxEvents = MAX_int32)
+    {
+        int32 NumDrained = 0;
+        while (NumDrained < MaxEvents)
+        {
+            FNode* Node = PopNode();
+            if (!Node)
+            {
+                break;
+            }
+
+            Visitor(static_cast<const FPJLinkEvent&>(Node->Event));
+            ++NumDrained;
+        }
+        return NumDrained;
+    }
+
+    // 남은 이벤트 모두 버리기 (소비자 스레드 전용)
+    int32 Discard();
+
+    // 꺼낼 이벤트가 없는지 (소비자 스레드 전용)
+    bool IsEmpty() const;
+
+    // 대기 중인 이벤트 수 (근사값)
+    int32 Num() const { return NumQueued.load(std::memory_order_relaxed); }
+
+    // 풀에 보관 중인 노드 수 (근사값)
+    int32 GetNumPooled() const { return NumPooled.load(std::memory_order_relaxed); }
+
+private:
+    struct FNode
+    {
+        TAtomic<FNode*> Next;
+        FPJLinkEvent Event;
+
+        FNode() : Next(nullptr) {}
+    };
+
+    FNode* AllocateNode();
+    void ReleaseNode(FNode* Node);
+    void Push(FNode* Node);
+
+    // 다음 노드를 꺼내 새 더미 노드로 삼고 이전 더미는 풀로 반환
+    FNode* PopNode();
+
+    // 생산자가 교환하는 마지막 노드
+    TAtomic<FNode*> Head;
+
+    // 소비자 전용 더미 노드 (다음 노드가 가장 오래된 이벤트)
+    FNode* Tail;
+
+    // 재사용 노드 풀
+    TLockFreePointerListUnordered<FNode, PLATFORM_CACHE_LINE_SIZE> FreeNodes;
+
+    TAtomic<int32> NumQueued;
+    TAtomic<int32> NumPooled;
+
+    // 풀에 보관하는 최대 노드 수 (폭주 후 메모리가 계속 남지 않도록)
+    static constexpr int32 MaxPooledNodes = 4096;
+};
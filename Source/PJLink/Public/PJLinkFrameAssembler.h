@@ -0,0 +1,78 @@
+﻿// PJLinkFrameAssembler.h
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * CR(0x0D)로 끝나는 PJLink 응답 프레임 재조립기
+ *
+ * TCP 수신은 메시지 경계를 보장하지 않으므로 한 번의 Recv 에 여러 응답이 들어오거나
+ * 하나의 응답이 여러 Recv 로 나뉘어 들어올 수 있습니다.
+ * 고정 크기 링 버퍼에 바이트를 쌓아 두고 완성된 프레임만 꺼내며, 프레임마다 메모리를 할당하지 않습니다.
+ *
+ * 연결 하나당 하나씩 두고 해당 연결의 I/O 스레드에서만 사용합니다 (스레드 안전하지 않음).
+ */
+class PJLINK_API FPJLinkFrameAssembler
+{
+public:
+    // 링 버퍼 크기 (2의 거듭제곱)
+    static constexpr int32 Capacity = 4096;
+
+    // 프레임 최대 길이 - PJLink 응답은 최대 수백 바이트이므로 이보다 긴 줄은 버림
+    static constexpr int32 MaxFrameLength = 1024;
+
+    FPJLinkFrameAssembler();
+
+    // 수신 데이터를 넣고 완성된 프레임마다 Handler(const uint8* Frame, int32 Length) 호출
+    // Frame 은 종료 문자(CR)를 포함하지 않으며, 다음 Feed/Reset 호출 전까지만 유효함
+    template <typename FrameHandlerType>
+    void Feed(const uint8* Data, int32 Length, FrameHandlerType&& Handler)
+    {
+        while (Length > 0)
+        {
+            const int32 Written = Write(Data, Length);
+            Data += Written;
+            Length -= Written;
+
+            const uint8* Frame = nullptr;
+            int32 FrameLength = 0;
+            while (NextFrame(Frame, FrameLength))
+            {
+                Handler(Frame, FrameLength);
+            }
+        }
+    }
+
+    // 링 버퍼에 데이터 복사 (복사한 바이트 수 반환, 남은 공간만큼만 복사)
+    int32 Write(const uint8* Data, int32 Length);
+
+    // 완성된 프레임 하나 꺼내기 (없으면 false)
+    bool NextFrame(const uint8*& OutFrame, int32& OutLength);
+
+    // 버퍼 비우기 (재연결 시)
+    void Reset();
+
+    // 아직 종료 문자가 오지 않은 바이트 수
+    int32 GetPendingBytes() const { return static_cast<int32>(Tail - Head); }
+
+    // 너무 길어서 버린 프레임 수
+    int32 GetNumDiscardedFrames() const { return NumDiscardedFrames; }
+
+private:
+    static constexpr uint32 IndexMask = Capacity - 1;
+
+    // 링 버퍼 (Head/Tail/ScanPos 는 단조 증가하는 위치, 실제 인덱스는 & IndexMask)
+    uint8 Ring[Capacity];
+    uint32 Head;
+    uint32 Tail;
+
+    // 종료 문자를 찾지 못한 것으로 확인된 위치 (재검색 방지)
+    uint32 ScanPos;
+
+    // 너무 긴 프레임을 버리는 중 (다음 CR 까지 무시)
+    bool bDiscarding;
+    int32 NumDiscardedFrames;
+
+    // 링 끝에서 감긴 프레임을 이어 붙이는 임시 버퍼
+    uint8 Scratch[MaxFrameLength];
+};
@@ -0,0 +1,102 @@
+﻿// PJLinkIOReactor.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PJLinkSocketPlatform.h"
+#include "PJLinkTimingWheel.h"
+
+class FPJLinkReactorShard;
+
+/**
+ * 리액터에 등록된 소켓의 이벤트 처리기
+ * 모든 콜백은 해당 소켓을 소유한 I/O 스레드에서 호출됩니다.
+ */
+class PJLINK_API IPJLinkIOHandler
+{
+public:
+    virtual ~IPJLinkIOHandler() {}
+
+    // 읽을 데이터가 있거나 원격에서 연결을 닫았을 때
+    virtual void OnReadable() = 0;
+
+    // 소켓에 쓸 수 있을 때 (Writable 관심 등록 시에만)
+    virtual void OnWritable() = 0;
+
+    // poll 이 소켓 오류를 보고했을 때
+    virtual void OnPollError() = 0;
+};
+
+using FPJLinkIOHandlerRef = TSharedRef<IPJLinkIOHandler, ESPMode::ThreadSafe>;
+
+/**
+ * 모든 PJLink 소켓을 소유하는 준비 상태 기반(poll) I/O 리액터
+ *
+ * 프로젝터마다 수신 스레드를 두는 대신, 고정된 수의 I/O 스레드(샤드)가
+ * 등록된 소켓 전체를 poll 로 감시하고 이벤트를 각 연결 처리기로 전달합니다.
+ * 스레드 수는 연결된 프로젝터 수와 무관합니다.
+ *
+ * 각 I/O 스레드는 타이밍 휠을 하나씩 가지며, poll 대기 시간을 다음 타이머 마감에 맞춥니다.
+ * 명령 타임아웃 같은 타이머는 UWorld/게임 스레드 없이 I/O 스레드에서 호출됩니다.
+ */
+class PJLINK_API FPJLinkIOReactor
+{
+public:
+    // 싱글톤 접근 (처음 호출 시 I/O 스레드 생성)
+    static FPJLinkIOReactor& Get();
+
+    // 모든 I/O 스레드 종료 및 등록된 소켓 정리 (모듈 종료 시 호출)
+    static void Shutdown();
+
+    // 리액터 생성 전에 I/O 스레드 수 지정 (0 = 코어 수 기반 자동)
+    static void SetDesiredThreadCount(int32 ThreadCount);
+
+    // 소켓 등록 (Interest 는 PJLinkSocketPlatform::EPollFlags 조합)
+    void Register(PJLinkSocketPlatform::FNativeSocket Socket, const FPJLinkIOHandlerRef& Handler, uint8 Interest);
+
+    // 관심 이벤트 변경
+    void SetInterest(PJLinkSocketPlatform::FNativeSocket Socket, uint8 Interest);
+
+    // 등록 해제 (bCloseSocket 이면 I/O 스레드가 poll 목록에서 제거한 뒤 소켓을 닫음)
+    void Unregister(PJLinkSocketPlatform::FNativeSocket Socket, bool bCloseSocket = true);
+
+    // 타이머 예약 (임의 스레드에서 호출 가능, 콜백은 I/O 스레드에서 호출)
+    FPJLinkTimerId ScheduleTimer(double DelaySeconds, TUniqueFunction<void()>&& Callback);
+
+    // 소켓과 같은 I/O 스레드에서 호출되는 타이머 예약 (소켓 콜백과 순서가 섞이지 않음)
+    FPJLinkTimerId ScheduleSocketTimer(PJLinkSocketPlatform::FNativeSocket Socket, double DelaySeconds,
+        TUniqueFunction<void()>&& Callback);
+
+    // 타이머 취소 (이미 호출된 타이머면 무시)
+    void CancelTimer(FPJLinkTimerId TimerId);
+
+    // 예약된 타이머 수 (I/O 스레드가 마지막으로 반영한 값)
+    int32 GetNumPendingTimers() const;
+
+    // I/O 스레드 수
+    int32 GetNumThreads() const { return Shards.Num(); }
+
+    // 등록된 소켓 수
+    int32 GetNumRegistered() const;
+
+    // 현재 스레드가 리액터 I/O 스레드인지 확인
+    static bool IsInIOThread();
+
+private:
+    explicit FPJLinkIOReactor(int32 ThreadCount);
+    ~FPJLinkIOReactor();
+
+    FPJLinkReactorShard& GetShard(PJLinkSocketPlatform::FNativeSocket Socket) const;
+
+    FPJLinkTimerId ScheduleTimerOnShard(FPJLinkReactorShard& Shard, uint64 Serial, double DelaySeconds,
+        TUniqueFunction<void()>&& Callback);
+
+    // 타이머 식별자 하위 비트에 담는 샤드 번호 폭
+    static constexpr int32 TimerShardBits = 8;
+
+    TArray<FPJLinkReactorShard*> Shards;
+    TAtomic<uint64> NextTimerSerial;
+
+    static FPJLinkIOReactor* Instance;
+    static FCriticalSection InstanceLock;
+    static int32 DesiredThreadCount;
+};
@@ -0,0 +1,62 @@
+﻿// PJLinkIOThreadPool.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/ThreadingBase.h"
+
+class FQueuedThreadPool;
+
+/**
+ * 플러그인 전용 I/O 작업 스레드 풀
+ *
+ * 스캔처럼 poll 에서 오래 대기하는 작업을 엔진 공유 풀(GThreadPool)에 넣으면 텍스처 스트리밍이나
+ * 에셋 로딩 같은 엔진 비동기 작업이 밀려나므로, 플러그인이 크기와 우선순위를 정한 별도 풀을 소유합니다.
+ * 스레드 수를 넘는 작업은 큐에서 기다렸다가 앞선 작업이 끝나면 실행됩니다.
+ * 연결 송수신은 이 풀이 아니라 리액터 I/O 스레드가 처리합니다.
+ */
+class PJLINK_API FPJLinkIOThreadPool
+{
+public:
+    // 싱글톤 접근 (처음 호출 시 스레드 생성)
+    static FPJLinkIOThreadPool& Get();
+
+    // 풀 스레드 종료 (모듈 종료 시 호출, 실행 중인 작업이 끝날 때까지 대기하고 큐에 남은 작업은 포기)
+    static void Shutdown();
+
+    // 풀 생성 전에 스레드 수 지정 (0 = 코어 수 기반 자동)
+    static void SetDesiredThreadCount(int32 ThreadCount);
+
+    // 풀 생성 전에 스레드 우선순위 지정
+    static void SetDesiredThreadPriority(EThreadPriority Priority);
+
+    // 작업 실행 요청 (빈 스레드가 없으면 큐에서 대기, 풀을 만들지 못했으면 false)
+    // 풀 종료 때까지 시작하지 못한 작업은 실행하지 않고 OnAbandoned 만 호출 (완료 대기자를 깨우는 용도)
+    bool Launch(TUniqueFunction<void()>&& Work, TUniqueFunction<void()>&& OnAbandoned = nullptr);
+
+    // 스레드 수
+    int32 GetNumThreads() const { return NumThreads; }
+
+    // 실행 중인 작업 수 / 큐에서 기다리는 작업 수
+    int32 GetNumActive() const { return NumActive.load(); }
+    int32 GetNumQueued() const { return NumQueued.load(); }
+
+    // 스레드 수 상한
+    static constexpr int32 MaxThreadCount = 16;
+
+private:
+    class FWork;
+
+    FPJLinkIOThreadPool(int32 InNumThreads, EThreadPriority InPriority);
+    ~FPJLinkIOThreadPool();
+
+    FQueuedThreadPool* Pool;
+    int32 NumThreads;
+
+    TAtomic<int32> NumActive;
+    TAtomic<int32> NumQueued;
+
+    static FPJLinkIOThreadPool* Instance;
+    static FCriticalSection InstanceLock;
+    static int32 DesiredThreadCount;
+    static EThreadPriority DesiredThreadPriority;
+};
@@ -0,0 +1,88 @@
+﻿// PJLinkKnownHostsIndex.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PJLinkDiscoveryManager.h"
+
+/**
+ * 알려진 호스트 하나
+ */
+struct PJLINK_API FPJLinkKnownHost
+{
+    // 마지막으로 응답했을 때의 검색 결과 (DiscoveryTime = 마지막 응답 시각, ResponseTimeMs = 그때의 응답 시간)
+    FPJLinkDiscoveryResult Device;
+
+    // 마지막 응답 뒤 연속으로 응답하지 않은 스캔 수
+    int32 MissedScans = 0;
+};
+
+/**
+ * 범위/서브넷 스캔에서 응답한 장치의 색인 (/24 마다 JSON 파일 하나로 저장)
+ *
+ * 다시 스캔할 때 범위 안의 알려진 호스트를 먼저 확인하고 나머지 주소만 스윕하는 데 씁니다.
+ * 파일은 스캔 범위에 걸친 /24 만 처음 필요할 때 읽고, 바뀐 /24 만 다시 씁니다.
+ * MaxMissedScans 번 연속으로 응답하지 않은 호스트는 색인에서 빠집니다.
+ * 게임 스레드에서만 사용합니다.
+ */
+class PJLINK_API FPJLinkKnownHostsIndex
+{
+public:
+    // 이 횟수만큼 연속으로 응답하지 않으면 색인에서 제거
+    static constexpr int32 MaxMissedScans = 3;
+
+    explicit FPJLinkKnownHostsIndex(const FString& InDirectory);
+
+    // 범위 안(양 끝 포함)에서 Port 로 응답했던 호스트 (주소 순)
+    void FindHostsInRange(uint32 FirstIPv4, uint32 LastIPv4, int32 Port, TArray<FPJLinkKnownHost>& OutHosts);
+
+    // 알려진 호스트 (없으면 nullptr, 다음 갱신 전까지만 유효)
+    const FPJLinkKnownHost* FindHost(uint32 IPv4, int32 Port);
+
+    // 응답한 장치 기록 (식별 정보, 마지막 응답 시각과 응답 시간 갱신)
+    void RecordSeen(const FPJLinkDiscoveryResult& Result);
+
+    // 다시 확인했는데 응답하지 않은 호스트 기록 (MaxMissedScans 번째면 제거하고 true)
+    bool RecordMissed(uint32 IPv4, int32 Port);
+
+    // 바뀐 /24 파일 저장 (호스트가 남지 않은 /24 는 파일 삭제, 하나라도 실패하면 false)
+    bool Save();
+
+    // 저장된 파일을 모두 지우고 색인 비우기
+    void Clear();
+
+    // 저장 디렉터리
+    const FString& GetDirectory() const { return Directory; }
+
+    // 식별 정보가 바뀌었는지 (Current 에서 비어 있는 항목은 조회하지 못한 것으로 보고 비교하지 않음)
+    static bool HasIdentityChanged(const FPJLinkDiscoveryResult& Known, const FPJLinkDiscoveryResult& Current);
+
+private:
+    // /24 하나의 호스트 (IPv4+포트 키)
+    struct FSubnetHosts
+    {
+        TMap<uint64, FPJLinkKnownHost> Hosts;
+        bool bDirty = false;
+    };
+
+    // /24 의 호스트 (처음이면 파일에서 읽음, Subnet = IPv4 >> 8)
+    FSubnetHosts& GetSubnet(uint32 Subnet);
+
+    // 저장된 /24 목록을 한 번만 읽음
+    void ScanDirectory();
+
+    // /24 파일 읽기/쓰기
+    void LoadSubnet(uint32 Subnet, FSubnetHosts& OutHosts) const;
+    bool SaveSubnet(uint32 Subnet, const FSubnetHosts& Hosts);
+
+    // /24 파일 경로 (예: 192.168.1.json)
+    FString GetSubnetFilePath(uint32 Subnet) const;
+
+    FString Directory;
+
+    // 읽은 /24
+    TMap<uint32, FSubnetHosts> Subnets;
+
+    // 파일이 있는 /24
+    TSet<uint32> StoredSubnets;
+    bool bScannedDirectory;
+};
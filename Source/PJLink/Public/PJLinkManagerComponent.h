@@ -5,6 +5,7 @@
 #include "Components/ActorComponent.h"
 #include "PJLinkTypes.h"
 #include "UPJLinkComponent.h"
+#include "PJLinkNativeEvents.h"
 #include "PJLinkManagerComponent.generated.h"
 
 /**
@@ -317,6 +318,12 @@ public:
     UPROPERTY(BlueprintAssignable, Category = "PJLink|Manager|Events")
     FPJLinkGroupCommandCompletedDelegate OnGroupCommandCompleted;
 
+    /**
+     * C++ 전용 네이티브 이벤트 (관리 중인 모든 프로젝터의 이벤트를 I/O 스레드에서 그대로 전달)
+     * 첫 인자인 네트워크 매니저로 보낸 프로젝터를 구분합니다.
+     */
+    FPJLinkNativeEvents& GetNativeEvents() { return NativeEvents; }
+
 
     //---------- 상태 추적 함수 ----------//
 
@@ -383,6 +390,9 @@ public:
     
 
 private:
+    // 프로젝터 컴포넌트에서 모은 네이티브 이벤트
+    FPJLinkNativeEvents NativeEvents;
+
     // 진행 중인 명령 결과 맵
     TMap<FString, FPJLinkGroupCommandResult> CommandResults;
 
@@ -408,6 +418,9 @@ private:
     UFUNCTION()
     void HandleCommandCompleted(UPJLinkComponent* ProjectorComponent, EPJLinkCommand Command, bool bSuccess);
 
+    // 비동기 연결 결과 처리 (게임 스레드)
+    void HandleConnectResult(const FString& CommandID, const FString& ProjectorID, bool bConnected);
+
     // 명령 타임아웃 핸들러
     void HandleCommandTimeout(const FString& CommandID);
 
@@ -0,0 +1,61 @@
+﻿// PJLinkNativeEvents.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PJLinkTypes.h"
+
+class UPJLinkNetworkManager;
+
+/**
+ * 네이티브 응답 페이로드
+ * 파라미터는 수신 프레임을 그대로 가리키므로 콜백 안에서만 유효합니다.
+ */
+struct FPJLinkNativeResponse
+{
+    // 짝지어진 요청의 순번 (0 = 순번 없음)
+    int32 SequenceId = 0;
+
+    EPJLinkCommand Command = EPJLinkCommand::POWR;
+    EPJLinkResponseStatus Status = EPJLinkResponseStatus::Unknown;
+
+    // 응답 파라미터 원문 ('=' 뒤, CR 제외)
+    FAnsiStringView Parameter;
+
+    // 요청 전송부터 응답까지 걸린 시간 (짝이 없으면 0)
+    double RoundTripSeconds = 0.0;
+
+    // 프로젝터가 보낸 실제 응답인지 (타임아웃/응답 누락 알림과 구분)
+    bool bFromProjector = false;
+};
+
+// C++ 전용 네이티브 대리자 - 첫 인자는 이벤트를 보낸 네트워크 매니저
+DECLARE_TS_MULTICAST_DELEGATE_TwoParams(FPJLinkNativeResponseEvent, UPJLinkNetworkManager*, const FPJLinkNativeResponse&);
+DECLARE_TS_MULTICAST_DELEGATE_TwoParams(FPJLinkNativeConnectionEvent, UPJLinkNetworkManager*, bool /*bIsConnected*/);
+DECLARE_TS_MULTICAST_DELEGATE_ThreeParams(FPJLinkNativePowerStatusEvent, UPJLinkNetworkManager*, EPJLinkPowerStatus /*OldStatus*/, EPJLinkPowerStatus /*NewStatus*/);
+DECLARE_TS_MULTICAST_DELEGATE_ThreeParams(FPJLinkNativeInputSourceEvent, UPJLinkNetworkManager*, EPJLinkInputSource /*OldSource*/, EPJLinkInputSource /*NewSource*/);
+DECLARE_TS_MULTICAST_DELEGATE_FourParams(FPJLinkNativeErrorEvent, UPJLinkNetworkManager*, EPJLinkErrorCode, FStringView /*Message*/, EPJLinkCommand /*RelatedCommand*/);
+DECLARE_TS_MULTICAST_DELEGATE_FourParams(FPJLinkNativeCommunicationLogEvent, UPJLinkNetworkManager*, bool /*bIsSending*/, const TCHAR* /*CommandOrResponse*/, TArrayView<const uint8> /*RawData*/);
+
+/**
+ * C++ 제어 계층용 네이티브 이벤트 묶음
+ *
+ * 동적(블루프린트) 대리자와 달리 리플렉션과 게임 스레드 큐를 거치지 않고,
+ * 이벤트가 생긴 스레드(대부분 리액터 I/O 스레드)에서 바로 호출됩니다.
+ * 처리기는 짧게 끝내야 하며 UObject 상태를 건드리려면 직접 게임 스레드로 넘겨야 합니다.
+ * 스레드 안전 대리자이므로 어느 스레드에서든 바인딩/해제할 수 있습니다.
+ */
+struct PJLINK_API FPJLinkNativeEvents
+{
+    FPJLinkNativeResponseEvent OnResponse;
+    FPJLinkNativeConnectionEvent OnConnectionChanged;
+    FPJLinkNativePowerStatusEvent OnPowerStatusChanged;
+    FPJLinkNativeInputSourceEvent OnInputSourceChanged;
+    FPJLinkNativeErrorEvent OnError;
+    FPJLinkNativeCommunicationLogEvent OnCommunicationLog;
+
+    // 모든 이벤트를 Target 으로 그대로 전달 (Owner 가 사라지면 전달 중단)
+    void ForwardTo(FPJLinkNativeEvents& Target, UObject* Owner);
+
+    // Owner 로 바인딩된 처리기 모두 해제
+    void RemoveAll(const void* Owner);
+};
@@ -3,35 +3,81 @@
 
 #include "CoreMinimal.h"
 #include "PJLinkTypes.h"
-#include "HAL/Runnable.h"
+#include "PJLinkConnection.h"
+#include "PJLinkFrameAssembler.h"
+#include "PJLinkResponseParser.h"
+#include "PJLinkEventQueue.h"
+#include "PJLinkNativeEvents.h"
+#include "Containers/Queue.h"
+#include "Async/Future.h"
 #include "UObject/NoExportTypes.h"
 #include "PJLinkNetworkManager.generated.h"
 
-// 필요한 전방 선언 
-class FSocket;
-class FRunnableThread;
-
 // 네트워크 응답 대리자
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FPJLinkResponseDelegate, EPJLinkCommand, Command, EPJLinkResponseStatus, Status, const FString&, Response);
 
+// 순번이 매겨진 명령의 응답 대리자 (타임아웃/응답 누락은 Status = NoResponse)
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_FourParams(FPJLinkSequencedResponseDelegate, int32, SequenceId, EPJLinkCommand, Command, EPJLinkResponseStatus, Status, const FString&, Response);
+
+// 비동기 연결 완료 대리자 (실패 시 ErrorCode 에 원인)
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FPJLinkConnectCompletedDelegate, bool, bSuccess, EPJLinkErrorCode, ErrorCode);
+
+// 비동기 연결 진행 단계
+enum class EPJLinkConnectPhase : uint8
+{
+    Idle,           // 연결 시도 없음
+    Connecting,     // TCP 연결 대기
+    Handshaking,    // 인증 인사말 대기
+    Connected       // 연결 완료
+};
+
 // 명령 추적을 위한 구조체
 struct FPJLinkCommandInfo
 {
-    EPJLinkCommand Command;
+    int32 SequenceId = 0;
+    EPJLinkCommand Command = EPJLinkCommand::POWR;
+    double SendTime = 0.0;
+    float TimeoutSeconds = 0.0f;
+
+    // 리액터 타이밍 휠에 예약된 타임아웃 (0 = 없음)
+    FPJLinkTimerId TimeoutTimerId = 0;
+
+    // 타임아웃이 이미 보고됨 - 늦게 도착한 응답이 다음 요청과 짝지어지지 않도록 자리만 유지
+    bool bTimedOut = false;
+};
+
+// 일괄 전송할 명령 하나
+struct FPJLinkBatchCommand
+{
+    EPJLinkCommand Command = EPJLinkCommand::POWR;
     FString Parameter;
-    double SendTime;
-    float TimeoutSeconds;
-    bool bResponseReceived;
+
+    FPJLinkBatchCommand() {}
+    FPJLinkBatchCommand(EPJLinkCommand InCommand, const FString& InParameter)
+        : Command(InCommand), Parameter(InParameter) {}
 };
 
 /**
  * PJLink 네트워크 통신을 관리하는 클래스
+ * 소켓 I/O 는 공유 리액터(FPJLinkIOReactor)가 담당하며, 이 객체는 프로젝터 하나의 세션 상태만 가집니다.
  */
 UCLASS(BlueprintType, Blueprintable)
-class PJLINK_API UPJLinkNetworkManager : public UObject, public FRunnable
+class PJLINK_API UPJLinkNetworkManager : public UObject, public IPJLinkConnectionListener
 {
     GENERATED_BODY()
 
+    // 테스트에서 응답 큐와 내부 상태를 직접 확인
+    friend class UPJLinkTests;
+
+    // 재연결 스케줄러가 AttemptReconnect 호출
+    friend class FPJLinkReconnectScheduler;
+
+    // 알림 수신기가 HandleNotificationFrame 호출
+    friend class FPJLinkNotificationListener;
+
+    // 공유 이벤트 처리기가 DrainEvents 호출
+    friend class FPJLinkEventDrainScheduler;
+
 public:
     UPJLinkNetworkManager();
     virtual ~UPJLinkNetworkManager();
@@ -43,7 +89,19 @@ public:
     UFUNCTION(BlueprintCallable, Category = "PJLink|Network")
     bool ConnectToProjector(const FPJLinkProjectorInfo& ProjectorInfo, float TimeoutSeconds = 5.0f);
 
-    // 프로젝터 연결 해제
+    // 비동기 연결 시작 (게임 스레드를 막지 않음, 즉시 실패하면 false)
+    // TCP 연결과 인증은 리액터 I/O 스레드에서 진행되며 결과는 OnConnectCompleted 로 전달됩니다.
+    UFUNCTION(BlueprintCallable, Category = "PJLink|Network")
+    bool ConnectToProjectorAsync(const FPJLinkProjectorInfo& ProjectorInfo, float TimeoutSeconds = 5.0f);
+
+    // 비동기 연결 시작 (C++ 전용, 반환된 TFuture 는 I/O 스레드에서 완료됨)
+    TFuture<bool> StartConnect(const FPJLinkProjectorInfo& ProjectorInfo, float TimeoutSeconds = 5.0f);
+
+    // 비동기 연결 진행 중 여부
+    UFUNCTION(BlueprintPure, Category = "PJLink|Network")
+    bool IsConnecting() const;
+
+    // 프로젝터 연결 해제 (진행 중인 비동기 연결은 실패로 완료)
     UFUNCTION(BlueprintCallable, Category = "PJLink|Network")
     void DisconnectFromProjector();
 
@@ -51,6 +109,20 @@ public:
     UFUNCTION(BlueprintCallable, Category = "PJLink|Network")
     bool SendCommand(EPJLinkCommand Command, const FString& Parameter = "");
 
+    // 순번을 붙여 명령 전송 (실패 시 0 반환, TimeoutSeconds <= 0 이면 타임아웃 없음)
+    // 응답을 기다리지 않으므로 여러 명령을 한 연결에 연달아 보낼 수 있으며,
+    // 각 응답/타임아웃은 OnSequencedResponse 로 해당 순번과 함께 전달됩니다.
+    UFUNCTION(BlueprintCallable, Category = "PJLink|Network")
+    int32 SendCommandWithSequence(EPJLinkCommand Command, const FString& Parameter = TEXT(""), float TimeoutSeconds = 5.0f);
+
+    // 여러 명령을 버퍼 하나에 인코딩해 한 번의 송신으로 전송 (C++ 전용)
+    // 각 명령에는 연속된 순번이 붙으며 첫 번째 순번을 반환합니다 (실패 시 0).
+    int32 SendCommandBatch(TArrayView<const FPJLinkBatchCommand> Commands, float TimeoutSeconds = 0.0f);
+
+    // 응답을 기다리는 명령 수
+    UFUNCTION(BlueprintPure, Category = "PJLink|Network")
+    int32 GetInFlightCommandCount() const;
+
     // 현재 연결된 프로젝터 정보 가져오기
     UFUNCTION(BlueprintCallable, Category = "PJLink|Network")
     FPJLinkProjectorInfo GetProjectorInfo() const;
@@ -79,6 +151,10 @@ public:
     UPROPERTY(BlueprintAssignable, Category = "PJLink|Events")
     FPJLinkResponseDelegate OnResponseReceived;
 
+    // 순번 응답 이벤트 (SendCommandWithSequence 로 보낸 명령마다 한 번)
+    UPROPERTY(BlueprintAssignable, Category = "PJLink|Events")
+    FPJLinkSequencedResponseDelegate OnSequencedResponse;
+
     // 통신 로그 이벤트
     UPROPERTY(BlueprintAssignable, Category = "PJLink|Debug")
     FPJLinkCommunicationLogDelegate OnCommunicationLog;
@@ -90,22 +166,53 @@ public:
     // private 영역에 로깅 함수 추가
     void LogCommunication(bool bIsSending, const FString& CommandOrResponse, const FString& RawData);
 
+    // 송수신 원문 바이트를 그대로 받는 통신 로그 (중간 FString 없이 이벤트 버퍼로 변환)
+    void LogCommunication(bool bIsSending, const TCHAR* CommandOrResponse, const uint8* Data, int32 Length);
+
     // 확장된 오류 이벤트
     UPROPERTY(BlueprintAssignable, Category = "PJLink|Events")
     FPJLinkExtendedErrorDelegate OnExtendedError;
 
+    // 연결 상태 변경 이벤트
+    UPROPERTY(BlueprintAssignable, Category = "PJLink|Events")
+    FPJLinkConnectionChangedDelegate OnConnectionChanged;
+
+    // 비동기 연결 완료 이벤트 (ConnectToProjectorAsync/StartConnect 호출마다 한 번)
+    UPROPERTY(BlueprintAssignable, Category = "PJLink|Events")
+    FPJLinkConnectCompletedDelegate OnConnectCompleted;
+
+    // C++ 전용 네이티브 이벤트 (게임 스레드 큐 없이 I/O 스레드에서 바로 호출)
+    // 블루프린트 대리자는 그대로 게임 스레드에서 호출되며, 두 경로는 서로 독립적입니다.
+    FPJLinkNativeEvents& GetNativeEvents() { return NativeEvents; }
+
     // 오류 발생 함수
     void EmitError(EPJLinkErrorCode ErrorCode, const FString& ErrorMessage, EPJLinkCommand RelatedCommand = EPJLinkCommand::POWR);
 
     // 마지막 오류 메시지 가져오기
     UFUNCTION(BlueprintPure, Category = "PJLink|Error")
-    FString GetLastErrorMessage() const { return LastErrorMessage; }
+    FString GetLastErrorMessage() const;
+
+    // 마지막 오류 코드 가져오기
+    UFUNCTION(BlueprintPure, Category = "PJLink|Error")
+    EPJLinkErrorCode GetLastErrorCode() const;
+
+    // 대기 이벤트가 이 수를 넘으면 통신 로그 이벤트를 버림 (응답/오류는 버리지 않음)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PJLink|Performance", meta = (ClampMin = 100))
+    int32 MaxQueuedEvents = 10000;
+
+    // 이벤트 처리 통계
+    UFUNCTION(BlueprintPure, Category = "PJLink|Performance")
+    FPJLinkEventQueueStats GetEventQueueStats() const;
+
+    // 이벤트 처리 통계 초기화
+    UFUNCTION(BlueprintCallable, Category = "PJLink|Performance")
+    void ResetEventQueueStats();
 
     // 자동 재연결 설정
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PJLink|Connection")
     bool bAutoReconnect = true;
 
-    // 재연결 시도 간격 (초)
+    // 재연결 백오프 기준 간격 (초) - 실패할 때마다 두 배로 늘고, 실제 대기는 0 ~ 백오프 사이 무작위
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PJLink|Connection", meta = (EditCondition = "bAutoReconnect", UIMin = 1.0, UIMax = 10.0))
     float ReconnectInterval = 3.0f;
 
@@ -113,6 +220,42 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PJLink|Connection", meta = (EditCondition = "bAutoReconnect", UIMin = 0, UIMax = 10))
     int32 MaxReconnectAttempts = 3;
 
+    // 세션 유지 방식 (유휴 종료 후 필요할 때 다시 연결 / 조회로 세션 유지)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PJLink|Session")
+    EPJLinkSessionPolicy SessionPolicy = EPJLinkSessionPolicy::ReconnectOnDemand;
+
+    // 프로젝터가 유휴 세션을 닫기까지의 시간 (초)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PJLink|Session", meta = (ClampMin = 0.1, UIMin = 5.0, UIMax = 120.0))
+    float SessionIdleTimeoutSeconds = 30.0f;
+
+    // KeepAlive 에서 유휴 시간보다 이만큼 먼저 조회를 보냄 (초)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PJLink|Session", meta = (ClampMin = 0.0, UIMin = 1.0, UIMax = 20.0))
+    float KeepAliveMarginSeconds = 5.0f;
+
+    // 세션 통계
+    UFUNCTION(BlueprintPure, Category = "PJLink|Session")
+    FPJLinkSessionStats GetSessionStats() const;
+
+    // 세션 통계 초기화
+    UFUNCTION(BlueprintCallable, Category = "PJLink|Session")
+    void ResetSessionStats();
+
+    // 유휴 종료된 세션인지 (다음 명령에서 자동으로 다시 연결)
+    UFUNCTION(BlueprintPure, Category = "PJLink|Session")
+    bool IsSessionDormant() const;
+
+    // Class 2 상태 알림 수신 (UDP 4352, 모든 프로젝터가 소켓 하나를 공유)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PJLink|Notification")
+    bool bListenForNotifications = true;
+
+    // 이 프로젝터에서 상태 알림을 받은 적이 있는지 (받고 있으면 상태 폴링 간격을 늘려도 됨)
+    UFUNCTION(BlueprintPure, Category = "PJLink|Notification")
+    bool IsReceivingNotifications() const;
+
+    // 받은 상태 알림 수 (LKUP 포함)
+    UFUNCTION(BlueprintPure, Category = "PJLink|Notification")
+    int32 GetNotificationCount() const;
+
     // 타임아웃 처리 함수
     UFUNCTION(BlueprintCallable, Category = "PJLink|Network")
     bool SendCommandWithTimeout(EPJLinkCommand Command, const FString& Parameter = TEXT(""), float TimeoutSeconds = 5.0f);
@@ -128,115 +271,216 @@ public:
     UFUNCTION(BlueprintCallable, Category = "PJLink|Diagnostic")
     FString GenerateDiagnosticReport() const;
 
-protected:
-    // FRunnable 인터페이스 구현
-    virtual bool Init() override;
-    virtual uint32 Run() override;
-    virtual void Stop() override;
-    virtual void Exit() override;
+    // IPJLinkConnectionListener 인터페이스 구현 (리액터 I/O 스레드에서 호출)
+    virtual void OnConnectionEstablished() override;
+    virtual void OnConnectionData(const uint8* Data, int32 Length) override;
+    virtual void OnConnectionClosed(int32 ErrorCode) override;
+    virtual void OnConnectionTimer(uint64 Cookie) override;
 
-    // 명령 문자열 생성
-    FString BuildCommandString(EPJLinkCommand Command, const FString& Parameter = "");
-
-    // 응답 파싱
-    // PJLinkNetworkManager.h에서 수정
-    bool ParseResponse(const FString& ResponseString, EPJLinkCommand& Command, FString& Parameter, EPJLinkResponseStatus& Status);
-
-    // 응답으로부터 프로젝터 정보 업데이트
-    void UpdateProjectorInfo(EPJLinkCommand Command, const FString& Response);
-
-    // PJLink 인증 처리
-    bool HandleAuthentication(const FString& Challenge);
-
-    // 타임아웃 처리 함수 (내부용)
-    void HandleCommandTimeout(EPJLinkCommand Command);
+protected:
+    // 응답으로부터 프로젝터 정보 업데이트 (I/O 스레드, 파라미터는 프레임 바이트에서 직접 해석)
+    void UpdateProjectorInfo(const uint8* Frame, const FPJLinkParsedFrame& Parsed);
 
     // 소켓 생성 함수
-    bool CreateSocket();
+    bool CreateSocket(PJLinkSocketPlatform::FNativeSocket& OutSocket);
 
     // 서버 주소 구성 및 연결 시도 함수
-    bool ConnectToServer(const FString& IPAddress, int32 Port, float TimeoutSeconds);
+    bool ConnectToServer(PJLinkSocketPlatform::FNativeSocket InSocket, const FString& IPAddress, int32 Port, float TimeoutSeconds);
 
-    // 인증 처리 함수
-    bool HandleAuthentication(const FPJLinkProjectorInfo& ProjectorInfo);
+    // 인사말 수신 및 인증 처리 (응답 해시는 첫 명령 앞에 붙여 보냄)
+    bool HandleAuthentication(PJLinkSocketPlatform::FNativeSocket InSocket, const FPJLinkProjectorInfo& ProjectorInfo, float TimeoutSeconds);
 
-    // 수신 스레드 시작 함수
-    bool StartReceiverThread();
+    // 연결된 소켓을 리액터에 등록
+    bool StartConnection(PJLinkSocketPlatform::FNativeSocket InSocket);
 
     // 에러 처리 헬퍼 함수 (코드 중복 제거)
     bool HandleError(EPJLinkErrorCode ErrorCode, const FString& ErrorMessage, EPJLinkCommand RelatedCommand = EPJLinkCommand::POWR);
 
-    // 타임아웃 처리 함수
-    void HandleCommandTimeout(EPJLinkCommand Command);
+    // 타임아웃 처리 함수 (리액터 I/O 스레드)
+    void HandleCommandTimeout(int32 SequenceId);
 
-    // 재연결 시도 함수
-    void AttemptReconnect();
+    // 재연결 시도 (재연결 스케줄러가 I/O 스레드에서 호출, 결과는 CompleteConnect 에서 보고)
+    void AttemptReconnect(int32 Attempt, int32 MaxAttempts);
+
+    // 연결 종료 (유휴 세션의 대기 명령은 유지)
+    void CloseConnection();
 
 private:
-    // 응답 큐 구조체 정의 (private 내부에 위치)
-    struct FPJLinkResponseQueueItem
+    // 게임 스레드로 넘길 이벤트 큐 (I/O 스레드와 게임 스레드가 모두 생산자)
+    FPJLinkEventQueue EventQueue;
+
+    // C++ 처리기용 네이티브 이벤트
+    FPJLinkNativeEvents NativeEvents;
+
+    // 큐 처리 예약 여부 (게임 스레드 작업 중복 방지)
+    TAtomic<bool> bResponseDrainScheduled;
+
+    // 응답 대기 중인 명령 (전송 순서 FIFO - PJLink 는 한 연결에서 요청 순서대로 응답함)
+    TArray<FPJLinkCommandInfo> InFlightCommands;
+    int32 NextSequenceId;
+
+    // FIFO 추가와 송신 큐 삽입을 함께 보호 (FIFO 순서 = 전송 순서)
+    mutable FCriticalSection InFlightLock;
+
+    // 첫 명령 앞에 붙여 보낼 인증 응답 해시 (InFlightLock 으로 보호)
+    // PJLink 규격대로 해시를 따로 보내지 않고 첫 명령과 한 번에 보내 왕복 한 번을 줄임
+    TArray<uint8> PendingAuthDigest;
+
+    // FIFO 최대 길이 - 응답 없는 장비에서 무한히 쌓이지 않도록 제한
+    static constexpr int32 MaxInFlightCommands = 64;
+
+    // 유휴 종료된 세션에 보낸 명령 묶음 (다시 연결되면 순번 그대로 전송)
+    struct FPJLinkDeferredBatch
     {
-        EPJLinkCommand Command;
-        EPJLinkResponseStatus Status;
-        FString ResponseText;
-        TWeakObjectPtr<UPJLinkNetworkManager> WeakThis;
-
-        FPJLinkResponseQueueItem() {}
-
-        FPJLinkResponseQueueItem(
-            EPJLinkCommand InCommand,
-            EPJLinkResponseStatus InStatus,
-            const FString& InResponseText,
-            TWeakObjectPtr<UPJLinkNetworkManager> InWeakThis = nullptr)
-            : Command(InCommand), Status(InStatus), ResponseText(InResponseText), WeakThis(InWeakThis) {
-        }
+        TArray<FPJLinkBatchCommand> Commands;
+        float TimeoutSeconds = 0.0f;
+        int32 FirstSequenceId = 0;
+        double QueuedTime = 0.0;
     };
 
-    // 응답 큐
-    TQueue<FPJLinkResponseQueueItem> ResponseQueue;
+    // 유휴 종료된 세션이면 명령을 큐에 넣고 다시 연결 시작 (큐에 넣었으면 true)
+    bool DeferUntilReconnected(TArrayView<const FPJLinkBatchCommand> Commands, float TimeoutSeconds, int32& OutFirstSequenceId);
+
+    // 명령 묶음을 바로 전송 (PreassignedSequenceId 가 0 이면 새 순번 할당)
+    int32 SendBatchNow(TArrayView<const FPJLinkBatchCommand> Commands, float TimeoutSeconds, int32 PreassignedSequenceId, double SendTime);
+
+    // 대기 명령 폐기 (명시적 연결 해제 또는 재연결 실패, 명령마다 응답 없음으로 완료)
+    // Reason 은 응답 이벤트에 그대로 담기므로 문자열 리터럴이어야 함
+    void DiscardDeferredBatches(const TCHAR* Reason);
+
+    // 세션 준비 완료 처리 (연결 비용 기록, 세션 유지 타이머 예약, 대기 명령 또는 초기 상태 조회 전송)
+    void OnSessionEstablished();
+
+    // 세션 유지 타이머 만료 (I/O 스레드)
+    void HandleKeepAliveTimer();
 
-    // 큐 동기화를 위한 임계 영역
-    FCriticalSection ResponseQueueLock;
+    // 마지막 송수신 이후 경과 시간 (초)
+    double GetIdleSeconds() const;
 
-    // 명령 추적 맵 및 타이머 핸들
-    TMap<EPJLinkCommand, FPJLinkCommandInfo> PendingCommands;
-    TMap<EPJLinkCommand, FTimerHandle> CommandTimeoutHandles;
-    FCriticalSection CommandTrackingLock;
+    // 응답 명령과 FIFO 항목 짝짓기 (I/O 스레드, 짝이 없으면 0)
+    int32 MatchInFlightCommand(EPJLinkCommand Command, double& OutRoundTripSeconds);
 
-    // 소켓 및 스레드 관련 변수
-    FSocket* Socket;
-    FRunnableThread* ReceiverThread;
-    TAtomic<bool> bThreadStop;
+    // 응답 대기 목록 비우기 (연결 종료 시, 남은 명령은 응답 없음으로 완료)
+    void ClearInFlightCommands();
+
+    // 리액터에 등록된 연결
+    TSharedPtr<FPJLinkConnection, ESPMode::ThreadSafe> Connection;
     TAtomic<bool> bConnected;
 
+    // 비동기 연결 상태 (ConnectionLock 으로 보호)
+    EPJLinkConnectPhase ConnectPhase = EPJLinkConnectPhase::Idle;
+    TSharedPtr<TPromise<bool>, ESPMode::ThreadSafe> ConnectPromise;
+    FPJLinkTimerId ConnectTimeoutTimerId = 0;
+    float ConnectTimeoutSeconds = 0.0f;
+    FString ConnectPassword;
+
+    // 인사말 대기 중 (수신 프레임마다 락 없이 확인)
+    TAtomic<bool> bHandshakePending;
+
+    // 연결 타임아웃 타이머 쿠키 (명령 타임아웃은 양수 순번을 쿠키로 씀)
+    static constexpr uint64 ConnectTimerCookie = 1ull << 63;
+
+    // 세션 유지 타이머 쿠키
+    static constexpr uint64 KeepAliveTimerCookie = 1ull << 62;
+
+    // 유휴 시간의 이 비율 이상 조용하다가 정상 종료되면 유휴 세션 종료로 판단
+    static constexpr double IdleDropThreshold = 0.8;
+
+    // 세션 유지 조회 최소 간격 (초)
+    static constexpr double MinKeepAliveIntervalSeconds = 0.1;
+
+    // 세션 상태 (ConnectionLock 으로 보호)
+    bool bSessionDormant = false;
+    double ConnectStartTime = 0.0;
+    FPJLinkTimerId KeepAliveTimerId = 0;
+    FPJLinkSessionStats SessionStats;
+    TArray<FPJLinkDeferredBatch> DeferredBatches;
+
+    // 마지막 송수신 시각 (FPlatformTime::Cycles64)
+    TAtomic<uint64> LastActivityCycles;
+
+    // 비동기 연결 완료 처리 (어느 스레드에서든 호출 가능, 이미 끝난 시도면 무시)
+    void CompleteConnect(bool bSuccess, EPJLinkErrorCode ErrorCode = EPJLinkErrorCode::None, const FString& ErrorMessage = FString());
+
+    // 진행 중인 비동기 연결 취소 (대기자에게 실패만 알리고 오류 이벤트, 대기 명령 폐기, 재연결 결과 보고는 생략)
+    void CancelConnect();
+
+    // 연결 직후 인사말 처리 (I/O 스레드)
+    void HandleGreeting(const uint8* Frame, int32 Length);
+
+    // 인사말 해석 ("PJLINK 0" = 인증 없음, "PJLINK 1 <난수>" = OutDigest 에 응답 해시)
+    // 형식 오류나 인증 불가면 OutErrorCode 를 채우고 false
+    bool ParseGreeting(const FString& Greeting, const FString& Password, FString& OutDigest, EPJLinkErrorCode& OutErrorCode) const;
+
+    // 인증 응답 해시를 다음 송신 앞에 붙이도록 예약
+    void SetPendingAuthDigest(const FString& Digest);
+
+    // 연결 완료 이벤트 추가
+    void EnqueueConnectCompleted(bool bSuccess, EPJLinkErrorCode ErrorCode);
+
+    // 수신 프레임 재조립기 (I/O 스레드 전용)
+    FPJLinkFrameAssembler FrameAssembler;
+
     // 프로젝터 정보 - 락을 통해 보호됨
     FPJLinkProjectorInfo CurrentProjectorInfo;
 
     // 임계 영역들
-    mutable FCriticalSection SocketCriticalSection;
+    mutable FCriticalSection ConnectionLock;
     mutable FCriticalSection ProjectorInfoLock;
-    mutable FCriticalSection ResponseQueueLock;
+    mutable FCriticalSection ErrorLock;
+
+    // 주어진 시간 안에서 이벤트 처리 (최소 1개, 사용한 시간 반환)
+    // 프레임 예산은 FPJLinkEventDrainScheduler 가 모든 매니저에 나눠 줌
+    double DrainEvents(double BudgetSeconds);
+
+    // 공유 이벤트 처리기의 대기 목록에 있음 (게임 스레드 전용)
+    bool bEventDrainPending = false;
+
+    // 이벤트 하나당 평균 처리 비용 (묶음 크기 계산용)
+    double AverageEventCostSeconds = 0.0;
+
+    // 한 번에 꺼내는 최대 이벤트 수
+    static constexpr int32 MaxDrainBatchSize = 256;
+
+    // 처리 통계 (게임 스레드 전용, 버린 수만 원자적)
+    FPJLinkEventQueueStats EventStats;
+    TAtomic<int32> DroppedEventCount;
+
+    // 이벤트 하나를 대리자로 전달 (게임 스레드)
+    void ProcessEvent(const FPJLinkEvent& Event);
+
+    // 내부 알림을 응답 이벤트로 추가 (어느 스레드에서든 호출 가능)
+    void EnqueueResponseEvent(EPJLinkCommand Command, EPJLinkResponseStatus Status, const TCHAR* Text, int32 SequenceId = 0);
+
+    // 연결 상태 변경 이벤트 추가
+    void EnqueueConnectionChanged(bool bIsConnected);
+
+    // 게임 스레드에서 큐 처리 예약 (어느 스레드에서든 호출 가능)
+    void ScheduleResponseDrain();
+
+    // 완성된 응답 프레임 처리 (I/O 스레드, Frame 은 CR 제외)
+    void HandleResponseFrame(const uint8* Frame, int32 Length);
+
+    // Class 2 상태 알림 처리 (알림 수신기, I/O 스레드, Frame 은 CR 제외)
+    void HandleNotificationFrame(const uint8* Frame, int32 Length);
+
+    // 파싱된 프레임을 네이티브 처리기와 게임 스레드 이벤트로 전달 (I/O 스레드)
+    void DispatchResponseFrame(const uint8* Frame, const FPJLinkParsedFrame& Parsed, int32 SequenceId, double RoundTripSeconds);
 
-    // 명령어 대기열
-    TQueue<TPair<EPJLinkCommand, FString>> CommandQueue;
- 
-    // 큐 처리 타이머
-    FTimerHandle ResponseQueueTimerHandle;
+    // 현재 프로젝터 주소로 알림 수신 등록 (설정이 꺼져 있으면 해제)
+    void UpdateNotificationRegistration();
 
-    // 큐 처리 함수
-    void ProcessResponseQueue();
+    // 받은 상태 알림 수
+    TAtomic<int32> NotificationCount;
 
     // 마지막 오류 정보
     EPJLinkErrorCode LastErrorCode;
     FString LastErrorMessage;
 
-    // 재연결 관련 변수
-    int32 ReconnectAttemptCount = 0;
-    FTimerHandle ReconnectTimerHandle;
+    // 재연결 대상 (ProjectorInfoLock 으로 보호)
     FPJLinkProjectorInfo LastProjectorInfo;
 
     // 진단 데이터
     FPJLinkDiagnosticData ConnectionDiagnosticData;
     FPJLinkDiagnosticData LastCommandDiagnosticData;
-     
- };
\ No newline at end of file
+};
\ No newline at end of file
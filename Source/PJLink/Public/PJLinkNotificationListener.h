@@ -0,0 +1,105 @@
+﻿// PJLinkNotificationListener.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PJLinkSocketPlatform.h"
+
+class UPJLinkNetworkManager;
+class FPJLinkNotificationSocketHandler;
+
+/**
+ * Class 2 검색 응답(%2ACKN) 수신자
+ * 장치는 검색 응답을 컨트롤러의 UDP 4352 포트로 보내므로 알림 소켓으로 들어옵니다.
+ * 콜백은 리액터 I/O 스레드에서 호출됩니다.
+ */
+class PJLINK_API IPJLinkSearchReplySink
+{
+public:
+    virtual ~IPJLinkSearchReplySink() {}
+
+    // ACKN 한 줄 도착 (Frame 은 CR 을 뺀 "%2ACKN=..." 전체)
+    virtual void OnSearchReply(uint32 SourceIPv4, const uint8* Frame, int32 Length) = 0;
+};
+
+/**
+ * PJLink Class 2 상태 알림 수신기
+ *
+ * Class 2 프로젝터는 전원/입력/음소거/오류 상태가 바뀌거나 네트워크가 켜지면(LKUP)
+ * 마지막으로 명령을 보낸 컨트롤러의 UDP 4352 포트로 알림을 보냅니다.
+ * 모든 프로젝터가 UDP 소켓 하나를 공유하며, 소켓은 I/O 리액터에 등록되어 알림이 오면
+ * 송신 IP 로 네트워크 매니저를 찾아 응답과 같은 경로(상태 갱신 + 이벤트)로 전달합니다.
+ * 같은 포트로 오는 검색 응답(%2ACKN)은 등록된 검색 수신자에게 전달합니다.
+ *
+ * 포트를 열 수 없으면(다른 프로그램이 사용 중 등) 경고만 남기고 기존 상태 폴링으로 동작합니다.
+ */
+class PJLINK_API FPJLinkNotificationListener
+{
+public:
+    // PJLink 알림 포트
+    static constexpr uint16 DefaultPort = 4352;
+
+    // 싱글톤 접근
+    static FPJLinkNotificationListener& Get();
+
+    // 소켓을 닫고 등록을 모두 해제 (모듈 종료 시, 리액터 종료 전에 호출)
+    static void Shutdown();
+
+    // 프로젝터 IP(호스트 바이트 순서)의 알림을 매니저로 전달 (이미 등록된 매니저면 IP 만 갱신)
+    // 첫 등록 시 소켓을 엽니다.
+    void Register(UPJLinkNetworkManager* Manager, uint32 IPv4);
+
+    // 등록 해제 - 반환 후에는 이 매니저로 알림을 전달하지 않음
+    void Unregister(UPJLinkNetworkManager* Manager);
+
+    // 검색 응답 수신자 추가 (소켓이 닫혀 있으면 엶)
+    void AddSearchSink(IPJLinkSearchReplySink* Sink);
+
+    // 검색 응답 수신자 제거 - 반환 후에는 호출되지 않음
+    void RemoveSearchSink(IPJLinkSearchReplySink* Sink);
+
+    // 수신 포트 변경 (0 = 임의 포트, 테스트용) - 열려 있는 소켓은 새 포트로 다시 엶
+    void SetListenPort(uint16 InPort);
+
+    // 실제로 바인딩된 포트 (소켓이 닫혀 있으면 0)
+    uint16 GetBoundPort() const;
+
+    // 받은 알림 수 / 등록되지 않은 IP 에서 온 알림 수
+    int32 GetReceivedCount() const { return ReceivedCount.load(); }
+    int32 GetUnmatchedCount() const { return UnmatchedCount.load(); }
+
+private:
+    friend class FPJLinkNotificationSocketHandler;
+
+    FPJLinkNotificationListener();
+    ~FPJLinkNotificationListener();
+
+    // 소켓 열기/닫기 (Lock 보유 상태에서 호출)
+    bool OpenSocket();
+    void CloseSocket();
+
+    // 소켓을 열어 둘 이유가 있는지 (Lock 보유 상태에서 호출)
+    bool HasSubscribers() const { return AddressByManager.Num() > 0 || SearchSinks.Num() > 0; }
+
+    // 처리기에서 받은 데이터그램 전달 (I/O 스레드, 수신기가 종료되었으면 버림)
+    static void DispatchDatagram(const FPJLinkNotificationSocketHandler* Sender, const uint8* Data, int32 Length, uint32 SourceIPv4);
+
+    // 데이터그램을 줄 단위로 나눠 송신 IP 의 매니저에 전달 (I/O 스레드)
+    void HandleDatagram(const FPJLinkNotificationSocketHandler* Sender, const uint8* Data, int32 Length, uint32 SourceIPv4);
+
+    // 등록 정보와 소켓 보호 (알림 전달 중에도 보유 - 등록 해제는 전달이 끝날 때까지 대기)
+    mutable FCriticalSection Lock;
+    TMap<uint32, TArray<UPJLinkNetworkManager*>> ManagersByAddress;
+    TMap<UPJLinkNetworkManager*, uint32> AddressByManager;
+    TArray<IPJLinkSearchReplySink*> SearchSinks;
+
+    TSharedPtr<FPJLinkNotificationSocketHandler, ESPMode::ThreadSafe> Handler;
+    uint16 ListenPort;
+    uint16 BoundPort;
+    bool bBindFailed;
+
+    TAtomic<int32> ReceivedCount;
+    TAtomic<int32> UnmatchedCount;
+
+    static FPJLinkNotificationListener* Instance;
+    static FCriticalSection InstanceLock;
+};
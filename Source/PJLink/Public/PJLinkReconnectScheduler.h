@@ -0,0 +1,120 @@
+﻿// PJLinkReconnectScheduler.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PJLinkTypes.h"
+#include "PJLinkTimingWheel.h"
+#include "Math/RandomStream.h"
+
+class UPJLinkNetworkManager;
+
+/**
+ * 모든 프로젝터가 공유하는 재연결 스케줄러
+ *
+ * 네트워크 매니저마다 재연결 타이머를 따로 돌리는 대신, 한 곳에서 프로젝터별 시도 횟수와
+ * 다음 시도 시각, 동시에 진행 중인 연결 수를 관리합니다.
+ * 대기 시간은 상한이 있는 지수 백오프에 전체 지터(0 ~ 백오프 사이 무작위)를 적용하므로
+ * 스위치 재부팅처럼 많은 프로젝터가 한꺼번에 끊겨도 재연결 시도가 시간에 고르게 퍼지고,
+ * 동시에 진행되는 연결은 MaxConcurrentConnects 를 넘지 않습니다.
+ *
+ * 타이머는 리액터 I/O 스레드에서 만료되며, 재연결 자체도 비동기 연결로 진행됩니다.
+ */
+class PJLINK_API FPJLinkReconnectScheduler
+{
+public:
+    // 싱글톤 접근
+    static FPJLinkReconnectScheduler& Get();
+
+    // 예약된 재연결을 모두 취소하고 정리 (모듈 종료 시, 리액터 종료 전에 호출)
+    static void Shutdown();
+
+    // 재연결 예약 (이미 예약된 프로젝터면 무시)
+    // BaseDelaySeconds 는 첫 시도의 백오프 상한이며 시도마다 두 배가 됩니다. MaxAttempts 0 = 무제한
+    void Schedule(UPJLinkNetworkManager* Manager, float BaseDelaySeconds, int32 MaxAttempts);
+
+    // 연결 시도 결과 보고 (네트워크 매니저의 연결 완료 처리에서 호출, 예약이 없으면 무시)
+    void ReportResult(UPJLinkNetworkManager* Manager, bool bConnected);
+
+    // 예약 취소 (명시적 연결 해제, 매니저 종료) - 반환 후에는 이 매니저로 시도를 시작하지 않음
+    void Cancel(UPJLinkNetworkManager* Manager);
+
+    // 동시에 진행할 수 있는 재연결 수
+    void SetMaxConcurrentConnects(int32 InMaxConcurrentConnects);
+    int32 GetMaxConcurrentConnects() const;
+
+    // 백오프 상한 (초)
+    void SetMaxBackoffSeconds(float InMaxBackoffSeconds);
+    float GetMaxBackoffSeconds() const;
+
+    // 재연결 통계
+    FPJLinkReconnectStats GetStats() const;
+    void ResetStats();
+
+    // 예약 여부
+    bool IsScheduled(const UPJLinkNetworkManager* Manager) const;
+
+    // 전체 지터 백오프 (0 ~ Min(MaxSeconds, BaseSeconds * 2^Attempt) 사이 균등 분포)
+    static double ComputeBackoffSeconds(float BaseSeconds, float MaxSeconds, int32 Attempt, FRandomStream& Random);
+
+private:
+    FPJLinkReconnectScheduler();
+    ~FPJLinkReconnectScheduler();
+
+    enum class EEntryState : uint8
+    {
+        Backoff,
+        WaitingForSlot,
+        Connecting
+    };
+
+    // 프로젝터 하나의 재연결 상태
+    struct FEntry
+    {
+        // 시도 시작과 취소를 직렬화 (Cancel 반환 후에는 Manager 를 쓰지 않음)
+        FCriticalSection StartLock;
+        UPJLinkNetworkManager* Manager = nullptr;
+
+        // 예약에서 제거됨 (시작 대기 중인 시도를 건너뜀)
+        TAtomic<bool> bRemoved { false };
+
+        // 이하 스케줄러 Lock 으로 보호
+        EEntryState State = EEntryState::Backoff;
+        int32 Attempt = 0;
+        int32 MaxAttempts = 0;
+        float BaseDelaySeconds = 1.0f;
+        FPJLinkTimerId TimerId = 0;
+    };
+
+    using FEntryRef = TSharedRef<FEntry, ESPMode::ThreadSafe>;
+
+    // 백오프 타이머 예약 (Lock 보유 상태에서 호출)
+    void ArmBackoffTimer(const FEntryRef& Entry);
+
+    // 백오프 만료 - 슬롯이 있으면 시도 시작, 없으면 슬롯 대기
+    void HandleBackoffExpired(const FEntryRef& Entry);
+
+    // 빈 슬롯만큼 대기 중인 프로젝터의 시도를 예약 (Lock 보유 상태에서 호출)
+    void PumpWaitingEntries();
+
+    // 슬롯을 차지하고 시도 시작을 I/O 스레드에 예약 (Lock 보유 상태에서 호출)
+    void DispatchAttempt(const FEntryRef& Entry);
+
+    // 시도 시작 (I/O 스레드, 스케줄러 락 없이 호출)
+    static void StartAttempt(const FEntryRef& Entry);
+
+    // 예약 제거 (Lock 보유 상태에서 호출)
+    void RemoveEntry(const FEntryRef& Entry);
+
+    mutable FCriticalSection Lock;
+    TMap<const UPJLinkNetworkManager*, FEntryRef> Entries;
+    TArray<FEntryRef> WaitingEntries;
+    FRandomStream Random;
+
+    int32 MaxConcurrentConnects;
+    float MaxBackoffSeconds;
+    int32 ActiveConnects;
+    FPJLinkReconnectStats Stats;
+
+    static FPJLinkReconnectScheduler* Instance;
+    static FCriticalSection InstanceLock;
+};
@@ -0,0 +1,63 @@
+﻿// PJLinkResponseParser.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PJLinkTypes.h"
+
+/**
+ * 파싱된 PJLink 응답 프레임
+ * 파라미터는 복사하지 않고 원본 프레임 안의 위치(오프셋/길이)만 기록합니다.
+ */
+struct FPJLinkParsedFrame
+{
+    // 응답 명령 (bHasCommand 가 false 면 의미 없음)
+    EPJLinkCommand Command = EPJLinkCommand::POWR;
+
+    // 응답 상태 ("=ERR1".."=ERR4", "=ERRA" 는 각 오류 상태로 변환)
+    EPJLinkResponseStatus Status = EPJLinkResponseStatus::Unknown;
+
+    // 응답 클래스 ('%1' = 1, '%2' = 2, 명령 없는 오류 응답은 0)
+    uint8 ProtocolClass = 0;
+
+    // 명령 응답인지 여부 ("PJLINK ERRA" 같은 단독 오류 응답은 false)
+    bool bHasCommand = false;
+
+    // 파라미터 위치 (프레임 시작 기준, 뒤쪽 공백 제외)
+    int32 ParameterOffset = 0;
+    int32 ParameterLength = 0;
+};
+
+/**
+ * UTF-8 바이트 단위 PJLink 응답 파서
+ *
+ * 프레임 재조립기가 넘겨준 바이트 범위를 그대로 읽으며 메모리를 할당하지 않습니다.
+ * 4글자 명령 이름은 32비트 정수 하나로 묶어 switch 로 판별합니다.
+ */
+namespace PJLinkResponseParser
+{
+    // 4글자 명령 이름을 32비트 코드로 변환 (바이트 순서와 무관하게 첫 글자가 하위 바이트)
+    constexpr uint32 MakeCode(ANSICHAR A, ANSICHAR B, ANSICHAR C, ANSICHAR D)
+    {
+        return static_cast<uint32>(static_cast<uint8>(A))
+            | (static_cast<uint32>(static_cast<uint8>(B)) << 8)
+            | (static_cast<uint32>(static_cast<uint8>(C)) << 16)
+            | (static_cast<uint32>(static_cast<uint8>(D)) << 24);
+    }
+
+    // 응답 프레임 파싱 (Frame 은 종료 문자 CR 제외, 인식할 수 없는 형식이면 false)
+    PJLINK_API bool ParseFrame(const uint8* Frame, int32 Length, FPJLinkParsedFrame& OutFrame);
+
+    // 명령 코드 판별
+    PJLINK_API bool DecodeCommand(uint32 Code, EPJLinkCommand& OutCommand);
+
+    // 파라미터 값 해석 (UpdateProjectorInfo 용)
+    PJLINK_API EPJLinkPowerStatus DecodePowerStatus(const uint8* Parameter, int32 Length);
+    PJLINK_API EPJLinkInputSource DecodeInputSource(const uint8* Parameter, int32 Length);
+    PJLINK_API bool DecodeClass(const uint8* Parameter, int32 Length, EPJLinkClass& OutClass);
+
+    // 파라미터를 FString 으로 변환 (보관이 필요할 때만 호출)
+    PJLINK_API FString ParameterToString(const uint8* Frame, const FPJLinkParsedFrame& Parsed);
+
+    // 파라미터를 기존 문자열 뒤에 덧붙임 (재사용 버퍼에 쓸 때 할당 없음)
+    PJLINK_API void AppendParameter(FString& Out, const uint8* Frame, const FPJLinkParsedFrame& Parsed);
+}
@@ -0,0 +1,289 @@
+﻿// PJLinkScanEngine.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PJLinkSocketPlatform.h"
+
+/**
+ * 스캔 설정
+ */
+struct PJLINK_API FPJLinkScanSettings
+{
+    // 스캔 범위 (호스트 바이트 순서, 양 끝 포함)
+    uint32 FirstIPv4 = 0;
+    uint32 LastIPv4 = 0;
+
+    // 비어 있지 않으면 범위 전체 대신 이 주소들만 스캔 (범위 안 주소, 범위는 /24 별 RTT 추정에만 씀)
+    TArray<uint32> TargetIPv4s;
+
+    // 스캔하지 않고 끝난 것으로 셀 주소 (이미 확인한 호스트, 순서 무관)
+    TArray<uint32> ExcludedIPv4s;
+
+    // 대상 TCP 포트
+    uint16 Port = 4352;
+
+    // 호스트당 연결 제한 시간 상한 (초, 같은 /24 에서 연결 RTT 표본이 모이기 전에는 이 값을 씀)
+    double ConnectTimeoutSeconds = 1.0;
+
+    // 연결 RTT 로 줄인 연결 제한 시간의 하한 (초, 0 이하면 줄이지 않고 ConnectTimeoutSeconds 만 씀)
+    double MinConnectTimeoutSeconds = 0.25;
+
+    // 줄인 연결 제한 시간 안에 응답이 없던 호스트를 모든 주소를 나눠 준 뒤 한 번 더 시도
+    bool bRetryTimedOut = true;
+
+    // 재시도 연결 제한 시간 = 처음 쓴 제한 시간 x 이 값 (상한 ConnectTimeoutSeconds)
+    double RetryTimeoutMultiplier = 2.0;
+
+    // 연결 후 인사말, 그리고 정보 조회 응답 각각의 제한 시간 (초)
+    double ResponseTimeoutSeconds = 2.0;
+
+    // 2단계에서 NAME/INF1/INF2 도 함께 조회 (false 면 CLSS 만 조회하고, 식별 정보는 OnAdoptConnection 으로
+    // 연결을 넘겨받은 쪽이 조회)
+    bool bQueryIdentity = true;
+
+    // 동시에 진행할 최대 연결 수 (작업 스레드에 나눠 배정)
+    int32 MaxInFlight = 1024;
+
+    // 작업 스레드 수
+    int32 NumWorkers = 1;
+
+    // 작업 스레드가 공유 커서에서 한 번에 가져가는 주소 수
+    int32 ChunkSize = 16;
+};
+
+/**
+ * 스캔 통계 (스캔 중에도 락 없이 읽을 수 있음)
+ */
+struct PJLINK_API FPJLinkScanStats
+{
+    // 전체 주소 수 / 끝난 주소 수
+    int32 TotalAddresses = 0;
+    int32 ScannedAddresses = 0;
+
+    // 현재 / 최대 동시 연결 수
+    int32 InFlight = 0;
+    int32 PeakInFlight = 0;
+
+    // TCP 연결을 받아들인 호스트 (PJLink 조회 단계로 넘어간 수)
+    int32 OpenHosts = 0;
+
+    // PJLink 응답을 보낸 호스트 / 연결 거부 / 연결 시간 초과 (재시도까지 끝난 뒤 기준)
+    int32 FoundHosts = 0;
+    int32 RefusedHosts = 0;
+    int32 TimedOutHosts = 0;
+
+    // 줄인 제한 시간으로 시간 초과되어 다시 시도한 호스트 / 그중 재시도에서 연결되거나 거부 응답을 보낸 호스트
+    int32 RetriedHosts = 0;
+    int32 RetryRecoveredHosts = 0;
+
+    // 연결 RTT 표본이 있는 /24 수
+    int32 RttSubnets = 0;
+
+    // 가장 최근에 끝난 주소 (호스트 바이트 순서, 아직 없으면 0)
+    uint32 LastCompletedIPv4 = 0;
+
+    // 모든 /24 의 표본을 합친 연결 RTT 평균 (초, 아직 표본이 없으면 0) / 그 값으로 계산한 연결 제한 시간 (초)
+    // 실제 마감은 /24 마다 따로 계산한 제한 시간을 씀
+    double SmoothedConnectRttSeconds = 0.0;
+    double ConnectTimeoutSeconds = 0.0;
+
+    // 시작 후 경과 시간 (초)
+    double ElapsedSeconds = 0.0;
+
+    // 작업 스레드 수 / 아직 실행 중인 작업 스레드 수
+    int32 NumWorkers = 0;
+    int32 RunningWorkers = 0;
+
+    // 작업 스레드가 일한 시간의 비율 (0~1, 모두 마지막까지 일했으면 1)
+    double WorkerUtilization = 0.0;
+
+    // 첫 작업 스레드가 끝난 뒤 마지막 작업 스레드가 끝날 때까지 걸린 시간 (초)
+    double TailSeconds = 0.0;
+};
+
+/**
+ * 스캔 이벤트 수신 함수 (모두 작업 스레드에서 호출)
+ */
+struct PJLINK_API FPJLinkScanCallbacks
+{
+    // PJLink 응답을 보낸 호스트 (Response 는 인사말을 포함한 수신 문자열)
+    TFunction<void(uint32 IPv4, const FString& Response, int32 ResponseTimeMs)> OnHostFound;
+
+    // 조회를 마친 연결을 넘겨받음 (OnHostFound 다음에 호출, true 를 반환하면 소켓 소유권이 넘어가 엔진이 닫지 않음)
+    // 인사말이 "PJLINK 0" 이고 모든 조회에 응답한 뒤 연결이 열려 있는 호스트만 대상
+    TFunction<bool(uint32 IPv4, PJLinkSocketPlatform::FNativeSocket Socket)> OnAdoptConnection;
+
+    // 진행 상황 (작업 스레드마다 poll 한 번에 최대 한 번, LastIPv4 = 그 스레드가 마지막으로 끝낸 주소)
+    TFunction<void(const FPJLinkScanStats& Stats, uint32 LastIPv4)> OnProgress;
+
+    // 스캔 종료 (마지막 작업 스레드에서 한 번, bCancelled = Cancel 로 중단됨)
+    TFunction<void(const FPJLinkScanStats& Stats, bool bCancelled)> OnFinished;
+};
+
+/**
+ * 논블로킹 TCP 스윕 엔진
+ *
+ * 주소마다 소켓을 열고 대기하는 대신, 각 작업 스레드가 MaxInFlight 를 나눠 가진 만큼 논블로킹 연결을
+ * 동시에 걸어 두고 poll 로 준비된 소켓만 처리합니다. 끝난 연결 자리는 다음 주소로 바로 채웁니다.
+ * 응답 없는 주소가 대부분인 /24 는 MaxInFlight 가 254 이상이면 연결 제한 시간 한 번 정도에 끝납니다.
+ *
+ * 범위를 작업 스레드 수로 미리 나누지 않고, 모든 스레드가 공유 원자 커서에서 ChunkSize 개씩 주소를
+ * 가져갑니다. 시간 초과 호스트가 몰린 구간을 맡은 스레드가 느려져도 나머지 주소는 다른 스레드가
+ * 가져가므로 작업 스레드들이 거의 함께 끝납니다.
+ * 작업은 엔진 공유 풀이 아닌 플러그인 I/O 스레드 풀(FPJLinkIOThreadPool)에서 실행되며,
+ * 작업 스레드 수는 풀 스레드 수를 넘지 않습니다.
+ * TargetIPv4s 를 주면 커서가 범위 대신 그 목록을 나눠 주므로, 흩어진 알려진 호스트만 같은 방식으로 다시 확인할 수 있습니다.
+ * ExcludedIPv4s 의 주소는 연결 없이 끝난 것으로 셉니다.
+ *
+ * 스캔은 두 단계입니다. 1단계는 TCP 연결이 되는지만 봅니다. 연결 제한 시간은 같은 /24 에 있는 다른 호스트의
+ * 연결 완료 시간과 하한보다 빠른 거부 시간(SRTT + 4 x RTTVAR)에서 계산해 MinConnectTimeoutSeconds 까지 줄이므로, 빈 주소가 대부분인
+ * 서브넷에서 주소마다 ConnectTimeoutSeconds 전체를 기다리지 않습니다. 이미 걸어 둔 연결에도 바로 적용됩니다.
+ * 추정은 /24 마다 따로 두므로 라우터 너머의 느린 VLAN 이 같은 스캔에 있어도 가까운 서브넷의 짧은 제한 시간을
+ * 쓰지 않습니다. 줄인 제한 시간으로 시간 초과된 호스트는 모든 주소를 나눠 준 뒤 RetryTimeoutMultiplier 배
+ * 긴 제한 시간으로 한 번 더 시도합니다.
+ * 연결을 받아들인 호스트만 같은 연결로 2단계를 진행합니다. 인사말이 "PJLINK 0" 이면 CLSS/NAME/INF1/INF2
+ * 조회를 한 번에 보내고 응답 네 줄을 모아 인사말과 함께 OnHostFound 로 전달합니다.
+ * bQueryIdentity 가 false 면 CLSS 만 조회하고 열린 연결을 OnAdoptConnection 으로 넘겨, 느린 식별 정보 조회가
+ * 스윕의 동시 연결 자리를 차지하지 않게 합니다.
+ * 인증이 필요한 장치("PJLINK 1")는 암호 없이 조회하면 연결이 끊기므로 인사말만 전달합니다.
+ */
+class PJLINK_API FPJLinkScanEngine
+{
+public:
+    // MaxInFlight 상한 (임시 포트와 소켓 핸들 고갈 방지)
+    static constexpr int32 MaxInFlightLimit = 8192;
+
+    // 작업 스레드 수 상한
+    static constexpr int32 MaxWorkersLimit = 16;
+
+    FPJLinkScanEngine(const FPJLinkScanSettings& InSettings, FPJLinkScanCallbacks&& InCallbacks);
+    ~FPJLinkScanEngine();
+
+    // 작업 스레드 시작
+    bool Start();
+
+    // 중단 요청 (임의 스레드, 진행 중인 연결은 작업 스레드가 닫음)
+    void Cancel();
+
+    // 작업 스레드 종료 대기 (작업 스레드 자신이 호출하면 중단 요청만 함)
+    void WaitForCompletion();
+
+    // 스캔이 끝났는지
+    bool IsFinished() const { return bFinished.load(); }
+
+    // 현재 스레드가 이 엔진의 작업 스레드인지 (콜백 안에서 호출되었는지)
+    bool IsInScanThread() const;
+
+    // 현재 통계
+    FPJLinkScanStats GetStats() const;
+
+private:
+    class FWorker;
+
+    // 테스트에서 서브넷별 RTT 추정과 재시도 대기열을 직접 확인
+    friend class UPJLinkTests;
+
+    // 연결 RTT 추정 하나 (RFC 6298 방식, 갱신은 RttLock 안에서)
+    struct FRttEstimate
+    {
+        double SmoothedRttSeconds = 0.0;
+        double RttVarianceSeconds = 0.0;
+        bool bHasSample = false;
+
+        // 작업 스레드가 poll 마다 락 없이 읽는 값 (마이크로초)
+        TAtomic<int64> SmoothedRttMicros { 0 };
+        TAtomic<int64> ConnectTimeoutMicros { 0 };
+    };
+
+    // 시간 초과 후 다시 시도할 호스트
+    struct FRetryTarget
+    {
+        uint32 IPv4 = 0;
+        double ConnectTimeoutSeconds = 0.0;
+    };
+
+    // 서브넷별 추정 최대 수 (/8 보다 넓은 범위는 여러 /24 가 추정을 나눠 씀)
+    static constexpr int32 MaxSubnetEstimates = 65536;
+
+    // 공유 커서에서 다음 주소 묶음의 위치를 가져옴 (양 끝 포함, 남은 주소가 없으면 false)
+    bool ClaimChunk(uint64& OutFirstPosition, uint64& OutLastPosition);
+
+    // 스캔 순서상 위치의 주소 (TargetIPv4s 가 있으면 그 목록, 없으면 범위)
+    uint32 GetAddressAt(uint64 Position) const;
+
+    // 스캔하지 않을 주소인지
+    bool IsExcluded(uint32 IPv4) const;
+
+    // 재시도 대기열에서 다음 호스트를 가져옴 (없으면 false)
+    bool ClaimRetry(FRetryTarget& OutTarget);
+
+    // 줄인 제한 시간으로 시간 초과된 호스트를 재시도 대기열에 넣음 (재시도 대상이 아니면 false)
+    bool QueueRetry(uint32 IPv4, double UsedTimeoutSeconds);
+
+    // 작업 스레드 종료 집계 (마지막 스레드가 OnFinished 호출)
+    void OnWorkerFinished();
+
+    // 동시 연결 수 증감 및 최대값 갱신
+    void AddInFlight(int32 Delta);
+
+    // 시작 후 경과 시간 (마이크로초)
+    int64 GetElapsedMicros() const;
+
+    // 연결 완료/거부 시간 표본을 그 주소의 /24 와 전체 추정에 반영
+    void AddConnectRttSample(uint32 IPv4, double RttSeconds);
+
+    // 표본 하나로 추정과 연결 제한 시간 갱신 (RttLock 안에서 호출)
+    void UpdateRttEstimate(FRttEstimate& Estimate, double RttSeconds) const;
+
+    // 주소가 속한 /24 의 추정
+    FRttEstimate& GetSubnetEstimate(uint32 IPv4) const;
+
+    // 주소가 속한 /24 에서 지금 쓰는 연결 제한 시간 (초)
+    double GetConnectTimeoutSeconds(uint32 IPv4) const;
+
+    FPJLinkScanSettings Settings;
+    FPJLinkScanCallbacks Callbacks;
+
+    // 작업 스레드 (Start 이후 변경되지 않음)
+    TArray<TUniquePtr<FWorker>> Workers;
+
+    // 스캔할 주소 수와 다음에 나눠 줄 위치 (fetch_add 가 끝을 넘어도 넘치지 않도록 64비트)
+    uint64 NumPositions;
+    TAtomic<uint64> NextChunkPosition;
+
+    double StartTime;
+    TAtomic<bool> bCancelRequested;
+    TAtomic<bool> bFinished;
+
+    // 통계 (작업 스레드가 갱신, 임의 스레드가 읽음)
+    TAtomic<int32> ScannedAddresses;
+    TAtomic<int32> InFlight;
+    TAtomic<int32> PeakInFlight;
+    TAtomic<int32> OpenHosts;
+    TAtomic<int32> FoundHosts;
+    TAtomic<int32> RefusedHosts;
+    TAtomic<int32> TimedOutHosts;
+    TAtomic<int32> RetriedHosts;
+    TAtomic<int32> RetryRecoveredHosts;
+    TAtomic<uint32> LastCompletedIPv4;
+
+    // 작업 스레드 종료 집계 (시작 기준 마이크로초, -1 = 아직 끝난 스레드 없음)
+    TAtomic<int32> RunningWorkers;
+    TAtomic<int64> FinishedWorkerMicros;
+    TAtomic<int64> FirstWorkerFinishMicros;
+    TAtomic<int64> LastWorkerFinishMicros;
+
+    // 연결 RTT 추정 (모든 작업 스레드가 공유, 갱신은 RttLock 으로 보호)
+    FCriticalSection RttLock;
+
+    // 스캔 범위의 /24 별 추정 (첫 /24 부터 순서대로, 통계용 전체 추정은 따로)
+    TUniquePtr<FRttEstimate[]> SubnetEstimates;
+    int32 NumSubnetEstimates;
+    uint32 FirstSubnet;
+    FRttEstimate OverallRtt;
+    TAtomic<int32> RttSubnets;
+
+    // 재시도 대기열 (나중에 넣은 호스트부터 꺼냄)
+    FCriticalSection RetryLock;
+    TArray<FRetryTarget> RetryTargets;
+};
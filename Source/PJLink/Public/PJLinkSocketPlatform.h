@@ -0,0 +1,98 @@
+﻿// PJLinkSocketPlatform.h
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * PJLink 리액터용 네이티브 소켓 래퍼
+ *
+ * FSocket은 여러 소켓을 한 번에 대기하는 API(poll)를 제공하지 않기 때문에
+ * 리액터와 스캐너는 OS 소켓 핸들을 직접 다룹니다.
+ * 플랫폼 헤더(winsock/POSIX)는 이 파일의 구현부에만 포함됩니다.
+ */
+namespace PJLinkSocketPlatform
+{
+    // 네이티브 소켓 핸들 (Windows SOCKET / POSIX int 를 모두 담을 수 있는 크기)
+    using FNativeSocket = UPTRINT;
+
+    // 유효하지 않은 소켓 값
+    static constexpr FNativeSocket InvalidSocket = ~static_cast<FNativeSocket>(0);
+
+    // poll 관심/결과 플래그
+    namespace EPollFlags
+    {
+        static constexpr uint8 None = 0;
+        static constexpr uint8 Readable = 1 << 0;
+        static constexpr uint8 Writable = 1 << 1;
+        static constexpr uint8 Error = 1 << 2;
+    }
+
+    // poll 대상 항목
+    struct FPollEntry
+    {
+        FNativeSocket Socket = InvalidSocket;
+        uint8 Requested = EPollFlags::None;
+        uint8 Returned = EPollFlags::None;
+    };
+
+    // 송수신 결과
+    enum class EIOResult : uint8
+    {
+        Ok,
+        WouldBlock,
+        Closed,
+        Error
+    };
+
+    // 비동기 연결 결과
+    enum class EConnectResult : uint8
+    {
+        Connected,
+        InProgress,
+        Failed
+    };
+
+    // 소켓 생성 (항상 논블로킹 모드로 생성)
+    PJLINK_API FNativeSocket CreateTcpSocket();
+    PJLINK_API FNativeSocket CreateUdpSocket();
+
+    // 소켓 옵션
+    PJLINK_API bool SetNoDelay(FNativeSocket Socket, bool bNoDelay);
+    PJLINK_API bool SetBroadcast(FNativeSocket Socket, bool bBroadcast);
+    PJLINK_API bool SetReuseAddress(FNativeSocket Socket, bool bReuse);
+
+    // 연결 (IP는 호스트 바이트 순서)
+    PJLINK_API EConnectResult Connect(FNativeSocket Socket, uint32 IPv4, uint16 Port);
+
+    // 진행 중이던 연결의 결과 코드 (SO_ERROR, 0 = 성공)
+    PJLINK_API int32 GetPendingError(FNativeSocket Socket);
+
+    // 스트림 송수신
+    PJLINK_API EIOResult Send(FNativeSocket Socket, const uint8* Data, int32 Length, int32& OutBytesSent);
+    PJLINK_API EIOResult Recv(FNativeSocket Socket, uint8* Buffer, int32 BufferSize, int32& OutBytesRead);
+
+    // 데이터그램 송수신
+    PJLINK_API EIOResult SendTo(FNativeSocket Socket, const uint8* Data, int32 Length, uint32 IPv4, uint16 Port, int32& OutBytesSent);
+    PJLINK_API EIOResult RecvFrom(FNativeSocket Socket, uint8* Buffer, int32 BufferSize, int32& OutBytesRead, uint32& OutIPv4, uint16& OutPort);
+
+    // 서버 소켓 (루프백 테스트와 리액터 깨우기용)
+    PJLINK_API bool Bind(FNativeSocket Socket, uint32 IPv4, uint16 Port);
+    PJLINK_API bool Listen(FNativeSocket Socket, int32 Backlog);
+    PJLINK_API FNativeSocket Accept(FNativeSocket ListenSocket);
+    PJLINK_API uint16 GetBoundPort(FNativeSocket Socket);
+
+    // 여러 소켓 대기 (준비된 소켓 수 반환, 오류 시 -1)
+    PJLINK_API int32 Poll(FPollEntry* Entries, int32 NumEntries, int32 TimeoutMs);
+
+    // 소켓 닫기
+    PJLINK_API void Close(FNativeSocket Socket);
+
+    // 마지막 소켓 오류 코드
+    PJLINK_API int32 GetLastErrorCode();
+
+    // 상대 호스트가 연결을 거부한 오류인지 (RST 응답, 도달 불가 오류와 구분)
+    PJLINK_API bool IsConnectionRefused(int32 ErrorCode);
+
+    // 루프백 주소 (호스트 바이트 순서)
+    static constexpr uint32 LoopbackIPv4 = 0x7F000001;
+}
@@ -4,6 +4,7 @@
 #include "CoreMinimal.h"
 #include "UObject/NoExportTypes.h"
 #include "PJLinkTypes.h"
+#include "PJLinkDiscoveryManager.h"
 #include "PJLinkTests.generated.h"
 
 /**
@@ -64,12 +65,6 @@ public:
     UFUNCTION(BlueprintCallable, Category = "PJLink|Tests")
     static bool RunAllTests(const FPJLinkProjectorInfo& ProjectorInfo);
 
-    UFUNCTION(BlueprintCallable, Category = "PJLink|Tests")
-    static bool TestTimeoutHandling(const FPJLinkProjectorInfo& ProjectorInfo);
-
-    UFUNCTION(BlueprintCallable, Category = "PJLink|Tests")
-    static bool TestDiagnosticSystem(const FPJLinkProjectorInfo& ProjectorInfo);
-
     /**
      * 타임아웃 처리 테스트
      * 명령 타임아웃이 올바르게 감지되고 처리되는지 테스트합니다.
@@ -83,4 +78,250 @@ public:
      */
     UFUNCTION(BlueprintCallable, Category = "PJLink|Tests")
     static bool TestDiagnosticSystem(const FPJLinkProjectorInfo& ProjectorInfo);
+
+    /**
+     * I/O 리액터 유휴 연결 벤치마크
+     * 루프백 연결 NumConnections 개를 리액터에 등록하고 DurationSeconds 동안의
+     * 프로세스 CPU 사용 시간을 측정해 1000 연결당 CPU 사용량을 로그로 출력합니다.
+     */
+    UFUNCTION(BlueprintCallable, Category = "PJLink|Tests")
+    static bool BenchmarkReactorIdleConnections(int32 NumConnections = 1000, float DurationSeconds = 5.0f);
+
+    /**
+     * 수신 대기 중 송신 지연 테스트
+     * 응답하지 않는 루프백 에뮬레이터에 연결한 상태에서 SendCommand 호출 시간을 측정합니다.
+     * 송신이 수신 대기에 막히지 않고 마이크로초 단위로 반환되는지 확인합니다.
+     */
+    UFUNCTION(BlueprintCallable, Category = "PJLink|Tests")
+    static bool TestSendLatencyWhileReadPending(int32 Iterations = 1000);
+
+    /**
+     * 응답 프레임 재조립 테스트
+     * 여러 응답을 임의 크기 조각으로 나눠 넣었을 때 모든 프레임이 순서대로 온전히 복원되는지,
+     * 링 버퍼 경계에서 감긴 프레임과 너무 긴 줄이 올바르게 처리되는지 확인합니다.
+     */
+    UFUNCTION(BlueprintCallable, Category = "PJLink|Tests")
+    static bool TestFrameAssembler();
+
+    /**
+     * 응답 파서 벤치마크
+     * 기존 FString 기반 파서와 바이트 파서의 프레임당 처리 시간(ns)과 힙 할당 횟수를 비교합니다.
+     * 바이트 파서가 기존 파서와 같은 결과를 내고 할당이 전혀 없어야 통과합니다.
+     */
+    UFUNCTION(BlueprintCallable, Category = "PJLink|Tests")
+    static bool BenchmarkResponseParser(int32 Iterations = 1000000);
+
+    /**
+     * 명령 파이프라이닝 응답 짝짓기 테스트
+     * 루프백 에뮬레이터에 여러 명령을 응답을 기다리지 않고 연달아 보낸 뒤,
+     * 모든 응답이 정확한 순번의 요청과 짝지어지고 응답하지 않은 명령은 누락으로 보고되는지 확인합니다.
+     */
+    UFUNCTION(BlueprintCallable, Category = "PJLink|Tests")
+    static bool TestPipelinedCommandCorrelation(int32 NumCommands = 60);
+
+    /**
+     * 상태 조회 일괄 전송 테스트
+     * 명령을 하나씩 보낼 때와 RequestStatus 로 한 번에 보낼 때 에뮬레이터가 받은 세그먼트 수를 비교합니다.
+     * 일괄 전송은 상태 조회 한 번에 세그먼트 하나로 도착해야 통과합니다.
+     */
+    UFUNCTION(BlueprintCallable, Category = "PJLink|Tests")
+    static bool TestBatchedStatusRefresh(int32 Rounds = 20);
+
+    /**
+     * 타이밍 휠 테스트
+     * 가상 시간으로 타임아웃 NumTimers 개를 예약/취소/진행해 일찍 호출되거나 취소된 타이머가 호출되지 않는지 확인하고,
+     * 같은 수의 타이머를 리액터에 예약해 모두 I/O 스레드에서 만료되는지 확인합니다.
+     * 마지막으로 월드 없는 네트워크 매니저의 명령 타임아웃이 보고되는지 확인합니다.
+     */
+    UFUNCTION(BlueprintCallable, Category = "PJLink|Tests")
+    static bool TestTimingWheel(int32 NumTimers = 100000);
+
+    /**
+     * 이벤트 큐 처리 벤치마크
+     * 응답/통신 로그/오류 이벤트 NumEvents 개를 이전 문자열 인코딩 큐와 타입 이벤트 큐로 각각 처리해 비교합니다.
+     * 타입 이벤트 큐의 소비 구간에서 힙 할당이 없어야 통과합니다.
+     */
+    UFUNCTION(BlueprintCallable, Category = "PJLink|Tests")
+    static bool BenchmarkEventDrain(int32 NumEvents = 10000);
+
+    /**
+     * 예산 기반 이벤트 처리 테스트
+     * 이벤트 NumEvents 개를 쌓은 뒤 프레임마다 BudgetMicroseconds 안에서 처리해,
+     * 처리 한 번의 시간이 예산을 크게 넘지 않고 모든 이벤트가 순서대로 전달되는지 확인합니다.
+     * 고정 10개씩 처리하던 방식과 필요한 프레임 수를 비교해 출력합니다.
+     */
+    UFUNCTION(BlueprintCallable, Category = "PJLink|Tests")
+    static bool TestEventDrainBudget(int32 NumEvents = 100000, float BudgetMicroseconds = 100.0f);
+
+    /**
+     * 네이티브 이벤트 전달 벤치마크
+     * 응답 NumEvents 개를 동적 대리자(직접 Broadcast / 게임 스레드 큐 경유)와 네이티브 대리자로 각각 전달해
+     * 이벤트당 비용을 비교합니다. 수신 프레임 하나로 네이티브 응답/전원 변경 이벤트가 호출되는지도 확인합니다.
+     */
+    UFUNCTION(BlueprintCallable, Category = "PJLink|Tests")
+    static bool BenchmarkNativeDispatch(int32 NumEvents = 100000);
+
+    /**
+     * 비동기 연결 테스트
+     * 루프백 에뮬레이터에 비동기로 연결해 완료 후 상태 조회가 도착하는지, 닫힌 포트에는 바로 실패하는지 확인합니다.
+     * 응답 없는 주소 NumProjectors 개에 동시에 연결을 시작해 시작 호출이 막히지 않고
+     * 모든 연결이 TimeoutSeconds 의 두 배 안에 실패로 완료되는지 확인합니다.
+     */
+    UFUNCTION(BlueprintCallable, Category = "PJLink|Tests")
+    static bool TestAsyncConnect(int32 NumProjectors = 200, float TimeoutSeconds = 1.0f);
+
+    /**
+     * 인증 핸드셰이크 테스트
+     * 동기/비동기 연결 각각으로 인증을 요구하는 에뮬레이터에 연결해, 응답 해시가 첫 상태 조회 묶음 앞에 붙어
+     * 세그먼트 하나로 도착하고 에뮬레이터가 인증을 통과시키는지 확인합니다.
+     * "PJLINK 0" 인사말은 인증 없이, 틀린 암호는 인증 실패로 처리되는지도 확인합니다.
+     */
+    UFUNCTION(BlueprintCallable, Category = "PJLink|Tests")
+    static bool TestAuthHandshake();
+
+    /**
+     * 세션 유휴 정책 테스트
+     * 유휴 세션을 IdleTimeoutSeconds 후에 닫는 에뮬레이터로, 유휴 종료 뒤 보낸 명령이 큐에 들어갔다가
+     * 다시 연결되자마자 전송되어 응답을 받는지 Iterations 번 확인하고 연결 유지 상태의 응답 시간과 비교합니다.
+     * KeepAlive 정책에서는 유휴 시간이 여러 번 지나도 세션이 닫히지 않아야 합니다.
+     * 다시 연결이 실패하면 큐에 넣었던 명령마다 응답 없음 완료가 정확히 한 번 보고되어야 합니다.
+     */
+    UFUNCTION(BlueprintCallable, Category = "PJLink|Tests")
+    static bool TestSessionIdlePolicy(int32 Iterations = 5, float IdleTimeoutSeconds = 0.5f);
+
+    /**
+     * 재연결 스케줄러 테스트
+     * 전체 지터 백오프가 0 ~ 상한 사이에 고르게 분포하고 시도마다 상한이 두 배로 느는지 확인합니다.
+     * NumProjectors 개를 연결한 에뮬레이터가 연결을 한꺼번에 끊으면, 모두 다시 연결되되 동시 연결 수가
+     * MaxConcurrentConnects 를 넘지 않고 재연결이 한 순간에 몰리지 않는지 확인합니다.
+     * 닫힌 포트에서는 최대 시도 횟수만큼만 시도하고 포기해야 합니다.
+     */
+    UFUNCTION(BlueprintCallable, Category = "PJLink|Tests")
+    static bool TestReconnectScheduler(int32 NumProjectors = 200, int32 MaxConcurrentConnects = 8);
+
+    /**
+     * Class 2 상태 알림 테스트
+     * 에뮬레이터에 연결한 매니저로 루프백 UDP 알림(전원, 입력, 한 데이터그램에 든 여러 줄, LKUP)을 보내
+     * 상태가 갱신되고 순번 0 응답 이벤트와 변경 이벤트가 발생하는지, 알림을 받은 뒤 IsReceivingNotifications 가
+     * 켜지는지 확인합니다. 수신 포트는 테스트 동안 임의 포트를 사용합니다.
+     */
+    UFUNCTION(BlueprintCallable, Category = "PJLink|Tests")
+    static bool TestNotificationListener();
+
+    /**
+     * Class 2 브로드캐스트 검색 테스트
+     * 루프백 UDP 응답기로 검색 대상을 돌려 %2SRCH 가 설정한 횟수만큼 재전송되는지, 응답기가 송신 포트와
+     * 알림 포트 양쪽으로 보낸 %2ACKN 이 장치 하나(MAC, Class 2)로 중복 제거되어 결과에 들어가는지,
+     * 제한 시간이 지나면 검색이 완료되는지 확인합니다. 게임 스레드에서 실행해야 합니다.
+     */
+    UFUNCTION(BlueprintCallable, Category = "PJLink|Tests")
+    static bool TestBroadcastDiscovery(int32 TransmitCount = 3);
+
+    /**
+     * 논블로킹 스캔 엔진 테스트
+     * NumWorkers 개의 작업 스레드로 루프백 범위를 스캔해 에뮬레이터 하나만 PJLink 호스트로 보고되고
+     * 나머지 주소는 빠짐없이 한 번씩 끝나는지 확인합니다.
+     * 응답하지 않는 TEST-NET 범위 /24 는 연결을 MaxInFlight 개씩 동시에 걸어 연결 제한 시간 한두 번 안에 끝나야 하며,
+     * 작업 스레드들이 거의 함께 끝나 꼬리 시간이 연결 제한 시간 한 번을 넘지 않아야 합니다.
+     */
+    UFUNCTION(BlueprintCallable, Category = "PJLink|Tests")
+    static bool TestScanEngine(int32 MaxInFlight = 256, float ConnectTimeoutSeconds = 0.5f, int32 NumWorkers = 4);
+
+    /**
+     * 스캔 스레드 풀 격리 테스트
+     * 응답하지 않는 /22 (198.18.0.0/22) 를 스캔하는 동안 엔진 공유 풀(GThreadPool)의 점유 스레드 수를
+     * 스캔 전과 비교해 늘지 않았는지, 스캔 작업이 플러그인 I/O 스레드 풀에서 실행되는지 확인합니다.
+     */
+    UFUNCTION(BlueprintCallable, Category = "PJLink|Tests")
+    static bool TestScanThreadPoolIsolation(float ConnectTimeoutSeconds = 1.0f);
+
+    /**
+     * 검색 진행 이벤트 게시 테스트
+     * 응답하지 않는 /22 를 범위 스캔하는 동안 진행 이벤트와 현재 주소 이벤트가 주소마다가 아니라
+     * 게시 주기(10 Hz)로 모여 게임 스레드에서만 발생하는지, 완료 전 마지막 진행 이벤트가 100% 인지 확인합니다.
+     * 게임 스레드에서 실행해야 합니다.
+     */
+    UFUNCTION(BlueprintCallable, Category = "PJLink|Tests")
+    static bool TestDiscoveryProgressPublishing(float ConnectTimeoutSeconds = 1.0f);
+
+    /**
+     * 검색 결과 중복 검사 테스트
+     * 서로 다른 주소의 결과를 NumResults 개 넣은 뒤 같은 주소/MAC 을 다시 넣어 모두 거부되는지,
+     * 결과 수와 무관하게 한 건당 비용이 일정한지(해시 조회), 표시용 IP 문자열이 채워지는지 확인합니다.
+     * IP 문자열 파서의 경계 입력도 함께 확인합니다.
+     */
+    UFUNCTION(BlueprintCallable, Category = "PJLink|Tests")
+    static bool TestDiscoveryResultDedupe(int32 NumResults = 20000);
+
+    /**
+     * 2단계 스캔 테스트
+     * 루프백 에뮬레이터를 스캔해 연결된 호스트에만 CLSS/NAME/INF1/INF2 조회가 한 연결로 한 번에 가는지,
+     * 인증이 필요한 에뮬레이터에는 조회 없이 인사말만 보고되는지 확인합니다.
+     * 루프백 연결 RTT 로 연결 제한 시간이 상한에서 MinConnectTimeoutSeconds 로 줄어드는지도 확인합니다.
+     */
+    UFUNCTION(BlueprintCallable, Category = "PJLink|Tests")
+    static bool TestTwoPhaseScan(float ConnectTimeoutSeconds = 2.0f, float MinConnectTimeoutSeconds = 0.2f);
+
+    /**
+     * 식별 정보 조회 단계 테스트
+     * 스윕이 CLSS 만 확인하고 넘긴 연결에서 NAME/INF1/INF2/INFO 가 같은 연결로 한 번에 조회되는지 확인합니다.
+     * NumDevices 개의 연결을 넘겼을 때 동시에 조회하는 장치가 MaxConcurrent 를 넘지 않고,
+     * 응답이 오는 대로 대기 중인 장치가 조회되어 모두 끝나는지, 처리량 통계가 채워지는지도 확인합니다.
+     */
+    UFUNCTION(BlueprintCallable, Category = "PJLink|Tests")
+    static bool TestDiscoveryEnrichment(int32 NumDevices = 24, int32 MaxConcurrent = 4);
+
+    /**
+     * /24 별 연결 제한 시간 테스트
+     * 빠른 /24 와 느린 /24 에 RTT 표본을 넣었을 때 각자의 제한 시간이 따로 줄고 표본 없는 /24 는 상한을 쓰는지,
+     * 줄인 제한 시간으로 시간 초과된 호스트만 더 긴 제한 시간으로 재시도 대기열에 들어가는지 확인합니다.
+     */
+    UFUNCTION(BlueprintCallable, Category = "PJLink|Tests")
+    static bool TestSubnetRttTimeouts();
+
+    /**
+     * 알려진 호스트 색인과 증분 재스캔 테스트
+     * 두 /24 에 기록한 호스트가 새 색인 객체에서 범위별로 다시 읽히는지, 식별 정보 변경 판단과
+     * 연속 미응답 제거가 맞는지, 스캔 엔진이 대상 목록만 확인하고 제외 목록은 건너뛰는지 확인합니다.
+     */
+    UFUNCTION(BlueprintCallable, Category = "PJLink|Tests")
+    static bool TestKnownHostsRescan();
+
+    /**
+     * 응답 대기 창 초과 테스트
+     * 응답하지 않는 명령을 MaxInFlightCommands 보다 많이 보냈을 때 밀려난 가장 오래된 명령마다
+     * 응답 없음 완료가 정확히 한 번 보고되고, 창에 남은 명령은 아직 완료되지 않았는지 확인합니다.
+     * 이어서 프로젝터 쪽에서 연결을 끊었을 때 남은 명령도 순번마다 한 번씩 완료되는지 확인합니다.
+     */
+    UFUNCTION(BlueprintCallable, Category = "PJLink|Tests")
+    static bool TestInFlightWindowOverflow(int32 NumOverflow = 8);
+
+    /**
+     * 여러 매니저 공유 이벤트 처리 예산 테스트
+     * NumManagers 개 매니저에 이벤트를 한꺼번에 쌓고 같은 프레임에 모두 처리를 예약했을 때
+     * 그 프레임의 처리 시간 합계가 매니저 수와 무관하게 공유 예산 안에 머무는지,
+     * 이후 프레임에서 매니저를 돌아가며 처리해 모든 이벤트가 전달되는지 확인합니다.
+     */
+    UFUNCTION(BlueprintCallable, Category = "PJLink|Tests")
+    static bool TestSharedEventDrainBudget(int32 NumManagers = 32, int32 EventsPerManager = 2000, float BudgetMicroseconds = 200.0f);
+
+private:
+    // 동적 대리자 벤치마크용 처리기
+    UFUNCTION()
+    void HandleBenchmarkResponse(EPJLinkCommand Command, EPJLinkResponseStatus Status, const FString& Response);
+
+    // 검색 진행 이벤트 수신기
+    UFUNCTION()
+    void HandleDiscoveryProgress(const FPJLinkDiscoveryStatus& Status);
+
+    UFUNCTION()
+    void HandleCurrentScanAddress(const FString& CurrentAddress);
+
+    int32 BenchmarkResponseCount = 0;
+
+    // 진행 이벤트 수 / 현재 주소 이벤트 수 / 게임 스레드 밖에서 받은 이벤트 수
+    int32 ProgressEventCount = 0;
+    int32 ScanAddressEventCount = 0;
+    int32 OffGameThreadEventCount = 0;
+    float LastProgressPercentage = 0.0f;
 };
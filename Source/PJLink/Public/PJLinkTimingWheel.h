@@ -0,0 +1,87 @@
+﻿// PJLinkTimingWheel.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/Function.h"
+
+// 타이머 식별자 (0 = 유효하지 않음)
+using FPJLinkTimerId = uint64;
+
+/**
+ * 계층형 타이밍 휠
+ *
+ * 64칸짜리 휠 4단(틱 10ms 기준 약 46시간 범위)으로 마감 시각을 관리합니다.
+ * 예약/취소는 O(1)이고, 진행(Advance)은 틱마다 해당 칸만 처리하며
+ * 상위 단의 타이머는 하위 단으로 내려올 때 한 번씩만 재배치됩니다.
+ *
+ * 스레드 안전하지 않습니다. 리액터 샤드처럼 한 스레드가 소유하고 사용합니다.
+ */
+class PJLINK_API FPJLinkTimingWheel
+{
+public:
+    using FCallback = TUniqueFunction<void()>;
+
+    explicit FPJLinkTimingWheel(double InTickSeconds = 0.01, double StartSeconds = 0.0);
+
+    // 마감 시각(초)에 콜백 예약 - 이미 지난 시각이면 다음 틱에 호출
+    void Schedule(FPJLinkTimerId TimerId, double DeadlineSeconds, FCallback&& Callback);
+
+    // 예약 취소 (이미 호출되었거나 없는 타이머면 false)
+    bool Cancel(FPJLinkTimerId TimerId);
+
+    // 현재 시각까지 진행하며 마감된 콜백 호출 (호출한 콜백 수 반환)
+    // 콜백 안에서 Schedule/Cancel 을 호출해도 됩니다.
+    int32 Advance(double NowSeconds);
+
+    // 다음 처리 시점까지 남은 시간 (예약이 없으면 음수)
+    double GetSecondsUntilNextEvent(double NowSeconds) const;
+
+    // 예약된 타이머 수
+    int32 Num() const { return TimerToNode.Num(); }
+
+    double GetTickSeconds() const { return TickSeconds; }
+
+private:
+    static constexpr int32 NumLevels = 4;
+    static constexpr int32 SlotBits = 6;
+    static constexpr int32 SlotsPerLevel = 1 << SlotBits;
+    static constexpr uint64 SlotMask = SlotsPerLevel - 1;
+
+    struct FNode
+    {
+        FPJLinkTimerId TimerId = 0;
+        uint64 DeadlineTick = 0;
+        int32 Prev = INDEX_NONE;
+        int32 Next = INDEX_NONE;
+        int32 Slot = INDEX_NONE;
+        FCallback Callback;
+    };
+
+    // 초 -> 틱 변환 (마감은 올림, 현재 시각은 내림)
+    uint64 DeadlineToTick(double Seconds) const;
+    uint64 NowToTick(double Seconds) const;
+
+    // 노드를 마감 틱에 맞는 단/칸에 연결
+    void Insert(int32 NodeIndex);
+    void Unlink(int32 NodeIndex);
+
+    // 틱 하나 진행 (상위 단 재배치 후 현재 칸 호출)
+    int32 Step();
+    void Cascade(int32 Level);
+    int32 FireSlot(int32 Slot);
+
+    int32 AllocateNode();
+    void FreeNode(int32 NodeIndex);
+
+    TArray<FNode> Nodes;
+    TArray<int32> FreeNodes;
+    TMap<FPJLinkTimerId, int32> TimerToNode;
+
+    // 칸별 연결 리스트 머리와 단별 사용 중인 칸 비트
+    int32 SlotHeads[NumLevels * SlotsPerLevel];
+    uint64 OccupiedSlots[NumLevels];
+
+    uint64 CurrentTick;
+    double OriginSeconds;
+    double TickSeconds;
+};
@@ -525,4 +525,140 @@ struct PJLINK_API FPJLinkProjectorStatusRecord
     }
 };
 
+/**
+ * 게임 스레드 이벤트 처리 통계
+ */
+USTRUCT(BlueprintType)
+struct PJLINK_API FPJLinkEventQueueStats
+{
+    GENERATED_BODY()
+
+    // 현재 대기 중인 이벤트 수
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "PJLink|Stats")
+    int32 QueueDepth = 0;
+
+    // 처리 시작 시점에 관측된 최대 대기 이벤트 수
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "PJLink|Stats")
+    int32 PeakQueueDepth = 0;
+
+    // 대리자로 전달한 이벤트 수
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "PJLink|Stats")
+    int64 EventsDispatched = 0;
+
+    // 예산을 다 써서 다음 프레임으로 미룬 횟수
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "PJLink|Stats")
+    int32 DeferredDrains = 0;
+
+    // 마지막으로 미룬 이벤트 수
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "PJLink|Stats")
+    int32 LastDeferredEvents = 0;
+
+    // 큐가 가득 차 버린 이벤트 수 (통신 로그만 버림)
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "PJLink|Stats")
+    int32 DroppedEvents = 0;
+
+    // 이벤트가 큐에 들어간 뒤 대리자로 전달되기까지 걸린 시간 (지수 평균 / 최대)
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "PJLink|Stats")
+    float AverageDrainLatencyMs = 0.0f;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "PJLink|Stats")
+    float MaxDrainLatencyMs = 0.0f;
 
+    // 마지막 처리 한 번에 쓴 시간
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "PJLink|Stats")
+    float LastDrainTimeMicroseconds = 0.0f;
+
+    // 마지막으로 계산된 묶음 크기 (이벤트당 처리 비용에 따라 조정됨)
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "PJLink|Stats")
+    int32 LastBatchSize = 0;
+};
+
+/**
+ * 세션 유지 방식
+ * 프로젝터는 일정 시간(보통 약 30초) 통신이 없으면 PJLink 세션을 닫습니다.
+ */
+UENUM(BlueprintType)
+enum class EPJLinkSessionPolicy : uint8
+{
+    // 유휴 종료를 그대로 두고, 다음 명령을 큐에 넣은 채 다시 연결
+    ReconnectOnDemand UMETA(DisplayName = "Reconnect On Demand"),
+
+    // 유휴 시간이 차기 전에 가벼운 조회(POWR ?)를 보내 세션 유지
+    KeepAlive UMETA(DisplayName = "Keep Alive")
+};
+
+/**
+ * 프로젝터 세션 통계 (연결 비용과 유휴 종료 처리)
+ */
+USTRUCT(BlueprintType)
+struct PJLINK_API FPJLinkSessionStats
+{
+    GENERATED_BODY()
+
+    // 성공한 연결 수
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "PJLink|Stats")
+    int32 ConnectCount = 0;
+
+    // 연결 시작부터 세션 준비(인사말/인증 포함)까지 걸린 시간
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "PJLink|Stats")
+    float LastConnectMs = 0.0f;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "PJLink|Stats")
+    float AverageConnectMs = 0.0f;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "PJLink|Stats")
+    float MaxConnectMs = 0.0f;
+
+    // 프로젝터가 유휴 세션을 닫은 횟수
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "PJLink|Stats")
+    int32 IdleDropCount = 0;
+
+    // 세션 유지를 위해 보낸 조회 수
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "PJLink|Stats")
+    int32 KeepAliveCount = 0;
+
+    // 명령 전송 때문에 다시 연결한 횟수
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "PJLink|Stats")
+    int32 OnDemandReconnectCount = 0;
+
+    // 다시 연결될 때까지 큐에 넣었던 명령 수
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "PJLink|Stats")
+    int32 DeferredCommandCount = 0;
+};
+
+/**
+ * 전체 프로젝터 재연결 스케줄러 통계
+ */
+USTRUCT(BlueprintType)
+struct PJLINK_API FPJLinkReconnectStats
+{
+    GENERATED_BODY()
+
+    // 재연결을 기다리는 프로젝터 수 (백오프 대기 + 연결 슬롯 대기 + 연결 중)
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "PJLink|Stats")
+    int32 PendingProjectors = 0;
+
+    // 백오프가 끝났지만 동시 연결 제한 때문에 기다리는 프로젝터 수
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "PJLink|Stats")
+    int32 WaitingForSlot = 0;
+
+    // 지금 진행 중인 재연결 수
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "PJLink|Stats")
+    int32 ActiveConnects = 0;
+
+    // 동시에 진행된 재연결 수의 최댓값
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "PJLink|Stats")
+    int32 PeakActiveConnects = 0;
+
+    // 시작한 재연결 시도 수
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "PJLink|Stats")
+    int32 TotalAttempts = 0;
+
+    // 재연결에 성공한 수
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "PJLink|Stats")
+    int32 SuccessfulReconnects = 0;
+
+    // 최대 시도 횟수를 넘겨 포기한 수
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "PJLink|Stats")
+    int32 GaveUpCount = 0;
+};
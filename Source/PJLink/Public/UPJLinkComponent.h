@@ -4,6 +4,8 @@
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
 #include "PJLinkTypes.h"
+#include "PJLinkNativeEvents.h"
+#include "Async/Future.h"
 #include "UPJLinkComponent.generated.h"
 
 // 전방 선언으로 변경 (포인터로만 사용하므로)
@@ -44,7 +46,7 @@ public:
 
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PJLink|Connection",
         meta = (EditCondition = "bAutoReconnect", UIMin = 1, UIMax = 30, ClampMin = 1, ClampMax = 60,
-            DisplayName = "Reconnect Interval (seconds)", ToolTip = "자동 재연결 시도 간격(초)"))
+            DisplayName = "Reconnect Interval (seconds)", ToolTip = "재연결 백오프 기준 간격(초) - 실패할 때마다 두 배로 늘고 무작위 지연이 적용됨"))
     float ReconnectInterval = 5.0f;
 
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PJLink|Connection",
@@ -69,6 +71,12 @@ public:
             DisplayName = "Status Check Interval (seconds)", ToolTip = "상태 확인 주기(초)"))
     float StatusCheckInterval = 5.0f;
 
+    // 상태 알림을 보내는 프로젝터의 상태 확인 주기 (초)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PJLink|Status",
+        meta = (UIMin = 10.0, UIMax = 300.0, ClampMin = 1.0, ClampMax = 3600.0,
+            DisplayName = "Push Status Check Interval (seconds)", ToolTip = "Class 2 상태 알림을 받고 있는 프로젝터는 이 주기로만 상태 확인(초)"))
+    float PushStatusCheckInterval = 60.0f;
+
     // 디버깅 설정
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PJLink|Debug",
         meta = (DisplayName = "Enable Verbose Logging", ToolTip = "자세한 로그 메시지 활성화"))
@@ -81,6 +89,14 @@ public:
     UFUNCTION(BlueprintCallable, Category = "PJLink")
     void Disconnect();
 
+    // 비동기 연결 시작 (게임 스레드를 막지 않음, 즉시 실패하면 false)
+    // 결과는 상태 머신과 OnConnectionChanged 로 반영됩니다.
+    UFUNCTION(BlueprintCallable, Category = "PJLink")
+    bool ConnectAsync();
+
+    // 비동기 연결 시작 (C++ 전용, 반환된 TFuture 는 I/O 스레드에서 완료됨)
+    TFuture<bool> StartConnect();
+
     UFUNCTION(BlueprintPure, Category = "PJLink")
     bool IsConnected() const;
 
@@ -208,6 +224,9 @@ public:
     UFUNCTION(BlueprintCallable, Category = "PJLink|Advanced")
     UPJLinkNetworkManager* GetNetworkManager() const { return NetworkManager; }
 
+    // C++ 전용 네이티브 이벤트 (네트워크 매니저 이벤트를 I/O 스레드에서 그대로 전달)
+    FPJLinkNativeEvents& GetNativeEvents() { return NativeEvents; }
+
     // 블루프린트에서 쉽게 사용할 수 있는 상태 체크 함수
     UFUNCTION(BlueprintPure, Category = "PJLink|Status")
     bool IsPoweredOn() const { return GetPowerStatus() == EPJLinkPowerStatus::PoweredOn; }
@@ -293,6 +312,9 @@ private:
     UPROPERTY()
     UPJLinkNetworkManager* NetworkManager;
 
+    // 네트워크 매니저에서 전달받는 네이티브 이벤트
+    FPJLinkNativeEvents NativeEvents;
+
     // 상태 확인 타이머 핸들
     FTimerHandle StatusCheckTimerHandle;
 
@@ -303,6 +325,22 @@ private:
     // 주기적 상태 확인
     void CheckStatus();
 
+    // 마지막 상태 확인 후 확인 주기가 지났으면 상태 요청
+    void RequestStatusIfDue();
+
+    // 현재 상태 확인 주기 (상태 알림을 받고 있으면 PushStatusCheckInterval 로 늘어남)
+    float GetEffectiveStatusCheckInterval() const;
+
+    // 마지막 자동 상태 확인 시각 (FPlatformTime::Seconds)
+    double LastStatusCheckTime;
+
+    // 연결 결과를 상태 머신과 이벤트에 반영 (초기 상태 조회는 네트워크 매니저가 보냄)
+    void ApplyConnectResult(bool bConnected);
+
+    // 비동기 연결 완료 처리
+    UFUNCTION()
+    void HandleConnectCompleted(bool bSuccess, EPJLinkErrorCode ErrorCode);
+
     // 이전 상태 추적을 위한 변수
     EPJLinkPowerStatus PreviousPowerStatus;
     EPJLinkInputSource PreviousInputSource;